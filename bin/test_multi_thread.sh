@@ -88,6 +88,10 @@ then
    next_program
    echo_eval $program chkpoint_two 1 4 100
    #
+   # test_time=1,max_thread=4,num_row=1000
+   next_program
+   echo_eval $program subgraph_jac 1 4 1000
+   #
    # test_time=2,max_thread=4,num_zero=20,num_sub=30,num_sum=50,use_ad=true
    next_program
    echo_eval $program multi_newton 2 4 20 30 50 true
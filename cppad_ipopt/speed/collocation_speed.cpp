@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin ipopt_collocation_speed.cpp dev}
+{xrst_spell
+   collocation
+}
+
+Speed Test for Evaluating Many Terms in Parallel
+################################################
+This test times one call to each of the ``cppad_ipopt_nlp`` evaluation
+routines (objective, gradient, constraints, Jacobian, and Hessian)
+for a collocation problem with *N* grid points.
+There are :math:`L(0) = N + 1` objective terms and :math:`L(1) = N`
+constraint terms; see
+:ref:`cppad_ipopt_nlp@fg_info@fg_info.number_threads` .
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end ipopt_collocation_speed.cpp}
+*/
+
+// BEGIN C++
+# include <cppad_ipopt_nlp.hpp>
+# include <cppad/utility/elapsed_seconds.hpp>
+
+namespace {
+   using namespace cppad_ipopt;
+   //
+   // x = [ y_0 , ... , y_N , a ]
+   // f(x)    = sum_{i=0}^N (y_i - a)^2 + a * sin(y_i)
+   // g_i (x) = y_{i+1} - y_i + dt * a * (y_i * y_i + y_{i+1} * y_{i+1}) / 2
+   class FG_collocation : public cppad_ipopt_fg_info
+   {
+   private:
+      size_t N_;
+      size_t num_threads_;
+   public:
+      FG_collocation(size_t N, size_t num_threads)
+      : N_(N), num_threads_(num_threads)
+      { }
+      ADVector eval_r(size_t k, const ADVector&  u)
+      {  ADNumber a = u[u.size() - 1];
+         ADVector r(1);
+         if( k == 0 )
+         {  r[0] = (u[0] - a) * (u[0] - a) + a * sin( u[0] );
+            return r;
+         }
+         double dt = 1.0 / double(N_);
+         r[0] = u[1] - u[0] + dt * a * (u[0] * u[0] + u[1] * u[1]) / 2.0;
+         return r;
+      }
+      bool retape(size_t k)
+      {  return false; }
+      size_t number_functions(void)
+      {  return 2; }
+      size_t domain_size(size_t k)
+      {  if( k == 0 )
+            return 2;
+         return 3;
+      }
+      size_t range_size(size_t k)
+      {  return 1; }
+      size_t number_terms(size_t k)
+      {  if( k == 0 )
+            return N_ + 1;
+         return N_;
+      }
+      void index(size_t k, size_t ell, SizeVector& I, SizeVector& J)
+      {  if( k == 0 )
+         {  I[0] = 0;
+            J[0] = ell;
+            J[1] = N_ + 1;
+            return;
+         }
+         I[0] = 1 + ell;
+         J[0] = ell;
+         J[1] = ell + 1;
+         J[2] = N_ + 1;
+      }
+      size_t number_threads(void)
+      {  return num_threads_; }
+   };
+}
+
+double collocation_speed(size_t num_threads, size_t N)
+{  typedef Ipopt::Number Number;
+   typedef Ipopt::Index  Index;
+   size_t i, j;
+   //
+   // problem dimensions and limits
+   size_t n = N + 2;
+   size_t m = N;
+   NumberVector x_i(n), x_l(n), x_u(n), g_l(m), g_u(m), lambda(m);
+   for(j = 0; j < n; j++)
+   {  x_i[j] = 1.0 + double(j) / double(n);
+      x_l[j] = -1e19;
+      x_u[j] = +1e19;
+   }
+   for(i = 0; i < m; i++)
+   {  g_l[i]    = g_u[i] = 0.0;
+      lambda[i] = 1.0;
+   }
+   //
+   // create the cppad_ipopt_nlp object
+   FG_collocation fg_info(N, num_threads);
+   cppad_ipopt_solution solution;
+   cppad_ipopt_nlp nlp(n, m, x_i, x_l, x_u, g_l, g_u, &fg_info, &solution);
+   //
+   Index n_index = Index(n), m_index = Index(m), nnz_jac_g, nnz_h_lag;
+   Ipopt::TNLP::IndexStyleEnum index_style;
+   nlp.get_nlp_info(n_index, m_index, nnz_jac_g, nnz_h_lag, index_style);
+   //
+   NumberVector grad_f(n), g(m), jac_g( static_cast<size_t>(nnz_jac_g) );
+   NumberVector h_lag( static_cast<size_t>(nnz_h_lag) );
+   Number obj_value;
+   //
+   // The first pass allocates memory for each thread,
+   // time the second pass which makes one call to each evaluation routine.
+   const Number* x = x_i.data();
+   double s0 = 0.0;
+   for(size_t pass = 0; pass < 2; ++pass)
+   {  if( pass == 1 )
+         s0 = CppAD::elapsed_seconds();
+      nlp.eval_f(n_index, x, true, obj_value);
+      nlp.eval_grad_f(n_index, x, false, grad_f.data());
+      nlp.eval_g(n_index, x, false, m_index, g.data());
+      nlp.eval_jac_g(n_index, x, false, m_index,
+         nnz_jac_g, nullptr, nullptr, jac_g.data()
+      );
+      nlp.eval_h(n_index, x, false, 1.0, m_index, lambda.data(), true,
+         nnz_h_lag, nullptr, nullptr, h_lag.data()
+      );
+   }
+   double s1 = CppAD::elapsed_seconds();
+   //
+   return s1 - s0;
+}
+// END C++
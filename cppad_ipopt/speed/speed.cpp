@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cstdio>  // system include files used for I/O
@@ -8,6 +8,7 @@
 
 // external complied tests
 extern double ode_speed(const char* name, size_t& count);
+extern double collocation_speed(size_t num_threads, size_t N);
 
 // main program that runs all the cppad_ipopt speed tests
 int main(void)
@@ -36,5 +37,14 @@ int main(void)
    printf("ode %20s: seconds = %5.2f: eval_r_count = %d\n",
       name, seconds, int(count) );
 
+   // evaluation of many terms using different numbers of threads
+   size_t N = 100000;
+   for(size_t num_threads = 1; num_threads <= 4; num_threads *= 2)
+   {  seconds = collocation_speed(num_threads, N);
+      printf("collocation N = %d, num_threads = %d: seconds = %5.2f\n",
+         int(N), int(num_threads), seconds
+      );
+   }
+
    return 0;
 }
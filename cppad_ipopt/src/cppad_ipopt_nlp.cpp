@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <limits>
 
@@ -19,6 +19,10 @@
 # include <cstdio>
 # endif
 
+# ifdef _OPENMP
+# include <omp.h>
+# endif
+
 // ---------------------------------------------------------------------------
 namespace cppad_ipopt {
 // ---------------------------------------------------------------------------
@@ -28,6 +32,17 @@ namespace cppad_ipopt {
 \brief Member functions for the cppad_ipopt_nlp class.
 */
 
+# ifdef _OPENMP
+namespace {
+   /// in_parallel function used by thread_alloc::parallel_setup
+   bool in_parallel(void)
+   {  return omp_in_parallel() != 0; }
+   /// thread_num function used by thread_alloc::parallel_setup
+   size_t thread_number(void)
+   {  return static_cast<size_t>( omp_get_thread_num() ); }
+}
+# endif
+
 
 /*!
 Constructor for the \ref Nonlinear_Programming_Problem.
@@ -91,6 +106,19 @@ to \f$ r_k (u) \f$ is stored in <tt>r_fun_[k]</tt>.
 
 \li J_ has size equal to the maximum of <tt>q[k]</tt> w.r.t k.
 
+\li num_threads_ is set to <tt>fg_info->number_threads()</tt>
+(to one if this file is not compiled with OpenMP).
+
+\li I_all_, J_all_ have size K_.
+They are set using <tt>fg_info->index</tt> for k such that
+<tt>parallel_k(k)</tt> is true.
+
+\li r_fun_thread_ has size <tt>num_threads_ * K_</tt>.
+For k such that <tt>parallel_k(k)</tt> is true, it contains a copy of
+<tt>r_fun_[k]</tt> for each thread except thread zero.
+
+\li sum_thread_ has size num_threads_.
+
 \par NDEBUG
 If the preprocessor symbol NEBUG is not defined,
 certain of the assumptions about the function calls of the form
@@ -119,7 +147,7 @@ cppad_ipopt_nlp::cppad_ipopt_nlp(
       fg_info_ ( fg_info ) ,
       solution_ (solution) ,
       infinity_ ( std::numeric_limits<Number>::infinity() )
-{  size_t k;
+{  size_t i, j, k, ell;
 
    // set information needed in cppad_ipopt_fg_info
    fg_info_->set_n(n);
@@ -150,7 +178,6 @@ cppad_ipopt_nlp::cppad_ipopt_nlp(
    I_.resize(max_p);
    J_.resize(max_q);
 # ifndef NDEBUG
-   size_t i, j, ell;
    // check for valid range and domain indices
    for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
    {
@@ -199,6 +226,38 @@ cppad_ipopt_nlp::cppad_ipopt_nlp(
       }
    }
 
+   // number of threads used to evaluate terms in parallel
+   num_threads_ = fg_info_->number_threads();
+# ifndef _OPENMP
+   num_threads_ = 1;
+# endif
+   CPPAD_ASSERT_KNOWN(
+      0 < num_threads_ && num_threads_ <= CPPAD_MAX_NUM_THREADS,
+      "cppad_ipopt_nlp: fg_info->number_threads() is zero or too large"
+   );
+   I_all_.resize(K_);
+   J_all_.resize(K_);
+   r_fun_thread_.resize(num_threads_ * K_);
+   sum_thread_.resize(num_threads_);
+   for(k = 0; k < K_; k++) if( parallel_k(k) )
+   {  // index vectors for all the terms that use r_k
+      // (so fg_info_ is not used in parallel mode)
+      I_all_[k].resize( L_[k] * p_[k] );
+      J_all_[k].resize( L_[k] * q_[k] );
+      for(ell = 0; ell < L_[k]; ell++)
+      {  fg_info_->index(k, ell, I_, J_);
+         for(i = 0; i < p_[k]; i++)
+            I_all_[k][ ell * p_[k] + i ] = I_[i];
+         for(j = 0; j < q_[k]; j++)
+            J_all_[k][ ell * q_[k] + j ] = J_[j];
+      }
+      // a copy of r_k for each thread except thread zero
+      for(size_t thread = 1; thread < num_threads_; thread++)
+         r_fun_thread_[thread * K_ + k] = r_fun_[k];
+   }
+   if( num_threads_ > 1 )
+      CppAD::parallel_ad<Number>();
+
    // compute a sparsity patterns for each r_k (u)
    vec_fun_pattern(
       K_, p_, q_, retape_, r_fun_,      // inputs
@@ -418,7 +477,9 @@ bool cppad_ipopt_nlp::eval_f(
          tape_ok_[k] = false;
    }
 
-   for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
+   // terms that are not evaluated in parallel
+   for(k = 0; k < K_; k++) if( ! parallel_k(k) )
+   for(ell = 0; ell < L_[k]; ell++)
    {  fg_info_->index(k, ell, I_, J_);
       for(iobj = 0; iobj < p_[k]; iobj++) if( I_[iobj] == 0 )
       {  if( ! tape_ok_[k] )
@@ -445,6 +506,9 @@ bool cppad_ipopt_nlp::eval_f(
          obj_value += r[iobj];
       }
    }
+   // terms that are evaluated in parallel
+   if( num_threads_ > 1 )
+      eval_parallel(eval_f_enum, x, 0., nullptr, 1, &obj_value);
 # if CPPAD_IPOPT_NLP_TRACE
    using std::printf;
    for(j = 0; j < n_; j++)
@@ -500,7 +564,9 @@ bool cppad_ipopt_nlp::eval_grad_f(
          tape_ok_[k] = false;
    }
 
-   for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
+   // terms that are not evaluated in parallel
+   for(k = 0; k < K_; k++) if( ! parallel_k(k) )
+   for(ell = 0; ell < L_[k]; ell++)
    {  fg_info_->index(k, ell, I_, J_);
       for(iobj = 0; iobj < p_[k]; iobj++) if( I_[iobj] == 0 )
       {  if( ! tape_ok_[k] )
@@ -535,6 +601,9 @@ bool cppad_ipopt_nlp::eval_grad_f(
          }
       }
    }
+   // terms that are evaluated in parallel
+   if( num_threads_ > 1 )
+      eval_parallel(eval_grad_f_enum, x, 0., nullptr, n_, grad_f);
 # if CPPAD_IPOPT_NLP_TRACE
    using std::printf;
    for(j = 0; j < n_; j++) printf(
@@ -596,7 +665,9 @@ bool cppad_ipopt_nlp::eval_g(
          tape_ok_[k] = false;
    }
 
-   for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
+   // terms that are not evaluated in parallel
+   for(k = 0; k < K_; k++) if( ! parallel_k(k) )
+   for(ell = 0; ell < L_[k]; ell++)
    {  fg_info_->index(k, ell, I_, J_);
       if( ! tape_ok_[k] )
       {  // Record r_k for value of u corresponding to x
@@ -625,6 +696,9 @@ bool cppad_ipopt_nlp::eval_g(
             g[ I_[i] - 1 ] += r[i];
       }
    }
+   // terms that are evaluated in parallel
+   if( num_threads_ > 1 )
+      eval_parallel(eval_g_enum, x, 0., nullptr, m_, g);
 # if CPPAD_IPOPT_NLP_TRACE
    using std::printf;
    for(j = 0; j < n_; j++)
@@ -725,7 +799,9 @@ bool cppad_ipopt_nlp::eval_jac_g(Index n, const Number* x, bool new_x,
          tape_ok_[k] = false;
    }
 
-   for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
+   // terms that are not evaluated in parallel
+   for(k = 0; k < K_; k++) if( ! parallel_k(k) )
+   for(ell = 0; ell < L_[k]; ell++)
    {  fg_info_->index(k, ell, I_, J_);
       if( ! tape_ok_[k] )
       {  // Record r_k for value of u corresponding to x
@@ -766,6 +842,9 @@ bool cppad_ipopt_nlp::eval_jac_g(Index n, const Number* x, bool new_x,
          }
       }
    }
+   // terms that are evaluated in parallel
+   if( num_threads_ > 1 )
+      eval_parallel(eval_jac_g_enum, x, 0., nullptr, nnz_jac_g_, values);
 # ifndef NDEBUG
    for(l = 0; l < nnz_jac_g_; l++) CPPAD_ASSERT_KNOWN(
       (-infinity_ < values[l]) && (values[l] < infinity_),
@@ -882,7 +961,9 @@ bool cppad_ipopt_nlp::eval_h(Index n, const Number* x, bool new_x,
          tape_ok_[k] = false;
    }
 
-   for(k = 0; k < K_; k++) for(ell = 0; ell < L_[k]; ell++)
+   // terms that are not evaluated in parallel
+   for(k = 0; k < K_; k++) if( ! parallel_k(k) )
+   for(ell = 0; ell < L_[k]; ell++)
    {  fg_info_->index(k, ell, I_, J_);
       bool in_use = false;
       for(i = 0; i < p_[k]; i++)
@@ -941,6 +1022,9 @@ bool cppad_ipopt_nlp::eval_h(Index n, const Number* x, bool new_x,
          }
       }
    }
+   // terms that are evaluated in parallel
+   if( num_threads_ > 1 )
+      eval_parallel(eval_h_enum, x, obj_factor, lambda, nnz_h_lag_, values);
 # ifndef NDEBUG
    for(l = 0; l < nnz_h_lag_; l++) CPPAD_ASSERT_KNOWN(
       (-infinity_ < values[l]) && (values[l] < infinity_),
@@ -951,6 +1035,238 @@ bool cppad_ipopt_nlp::eval_h(Index n, const Number* x, bool new_x,
    return true;
 }
 
+/*!
+Evaluate the terms that are computed in parallel and add them to a sum.
+
+\param[in] eval
+is the evaluation method that is computing the sum.
+
+\param[in] x
+is the point at which the terms are evaluated (size n_).
+
+\param[in] obj_factor
+is the factor multiplying the Hessian of f(x)
+(only used when eval is eval_h_enum).
+
+\param[in] lambda
+is the factor multiplying the Hessian of g(x) (size m_)
+(only used when eval is eval_h_enum).
+
+\param[in] n_sum
+is the number of elements in sum.
+
+\param[in,out] sum
+is a vector of size n_sum.
+The terms corresponding to k such that parallel_k(k) is true
+are added to its elements; e.g., for eval_jac_g_enum
+<tt>sum[l]</tt> is the l-th possibly non-zero entry in the Jacobian of g(x).
+
+\par sum_thread_
+Each thread sums its terms in its own element of this vector.
+These elements are then added to sum, in thread order, in sequential mode.
+Hence no locking is required and the result does not depend on the
+order in which the threads execute.
+*/
+void cppad_ipopt_nlp::eval_parallel(
+   eval_enum      eval        ,
+   const Number*  x           ,
+   Number         obj_factor  ,
+   const Number*  lambda      ,
+   size_t         n_sum       ,
+   Number*        sum         )
+{  CPPAD_ASSERT_UNKNOWN( num_threads_ > 1 );
+   size_t i, thread;
+
+   // initialize the sum for each thread
+   for(thread = 0; thread < num_threads_; thread++)
+   {  sum_thread_[thread].resize(n_sum);
+      for(i = 0; i < n_sum; i++)
+         sum_thread_[thread][i] = 0.;
+   }
+
+# ifdef _OPENMP
+   // The number of threads in the team may be less than num_threads_
+   CppAD::thread_alloc::parallel_setup(
+      num_threads_, in_parallel, thread_number
+   );
+# pragma omp parallel num_threads( int(num_threads_) )
+   {  size_t num_team = static_cast<size_t>( omp_get_num_threads() );
+      eval_thread(eval, thread_number(), num_team, x, obj_factor, lambda);
+   }
+   CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+# else
+   eval_thread(eval, 0, 1, x, obj_factor, lambda);
+# endif
+
+   // add the sums for each thread
+   for(thread = 0; thread < num_threads_; thread++)
+   {  for(i = 0; i < n_sum; i++)
+         sum[i] += sum_thread_[thread][i];
+   }
+   return;
+}
+/*!
+Evaluate the terms that are computed by one thread.
+
+\param[in] eval
+is the evaluation method that is computing the sum.
+
+\param[in] thread
+is the thread number for this thread; i.e., the value returned by
+thread_alloc::thread_num() for the current thread.
+
+\param[in] num_team
+is the number of threads that are evaluating terms.
+For each k, this thread evaluates the terms with index
+<tt>ell = ell_begin , ... , ell_end - 1</tt> where
+<tt>ell_begin = (thread * L_[k]) / num_team</tt> and
+<tt>ell_end = ((thread + 1) * L_[k]) / num_team</tt>.
+
+\param[in] x
+see eval_parallel.
+
+\param[in] obj_factor
+see eval_parallel.
+
+\param[in] lambda
+see eval_parallel.
+
+\par sum_thread_
+The terms for this thread are added to <tt>sum_thread_[thread]</tt>.
+No other element of sum_thread_ is modified.
+
+\par r_fun_thread_
+If thread is not zero, <tt>r_fun_thread_[thread * K_ + k]</tt>
+is used to evaluate r_k (u). Otherwise, <tt>r_fun_[k]</tt> is used.
+*/
+void cppad_ipopt_nlp::eval_thread(
+   eval_enum      eval        ,
+   size_t         thread      ,
+   size_t         num_team    ,
+   const Number*  x           ,
+   Number         obj_factor  ,
+   const Number*  lambda      )
+{  CPPAD_ASSERT_UNKNOWN( thread < num_team );
+   CPPAD_ASSERT_UNKNOWN( num_team <= num_threads_ );
+   size_t i, j, k, ell, l;
+   std::map<size_t,size_t>::const_iterator index_ij;
+
+   // sum for this thread
+   NumberVector& sum( sum_thread_[thread] );
+
+   for(k = 0; k < K_; k++) if( parallel_k(k) )
+   {  // function object for r_k that is used by this thread
+      CppAD::ADFun<Number>& r_fun(
+         thread == 0 ? r_fun_[k] : r_fun_thread_[thread * K_ + k]
+      );
+      // work space for this thread
+      NumberVector u(q_[k]), w(p_[k]), r, r_grad, jac_r, r_hes;
+      //
+      size_t ell_begin = (thread * L_[k]) / num_team;
+      size_t ell_end   = ((thread + 1) * L_[k]) / num_team;
+      for(ell = ell_begin; ell < ell_end; ell++)
+      {  // I_{k,ell} and J_{k,ell}
+         const size_t* I = I_all_[k].data() + ell * p_[k];
+         const size_t* J = J_all_[k].data() + ell * q_[k];
+         //
+         // u
+         for(j = 0; j < q_[k]; j++)
+         {  CPPAD_ASSERT_UNKNOWN( J[j] < n_ );
+            u[j]   = x[ J[j] ];
+         }
+         //
+         // does this term contribute to f(x)
+         bool in_f = false;
+         for(i = 0; i < p_[k]; i++)
+            in_f |= I[i] == 0;
+         //
+         switch( eval )
+         {  // ----------------------------------------------------------
+            case eval_f_enum:
+            if( in_f )
+            {  r = r_fun.Forward(0, u);
+               for(i = 0; i < p_[k]; i++) if( I[i] == 0 )
+                  sum[0] += r[i];
+            }
+            break;
+            // ----------------------------------------------------------
+            case eval_grad_f_enum:
+            if( in_f )
+            {  r_fun.Forward(0, u);
+               for(i = 0; i < p_[k]; i++)
+                  w[i] = I[i] == 0 ? 1. : 0.;
+               r_grad = r_fun.Reverse(1, w);
+               for(j = 0; j < q_[k]; j++)
+                  sum[ J[j] ] += r_grad[j];
+            }
+            break;
+            // ----------------------------------------------------------
+            case eval_g_enum:
+            r = r_fun.Forward(0, u);
+            for(i = 0; i < p_[k]; i++)
+            {  CPPAD_ASSERT_UNKNOWN( I[i] <= m_ );
+               if( I[i] >= 1 )
+                  sum[ I[i] - 1 ] += r[i];
+            }
+            break;
+            // ----------------------------------------------------------
+            case eval_jac_g_enum:
+            jac_r = r_fun.SparseJacobian(u, pattern_jac_r_[k]);
+            for(i = 0; i < p_[k]; i++) if( I[i] != 0 )
+            {  CPPAD_ASSERT_UNKNOWN( I[i] <= m_ );
+               const std::map<size_t,size_t>& index_i(
+                  index_jac_g_[ I[i] - 1 ]
+               );
+               for(j = 0; j < q_[k]; j++)
+               {  index_ij = index_i.find( J[j] );
+                  if( index_ij != index_i.end() )
+                  {  l       = index_ij->second;
+                     sum[l] += jac_r[i * q_[k] + j];
+                  }
+                  else
+                     CPPAD_ASSERT_UNKNOWN(
+                     jac_r[i * q_[k] + j] == 0.
+                  );
+               }
+            }
+            break;
+            // ----------------------------------------------------------
+            case eval_h_enum:
+            {  bool in_use = false;
+               for(i = 0; i < p_[k]; i++)
+               {  CPPAD_ASSERT_UNKNOWN( I[i] <= m_ );
+                  if( I[i] == 0 )
+                     w[i] = obj_factor;
+                  else
+                     w[i] = lambda[ I[i] - 1 ];
+                  in_use |= w[i] > 0.;
+               }
+               if( in_use )
+               {  r_hes = r_fun.SparseHessian(u, w, pattern_hes_r_[k]);
+                  for(i = 0; i < q_[k]; i++) for(j = 0; j < q_[k]; j++)
+                  if( J[j] <= J[i] )
+                  {  const std::map<size_t,size_t>& index_i(
+                        index_hes_fg_[ J[i] ]
+                     );
+                     index_ij = index_i.find( J[j] );
+                     if( index_ij != index_i.end() )
+                     {  l       = index_ij->second;
+                        sum[l] += r_hes[i * q_[k] + j];
+                     }
+                     else
+                        CPPAD_ASSERT_UNKNOWN(
+                        r_hes[i * q_[k] + j] == 0.
+                     );
+                  }
+               }
+            }
+            break;
+         }
+      }
+   }
+   return;
+}
+
 /*!
 Pass solution information from Ipopt to users solution structure.
 
@@ -446,6 +446,45 @@ for :math:`i = 0 , \ldots , m`,
 and  for :math:`j = 0 , \ldots , n-1`,
 *J* [ *j* ] = *j* .
 
+fg_info.number_threads
+======================
+This member function has prototype
+
+   ``virtual size_t cppad_ipopt_fg_info::number_threads`` ( ``void`` )
+
+If *number_threads* has type ``size_t`` , the syntax
+
+   *number_threads* = *fg_info* . ``number_threads`` ()
+
+sets the number of threads used to evaluate :math:`r_k (u)`,
+and its derivatives,
+for the :math:`L(k)` terms corresponding to each *k*
+such that *fg_info* . ``retape`` ( *k* ) is false.
+
+#. Each thread evaluates a contiguous subset of the terms
+   using its own copy of the operation sequence for :math:`r_k (u)` .
+#. Each thread accumulates its terms in its own copy of
+   the values for :math:`fg(x)` and its derivatives.
+   These copies are added together after all the threads are done
+   (no locking is used).
+#. The index vectors :math:`I_{k,\ell}` and :math:`J_{k,\ell}`
+   for these terms are computed by the ``cppad_ipopt_nlp`` constructor.
+   Hence the *fg_info* member functions are only called in sequential mode.
+#. The threads are created using OpenMP.
+   If the ``cppad_ipopt`` library is not compiled with OpenMP support,
+   *number_threads* is not used.
+#. The ``cppad_ipopt_nlp`` evaluation routines call
+   :ref:`thread_alloc::parallel_setup<ta_parallel_setup-name>`
+   before they create the threads,
+   and return to sequential mode when the threads are done.
+   Hence CppAD must not be executing in parallel mode when Ipopt
+   calls these routines.
+
+The ``cppad_ipopt_fg_info`` implementation of this function
+sets *number_threads* to one; i.e., the terms are evaluated sequentially.
+The :ref:`ipopt_collocation_speed.cpp-name` program times the evaluations
+for different values of *number_threads* .
+
 solution
 ********
 After the optimization process is completed, *solution* contains
@@ -638,6 +677,10 @@ public:
       for(size_t j = 0; j < n_; j++)
          J[j] = j;
    }
+   /// number of threads used to evaluate the terms for r_k (u)
+   /// when retape(k) is false (default is one)
+   virtual size_t number_threads(void)
+   {  return 1; }
 };
 
 /*!
@@ -744,6 +787,14 @@ private:
    /// A mapping that is dense in i, sparse in j, and maps (i, j)
    /// to the corresponding sparsity index in Ipopt.
    typedef CppAD::vector< std::map<size_t,size_t> > IndexMap;
+   /// A simple vector of simple vectors of size_t values
+   typedef CppAD::vector<SizeVector>             SizeVectorVector;
+   /// A simple vector of simple vectors of Ipopt values
+   typedef CppAD::vector<NumberVector>           NumberVectorVector;
+   /// Which evaluation method is computing terms in parallel
+   enum eval_enum {
+      eval_f_enum, eval_grad_f_enum, eval_g_enum, eval_jac_g_enum, eval_h_enum
+   };
 
    // ------------------------------------------------------------------
    // Values directly passed in to constuctor
@@ -884,6 +935,36 @@ private:
    SizeVector             J_;
    /// work space of size equal maximum of <tt>p[k]</tt> w.r.t k.
    SizeVector             I_;
+   // ------------------------------------------------------------------
+   // Values used to evaluate terms in parallel
+   // ------------------------------------------------------------------
+   /// number of threads used to evaluate the terms for r_k (u)
+   /// when retape_[k] is false (one means the terms are evaluated
+   /// sequentially); see parallel_k.
+   size_t                           num_threads_;
+   /*!
+   Index vectors for terms that are evaluated in parallel.
+
+   If <tt>parallel_k(k)</tt> is true,
+   for <tt>ell = 0 , ... , L_[k]-1</tt>,
+   <tt>I_all_[k][ ell * p_[k] + i ]</tt> is the i-th element of
+   \f$ I_{k,\ell} \f$ and
+   <tt>J_all_[k][ ell * q_[k] + j ]</tt> is the j-th element of
+   \f$ J_{k,\ell} \f$.
+   Otherwise <tt>I_all_[k]</tt> and <tt>J_all_[k]</tt> are empty.
+   */
+   SizeVectorVector                 I_all_;
+   /// see I_all_
+   SizeVectorVector                 J_all_;
+   /// If <tt>parallel_k(k)</tt> is true,
+   /// for <tt>thread = 1 , ... , num_threads_-1</tt>,
+   /// <tt>r_fun_thread_[thread * K_ + k]</tt> is a copy of
+   /// <tt>r_fun_[k]</tt> that is only used by the specified thread.
+   ADFunVector                      r_fun_thread_;
+   /// For <tt>thread = 0 , ... , num_threads_-1</tt>,
+   /// <tt>sum_thread_[thread]</tt> is the sum of the terms computed by
+   /// the specified thread; see eval_parallel.
+   NumberVectorVector               sum_thread_;
    // ------------------------------------------------------------
    // Private Methods
    // ------------------------------------------------------------
@@ -891,6 +972,27 @@ private:
    cppad_ipopt_nlp(const cppad_ipopt_nlp&);
    /// blocks the assignment operator from use
    cppad_ipopt_nlp& operator=(const cppad_ipopt_nlp&);
+   /// are the terms for r_k (u) evaluated in parallel
+   bool parallel_k(size_t k) const
+   {  return num_threads_ > 1 && ! retape_[k]; }
+   // evaluate the terms for r_k (u) that are evaluated in parallel
+   void eval_parallel(
+      eval_enum      eval        ,
+      const Number*  x           ,
+      Number         obj_factor  ,
+      const Number*  lambda      ,
+      size_t         n_sum       ,
+      Number*        sum
+   );
+   // evaluate the terms for one thread
+   void eval_thread(
+      eval_enum      eval        ,
+      size_t         thread      ,
+      size_t         num_team    ,
+      const Number*  x           ,
+      Number         obj_factor  ,
+      const Number*  lambda
+   );
 public:
    // ----------------------------------------------------------------
    // See cppad_ipopt_nlp.cpp for doxygen documentation of these methods
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad_ipopt_nlp.hpp>
+
+namespace { // Begin empty namespace
+using namespace cppad_ipopt;
+
+// ---------------------------------------------------------------------------
+/*
+x = [ y_0 , ... , y_N , a ]
+f(x) = sum_{i=0}^N (y_i - a)^2 + a * sin(y_i)
+g_i (x) = y_{i+1} - y_i + dt * a * (y_i * y_i + y_{i+1} * y_{i+1}) / 2
+*/
+class FG_parallel_eval : public cppad_ipopt_fg_info
+{
+private:
+   size_t N_;
+   size_t num_threads_;
+public:
+   // derived class part of constructor
+   FG_parallel_eval(size_t N, size_t num_threads)
+   : N_(N), num_threads_(num_threads)
+   { }
+   ADVector eval_r(size_t k, const ADVector&  u)
+   {  ADNumber a = u[u.size() - 1];
+      ADVector r(1);
+      if( k == 0 )
+      {  // objective term
+         r[0] = (u[0] - a) * (u[0] - a) + a * sin( u[0] );
+         return r;
+      }
+      // trapezoidal approximation for y'(t) = - a * y(t) * y(t)
+      double dt = 1.0 / double(N_);
+      r[0] = u[1] - u[0] + dt * a * (u[0] * u[0] + u[1] * u[1]) / 2.0;
+      return r;
+   }
+   bool retape(size_t k)
+   {  return false; }
+   size_t number_functions(void)
+   {  return 2; }
+   size_t domain_size(size_t k)
+   {  if( k == 0 )
+         return 2;
+      return 3;
+   }
+   size_t range_size(size_t k)
+   {  return 1; }
+   size_t number_terms(size_t k)
+   {  if( k == 0 )
+         return N_ + 1;
+      return N_;
+   }
+   void index(size_t k, size_t ell, SizeVector& I, SizeVector& J)
+   {  if( k == 0 )
+      {  I[0] = 0;
+         J[0] = ell;
+         J[1] = N_ + 1;
+         return;
+      }
+      I[0] = 1 + ell;
+      J[0] = ell;
+      J[1] = ell + 1;
+      J[2] = N_ + 1;
+   }
+   size_t number_threads(void)
+   {  return num_threads_; }
+};
+} // end empty namespace
+
+bool parallel_eval(void)
+{  bool ok = true;
+   typedef Ipopt::Number Number;
+   typedef Ipopt::Index  Index;
+   size_t i, j;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+
+   // dimensions for this problem
+   size_t N = 50;
+   size_t n = N + 2;
+   size_t m = N;
+   NumberVector x_i(n), x_l(n), x_u(n), g_l(m), g_u(m);
+   for(j = 0; j < n; j++)
+   {  x_i[j] = 1.0 + double(j) / double(n);
+      x_l[j] = -1e19;
+      x_u[j] = +1e19;
+   }
+   for(i = 0; i < m; i++)
+      g_l[i] = g_u[i] = 0.0;
+   NumberVector lambda(m);
+   for(i = 0; i < m; i++)
+      lambda[i] = 1.0 + double(i);
+   Number obj_factor = 2.0;
+
+   // one thread (sequential) and multiple thread evaluations
+   FG_parallel_eval fg_one(N, 1), fg_four(N, 4);
+   cppad_ipopt_solution solution_one, solution_four;
+   cppad_ipopt_nlp nlp_one(
+      n, m, x_i, x_l, x_u, g_l, g_u, &fg_one, &solution_one
+   );
+   cppad_ipopt_nlp nlp_four(
+      n, m, x_i, x_l, x_u, g_l, g_u, &fg_four, &solution_four
+   );
+
+   // sparsity patterns
+   Index n_index = Index(n), m_index = Index(m);
+   Index nnz_jac_g, nnz_h_lag, nnz_jac_four, nnz_h_four;
+   Ipopt::TNLP::IndexStyleEnum index_style;
+   nlp_one.get_nlp_info(n_index, m_index, nnz_jac_g, nnz_h_lag, index_style);
+   nlp_four.get_nlp_info(
+      n_index, m_index, nnz_jac_four, nnz_h_four, index_style
+   );
+   ok &= nnz_jac_g == nnz_jac_four;
+   ok &= nnz_h_lag == nnz_h_four;
+   if( ! ok )
+      return ok;
+
+   // x
+   NumberVector x(n);
+   for(j = 0; j < n; j++)
+      x[j] = 0.5 + double(j) / double(n);
+   bool new_x = true;
+
+   // eval_f
+   Number f_one, f_four;
+   nlp_one.eval_f(n_index, x.data(), new_x, f_one);
+   nlp_four.eval_f(n_index, x.data(), new_x, f_four);
+   ok &= CppAD::NearEqual(f_one, f_four, eps99, eps99);
+
+   // eval_grad_f
+   NumberVector grad_one(n), grad_four(n);
+   nlp_one.eval_grad_f(n_index, x.data(), new_x, grad_one.data());
+   nlp_four.eval_grad_f(n_index, x.data(), new_x, grad_four.data());
+   for(j = 0; j < n; j++)
+      ok &= CppAD::NearEqual(grad_one[j], grad_four[j], eps99, eps99);
+
+   // eval_g
+   NumberVector g_one(m), g_four(m);
+   nlp_one.eval_g(n_index, x.data(), new_x, m_index, g_one.data());
+   nlp_four.eval_g(n_index, x.data(), new_x, m_index, g_four.data());
+   for(i = 0; i < m; i++)
+      ok &= CppAD::NearEqual(g_one[i], g_four[i], eps99, eps99);
+
+   // eval_jac_g
+   size_t nnz = size_t(nnz_jac_g);
+   NumberVector jac_one(nnz), jac_four(nnz);
+   nlp_one.eval_jac_g(n_index, x.data(), new_x, m_index,
+      nnz_jac_g, nullptr, nullptr, jac_one.data()
+   );
+   nlp_four.eval_jac_g(n_index, x.data(), new_x, m_index,
+      nnz_jac_g, nullptr, nullptr, jac_four.data()
+   );
+   for(size_t l = 0; l < nnz; l++)
+      ok &= CppAD::NearEqual(jac_one[l], jac_four[l], eps99, eps99);
+
+   // eval_h
+   nnz = size_t(nnz_h_lag);
+   NumberVector hes_one(nnz), hes_four(nnz);
+   bool new_lambda = true;
+   nlp_one.eval_h(n_index, x.data(), new_x, obj_factor, m_index,
+      lambda.data(), new_lambda, nnz_h_lag, nullptr, nullptr, hes_one.data()
+   );
+   nlp_four.eval_h(n_index, x.data(), new_x, obj_factor, m_index,
+      lambda.data(), new_lambda, nnz_h_lag, nullptr, nullptr, hes_four.data()
+   );
+   for(size_t l = 0; l < nnz; l++)
+      ok &= CppAD::NearEqual(hes_one[l], hes_four[l], eps99, eps99);
+
+   // check one value of the objective
+   Number check = 0.0;
+   Number a     = x[N+1];
+   for(j = 0; j <= N; j++)
+      check += (x[j] - a) * (x[j] - a) + a * std::sin( x[j] );
+   ok &= CppAD::NearEqual(f_one, check, eps99, eps99);
+
+   return ok;
+}
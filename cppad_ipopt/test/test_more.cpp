@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // system include files used for I/O
@@ -18,6 +18,7 @@
 // external complied tests
 extern bool k_gt_one(void);
 extern bool multiple_solution(void);
+extern bool parallel_eval(void);
 extern bool retape_k1_l1(void);
 extern bool retape_k1_l2(void);
 
@@ -30,6 +31,7 @@ int main(void)
    // external compiled tests
    Run( k_gt_one,            "k_gt_one"           );
    Run( multiple_solution,   "multiple_solution"  );
+   Run( parallel_eval,       "parallel_eval"      );
    Run( retape_k1_l1,        "retape_k1_l1"       );
    Run( retape_k1_l2,        "retape_k1_l2"       );
    //
@@ -10,8 +10,9 @@ Converts Cpp Graph to C Source
 
 Syntax
 ******
-``csrc_writer(%os%, %graph_obj%, %c_type%)``
-``%``
+| ``csrc_writer(%os%, %graph_obj%, %c_type%)``
+| ``csrc_writer(%os%, %graph_obj%, %c_type%, %options%)``
+| ``csrc_writer(%csrc_vec%, %graph_obj%, %c_type%, %options%)``
 
 Prototype
 *********
@@ -24,6 +25,12 @@ os
 **
 The C source code corresponding to the function is written to *os* .
 
+csrc_vec
+********
+The size of this vector is the number of translation units.
+Upon return, *csrc_vec* [ *i* ] is the C source code for
+the *i*-th translation unit; see :ref:`to_csrc@csrc_vec` .
+
 graph
 *****
 is the C++ graph representation of the function.
@@ -34,9 +41,16 @@ this specifies the type corresponding to the C source code and must
 be one of the following:
 ``float`` , ``double`` , or ``long_double`` .
 
+options
+*******
+If this argument is present, it has the same meaning as
+:ref:`to_csrc@options` in the ``to_csrc`` documentation.
+
 {xrst_end cpp_csrc_writer}
 */
 
+# include <sstream>
+# include <cstdlib>
 # include <cppad/local/pod_vector.hpp>
 # include <cppad/core/cppad_assert.hpp>
 # include <cppad/core/graph/cpp_graph.hpp>
@@ -45,17 +59,37 @@ be one of the following:
 // documentation for this routine is in the file below
 # include <cppad/local/graph/csrc_writer.hpp>
 
+# include <cppad/utility/vector.hpp>
+
 /* Optimizations 2DO:
 1. Reduce size of v by removing x and y from the v vector.
-2. Reduce size of v by reusing elemnents when they are no longer needed.
 */
 
 
 namespace {
    //
    // element
-   std::string element(const std::string& array_name, size_t array_index)
-   {  return array_name + "[" + CppAD::to_string(array_index) + "]"; }
+   // lane is empty for the scalar function. For the batch function
+   // it is [k] where k is the index of the current point in the block.
+   std::string element(
+      const std::string& array_name  ,
+      size_t             array_index ,
+      const std::string& lane = ""   )
+   {  return array_name + "[" + CppAD::to_string(array_index) + "]" + lane; }
+   //
+   // loop
+   // If lane is non-empty, this is the start of a loop over the points in
+   // the current block. If simd is true, the iterations of the loop are
+   // independent and the compiler is told it can vectorize them.
+   std::string loop(const std::string& lane, bool simd)
+   {  if( lane == "" )
+         return "";
+      std::string result;
+      if( simd )
+         result = "\t# pragma omp simd\n";
+      result += "\tfor(k = 0; k < nb; ++k)\n\t";
+      return result;
+   }
    //
    // binary_function
    void binary_function(
@@ -63,11 +97,13 @@ namespace {
       const char*    op_csrc      ,
       size_t         result_node  ,
       size_t         left_node    ,
-      size_t         right_node   )
-   {  os << "\t" + element("v", result_node) + " = ";
+      size_t         right_node   ,
+      const std::string& lane     )
+   {  os << loop(lane, true);
+      os << "\t" + element("v", result_node, lane) + " = ";
       os << op_csrc;
-      os << "( " + element("v", left_node);
-      os << ", " + element("v", right_node) + " );\n";
+      os << "( " + element("v", left_node, lane);
+      os << ", " + element("v", right_node, lane) + " );\n";
    }
    //
    // binary_operator
@@ -76,10 +112,12 @@ namespace {
       const char*    op_csrc      ,
       size_t         result_node  ,
       size_t         left_node    ,
-      size_t         right_node   )
-   {  os << "\t" + element("v", result_node) + " = ";
-      os << element("v", left_node) + " " + op_csrc + " ";
-      os << element("v", right_node) + ";\n";
+      size_t         right_node   ,
+      const std::string& lane     )
+   {  os << loop(lane, true);
+      os << "\t" + element("v", result_node, lane) + " = ";
+      os << element("v", left_node, lane) + " " + op_csrc + " ";
+      os << element("v", right_node, lane) + ";\n";
    }
    //
    // compare_operator
@@ -87,9 +125,11 @@ namespace {
       std::ostream&  os           ,
       const char*    op_csrc      ,
       size_t         left_node    ,
-      size_t         right_node   )
-   {  os << "\tif( " + element("v", left_node) + " " + op_csrc + " ";
-      os << element("v", right_node) + " )\n";
+      size_t         right_node   ,
+      const std::string& lane     )
+   {  os << loop(lane, false);
+      os << "\tif( " + element("v", left_node, lane) + " " + op_csrc + " ";
+      os << element("v", right_node, lane) + " )\n";
       os << "\t\t++(*compare_change);\n";
    }
    //
@@ -98,18 +138,22 @@ namespace {
       std::ostream&  os           ,
       const char*    op_csrc      ,
       size_t         result_node  ,
-      size_t         arg_node     )
-   {  os << "\t" + element("v", result_node) + " = ";
+      size_t         arg_node     ,
+      const std::string& lane     )
+   {  os << loop(lane, true);
+      os << "\t" + element("v", result_node, lane) + " = ";
       os << op_csrc;
-      os << "( " + element("v", arg_node) + " );\n";
+      os << "( " + element("v", arg_node, lane) + " );\n";
    }
    //
    // sum_operator
    void sum_operator(
       std::ostream&                os                  ,
       size_t                       result_node         ,
-      const CppAD::vector<size_t>& arg_node            )
-   {  std::string rhs = "\t" + element("v", result_node) + " = ";
+      const CppAD::vector<size_t>& arg_node            ,
+      const std::string&           lane                )
+   {  os << loop(lane, true);
+      std::string rhs = "\t" + element("v", result_node, lane) + " = ";
       os << rhs;
       if( arg_node.size() == 1 )
       {  // can have subraction terms with no addition terms
@@ -124,7 +168,7 @@ namespace {
          }
          if( 0 < i )
             os << " + ";
-         os << element("v", arg_node[i]);
+         os << element("v", arg_node[i], lane);
       }
       os << ";\n";
    }
@@ -132,22 +176,23 @@ namespace {
    // atomic_function
    void atomic_function(
       std::ostream&                os                  ,
-      size_t                       result_node         ,
+      const CppAD::vector<size_t>& result_node         ,
       const std::string&           atomic_name         ,
       size_t                       call_id             ,
-      size_t                       n_result            ,
-      const CppAD::vector<size_t>& arg_node            )
+      const CppAD::vector<size_t>& arg_node            ,
+      const std::string&           lane                )
    {  using CppAD::to_string;
       std::string complete_name = "cppad_atomic_" + atomic_name;
       size_t nu = arg_node.size();
-      size_t nw = n_result;
+      size_t nw = result_node.size();
+      os << loop(lane, false);
       os << "\t{\t// call " + atomic_name + "\n";
       os << "\t\tint flag;\n";
       os << "\t\tfloat_point_t " + element("u", nu) + ";\n";
-      os << "\t\tfloat_point_t* w = v + " + to_string(result_node) + ";\n";
+      os << "\t\tfloat_point_t " + element("w", nw) + ";\n";
       for(size_t j = 0; j < nu; ++j)
       {  size_t i = arg_node[j];
-         os << "\t\t" + element("u",j) + " = " + element("v",i) + ";\n";
+         os << "\t\t" + element("u",j) + " = " + element("v",i,lane) + ";\n";
       }
       //
       os << "\t\tflag = " + complete_name + "(";
@@ -158,6 +203,12 @@ namespace {
       os << "\t\tif( flag == 1 || flag == 2 ) return 3;\n";
       os << "\t\tif( flag != 0 ) return flag;\n";
       //
+      // results
+      // (result nodes are not necessarily contiguous in v)
+      for(size_t i = 0; i < nw; ++i)
+      {  os << "\t\t" + element("v", result_node[i], lane);
+         os << " = " + element("w", i) + ";\n";
+      }
       os << "\t}\n";
    }
    //
@@ -166,431 +217,856 @@ namespace {
       std::ostream&                os                  ,
       size_t                       result_node         ,
       const std::string&           discrete_name       ,
-      size_t                       arg_node            )
+      size_t                       arg_node            ,
+      const std::string&           lane                )
    {  using CppAD::to_string;
       std::string complete_name = "cppad_discrete_" + discrete_name;
+      os << loop(lane, false);
       os << "\t{\t// call " + discrete_name + "\n";
-      os << "\t\t" + element("v", result_node) + " = ";
-      os << complete_name + "( " + element("v", arg_node) + " );\n";
+      os << "\t\t" + element("v", result_node, lane) + " = ";
+      os << complete_name + "( " + element("v", arg_node, lane) + " );\n";
       os << "\t}\n";
    }
 
+   //
+   // node2slot
+   // Sets slot[node] to the index in v used for each node and returns the
+   // number of elements in v. The independent and constant nodes have
+   // slot[node] = node. The slot for a result node is reused once the last
+   // operator that uses the node has been computed (liveness analysis).
+   size_t node2slot(
+      CppAD::vector<size_t>&       slot                ,
+      const CppAD::cpp_graph&      graph_obj           )
+   {  using CppAD::vector;
+      //
+      // n_usage, first_result_node
+      size_t n_usage           = graph_obj.operator_vec_size();
+      size_t first_result_node = 1
+         + graph_obj.n_dynamic_ind_get()
+         + graph_obj.n_variable_ind_get()
+         + graph_obj.constant_vec_size();
+      //
+      // not_used, freed
+      size_t not_used = n_usage + 1;
+      size_t freed    = n_usage + 2;
+      //
+      // graph_itr
+      // defined here because not using as loop index
+      CppAD::cpp_graph::const_iterator graph_itr;
+      //
+      // last_use
+      // last_use[node] is the index of the last operator that uses node.
+      // It is n_usage for dependent nodes and not_used if node is not used.
+      vector<size_t> last_use(first_result_node);
+      for(size_t node = 0; node < first_result_node; ++node)
+         last_use[node] = not_used;
+      for(size_t op_index = 0; op_index < n_usage; ++op_index)
+      {  if( op_index == 0 )
+            graph_itr = graph_obj.begin();
+         else
+            ++graph_itr;
+         CppAD::cpp_graph::const_iterator::value_type itr_value = *graph_itr;
+         const vector<size_t>& arg_node( *itr_value.arg_node_ptr );
+         for(size_t j = 0; j < arg_node.size(); ++j)
+            last_use[ arg_node[j] ] = op_index;
+         for(size_t i = 0; i < itr_value.n_result; ++i)
+            last_use.push_back(not_used);
+      }
+      for(size_t i = 0; i < graph_obj.dependent_vec_size(); ++i)
+         last_use[ graph_obj.dependent_vec_get(i) ] = n_usage;
+      //
+      // slot, n_slot
+      size_t n_node = last_use.size();
+      slot.resize(n_node);
+      for(size_t node = 0; node < first_result_node; ++node)
+         slot[node] = node;
+      size_t n_slot = first_result_node;
+      //
+      // free_slot
+      // stack of slots that are available for reuse
+      vector<size_t> free_slot;
+      //
+      // result_node
+      size_t result_node = first_result_node;
+      //
+      // op_index
+      for(size_t op_index = 0; op_index < n_usage; ++op_index)
+      {  if( op_index == 0 )
+            graph_itr = graph_obj.begin();
+         else
+            ++graph_itr;
+         CppAD::cpp_graph::const_iterator::value_type itr_value = *graph_itr;
+         const vector<size_t>& arg_node( *itr_value.arg_node_ptr );
+         size_t n_result = itr_value.n_result;
+         //
+         // free_slot
+         // arguments that are not used after this operator
+         // (the right hand side is evaluated before the assignment so a
+         // result can use the same slot as one of its arguments)
+         for(size_t j = 0; j < arg_node.size(); ++j)
+         {  size_t node = arg_node[j];
+            if( first_result_node <= node && last_use[node] == op_index )
+            {  free_slot.push_back( slot[node] );
+               last_use[node] = freed;
+            }
+         }
+         //
+         // slot
+         for(size_t i = 0; i < n_result; ++i)
+         {  size_t node = result_node + i;
+            if( free_slot.size() == 0 )
+               slot[node] = n_slot++;
+            else
+            {  slot[node] = free_slot[ free_slot.size() - 1 ];
+               free_slot.resize( free_slot.size() - 1 );
+            }
+         }
+         //
+         // free_slot
+         // results that are never used
+         for(size_t i = 0; i < n_result; ++i)
+         {  size_t node = result_node + i;
+            if( last_use[node] == not_used )
+               free_slot.push_back( slot[node] );
+         }
+         //
+         // result_node
+         result_node += n_result;
+      }
+      return n_slot;
+   }
+   //
+   // result_nodes
+   // Write the C source that computes the result nodes to part[0], part[1],
+   // ... . Each part contains at most max_statement operators
+   // (there is no limit when max_statement is zero).
+   void result_nodes(
+      CppAD::vector<std::string>&  part                ,
+      const CppAD::cpp_graph&      graph_obj           ,
+      const CppAD::vector<size_t>& slot                ,
+      size_t                       max_statement       ,
+      const std::string&           lane                )
+   {  using std::string;
+      using CppAD::vector;
+      using namespace CppAD::graph;
+      using CppAD::local::graph::op_enum2name;
+      //
+      // n_usage
+      size_t n_usage = graph_obj.operator_vec_size();
+      //
+      // graph_itr
+      // defined here because not using as loop index
+      CppAD::cpp_graph::const_iterator graph_itr;
+      //
+      // result_node
+      size_t result_node = 1
+         + graph_obj.n_dynamic_ind_get()
+         + graph_obj.n_variable_ind_get()
+         + graph_obj.constant_vec_size();
+      //
+      // os, n_statement
+      std::stringstream os;
+      size_t n_statement = 0;
+      part.resize(0);
+      //
+      // arg_slot, result_slot
+      vector<size_t> arg_slot, result_slot;
+      //
+      // op_index
+      for(size_t op_index = 0; op_index < n_usage; ++op_index)
+      {  //
+         // graph_itr
+         if( op_index == 0 )
+            graph_itr = graph_obj.begin();
+         else
+            ++graph_itr;
+         //
+         // str_index, op_enum, call_id, n_result, arg_node
+         CppAD::cpp_graph::const_iterator::value_type itr_value = *graph_itr;
+         const vector<size_t>& str_index( *itr_value.str_index_ptr );
+         const vector<size_t>& arg_node(  *itr_value.arg_node_ptr  );
+         graph_op_enum op_enum    = itr_value.op_enum;
+         size_t        call_id    = itr_value.call_id;
+         size_t        n_result   = itr_value.n_result;
+         CPPAD_ASSERT_UNKNOWN( arg_node.size() > 0 );
+         //
+         // arg_slot, result_slot
+         arg_slot.resize( arg_node.size() );
+         for(size_t j = 0; j < arg_node.size(); ++j)
+            arg_slot[j] = slot[ arg_node[j] ];
+         result_slot.resize(n_result);
+         for(size_t i = 0; i < n_result; ++i)
+            result_slot[i] = slot[ result_node + i ];
+         //
+         // op_csrc
+         const char* op_csrc = nullptr;
+         switch( op_enum )
+         {
+            // -------------------------------------------------------------
+            // binary functions
+            // -------------------------------------------------------------
+            case azmul_graph_op:
+            case pow_graph_op:
+            op_csrc = op_enum2name[op_enum];
+            break;
+            // -------------------------------------------------------------
+            // binary operators
+            // -------------------------------------------------------------
+            case add_graph_op:
+            op_csrc = "+";
+            break;
+            case div_graph_op:
+            op_csrc = "/";
+            break;
+            case mul_graph_op:
+            op_csrc = "*";
+            break;
+            case sub_graph_op:
+            op_csrc = "-";
+            break;
+            // -------------------------------------------------------------
+            // comparison operators
+            // -------------------------------------------------------------
+            case comp_eq_graph_op:
+            op_csrc = "!="; // not eq
+            break;
+            case comp_le_graph_op:
+            op_csrc = ">";  // not le
+            break;
+            case comp_lt_graph_op:
+            op_csrc = ">="; // not lt
+            break;
+            case comp_ne_graph_op:
+            op_csrc = "=="; // not ne
+            break;
+            // -------------------------------------------------------------
+            // unary functions
+            // -------------------------------------------------------------
+            case abs_graph_op:
+            op_csrc = "fabs";
+            break;
+            //
+            case neg_graph_op:
+            op_csrc = "-";
+            break;
+            //
+            case acos_graph_op:
+            case acosh_graph_op:
+            case asin_graph_op:
+            case asinh_graph_op:
+            case atan_graph_op:
+            case atanh_graph_op:
+            case cos_graph_op:
+            case cosh_graph_op:
+            case erf_graph_op:
+            case erfc_graph_op:
+            case exp_graph_op:
+            case expm1_graph_op:
+            case log1p_graph_op:
+            case log_graph_op:
+            case sign_graph_op:
+            case sin_graph_op:
+            case sinh_graph_op:
+            case sqrt_graph_op:
+            case tan_graph_op:
+            case tanh_graph_op:
+            op_csrc = op_enum2name[op_enum];
+            break;
+
+            // ---------------------------------------------------------------
+            // operators that do not use op_csrc
+            // ---------------------------------------------------------------
+            case atom4_graph_op:
+            case discrete_graph_op:
+            case sum_graph_op:
+            op_csrc = "";
+            break;
+
+            default:
+            {  string msg = op_enum2name[op_enum];
+               msg = "f.to_csrc: The " + msg + " is not yet implemented.";
+               CPPAD_ASSERT_KNOWN(false, msg.c_str() );
+            }
+            break;
+         }
+         //
+         // csrc
+         switch( op_enum )
+         {  //
+            // binary functions
+            case azmul_graph_op:
+            case pow_graph_op:
+            CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
+            CPPAD_ASSERT_UNKNOWN( n_result == 1 );
+            binary_function(
+               os, op_csrc, result_slot[0], arg_slot[0], arg_slot[1], lane
+            );
+            break;
+            //
+            // binary operators
+            case add_graph_op:
+            case div_graph_op:
+            case mul_graph_op:
+            case sub_graph_op:
+            CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
+            CPPAD_ASSERT_UNKNOWN( n_result == 1 );
+            binary_operator(
+               os, op_csrc, result_slot[0], arg_slot[0], arg_slot[1], lane
+            );
+            break;
+            //
+            // comparison operators
+            case comp_eq_graph_op:
+            case comp_le_graph_op:
+            case comp_lt_graph_op:
+            case comp_ne_graph_op:
+            CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
+            CPPAD_ASSERT_UNKNOWN( n_result == 0 );
+            compare_operator(
+               os, op_csrc, arg_slot[0], arg_slot[1], lane
+            );
+            break;
+            //
+            // unary functions
+            case abs_graph_op:
+            case acos_graph_op:
+            case acosh_graph_op:
+            case asin_graph_op:
+            case asinh_graph_op:
+            case atan_graph_op:
+            case atanh_graph_op:
+            case cos_graph_op:
+            case cosh_graph_op:
+            case erf_graph_op:
+            case erfc_graph_op:
+            case exp_graph_op:
+            case expm1_graph_op:
+            case log1p_graph_op:
+            case log_graph_op:
+            case neg_graph_op:
+            case sign_graph_op:
+            case sin_graph_op:
+            case sinh_graph_op:
+            case sqrt_graph_op:
+            case tan_graph_op:
+            case tanh_graph_op:
+            CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
+            CPPAD_ASSERT_UNKNOWN( n_result == 1 );
+            unary_function(
+               os, op_csrc, result_slot[0], arg_slot[0], lane
+            );
+            break;
+            //
+            // atom4
+            case atom4_graph_op:
+            {  size_t index       = str_index[0];
+               string atomic_name = graph_obj.atomic_name_vec_get(index);
+               atomic_function(os,
+                  result_slot, atomic_name, call_id, arg_slot, lane
+               );
+            }
+            break;
+            //
+            // discrete
+            case discrete_graph_op:
+            CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
+            CPPAD_ASSERT_UNKNOWN( n_result == 1 );
+            {  size_t index         = str_index[0];
+               string discrete_name = graph_obj.discrete_name_vec_get(index);
+               discrete_function(os,
+                  result_slot[0], discrete_name, arg_slot[0], lane
+               );
+            }
+            break;
+            //
+            // sum
+            case sum_graph_op:
+            CPPAD_ASSERT_UNKNOWN( n_result == 1 );
+            sum_operator(os, result_slot[0], arg_slot, lane);
+            break;
+            //
+            // default
+            default:
+            CPPAD_ASSERT_UNKNOWN(false);
+            break;
+         }
+         //
+         // result_node
+         result_node += n_result;
+         //
+         // part
+         ++n_statement;
+         if( n_statement == max_statement )
+         {  part.push_back( os.str() );
+            os.str("");
+            n_statement = 0;
+         }
+      }
+      if( n_statement > 0 || part.size() == 0 )
+         part.push_back( os.str() );
+   }
+   //
+   // jit_function
+   // write the C source for the scalar (batch_size == 0) or
+   // batch (batch_size > 0) JIT function.
+   // If max_statement is non-zero, the result nodes are computed by
+   // part functions that each contain at most max_statement operators.
+   // The parts are distributed in order between os and the other
+   // translation units; i.e., other[0], other[1], ... .
+   void jit_function(
+      std::ostream&                os                  ,
+      CppAD::vector<std::string>&  other               ,
+      const CppAD::cpp_graph&      graph_obj           ,
+      size_t                       batch_size          ,
+      size_t                       max_statement       )
+   {  using std::string;
+      using CppAD::to_string;
+      //
+      // batch, lane, block
+      bool   batch = batch_size > 0;
+      string lane  = "";
+      string block = "";
+      if( batch )
+      {  lane  = "[k]";
+         block = "[" + to_string(batch_size) + "]";
+      }
+      //
+      // prefix
+      string prefix = "cppad_jit_";
+      if( batch )
+         prefix = "cppad_jit_batch_";
+      // --------------------------------------------------------------------
+      string function_name  = graph_obj.function_name_get();
+      size_t n_dynamic_ind  = graph_obj.n_dynamic_ind_get();
+      size_t n_variable_ind = graph_obj.n_variable_ind_get();
+      size_t n_constant     = graph_obj.constant_vec_size();
+      size_t n_dependent    = graph_obj.dependent_vec_size();
+      // --------------------------------------------------------------------
+      //
+      // slot, n_slot
+      CppAD::vector<size_t> slot;
+      size_t n_slot = node2slot(slot, graph_obj);
+      //
+      // part
+      CppAD::vector<string> part;
+      result_nodes(part, graph_obj, slot, max_statement, lane);
+      size_t n_part = part.size();
+      //
+      // n_unit
+      size_t n_unit = 1 + other.size();
+      //
+      // parts of this JIT function
+      // (not used when there is only one part)
+      for(size_t i_part = 0; n_part > 1 && i_part < n_part; ++i_part)
+      {  //
+         // i_unit
+         // translation unit that this part is written to
+         size_t i_unit = (i_part * n_unit) / n_part;
+         //
+         // signature
+         string signature =
+            "int " + prefix + function_name + "_part_" + to_string(i_part) +
+            "(\n"
+         ;
+         if( batch )
+         {  signature +=
+               "\tfloat_point_t        v[]" + block + "   ,\n"
+               "\tsize_t               nb              ,\n"
+            ;
+         }
+         else
+            signature += "\tfloat_point_t*       v               ,\n";
+         signature += "\tsize_t*              compare_change  )";
+         //
+         // csrc
+         string csrc = "// part " + to_string(i_part) + " of this JIT ";
+         if( batch )
+            csrc += "batch ";
+         csrc += "function\n";
+         if( i_unit == 0 )
+            csrc += "static ";
+         csrc += "CPPAD_NOINLINE " + signature + "\n{\n";
+         if( batch )
+            csrc += "\tsize_t k;\n";
+         csrc += part[i_part];
+         csrc +=
+            "\treturn 0;\n"
+            "}\n"
+         ;
+         //
+         // os, other
+         // a part in another translation unit is declared in os
+         if( i_unit == 0 )
+            os << csrc;
+         else
+         {  os << "extern " + signature + ";\n";
+            other[i_unit - 1] += csrc;
+         }
+      }
+      //
+      // This JIT function
+      if( batch )
+         os << "// This JIT batch function\n";
+      else
+         os << "// This JIT function\n";
+      os <<
+# ifdef _MSC_VER
+         "__declspec(dllexport) int __cdecl "
+# else
+         "int "
+# endif
+      ;
+      os << prefix + function_name + "(\n";
+      if( batch )
+         os << "\tsize_t               n_point         ,\n";
+      os <<
+         "\tsize_t               nu              ,\n"
+         "\tconst float_point_t* u               ,\n"
+         "\tsize_t               ny              ,\n"
+         "\tfloat_point_t*       y               ,\n"
+         "\tsize_t*              compare_change  )\n"
+      ;
+      //
+      // begin function body
+      os <<
+         "{\t// begin function body \n"
+         "\n"
+      ;
+      //
+      // declare variables
+      // v, i, nan
+      os <<
+         "\t// declare variables\n"
+         "\tfloat_point_t v[" + to_string(n_slot) + "]" + block + ";\n"
+         "\tsize_t i;\n"
+      ;
+      if( n_part > 1 )
+         os << "\tint flag;\n";
+      if( batch )
+         os << "\tsize_t k, nb, p0;\n";
+      os <<
+         "\n"
+         "\t// check nu, ny\n"
+      ;
+      //
+      // nx
+      size_t nu = n_dynamic_ind + n_variable_ind;
+      os << "\tif( nu != " + to_string(nu) + ") return 1;\n";
+      //
+      // ny
+      size_t ny = n_dependent;
+      os << "\tif( ny != " + to_string(ny) + ") return 2;\n";
+      //
+      // k_loop
+      // loop over all the points in a block
+      string k_loop = "";
+      if( batch )
+         k_loop = "\tfor(k = 0; k < " + to_string(batch_size) + "; ++k)\n\t";
+      //
+      // initialize
+      // compare_change, v[0]
+      os <<
+         "\n"
+         "\t// initialize\n"
+         + k_loop +
+         "\t" + element("v", 0, lane) + "            = NAN; // const \n"
+      ;
+      //
+      // cosntants
+      // set v[1+nu+i] for i = 0, ..., nc-1
+      size_t nc = n_constant;
+      os <<
+         "\n"
+         "\t// constants\n"
+         "\t// set v[1+nu+i] for i = 0, ..., nc-1\n"
+         "\t// nc = " + to_string(nc) + "\n"
+      ;
+      for(size_t i = 0; i < nc; ++i)
+      {  double c_i = graph_obj.constant_vec_get(i);
+         os << k_loop <<
+            "\tv[1+nu+" + to_string(i) + "]" + lane +
+            " = " + to_string(c_i) + ";\n"
+         ;
+      }
+      //
+      // ops
+      // In the batch case, ops is written to os with an extra indentation
+      // because it is inside the loop over blocks of points.
+      std::stringstream ops;
+      //
+      // independent variables
+      // set v[1+i] for i = 0, ..., nx-1"
+      ops <<
+         "\n"
+         "\t// independent variables\n"
+         "\t// set v[1+i] for i = 0, ..., nu-1\n"
+         "\tfor(i = 0; i < nu; ++i)\n"
+      ;
+      if( batch )
+      {  ops <<
+            "\t\tfor(k = 0; k < nb; ++k)\n"
+            "\t\t\tv[1+i][k] = u[i * n_point + p0 + k];\n"
+         ;
+      }
+      else
+         ops << "\t\tv[1+i] = u[i];\n";
+      //
+      // result nodes
+      // set v[1+nu+nc+i] for i = 0, ..., n_slot-nu-nc-2
+      // (a slot is reused when the previous result in it is no longer needed)
+      ops <<
+         "\n"
+         "\t// result nodes\n"
+         "\t// set v[1+nu+nc+i] for i = 0, ..., n_slot-nu-nc-2\n"
+         "\t// n_slot = " + to_string(n_slot) + "\n"
+      ;
+      if( n_part == 1 )
+         ops << part[0];
+      else
+      {  string nb = "";
+         if( batch )
+            nb = "nb, ";
+         for(size_t i_part = 0; i_part < n_part; ++i_part)
+         {  ops <<
+               "\tflag = " + prefix + function_name +
+               "_part_" + to_string(i_part) + "(v, " + nb + "compare_change);\n"
+               "\tif( flag != 0 ) return flag;\n"
+            ;
+         }
+      }
+      // -------------------------------------------------------------------
+      // dependent
+      ops <<
+         "\n"
+         "\t// dependent variables\n"
+         "\t// set y[i] for i = 0, ny-1\n"
+      ;
+      for(size_t i = 0; i < ny; ++i)
+      {  size_t node = slot[ graph_obj.dependent_vec_get(i) ];
+         if( batch )
+         {  ops << loop(lane, true);
+            ops << "\ty[" + to_string(i) + " * n_point + p0 + k] = ";
+         }
+         else
+            ops << "\t" + element("y", i) + " = ";
+         ops << element("v", node, lane) + ";\n";
+      }
+      // -------------------------------------------------------------------
+      if( ! batch )
+         os << ops.str();
+      else
+      {  os <<
+            "\n"
+            "\t// loop over blocks of points\n"
+            "\tfor(p0 = 0; p0 < n_point; p0 += " + to_string(batch_size) + ")\n"
+            "\t{\t// nb = number of points in this block\n"
+            "\t\tnb = n_point - p0;\n"
+            "\t\tif( nb > " + to_string(batch_size) + " )\n"
+            "\t\t\tnb = " + to_string(batch_size) + ";\n"
+         ;
+         std::string line;
+         while( std::getline(ops, line) )
+         {  if( line == "" )
+               os << "\n";
+            else if( line[0] == '#' )
+               os << line << "\n";
+            else
+               os << "\t" << line << "\n";
+         }
+         os << "\t}\n";
+      }
+      // -------------------------------------------------------------------
+      // end function body
+      os << "\n";
+      os << "\treturn 0;\n";
+      os << "}\n";
+      //
+      return;
+   }
+   //
+   // prelude
+   // write the includes, typedefs, externals, and static functions
+   // that are needed by each translation unit
+   void prelude(
+      std::ostream&                os                  ,
+      const CppAD::cpp_graph&      graph_obj           ,
+      const std::string&           c_type              ,
+      bool                         noinline            )
+   {  using std::string;
+      //
+      // includes
+      os <<
+         "// includes\n"
+         "# include <stddef.h>\n"
+         "# include <math.h>\n"
+         "\n"
+      ;
+      //
+      // typedefs
+      string tmp_type = c_type;
+      if( c_type == "long_double" )
+         tmp_type = "long double";
+      os <<
+         "// typedefs\n"
+         "typedef " + tmp_type + " float_point_t;\n"
+         "\n"
+      ;
+      //
+      // CPPAD_NOINLINE
+      // used to keep the C compiler from combining the parts of a function
+      if( noinline )
+      {  os <<
+            "// CPPAD_NOINLINE\n"
+            "# if defined(__GNUC__)\n"
+            "# define CPPAD_NOINLINE __attribute__((noinline))\n"
+            "# elif defined(_MSC_VER)\n"
+            "# define CPPAD_NOINLINE __declspec(noinline)\n"
+            "# else\n"
+            "# define CPPAD_NOINLINE\n"
+            "# endif\n"
+            "\n"
+         ;
+      }
+      //
+      // externals
+      os << "// externals\n";
+      size_t n_atomic = graph_obj.atomic_name_vec_size();
+      for(size_t i_atomic = 0; i_atomic < n_atomic; ++i_atomic)
+      {  string atomic_name = graph_obj.atomic_name_vec_get(i_atomic);
+         os << "extern int cppad_atomic_" + atomic_name + "(\n";
+         os <<
+            "\tsize_t               call_id           ,\n"
+            "\tsize_t               nu                ,\n"
+            "\tconst float_point_t* u                 ,\n"
+            "\tsize_t               ny                ,\n"
+            "\tfloat_point_t*       y                 ,\n"
+            "\tsize_t*              compare_change\n"
+            ");\n"
+         ;
+      }
+      size_t n_discrete = graph_obj.discrete_name_vec_size();
+      for(size_t i_discrete = 0; i_discrete < n_discrete; ++i_discrete)
+      {  string discrete_name = graph_obj.discrete_name_vec_get(i_discrete);
+         os << "extern float_point_t cppad_discrete_" + discrete_name;
+         os << "( float_point_t x );\n";
+      }
+      //
+      // azmul
+      os <<
+         "// azmul\n"
+         "static float_point_t azmul(float_point_t x, float_point_t y)\n"
+         "{\tif( x == 0.0 ) return 0.0;\n"
+         "\treturn x * y;\n"
+         "}\n\n"
+      ;
+      //
+      // sign
+      os <<
+         "// sign\n"
+         "static float_point_t sign(float_point_t x)\n"
+         "{\tif( x > 0.0 ) return 1.0;\n"
+         "\tif( x == 0.0 ) return 0.0;\n"
+         "\treturn -1.0;\n"
+         "}\n\n"
+      ;
+   }
 }
 
 // BEGIN_PROTOTYPE
 void CppAD::local::graph::csrc_writer(
-   std::ostream&                             os                     ,
+   CppAD::vector<std::string>&               csrc_vec               ,
    const cpp_graph&                          graph_obj              ,
-   const std::string&                        c_type                 )
+   const std::string&                        c_type                 ,
+   const std::map<std::string, std::string>& options                )
 // END_PROTOTYPE
 {  using std::string;
    using CppAD::to_string;
    //
-   // --------------------------------------------------------------------
+   // function_name
    string function_name  = graph_obj.function_name_get();
-   size_t n_dynamic_ind  = graph_obj.n_dynamic_ind_get();
-   size_t n_variable_ind = graph_obj.n_variable_ind_get();
-   size_t n_constant     = graph_obj.constant_vec_size();
-   size_t n_dependent    = graph_obj.dependent_vec_size();
-   size_t n_usage        = graph_obj.operator_vec_size();
-   // --------------------------------------------------------------------
    CPPAD_ASSERT_KNOWN( function_name != "" ,
       "to_csrc: Cannot convert a function with no name"
    );
    //
-   // graph_itr
-   // defined here because not using as loop index
-   cpp_graph::const_iterator graph_itr;
-   //
-   // first_result_node
-   size_t first_result_node = 1 + n_dynamic_ind + n_variable_ind + n_constant;
+   // n_unit
+   size_t n_unit = csrc_vec.size();
+   CPPAD_ASSERT_KNOWN( n_unit > 0,
+      "to_csrc: the size of csrc_vec is zero"
+   );
    //
-   // n_node
-   size_t n_node = first_result_node;
-   for(size_t op_index = 0; op_index < n_usage; ++op_index)
-   {  // graph_itr
-      if( op_index == 0 )
-         graph_itr = graph_obj.begin();
-      else
-         ++graph_itr;
-      //
-      // nv
-      cpp_graph::const_iterator::value_type itr_value = *graph_itr;
-      n_node += itr_value.n_result;
+   // check options
+   std::map<string, string>::const_iterator itr;
+   for(itr = options.begin(); itr != options.end(); ++itr)
+   {  CPPAD_ASSERT_KNOWN(
+         itr->first == "batch_size" || itr->first == "max_statement",
+         "to_csrc: options has a key that is not batch_size or max_statement"
+      );
    }
    //
-   // includes
-   os <<
-      "// includes\n"
-      "# include <stddef.h>\n"
-      "# include <math.h>\n"
-      "\n"
-   ;
-   //
-   // typedefs
-   string tmp_type = c_type;
-   if( c_type == "long_double" )
-      tmp_type = "long double";
-   os <<
-      "// typedefs\n"
-      "typedef " + tmp_type + " float_point_t;\n"
-      "\n"
-   ;
-   //
-   // externals
-   os << "// externals\n";
-   size_t n_atomic = graph_obj.atomic_name_vec_size();
-   for(size_t i_atomic = 0; i_atomic < n_atomic; ++i_atomic)
-   {  string atomic_name = graph_obj.atomic_name_vec_get(i_atomic);
-      os << "extern int cppad_atomic_" + atomic_name + "(\n";
-      os <<
-         "\tsize_t               call_id           ,\n"
-         "\tsize_t               nu                ,\n"
-         "\tconst float_point_t* u                 ,\n"
-         "\tsize_t               ny                ,\n"
-         "\tfloat_point_t*       y                 ,\n"
-         "\tsize_t*              compare_change\n"
-         ");\n"
-      ;
+   // max_statement
+   size_t max_statement = 0;
+   if( options.find("max_statement") != options.end() )
+   {  max_statement =
+         size_t( std::atoi( options.at("max_statement").c_str() ) );
+      CPPAD_ASSERT_KNOWN( max_statement > 0,
+         "to_csrc: options[max_statement] is not a positive integer"
+      );
    }
-   size_t n_discrete = graph_obj.discrete_name_vec_size();
-   for(size_t i_discrete = 0; i_discrete < n_discrete; ++i_discrete)
-   {  string discrete_name = graph_obj.discrete_name_vec_get(i_discrete);
-      os << "extern float_point_t cppad_discrete_" + discrete_name;
-      os << "( float_point_t x );\n";
+   else if( n_unit > 1 )
+   {  // one part per translation unit
+      size_t n_usage = graph_obj.operator_vec_size();
+      max_statement  = (n_usage + n_unit - 1) / n_unit;
+      if( max_statement == 0 )
+         max_statement = 1;
    }
    //
-   // azmul
-   os <<
-      "// azmul\n"
-      "static float_point_t azmul(float_point_t x, float_point_t y)\n"
-      "{\tif( x == 0.0 ) return 0.0;\n"
-      "\treturn x * y;\n"
-      "}\n\n"
-   ;
+   // os, other
+   // os is the first translation unit, other is the rest
+   std::stringstream os;
+   CppAD::vector<string> other(n_unit - 1);
    //
-   // sign
-   os <<
-      "// sign\n"
-      "static float_point_t sign(float_point_t x)\n"
-      "{\tif( x > 0.0 ) return 1.0;\n"
-      "\tif( x == 0.0 ) return 0.0;\n"
-      "\treturn -1.0;\n"
-      "}\n\n"
-   ;
+   // prelude
+   bool noinline = max_statement > 0;
+   prelude(os, graph_obj, c_type, noinline);
    //
    // This JIT function
-   os <<
-      "// This JIT function\n"
-# ifdef _MSC_VER
-      "__declspec(dllexport) int __cdecl "
-# else
-      "int "
-# endif
-      "cppad_jit_" + function_name + "(\n"
-      "\tsize_t               nu              ,\n"
-      "\tconst float_point_t* u               ,\n"
-      "\tsize_t               ny              ,\n"
-      "\tfloat_point_t*       y               ,\n"
-      "\tsize_t*              compare_change  )\n"
-   ;
-   //
-   // begin function body
-   os <<
-      "{\t// begin function body \n"
-      "\n"
-   ;
+   size_t batch_size = 0;
+   jit_function(os, other, graph_obj, batch_size, max_statement);
    //
-   // declare variables
-   // v, i, nan
-   os <<
-      "\t// declare variables\n"
-      "\tfloat_point_t v[" + to_string(n_node) + "];\n"
-      "\tsize_t i;\n"
-      "\n"
-      "\t// check nu, ny\n"
-   ;
-   //
-   // nx
-   size_t nu = n_dynamic_ind + n_variable_ind;
-   os << "\tif( nu != " + to_string(nu) + ") return 1;\n";
-   //
-   // ny
-   size_t ny = n_dependent;
-   os << "\tif( ny != " + to_string(ny) + ") return 2;\n";
-   //
-   // initialize
-   // compare_change, v[0]
-   os <<
-      "\n"
-      "\t// initialize\n"
-      "\tv[0]            = NAN; // const \n"
-   ;
-   //
-   // independent variables
-   // set v[1+i] for i = 0, ..., nx-1"
-   os <<
-      "\n"
-      "\t// independent variables\n"
-      "\t// set v[1+i] for i = 0, ..., nu-1\n"
-      "\tfor(i = 0; i < nu; ++i)\n"
-      "\t\tv[1+i] = u[i];\n"
-   ;
-   //
-   // cosntants
-   // set v[1+nu+i] for i = 0, ..., nc-1
-   size_t nc = n_constant;
-   os <<
-      "\n"
-      "\t// constants\n"
-      "\t// set v[1+nu+i] for i = 0, ..., nc-1\n"
-      "\t// nc = " + to_string(nc) + "\n"
-   ;
-   for(size_t i = 0; i < nc; ++i)
-   {  double c_i = graph_obj.constant_vec_get(i);
-      os <<
-         "\tv[1+nu+" + to_string(i) + "] = " + to_string(c_i) + ";\n"
-      ;
+   // This JIT batch function
+   if( options.find("batch_size") != options.end() )
+   {  batch_size = size_t( std::atoi( options.at("batch_size").c_str() ) );
+      CPPAD_ASSERT_KNOWN( batch_size > 0,
+         "to_csrc: options[batch_size] is not a positive integer"
+      );
+      os << "\n";
+      jit_function(os, other, graph_obj, batch_size, max_statement);
    }
    //
-   // result nodes
-   // set v[1+nu+nc+i] for i = 0, ..., n_result_node-1
-   size_t n_result_node = n_node - first_result_node;
-   os <<
-      "\n"
-      "\t// result nodes\n"
-      "\t// set v[1+nu+nc+i] for i = 0, ..., n_result_node-1\n"
-      "\t// n_result_node = " + to_string(n_result_node) + "\n"
-   ;
-   //
-   // result_node
-   size_t result_node = first_result_node;
-   //
-   // op_index
-   for(size_t op_index = 0; op_index < n_usage; ++op_index)
-   {  //
-      // graph_itr
-      if( op_index == 0 )
-         graph_itr = graph_obj.begin();
-      else
-         ++graph_itr;
-      //
-      // str_index, op_enum, call_id, n_result, arg_node
-      cpp_graph::const_iterator::value_type itr_value = *graph_itr;
-      const vector<size_t>& str_index( *itr_value.str_index_ptr );
-      const vector<size_t>& arg_node(  *itr_value.arg_node_ptr  );
-      graph_op_enum op_enum    = itr_value.op_enum;
-      size_t        call_id    = itr_value.call_id;
-      size_t        n_result   = itr_value.n_result;
-      CPPAD_ASSERT_UNKNOWN( arg_node.size() > 0 );
-      //
-      // op_csrc
-      const char* op_csrc = nullptr;
-      switch( op_enum )
-      {
-         // -------------------------------------------------------------
-         // binary functions
-         // -------------------------------------------------------------
-         case azmul_graph_op:
-         case pow_graph_op:
-         op_csrc = op_enum2name[op_enum];
-         break;
-         // -------------------------------------------------------------
-         // binary operators
-         // -------------------------------------------------------------
-         case add_graph_op:
-         op_csrc = "+";
-         break;
-         case div_graph_op:
-         op_csrc = "/";
-         break;
-         case mul_graph_op:
-         op_csrc = "*";
-         break;
-         case sub_graph_op:
-         op_csrc = "-";
-         break;
-         // -------------------------------------------------------------
-         // comparison operators
-         // -------------------------------------------------------------
-         case comp_eq_graph_op:
-         op_csrc = "!="; // not eq
-         break;
-         case comp_le_graph_op:
-         op_csrc = ">";  // not le
-         break;
-         case comp_lt_graph_op:
-         op_csrc = ">="; // not lt
-         break;
-         case comp_ne_graph_op:
-         op_csrc = "=="; // not ne
-         break;
-         // -------------------------------------------------------------
-         // unary functions
-         // -------------------------------------------------------------
-         case abs_graph_op:
-         op_csrc = "fabs";
-         break;
-         //
-         case acos_graph_op:
-         case acosh_graph_op:
-         case asin_graph_op:
-         case asinh_graph_op:
-         case atan_graph_op:
-         case atanh_graph_op:
-         case cos_graph_op:
-         case cosh_graph_op:
-         case erf_graph_op:
-         case erfc_graph_op:
-         case exp_graph_op:
-         case expm1_graph_op:
-         case log1p_graph_op:
-         case log_graph_op:
-         case sign_graph_op:
-         case sin_graph_op:
-         case sinh_graph_op:
-         case sqrt_graph_op:
-         case tan_graph_op:
-         case tanh_graph_op:
-         op_csrc = op_enum2name[op_enum];
-         break;
-
-         // ---------------------------------------------------------------
-         // operators that do not use op_csrc
-         // ---------------------------------------------------------------
-         case atom4_graph_op:
-         case discrete_graph_op:
-         case sum_graph_op:
-         op_csrc = "";
-         break;
-
-         default:
-         {  string msg = op_enum2name[op_enum];
-            msg = "f.to_csrc: The " + msg + " is not yet implemented.";
-            CPPAD_ASSERT_KNOWN(false, msg.c_str() );
-         }
-         break;
-      }
-      //
-      // csrc
-      switch( op_enum )
-      {  //
-         // binary functions
-         case azmul_graph_op:
-         case pow_graph_op:
-         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
-         CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         binary_function(
-            os, op_csrc, result_node, arg_node[0], arg_node[1]
-         );
-         break;
-         //
-         // binary operators
-         case add_graph_op:
-         case div_graph_op:
-         case mul_graph_op:
-         case sub_graph_op:
-         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
-         CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         binary_operator(
-            os, op_csrc, result_node, arg_node[0], arg_node[1]
-         );
-         break;
-         //
-         // comparison operators
-         case comp_eq_graph_op:
-         case comp_le_graph_op:
-         case comp_lt_graph_op:
-         case comp_ne_graph_op:
-         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 2 );
-         CPPAD_ASSERT_UNKNOWN( n_result == 0 );
-         compare_operator(
-            os, op_csrc, arg_node[0], arg_node[1])
-         ;
-         break;
-         //
-         // unary functions
-         case abs_graph_op:
-         case acos_graph_op:
-         case acosh_graph_op:
-         case asin_graph_op:
-         case asinh_graph_op:
-         case atan_graph_op:
-         case atanh_graph_op:
-         case cos_graph_op:
-         case cosh_graph_op:
-         case erf_graph_op:
-         case erfc_graph_op:
-         case exp_graph_op:
-         case expm1_graph_op:
-         case log1p_graph_op:
-         case log_graph_op:
-         case sign_graph_op:
-         case sin_graph_op:
-         case sinh_graph_op:
-         case sqrt_graph_op:
-         case tan_graph_op:
-         case tanh_graph_op:
-         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
-         CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         unary_function(
-            os, op_csrc, result_node, arg_node[0]
-         );
-         break;
-         //
-         // atom4
-         case atom4_graph_op:
-         {  size_t index       = str_index[0];
-            string atomic_name = graph_obj.atomic_name_vec_get(index);
-            atomic_function(os,
-               result_node, atomic_name, call_id, n_result, arg_node
-            );
-         }
-         break;
-         //
-         // discrete
-         case discrete_graph_op:
-         CPPAD_ASSERT_UNKNOWN( arg_node.size() == 1 );
-         CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         {  size_t index         = str_index[0];
-            string discrete_name = graph_obj.discrete_name_vec_get(index);
-            discrete_function(os,
-               result_node, discrete_name, arg_node[0]
-            );
-         }
-         break;
-         //
-         // sum
-         case sum_graph_op:
-         CPPAD_ASSERT_UNKNOWN( n_result == 1 );
-         sum_operator(os, result_node, arg_node);
-         break;
-         //
-         // default
-         default:
-         CPPAD_ASSERT_UNKNOWN(false);
-         break;
-      }
-      //
-      // result_node
-      result_node += n_result;
-   }
-   // ----------------------------------------------------------------------
-   // dependent
-   os <<
-      "\n"
-      "\t// dependent variables\n"
-      "\t// set y[i] for i = 0, ny-1\n"
-   ;
-   for(size_t i = 0; i < ny; ++i)
-   {  size_t node = graph_obj.dependent_vec_get(i);
-      os << "\t" + element("y", i) + " = " + element("v", node) + ";\n";
+   // csrc_vec
+   csrc_vec[0] = os.str();
+   for(size_t i_unit = 1; i_unit < n_unit; ++i_unit)
+   {  std::stringstream unit;
+      prelude(unit, graph_obj, c_type, noinline);
+      unit << other[i_unit - 1];
+      csrc_vec[i_unit] = unit.str();
    }
-   // ----------------------------------------------------------------------
-   // end function body
-   os << "\n";
-   os << "\treturn 0;\n";
-   os << "}\n";
    //
    return;
 }
+void CppAD::local::graph::csrc_writer(
+   std::ostream&                             os                     ,
+   const cpp_graph&                          graph_obj              ,
+   const std::string&                        c_type                 ,
+   const std::map<std::string, std::string>& options                )
+{  CppAD::vector<std::string> csrc_vec(1);
+   csrc_writer(csrc_vec, graph_obj, c_type, options);
+   os << csrc_vec[0];
+}
+void CppAD::local::graph::csrc_writer(
+   std::ostream&                             os                     ,
+   const cpp_graph&                          graph_obj              ,
+   const std::string&                        c_type                 )
+{  std::map<std::string, std::string> options;
+   csrc_writer(os, graph_obj, c_type, options);
+}
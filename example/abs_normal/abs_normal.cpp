@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin abs_normal.cpp}
@@ -49,6 +49,7 @@ extern bool min_nso_linear(void);
 extern bool min_nso_quad(void);
 extern bool qp_box(void);
 extern bool qp_interior(void);
+extern bool qp_interior_sparse(void);
 extern bool simplex_method(void);
 
 // main program that runs all the tests
@@ -69,6 +70,7 @@ int main(void)
    Run( min_nso_quad,         "min_nso_quad"      );
    Run( qp_box,              "qp_box"             );
    Run( qp_interior,         "qp_interior"        );
+   Run( qp_interior_sparse,  "qp_interior_sparse" );
    Run( simplex_method,      "simplex_method"     );
 
    // check for memory leak
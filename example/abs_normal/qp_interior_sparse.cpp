@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin qp_interior_sparse.cpp}
+{xrst_spell
+   rl
+}
+
+abs_normal qp_interior_sparse: Example and Test
+###############################################
+
+Problem
+*******
+Given :math:`t \in \B{R}^N` ,
+our original problem is the piecewise linear problem
+
+.. math::
+
+   \R{minimize} \;
+   \sum_{i=0}^{N-1} | x_i - t_i | +
+   \sum_{i=0}^{N-2} | x_{i+1} - x_i |
+   \; \R{w.r.t} \; x \in \B{R}^N
+
+We reformulate this as the following problem
+
+.. math::
+
+   \begin{array}{rl}
+   \R{minimize} & \sum_{i=0}^{N-1} v_i + u_i
+   \; \R{w.r.t} \; (x, v, u) \in \B{R}^{3 N}
+   \\
+   \R{subject \; to}
+   & x_i - t_i \leq v_i \; \R{and} \; t_i - x_i \leq v_i
+   \; \R{for} \; i = 0 , \ldots , N-1
+   \\
+   & x_{i+1} - x_i \leq u_i \; \R{and} \; x_i - x_{i+1} \leq u_i
+   \; \R{for} \; i = 0 , \ldots , N-2
+   \\
+   & 0 \leq u_{N-1}
+   \end{array}
+
+The variables are ordered
+:math:`( x_0 , v_0 , u_0 , x_1 , v_1 , u_1 , \ldots )`
+so that the matrix :math:`G + C^T D(y/s) C` is banded; see
+:ref:`qp_interior_sparse@Sparse Factorization` .
+This problem is in the form expected by :ref:`qp_interior_sparse-name`
+and the solution is compared with the solution from
+:ref:`qp_interior-name` .
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end qp_interior_sparse.cpp}
+*/
+// BEGIN C++
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rcv.hpp>
+# include <cppad/utility/near_equal.hpp>
+# include "qp_interior.hpp"
+# include "qp_interior_sparse.hpp"
+
+bool qp_interior_sparse(void)
+{  bool ok = true;
+   typedef CppAD::vector<double> d_vector;
+   typedef CppAD::vector<size_t> s_vector;
+   typedef CppAD::sparse_rc<s_vector>           sparsity;
+   typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+   //
+   // t
+   size_t N = 10;
+   d_vector t(N);
+   for(size_t i = 0; i < N; ++i)
+      t[i] = double( (i * 7) % 5 );
+   //
+   // number of variables and constraints
+   size_t n = 3 * N;
+   size_t m = 4 * N - 1;
+   //
+   // C, c
+   size_t nnz = 4 * N + 6 * (N - 1) + 1;
+   sparsity C_pattern(m, n, nnz);
+   d_vector C_val(nnz), c(m);
+   size_t k = 0, r = 0;
+   for(size_t i = 0; i < N; ++i)
+   {  size_t x_i = 3 * i, v_i = 3 * i + 1, u_i = 3 * i + 2;
+      // x_i - v_i - t_i <= 0
+      C_pattern.set(k, r, x_i); C_val[k++] =  1.0;
+      C_pattern.set(k, r, v_i); C_val[k++] = -1.0;
+      c[r++] = - t[i];
+      // - x_i - v_i + t_i <= 0
+      C_pattern.set(k, r, x_i); C_val[k++] = -1.0;
+      C_pattern.set(k, r, v_i); C_val[k++] = -1.0;
+      c[r++] = t[i];
+      if( i + 1 < N )
+      {  size_t x_ip = 3 * (i + 1);
+         // x_{i+1} - x_i - u_i <= 0
+         C_pattern.set(k, r, x_ip); C_val[k++] =  1.0;
+         C_pattern.set(k, r, x_i);  C_val[k++] = -1.0;
+         C_pattern.set(k, r, u_i);  C_val[k++] = -1.0;
+         c[r++] = 0.0;
+         // x_i - x_{i+1} - u_i <= 0
+         C_pattern.set(k, r, x_ip); C_val[k++] = -1.0;
+         C_pattern.set(k, r, x_i);  C_val[k++] =  1.0;
+         C_pattern.set(k, r, u_i);  C_val[k++] = -1.0;
+         c[r++] = 0.0;
+      }
+      else
+      {  // - u_i <= 0
+         C_pattern.set(k, r, u_i); C_val[k++] = -1.0;
+         c[r++] = 0.0;
+      }
+   }
+   ok &= k == nnz;
+   ok &= r == m;
+   sparse_matrix C(C_pattern);
+   for(k = 0; k < nnz; ++k)
+      C.set(k, C_val[k]);
+   //
+   // G = 0, g
+   sparsity      G_pattern(n, n, 0);
+   sparse_matrix G(G_pattern);
+   d_vector      g(n);
+   for(size_t i = 0; i < N; ++i)
+   {  g[3 * i]     = 0.0;
+      g[3 * i + 1] = 1.0;
+      g[3 * i + 2] = 1.0;
+   }
+   //
+   // xin: a point that is strictly feasible
+   d_vector xin(n);
+   for(size_t i = 0; i < N; ++i)
+   {  xin[3 * i]     = t[i];
+      xin[3 * i + 1] = 1.0;
+      xin[3 * i + 2] = 1.0;
+      if( i + 1 < N )
+         xin[3 * i + 2] += std::fabs( t[i+1] - t[i] );
+   }
+   //
+   double epsilon = 1e-10;
+   size_t maxitr  = 100;
+   size_t level   = 0;
+   //
+   // sparse solution
+   d_vector xout(n), yout(m), sout(m);
+   ok &= CppAD::qp_interior_sparse(
+      level, c, C, g, G, epsilon, maxitr, xin, xout, yout, sout
+   );
+   //
+   // dense solution
+   d_vector C_dense(m * n), G_dense(n * n);
+   for(size_t ell = 0; ell < m * n; ++ell)
+      C_dense[ell] = 0.0;
+   for(size_t ell = 0; ell < n * n; ++ell)
+      G_dense[ell] = 0.0;
+   for(k = 0; k < nnz; ++k)
+      C_dense[ C.row()[k] * n + C.col()[k] ] = C.val()[k];
+   d_vector x_dense(n), y_dense(m), s_dense(m);
+   ok &= CppAD::qp_interior(
+      level, c, C_dense, g, G_dense, epsilon, maxitr, xin,
+      x_dense, y_dense, s_dense
+   );
+   //
+   // The solution x is not unique for this problem, so compare the
+   // optimal objective values
+   double obj_sparse = 0.0, obj_dense = 0.0, obj_t = 0.0;
+   for(size_t i = 0; i < N; ++i)
+   {  obj_sparse += std::fabs( xout[3 * i]    - t[i] );
+      obj_dense  += std::fabs( x_dense[3 * i] - t[i] );
+      if( i + 1 < N )
+      {  obj_sparse += std::fabs( xout[3 * (i+1)] - xout[3 * i] );
+         obj_dense  += std::fabs( x_dense[3 * (i+1)] - x_dense[3 * i] );
+         obj_t      += std::fabs( t[i+1] - t[i] );
+      }
+   }
+   ok &= CppAD::NearEqual( obj_sparse, obj_dense, 1e-8, 1e-8);
+   //
+   // the optimal objective is less than or equal its value at x = t
+   ok &= obj_sparse <= obj_t + 1e-8;
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,647 @@
+# ifndef CPPAD_EXAMPLE_ABS_NORMAL_QP_INTERIOR_SPARSE_HPP
+# define CPPAD_EXAMPLE_ABS_NORMAL_QP_INTERIOR_SPARSE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin qp_interior_sparse}
+{xrst_spell
+   maxitr
+   sout
+   xin
+   xout
+   yout
+}
+
+Solve a Sparse Quadratic Program Using Interior Point Method
+############################################################
+
+Syntax
+******
+
+| *ok* = ``qp_interior_sparse`` (
+| *level* , *c* , *C* , *g* , *G* , *epsilon* , *maxitr* , *xin* , *xout* , *yout* , *sout*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN PROTOTYPE
+   // END PROTOTYPE
+}
+
+Source
+******
+This following is a link to the source code for this example:
+:ref:`qp_interior_sparse.hpp-name` .
+
+Purpose
+*******
+This routine solves the same problem as :ref:`qp_interior-name` ,
+using the same Newton steps and line search,
+but the matrices :math:`C` and :math:`G` are stored as
+:ref:`sparse_rcv-name` objects and the linear equation for
+:math:`\Delta x` is solved using a sparse factorization;
+see :ref:`qp_interior@Solution` .
+This makes it possible to solve problems with thousands of variables
+and constraints.
+
+SizeVector
+**********
+The type *SizeVector* is a
+simple vector with elements of type ``size_t`` .
+
+Vector
+******
+The type *Vector* is a
+simple vector with elements of type ``double`` .
+
+level
+*****
+This value is zero or one.
+If *level*  == 0 ,
+no tracing is printed.
+If *level*  == 1 ,
+a trace of the ``qp_interior_sparse`` iterations is printed.
+(The problem matrices and vectors are not printed because they
+may be very large.)
+
+Lower c
+*******
+This is the vector :math:`c` in the problem and has size *m* .
+
+Upper C
+*******
+This is the sparse matrix :math:`C` in the problem.
+It has *m* rows and *n* columns.
+
+Lower g
+*******
+This is the vector :math:`g` in the problem and has size *n* .
+
+Upper G
+*******
+This is the sparse matrix :math:`G` in the problem.
+It has *n* rows and *n* columns.
+Only the entries with row index greater than or equal the column index
+are used; i.e., it does not matter if the upper triangle of the
+symmetric matrix :math:`G` is included.
+
+epsilon, maxitr, xin, xout, yout, sout, ok
+******************************************
+These arguments have the same meaning as for
+:ref:`qp_interior-name` .
+
+Sparse Factorization
+********************
+The sparsity pattern for the matrix
+
+.. math::
+
+   G + C^T D(y/s) C
+
+and the elimination tree for its :math:`L D L^T` factorization
+are computed once, before the first iteration.
+Each iteration only computes the values for this matrix,
+and the corresponding numerical factorization, using the same pattern.
+No fill reducing permutation is used, so the variables should be
+ordered so that this matrix has a small bandwidth
+(or a small fill in for some other reason).
+
+{xrst_toc_hidden
+   example/abs_normal/qp_interior_sparse.cpp
+   example/abs_normal/qp_interior_sparse.xrst
+}
+Example
+*******
+The file :ref:`qp_interior_sparse.cpp-name` contains an example and test of
+``qp_interior_sparse`` .
+The program :ref:`speed_abs_normal-name` compares the speed of
+``qp_interior_sparse`` and ``qp_interior`` .
+
+{xrst_end qp_interior_sparse}
+-----------------------------------------------------------------------------
+*/
+# include <cmath>
+# include <algorithm>
+# include <utility>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rcv.hpp>
+
+// BEGIN C++
+namespace {
+   // ------------------------------------------------------------------------
+   // L D L^T factorization of a sparse symmetric positive definite matrix
+   // where the elimination tree is computed once and reused.
+   class qp_interior_sparse_ldl {
+   private:
+      typedef CppAD::vector<size_t> s_vector;
+      typedef CppAD::vector<double> d_vector;
+      //
+      // dimension of the matrix A
+      size_t   n_;
+      // A_start_[k] ... A_start_[k+1]-1 are the indices, in A_col_ and
+      // the value vector, for row k of the lower triangle of A
+      s_vector A_start_;
+      s_vector A_col_;
+      // parent_[k] is the parent of k in the elimination tree (n_ for none)
+      s_vector parent_;
+      // L_start_[k] is the start, in L_row_ and L_val_, for column k of L
+      s_vector L_start_;
+      s_vector L_row_;
+      d_vector L_val_;
+      d_vector D_;
+      // work space
+      s_vector L_count_, flag_, pattern_;
+      d_vector y_;
+   public:
+      // ---------------------------------------------------------------------
+      // symbolic factorization
+      // A_start, A_col: row k of the lower triangle of A has column indices
+      // A_col[ A_start[k] ], ... , A_col[ A_start[k+1] - 1 ]
+      void analyze(const s_vector& A_start, const s_vector& A_col)
+      {  n_       = A_start.size() - 1;
+         A_start_ = A_start;
+         A_col_   = A_col;
+         parent_.resize(n_);
+         L_count_.resize(n_);
+         flag_.resize(n_);
+         pattern_.resize(n_);
+         y_.resize(n_);
+         D_.resize(n_);
+         L_start_.resize(n_ + 1);
+         for(size_t k = 0; k < n_; ++k)
+         {  parent_[k]  = n_;
+            flag_[k]    = k;
+            L_count_[k] = 0;
+            for(size_t p = A_start_[k]; p < A_start_[k+1]; ++p)
+            {  size_t i = A_col_[p];
+               CPPAD_ASSERT_UNKNOWN( i <= k );
+               // follow path from i to root of elimination tree
+               while( flag_[i] != k )
+               {  if( parent_[i] == n_ )
+                     parent_[i] = k;
+                  ++L_count_[i];
+                  flag_[i] = k;
+                  i        = parent_[i];
+               }
+            }
+         }
+         L_start_[0] = 0;
+         for(size_t k = 0; k < n_; ++k)
+            L_start_[k+1] = L_start_[k] + L_count_[k];
+         L_row_.resize( L_start_[n_] );
+         L_val_.resize( L_start_[n_] );
+      }
+      // ---------------------------------------------------------------------
+      // number of non-zeros in L
+      size_t nnz_L(void) const
+      {  return L_start_[n_]; }
+      // ---------------------------------------------------------------------
+      // numerical factorization, A_val has same order as A_col in analyze
+      // return false if a zero pivot is found
+      bool factor(const d_vector& A_val)
+      {  for(size_t k = 0; k < n_; ++k)
+         {  // y_ = row k of A, pattern_[top, n_) = non-zeros in row k of L
+            y_[k]       = 0.0;
+            size_t top  = n_;
+            flag_[k]    = k;
+            L_count_[k] = 0;
+            for(size_t p = A_start_[k]; p < A_start_[k+1]; ++p)
+            {  size_t i = A_col_[p];
+               y_[i]   += A_val[p];
+               size_t len = 0;
+               while( flag_[i] != k )
+               {  pattern_[len++] = i;
+                  flag_[i]        = k;
+                  i               = parent_[i];
+               }
+               while( len > 0 )
+                  pattern_[--top] = pattern_[--len];
+            }
+            // compute row k of L and D[k]
+            D_[k]  = y_[k];
+            y_[k]  = 0.0;
+            for(; top < n_; ++top)
+            {  size_t i  = pattern_[top];
+               double yi = y_[i];
+               y_[i]     = 0.0;
+               size_t p  = L_start_[i];
+               size_t p2 = L_start_[i] + L_count_[i];
+               for(; p < p2; ++p)
+                  y_[ L_row_[p] ] -= L_val_[p] * yi;
+               double l_ki = yi / D_[i];
+               D_[k]      -= l_ki * yi;
+               L_row_[p]   = k;
+               L_val_[p]   = l_ki;
+               ++L_count_[i];
+            }
+            if( D_[k] == 0.0 )
+               return false;
+         }
+         return true;
+      }
+      // ---------------------------------------------------------------------
+      // solve A x = b, on input x = b and on output x is the solution
+      template <class Vector>
+      void solve(Vector& x) const
+      {  for(size_t j = 0; j < n_; ++j)
+         {  for(size_t p = L_start_[j]; p < L_start_[j+1]; ++p)
+               x[ L_row_[p] ] -= L_val_[p] * x[j];
+         }
+         for(size_t j = 0; j < n_; ++j)
+            x[j] /= D_[j];
+         for(size_t j = n_; j > 0; --j)
+         {  for(size_t p = L_start_[j-1]; p < L_start_[j]; ++p)
+               x[j-1] -= L_val_[p] * x[ L_row_[p] ];
+         }
+      }
+   };
+   // ------------------------------------------------------------------------
+   // index in col of (i, j) where column indices for row i are
+   // col[ start[i] ], ... , col[ start[i+1] - 1 ] (in increasing order)
+   inline size_t qp_interior_sparse_index(
+      const CppAD::vector<size_t>& start ,
+      const CppAD::vector<size_t>& col   ,
+      size_t                       i     ,
+      size_t                       j     )
+   {  const size_t* begin = col.data() + start[i];
+      const size_t* end   = col.data() + start[i+1];
+      const size_t* ptr   = std::lower_bound(begin, end, j);
+      CPPAD_ASSERT_UNKNOWN( ptr != end && *ptr == j );
+      return start[i] + size_t(ptr - begin);
+   }
+   // ------------------------------------------------------------------------
+   template <class Vector>
+   double qp_interior_sparse_max_abs(const Vector& v)
+   {  double max_abs = 0.0;
+      for(size_t j = 0; j < size_t(v.size()); j++)
+         max_abs = std::max( max_abs, std::fabs(v[j]) );
+      return max_abs;
+   }
+   // ------------------------------------------------------------------------
+   // compute F_0 (x, y, s) = [ r_x, r_y, r_s ] where mu = 0
+   template <class SizeVector, class Vector>
+   void qp_interior_sparse_F_0(
+      const Vector&                                c       ,
+      const CppAD::sparse_rcv<SizeVector, Vector>& C       ,
+      const Vector&                                g       ,
+      const CppAD::sparse_rcv<SizeVector, Vector>& G       ,
+      const Vector&                                x       ,
+      const Vector&                                y       ,
+      const Vector&                                s       ,
+      Vector&                                      r_x     ,
+      Vector&                                      r_y     ,
+      Vector&                                      r_s     )
+   {  size_t n = g.size();
+      size_t m = c.size();
+      // r_x(x, y, s) = g + G x + y^T C
+      for(size_t j = 0; j < n; j++)
+         r_x[j] = g[j];
+      for(size_t k = 0; k < G.nnz(); ++k)
+      {  size_t i = G.row()[k];
+         size_t j = G.col()[k];
+         if( j <= i )
+         {  r_x[i] += G.val()[k] * x[j];
+            if( j < i )
+               r_x[j] += G.val()[k] * x[i];
+         }
+      }
+      // r_y(x, y, s) = C x + c + s
+      for(size_t i = 0; i < m; i++)
+         r_y[i] = c[i] + s[i];
+      for(size_t k = 0; k < C.nnz(); ++k)
+      {  size_t i = C.row()[k];
+         size_t j = C.col()[k];
+         r_x[j] += y[i] * C.val()[k];
+         r_y[i] += C.val()[k] * x[j];
+      }
+      // r_s(x, y, s) = D(s) * D(y) * 1_m
+      for(size_t i = 0; i < m; i++)
+         r_s[i] = s[i] * y[i];
+   }
+}
+//
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN PROTOTYPE
+template <class SizeVector, class Vector>
+bool qp_interior_sparse(
+   size_t                              level   ,
+   const Vector&                       c       ,
+   const sparse_rcv<SizeVector, Vector>& C     ,
+   const Vector&                       g       ,
+   const sparse_rcv<SizeVector, Vector>& G     ,
+   double                              epsilon ,
+   size_t                              maxitr  ,
+   const Vector&                       xin     ,
+   Vector&                             xout    ,
+   Vector&                             yout    ,
+   Vector&                             sout    )
+// END PROTOTYPE
+{  typedef CppAD::vector<size_t> s_vector;
+   typedef CppAD::vector<double> d_vector;
+   //
+   size_t m = c.size();
+   size_t n = g.size();
+   CPPAD_ASSERT_KNOWN(
+      level <= 1,
+      "qp_interior_sparse: level is greater than one"
+   );
+   CPPAD_ASSERT_KNOWN(
+      C.nr() == m && C.nc() == n,
+      "qp_interior_sparse: C does not have m rows and n columns"
+   );
+   CPPAD_ASSERT_KNOWN(
+      G.nr() == n && G.nc() == n,
+      "qp_interior_sparse: G does not have n rows and n columns"
+   );
+   if( level > 0 )
+      std::cout << "start qp_interior_sparse: n = " << n
+         << ", m = " << m << "\n";
+   // ----------------------------------------------------------------------
+   // pattern for lower triangle of M = G + C^T D(y/s) C
+   //
+   // C_row_major: order of C entries by row
+   s_vector C_row_major = C.row_major();
+   //
+   // M_pair: (row, column) pairs for lower triangle of M
+   typedef std::pair<size_t, size_t> size_pair;
+   CppAD::vector<size_pair> M_pair;
+   for(size_t i = 0; i < n; ++i)
+      M_pair.push_back( size_pair(i, i) );
+   for(size_t k = 0; k < G.nnz(); ++k)
+   {  if( G.col()[k] <= G.row()[k] )
+         M_pair.push_back( size_pair(G.row()[k], G.col()[k]) );
+   }
+   size_t k_start = 0;
+   while( k_start < C.nnz() )
+   {  size_t r     = C.row()[ C_row_major[k_start] ];
+      size_t k_end = k_start + 1;
+      while( k_end < C.nnz() && C.row()[ C_row_major[k_end] ] == r )
+         ++k_end;
+      for(size_t ka = k_start; ka < k_end; ++ka)
+      {  size_t ja = C.col()[ C_row_major[ka] ];
+         for(size_t kb = k_start; kb < k_end; ++kb)
+         {  size_t jb = C.col()[ C_row_major[kb] ];
+            if( jb <= ja )
+               M_pair.push_back( size_pair(ja, jb) );
+         }
+      }
+      k_start = k_end;
+   }
+   std::sort( M_pair.begin(), M_pair.end() );
+   size_t M_nnz = 0;
+   for(size_t ell = 0; ell < M_pair.size(); ++ell)
+   {  if( ell == 0 || M_pair[ell] != M_pair[ell-1] )
+         M_pair[M_nnz++] = M_pair[ell];
+   }
+   M_pair.resize(M_nnz);
+   //
+   // M_start, M_col: row major representation of lower triangle of M
+   s_vector M_start(n + 1), M_col(M_nnz);
+   for(size_t i = 0; i <= n; ++i)
+      M_start[i] = 0;
+   for(size_t ell = 0; ell < M_nnz; ++ell)
+   {  ++M_start[ M_pair[ell].first + 1 ];
+      M_col[ell] = M_pair[ell].second;
+   }
+   for(size_t i = 0; i < n; ++i)
+      M_start[i+1] += M_start[i];
+   //
+   // G_index: index in M_col for each lower triangle entry of G
+   s_vector G_index( G.nnz() );
+   for(size_t k = 0; k < G.nnz(); ++k)
+   {  if( G.col()[k] <= G.row()[k] )
+         G_index[k] = qp_interior_sparse_index(
+            M_start, M_col, G.row()[k], G.col()[k]
+         );
+   }
+   //
+   // C_term: for each pair of entries ka, kb in the same row of C,
+   // with column ja >= column jb, the index in C for ka, kb and in M_col
+   s_vector C_term_ka, C_term_kb, C_term_M;
+   k_start = 0;
+   while( k_start < C.nnz() )
+   {  size_t r     = C.row()[ C_row_major[k_start] ];
+      size_t k_end = k_start + 1;
+      while( k_end < C.nnz() && C.row()[ C_row_major[k_end] ] == r )
+         ++k_end;
+      for(size_t ka = k_start; ka < k_end; ++ka)
+      {  size_t ja = C.col()[ C_row_major[ka] ];
+         for(size_t kb = k_start; kb < k_end; ++kb)
+         {  size_t jb = C.col()[ C_row_major[kb] ];
+            if( jb <= ja )
+            {  C_term_ka.push_back( C_row_major[ka] );
+               C_term_kb.push_back( C_row_major[kb] );
+               C_term_M.push_back(
+                  qp_interior_sparse_index(M_start, M_col, ja, jb)
+               );
+            }
+         }
+      }
+      k_start = k_end;
+   }
+   //
+   // symbolic factorization of M
+   qp_interior_sparse_ldl ldl;
+   ldl.analyze(M_start, M_col);
+   if( level > 0 )
+      std::cout << "nnz(M) = " << M_nnz << ", nnz(L) = " << ldl.nnz_L()
+         << "\n";
+   // ----------------------------------------------------------------------
+   //
+   // compute the maximum absolute element of the problem vectors and matrices
+   double max_element = 0.0;
+   for(size_t k = 0; k < C.nnz(); k++)
+      max_element = std::max(max_element , std::fabs(C.val()[k]) );
+   for(size_t i = 0; i < size_t(c.size()); i++)
+      max_element = std::max(max_element , std::fabs(c[i]) );
+   for(size_t k = 0; k < G.nnz(); k++)
+      max_element = std::max(max_element , std::fabs(G.val()[k]) );
+   for(size_t i = 0; i < size_t(g.size()); i++)
+      max_element = std::max(max_element , std::fabs(g[i]) );
+   //
+   double mu = 1e-1 * max_element;
+   //
+   if( max_element == 0.0 )
+   {  if( level > 0 )
+         std::cout << "end qp_interior_sparse: line_search failed\n";
+      return false;
+   }
+   //
+   // initialize x, y, s
+   xout = xin;
+   Vector Cx(m);
+   for(size_t i = 0; i < m; i++)
+      Cx[i] = c[i];
+   for(size_t k = 0; k < C.nnz(); ++k)
+      Cx[ C.row()[k] ] += C.val()[k] * xout[ C.col()[k] ];
+   for(size_t i = 0; i < m; i++)
+   {  if( Cx[i] > 0.0 )
+      {  if( level > 0 ) std::cout <<
+            "end qp_interior_sparse: xin is not in interior of feasible set\n";
+         return false;
+      }
+      //
+      sout[i] = std::sqrt(mu);
+      yout[i] = std::sqrt(mu);
+   }
+   // ----------------------------------------------------------------------
+   // initialie F_0(xout, yout, sout)
+   Vector r_x(n), r_y(m), r_s(m);
+   qp_interior_sparse_F_0(c, C, g, G, xout, yout, sout, r_x, r_y, r_s);
+   double F_max_abs = std::max( qp_interior_sparse_max_abs(r_x),
+      std::max( qp_interior_sparse_max_abs(r_y),
+      qp_interior_sparse_max_abs(r_s) )
+   );
+   //
+   // work space used during the iterations
+   d_vector M_val(M_nnz);
+   Vector   delta_x(n), delta_y(m), delta_s(m), C_delta_x(m), tmp_m(m);
+   Vector   x(n), y(m), s(m), t_x(n), t_y(m), t_s(m);
+   for(size_t itr = 0; itr <= maxitr; itr++)
+   {
+      // check for convergence
+      if( F_max_abs <= epsilon )
+      {  if( level > 0 )
+            std::cout << "end qp_interior_sparse: ok = true\n";
+         return true;
+      }
+      if( itr == maxitr )
+      {  if( level > 0 ) std::cout <<
+         "end qp_interior_sparse: max # iterations without convergence\n";
+         return false;
+      }
+      //
+      // r_s = r_s - mu, so r_x, r_y, r_s correspond to F_mu(xout,yout,sout)
+      for(size_t i = 0; i < m; i++)
+         r_s[i] -= mu;
+      //
+      // tmp_m = D(s)^{-1} * [ r_s - D(y) r_y ]
+      for(size_t i = 0; i < m; i++)
+         tmp_m[i]  = ( r_s[i] - yout[i] * r_y[i] ) / sout[i];
+      //
+      // delta_x = C^T * D(s)^{-1} * [ r_s - D(y) r_y ] - r_x
+      for(size_t j = 0; j < n; j++)
+         delta_x[j] = - r_x[j];
+      for(size_t k = 0; k < C.nnz(); ++k)
+         delta_x[ C.col()[k] ] += C.val()[k] * tmp_m[ C.row()[k] ];
+      //
+      // M = G + C^T * D(y / s) * C
+      for(size_t ell = 0; ell < M_nnz; ++ell)
+         M_val[ell] = 0.0;
+      for(size_t k = 0; k < G.nnz(); ++k)
+      {  if( G.col()[k] <= G.row()[k] )
+            M_val[ G_index[k] ] += G.val()[k];
+      }
+      for(size_t ell = 0; ell < C_term_M.size(); ++ell)
+      {  size_t ka = C_term_ka[ell];
+         size_t kb = C_term_kb[ell];
+         size_t i  = C.row()[ka];
+         double y_s = yout[i] / sout[i];
+         M_val[ C_term_M[ell] ] += C.val()[ka] * y_s * C.val()[kb];
+      }
+      //
+      // delta_x = M^{-1} * delta_x
+      if( ! ldl.factor(M_val) )
+      {  if( level > 0 ) std::cout <<
+            "end qp_interior_sparse: G + C^T D(y/s) C is singular\n";
+         return false;
+      }
+      ldl.solve(delta_x);
+      //
+      // C_delta_x = C * delta_x
+      for(size_t i = 0; i < m; i++)
+         C_delta_x[i] = 0.0;
+      for(size_t k = 0; k < C.nnz(); ++k)
+         C_delta_x[ C.row()[k] ] += C.val()[k] * delta_x[ C.col()[k] ];
+      //
+      // delta_y = D(s)^-1 * [D(y) * r_y - r_s + D(y) * C * delta_x]
+      for(size_t i = 0; i < m; i++)
+      {  delta_y[i] = yout[i] * r_y[i] - r_s[i] + yout[i] * C_delta_x[i];
+         delta_y[i] /= sout[i];
+      }
+      // delta_s = - r_y - C * delta_x
+      for(size_t i = 0; i < m; i++)
+         delta_s[i] = - r_y[i] - C_delta_x[i];
+      // -------------------------------------------------------------------
+      //
+      // norm square of F_mu(xout, yout, sout)
+      double F_norm_sq = 0.0;
+      for(size_t j = 0; j < n; j++)
+         F_norm_sq += r_x[j] * r_x[j];
+      for(size_t i = 0; i < m; i++)
+         F_norm_sq += r_y[i] * r_y[i] + r_s[i] * r_s[i];
+      //
+      // line search parameter lam
+      double  lam = 2.0;
+      bool lam_ok = false;
+      while( ! lam_ok && lam > 1e-5 )
+      {  lam = lam / 2.0;
+         for(size_t j = 0; j < n; j++)
+            x[j] = xout[j] + lam * delta_x[j];
+         lam_ok = true;
+         for(size_t i = 0; i < m; i++)
+         {  y[i] = yout[i] + lam * delta_y[i];
+            s[i] = sout[i] + lam * delta_s[i];
+            lam_ok &= s[i] > 0.0 && y[i] > 0.0;
+         }
+         if( lam_ok )
+         {  qp_interior_sparse_F_0(c, C, g, G, x, y, s, t_x, t_y, t_s);
+            for(size_t i = 0; i < m; i++)
+               t_s[i] -= mu;
+            // avoid cancellation roundoff in difference of norm squared
+            // |v + dv|^2         = v^T * v + 2 * v^T * dv + dv^T * dv
+            // |v + dv|^2 - |v|^2 =           2 * v^T * dv + dv^T * dv
+            double diff_norm_sq = 0.0;
+            for(size_t j = 0; j < n; j++)
+            {  double dv     = t_x[j] - r_x[j];
+               diff_norm_sq += 2.0 * r_x[j] * dv + dv * dv;
+            }
+            for(size_t i = 0; i < m; i++)
+            {  double dv     = t_y[i] - r_y[i];
+               diff_norm_sq += 2.0 * r_y[i] * dv + dv * dv;
+               dv            = t_s[i] - r_s[i];
+               diff_norm_sq += 2.0 * r_s[i] * dv + dv * dv;
+            }
+            lam_ok &= diff_norm_sq < - lam * F_norm_sq / 4.0;
+         }
+      }
+      if( ! lam_ok )
+      {  if( level > 0 )
+            std::cout << "end qp_interior_sparse: line search failed\n";
+         return false;
+      }
+      //
+      // update current solution
+      xout = x;
+      yout = y;
+      sout = s;
+      //
+      // updage F_0
+      qp_interior_sparse_F_0(c, C, g, G, xout, yout, sout, r_x, r_y, r_s);
+      F_max_abs = std::max( qp_interior_sparse_max_abs(r_x),
+         std::max( qp_interior_sparse_max_abs(r_y),
+         qp_interior_sparse_max_abs(r_s) )
+      );
+      //
+      // update mu
+      if( F_max_abs <= 1e1 *  mu )
+         mu = mu / 1e2;
+      if( level > 0 )
+      {  std::cout << "itr = " << itr
+            << ", mu = " << mu
+            << ", lam = " << lam
+            << ", F_max_abs = " << F_max_abs << "\n";
+      }
+   }
+   if( level > 0 )
+      std::cout << "end qp_interior_sparse: progam error\n";
+   return false;
+}
+} // END_CPPAD_NAMESPACE
+// END C++
+
+# endif
@@ -40,10 +40,12 @@ an different version of make; e.g., ``ninja`` .
 # include <cppad/utility/test_boolofvoid.hpp>
 
 // BEGIN_SORT_THIS_LINE_PLUS_1
+extern bool batch(void);
 extern bool bilinear(void);
 extern bool dynamic(void);
 extern bool forward(void);
 extern bool get_started(void);
+extern bool linalg(void);
 extern bool norm_sq(void);
 // END_SORT_THIS_LINE_MINUS_1
 
@@ -56,10 +58,12 @@ int main(void)
    // This line is used by test_one.sh
 
    // BEGIN_SORT_THIS_LINE_PLUS_1
+   Run( batch,               "batch"          );
    Run( bilinear,            "bilinear"       );
    Run( dynamic,             "dynamic"        );
    Run( forward,             "forward"        );
    Run( get_started,         "get_started"    );
+   Run( linalg,              "linalg"         );
    Run( norm_sq,             "norm_sq"        );
    // END_SORT_THIS_LINE_MINUS_1
 
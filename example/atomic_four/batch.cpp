@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin atomic_four_batch.cpp}
+
+Atomic Functions With Batched Callbacks: Example and Test
+########################################################
+
+Function
+********
+This example demonstrates using :ref:`atomic_four_batch-name`
+for the 2 by 2 matrix multiply
+:math:`g : \B{R}^8 \rightarrow \B{R}^4` where
+
+.. math::
+
+   g(x) = \left( \begin{array}{cc}
+      x_0 & x_1 \\
+      x_2 & x_3
+   \end{array} \right)
+   \left( \begin{array}{cc}
+      x_4 & x_5 \\
+      x_6 & x_7
+   \end{array} \right)
+
+and the result is stored in row major order.
+
+Purpose
+*******
+This atomic function demonstrates the following cases:
+
+#. Batched zero order forward mode.
+#. Batched first order reverse mode.
+#. First order forward mode is not batched by the atomic function
+   (``forward_batch`` returns false) and so the single call
+   ``forward`` callback is used for each call.
+#. All the calls to the atomic function are made after their
+   arguments are computed, so the calls are next to each other
+   in the operation sequence.
+
+Define Atomic Function
+**********************
+{xrst_literal
+   // BEGIN_DEFINE_ATOMIC_FUNCTION
+   // END_DEFINE_ATOMIC_FUNCTION
+}
+
+Use Atomic Function
+*******************
+{xrst_literal
+   // BEGIN_USE_ATOMIC_FUNCTION
+   // END_USE_ATOMIC_FUNCTION
+}
+
+{xrst_end atomic_four_batch.cpp}
+*/
+# include <cppad/cppad.hpp>
+
+// BEGIN_DEFINE_ATOMIC_FUNCTION
+// empty namespace
+namespace {
+   //
+   // mat_mul_2
+   // z = x * y where x, y, and z are 2 by 2 row major matrices
+   template <class Scalar>
+   void mat_mul_2(const Scalar* x, const Scalar* y, Scalar* z)
+   {  z[0] = x[0] * y[0] + x[1] * y[2];
+      z[1] = x[0] * y[1] + x[1] * y[3];
+      z[2] = x[2] * y[0] + x[3] * y[2];
+      z[3] = x[2] * y[1] + x[3] * y[3];
+   }
+   //
+   class atomic_mat_mul_2 : public CppAD::atomic_four<double> {
+   public:
+      // n_forward_batch, n_reverse_batch
+      // number of times each batch callback returned true
+      size_t n_forward_batch;
+      size_t n_reverse_batch;
+      //
+      // n_forward
+      // number of times the single call forward callback was used
+      size_t n_forward;
+      //
+      // BEGIN CONSTRUCTOR
+      atomic_mat_mul_2(const std::string& name) :
+      CppAD::atomic_four<double>(name, /* batch = */ true) ,
+      n_forward_batch(0), n_reverse_batch(0), n_forward(0)
+      { }
+      // END CONSTRUCTOR
+   private:
+      // for_type
+      bool for_type(
+         size_t                                     call_id     ,
+         const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+         CppAD::vector<CppAD::ad_type_enum>&        type_y      ) override
+      {  assert( type_x.size() == 8 );
+         assert( type_y.size() == 4 );
+         CppAD::ad_type_enum type = CppAD::constant_enum;
+         for(size_t j = 0; j < 8; ++j)
+            type = std::max(type, type_x[j]);
+         for(size_t i = 0; i < 4; ++i)
+            type_y[i] = type;
+         return true;
+      }
+      // forward
+      bool forward(
+         size_t                             call_id     ,
+         const CppAD::vector<bool>&         select_y    ,
+         size_t                             order_low   ,
+         size_t                             order_up    ,
+         const CppAD::vector<double>&       tx          ,
+         CppAD::vector<double>&             ty          ) override
+      {  ++n_forward;
+         if( order_up > 1 )
+            return false;
+         //
+         // q, x, y
+         size_t q = order_up + 1;
+         double x[4], y[4], z[4], w[4];
+         for(size_t j = 0; j < 4; ++j)
+         {  x[j] = tx[ j * q + 0];
+            y[j] = tx[ (4 + j) * q + 0];
+         }
+         //
+         // ty order zero
+         if( order_low == 0 )
+         {  mat_mul_2(x, y, z);
+            for(size_t i = 0; i < 4; ++i)
+               ty[ i * q + 0] = z[i];
+         }
+         if( order_up == 0 )
+            return true;
+         //
+         // ty order one
+         double x1[4], y1[4];
+         for(size_t j = 0; j < 4; ++j)
+         {  x1[j] = tx[ j * q + 1];
+            y1[j] = tx[ (4 + j) * q + 1];
+         }
+         mat_mul_2(x1, y, z);
+         mat_mul_2(x, y1, w);
+         for(size_t i = 0; i < 4; ++i)
+            ty[ i * q + 1] = z[i] + w[i];
+         return true;
+      }
+      // reverse
+      bool reverse(
+         size_t                              call_id     ,
+         const CppAD::vector<bool>&          select_x    ,
+         size_t                              order_up    ,
+         const CppAD::vector<double>&        tx          ,
+         const CppAD::vector<double>&        ty          ,
+         CppAD::vector<double>&              px          ,
+         const CppAD::vector<double>&        py          ) override
+      {  // this example only uses batched reverse mode
+         return false;
+      }
+      // BEGIN_FORWARD_BATCH
+      bool forward_batch(
+         const CppAD::vector<size_t>&       call_id     ,
+         const CppAD::vector<bool>&         select_y    ,
+         size_t                             order_low   ,
+         size_t                             order_up    ,
+         const CppAD::vector<double>&       taylor_x    ,
+         CppAD::vector<double>&             taylor_y    ) override
+      {  // only batch zero order forward mode
+         if( order_up != 0 )
+            return false;
+         //
+         // taylor_y
+         // A library could compute all these products with one call.
+         size_t n_call = call_id.size();
+         for(size_t c = 0; c < n_call; ++c)
+         {  const double* x = taylor_x.data() + c * 8;
+            double*       z = taylor_y.data() + c * 4;
+            mat_mul_2(x, x + 4, z);
+         }
+         ++n_forward_batch;
+         return true;
+      }
+      // END_FORWARD_BATCH
+      // BEGIN_REVERSE_BATCH
+      bool reverse_batch(
+         const CppAD::vector<size_t>&       call_id     ,
+         const CppAD::vector<bool>&         select_x    ,
+         size_t                             order_up    ,
+         const CppAD::vector<double>&       taylor_x    ,
+         const CppAD::vector<double>&       taylor_y    ,
+         CppAD::vector<double>&             partial_x   ,
+         const CppAD::vector<double>&       partial_y   ) override
+      {  // only batch first order reverse mode
+         if( order_up != 0 )
+            return false;
+         //
+         // partial_x
+         // The partial of z = x * y w.r.t x is pz * y^T
+         // and its partial w.r.t. y is x^T * pz
+         size_t n_call = call_id.size();
+         for(size_t c = 0; c < n_call; ++c)
+         {  const double* x  = taylor_x.data()  + c * 8;
+            const double* y  = x + 4;
+            const double* pz = partial_y.data() + c * 4;
+            double*       px = partial_x.data() + c * 8;
+            double*       py = px + 4;
+            double x_t[4]  = { x[0], x[2], x[1], x[3] };
+            double y_t[4]  = { y[0], y[2], y[1], y[3] };
+            mat_mul_2(pz, y_t, px);
+            mat_mul_2(x_t, pz, py);
+         }
+         ++n_reverse_batch;
+         return true;
+      }
+      // END_REVERSE_BATCH
+   };
+}
+// END_DEFINE_ATOMIC_FUNCTION
+
+// BEGIN_USE_ATOMIC_FUNCTION
+bool batch(void)
+{  // ok, eps
+   bool ok    = true;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // afun
+   atomic_mat_mul_2 afun("atomic_mat_mul_2");
+   //
+   // AD, a_vector, d_vector
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+   typedef CPPAD_TESTVECTOR( double )     d_vector;
+   //
+   // n_call, n, m
+   // the function f has n_call independent matrix multiplies
+   size_t n_call = 5;
+   size_t n      = 8;
+   size_t m      = 4 * n_call;
+   //
+   // x
+   d_vector x(n);
+   for(size_t j = 0; j < n; ++j)
+      x[j] = double(j + 1);
+   //
+   // ax, au
+   // first compute the arguments for all the calls
+   a_vector ax(n), au(n * n_call);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   for(size_t c = 0; c < n_call; ++c)
+   {  for(size_t j = 0; j < n; ++j)
+         au[c * n + j] = double(c + 1) * ax[j];
+   }
+   //
+   // ay
+   // then make all the calls next to each other
+   a_vector ay(m), ax_c(n), ay_c(4);
+   for(size_t c = 0; c < n_call; ++c)
+   {  for(size_t j = 0; j < n; ++j)
+         ax_c[j] = au[c * n + j];
+      afun(ax_c, ay_c);
+      for(size_t i = 0; i < 4; ++i)
+         ay[c * 4 + i] = ay_c[i];
+   }
+   //
+   // f
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // check
+   // the c-th result is (c + 1)^2 times the product for c = 0
+   double check[4];
+   mat_mul_2(x.data(), x.data() + 4, check);
+   //
+   // ok
+   // zero order forward uses one call to forward_batch
+   // (the ADFun constructor also does a zero order forward sweep)
+   afun.n_forward       = 0;
+   afun.n_forward_batch = 0;
+   d_vector y = f.Forward(0, x);
+   ok &= afun.n_forward_batch == 1;
+   ok &= afun.n_forward == 0;
+   for(size_t c = 0; c < n_call; ++c)
+   {  double scale = double( (c + 1) * (c + 1) );
+      for(size_t i = 0; i < 4; ++i)
+         ok &= CppAD::NearEqual(y[c * 4 + i], scale * check[i], eps, eps);
+   }
+   //
+   // ok
+   // first order forward mode uses the single call forward callback
+   d_vector dx(n), dy(m);
+   for(size_t j = 0; j < n; ++j)
+      dx[j] = 0.0;
+   dx[0] = 1.0;
+   dy = f.Forward(1, dx);
+   ok &= afun.n_forward == n_call;
+   for(size_t c = 0; c < n_call; ++c)
+   {  // derivative of z = x * y w.r.t x[0] is first row of y
+      double scale = double( (c + 1) * (c + 1) );
+      ok &= CppAD::NearEqual(dy[c * 4 + 0], scale * x[4], eps, eps);
+      ok &= CppAD::NearEqual(dy[c * 4 + 1], scale * x[5], eps, eps);
+      ok &= dy[c * 4 + 2] == 0.0;
+      ok &= dy[c * 4 + 3] == 0.0;
+   }
+   //
+   // ok
+   // first order reverse uses one call to reverse_batch
+   d_vector w(m), dw(n);
+   for(size_t i = 0; i < m; ++i)
+      w[i] = 0.0;
+   w[0] = 1.0;  // z[0] for c = 0
+   w[4] = 1.0;  // z[0] for c = 1
+   dw = f.Reverse(1, w);
+   ok &= afun.n_reverse_batch == 1;
+   // z[0] = x[0] * x[4] + x[1] * x[6]
+   double scale = 1.0 + 4.0;
+   ok &= CppAD::NearEqual(dw[0], scale * x[4], eps, eps);
+   ok &= CppAD::NearEqual(dw[1], scale * x[6], eps, eps);
+   ok &= dw[2] == 0.0;
+   ok &= dw[3] == 0.0;
+   ok &= CppAD::NearEqual(dw[4], scale * x[0], eps, eps);
+   ok &= dw[5] == 0.0;
+   ok &= CppAD::NearEqual(dw[6], scale * x[1], eps, eps);
+   ok &= dw[7] == 0.0;
+   //
+   return ok;
+}
+// END_USE_ATOMIC_FUNCTION
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_linalg.cpp}
+
+Atomic Dense Linear Algebra: Example and Test
+#############################################
+
+Function
+********
+For this example, *A* is a 3 by 3 matrix, *b* is a 3 by 1 vector,
+:math:`x = ( A , b )` , and
+
+.. math::
+
+   f(x) = \left( \begin{array}{c}
+      \log | \det( A ) |  \\
+      A^{-1} b
+   \end{array} \right)
+
+Derivatives
+***********
+The derivative of :math:`\log | \det( A ) |` with respect to
+:math:`A_{i,j}` is the :math:`(j, i)` element of :math:`A^{-1}` and
+the derivative of :math:`A^{-1} b` with respect to :math:`b` is :math:`A^{-1}`.
+Thus, if *J* is the Jacobian of :math:`f(x)` ,
+:math:`A` times the corresponding blocks of *J* is the identity matrix.
+
+Sparsity
+********
+This example also computes the Jacobian sparsity pattern for the
+solution of a lower triangular system.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end atomic_linalg.cpp}
+*/
+// BEGIN C++
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+bool linalg(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   typedef CppAD::atomic_linalg<double> linalg_t;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // linalg
+   linalg_t linalg("linalg");
+   //
+   // n, nx, ny
+   size_t n  = 3;
+   size_t nx = n * n + n;
+   size_t ny = 1 + n;
+   //
+   // x = (A, b)
+   CppAD::vector<double> x(nx);
+   double a_init[] = {
+      2.0, 1.0, 0.0,
+      1.0, 3.0, 1.0,
+      0.0, 1.0, 4.0
+   };
+   for(size_t k = 0; k < n * n; ++k)
+      x[k] = a_init[k];
+   for(size_t i = 0; i < n; ++i)
+      x[n * n + i] = double(i + 1);
+   //
+   // ax
+   CppAD::vector< AD<double> > ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   //
+   // alog_det
+   CppAD::vector< AD<double> > aa(n * n), alog_det(2);
+   for(size_t k = 0; k < n * n; ++k)
+      aa[k] = ax[k];
+   size_t call_id = linalg.set_log_det(n);
+   linalg(call_id, aa, alog_det);
+   //
+   // asol
+   CppAD::vector< AD<double> > asol(n);
+   call_id = linalg.set_solve(linalg_t::lu_solve_enum, n, 1);
+   linalg(call_id, ax, asol);
+   //
+   // f
+   CppAD::vector< AD<double> > ay(ny);
+   ay[0] = alog_det[0];
+   for(size_t i = 0; i < n; ++i)
+      ay[1 + i] = asol[i];
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // check f(x)
+   // det(A) = 2 * (3 * 4 - 1) - 1 * (1 * 4 - 0) = 18
+   CppAD::vector<double> y = f.Forward(0, x);
+   ok &= NearEqual(y[0], std::log(18.0), eps99, eps99);
+   ok &= alog_det[1] == 1.0;
+   for(size_t i = 0; i < n; ++i)
+   {  double sum = 0.0;
+      for(size_t k = 0; k < n; ++k)
+         sum += x[i * n + k] * y[1 + k];
+      ok &= NearEqual(sum, x[n * n + i], eps99, eps99);
+   }
+   //
+   // check Jacobian
+   CppAD::vector<double> jac = f.Jacobian(x);
+   for(size_t i = 0; i < n; ++i)
+   {  for(size_t j = 0; j < n; ++j)
+      {  // sum_k A(i, k) * A^{-1}(k, j)
+         double sum_log_det = 0.0;
+         double sum_sol     = 0.0;
+         for(size_t k = 0; k < n; ++k)
+         {  double a_ik = x[i * n + k];
+            // A^{-1}(k, j) = partial log_det w.r.t. A(j, k)
+            sum_log_det += a_ik * jac[ j * n + k ];
+            // A^{-1}(k, j) = partial sol(k) w.r.t. b(j)
+            sum_sol     += a_ik * jac[ (1 + k) * nx + n * n + j ];
+         }
+         double check = i == j ? 1.0 : 0.0;
+         ok &= NearEqual(sum_log_det, check, eps99, eps99);
+         ok &= NearEqual(sum_sol,     check, eps99, eps99);
+      }
+   }
+   //
+   // g(x) = L^{-1} b where L is the lower triangle of A
+   CppAD::Independent(ax);
+   call_id = linalg.set_solve(linalg_t::lower_solve_enum, n, 1);
+   linalg(call_id, ax, asol);
+   CppAD::ADFun<double> g(ax, asol);
+   //
+   // pattern_out
+   CppAD::sparse_rc< CppAD::vector<size_t> > pattern_in(nx, nx, nx);
+   for(size_t k = 0; k < nx; ++k)
+      pattern_in.set(k, k, k);
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   CppAD::sparse_rc< CppAD::vector<size_t> > pattern_out;
+   g.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern_out
+   );
+   //
+   // check pattern_out
+   // row i of the solution depends on L(r, c) and b(r) for c <= r <= i
+   ok &= pattern_out.nnz() == 2 + 5 + 9;
+   CppAD::vector<size_t> row_major = pattern_out.row_major();
+   size_t k = 0;
+   for(size_t i = 0; i < n; ++i)
+   {  for(size_t r = 0; r <= i; ++r)
+      {  for(size_t c = 0; c <= r; ++c)
+         {  ok &= pattern_out.row()[ row_major[k] ] == i;
+            ok &= pattern_out.col()[ row_major[k] ] == r * n + c;
+            ++k;
+         }
+      }
+      for(size_t r = 0; r <= i; ++r)
+      {  ok &= pattern_out.row()[ row_major[k] ] == i;
+         ok &= pattern_out.col()[ row_major[k] ] == n * n + r;
+         ++k;
+      }
+   }
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin cond_exp_switch.cpp}
+
+Multi-Way Conditional Expression: Example and Test
+##################################################
+
+Function
+********
+This example uses the piecewise function
+
+.. math::
+
+   f(x) = ( k + 1 ) \sin( x ) \; \R{for} \; k \leq x < k + 1
+
+with breakpoints at :math:`1, \ldots , K-1` .
+
+Source Code
+***********
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end cond_exp_switch.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool cond_exp_switch(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // K, ax
+   size_t K = 8;
+   CPPAD_TESTVECTOR( AD<double> ) ax(1), ay(1);
+   ax[0] = 0.5;
+   CppAD::Independent(ax);
+   //
+   // breakpoint, value
+   CPPAD_TESTVECTOR( AD<double> ) breakpoint(K-1), value(K);
+   for(size_t k = 0; k < K; ++k)
+   {  value[k] = double(k + 1) * sin( ax[0] );
+      if( k + 1 < K )
+         breakpoint[k] = double(k + 1);
+   }
+   //
+   // f
+   ay[0] = CppAD::CondExpSwitch(ax[0], breakpoint, value);
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // f.optimize
+   // optimize so that only the active piece is computed
+   f.optimize();
+   //
+   // check function values and derivatives for each piece
+   // (including the breakpoints)
+   CPPAD_TESTVECTOR(double) x(1), y(1), w(1), dw(1);
+   w[0] = 1.0;
+   for(size_t k = 0; k < K; ++k)
+   {  for(size_t i = 0; i < 2; ++i)
+      {  x[0]  = double(k) + double(i) / 2.0;
+         y     = f.Forward(0, x);
+         ok   &= NearEqual(y[0], double(k+1) * sin(x[0]), eps99, eps99);
+         dw    = f.Reverse(1, w);
+         ok   &= NearEqual(dw[0], double(k+1) * cos(x[0]), eps99, eps99);
+         //
+         // The products for the inactive pieces are skipped
+         // and at most 4 of the K-1 conditional expressions are computed.
+         ok   &= 2 * (K - 1) - 4 <= f.number_skip();
+      }
+   }
+   //
+   return ok;
+}
+// END C++
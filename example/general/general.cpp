@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin general.cpp}
@@ -110,6 +110,7 @@ extern bool change_param(void);
 extern bool check_for_nan(void);
 extern bool complex_poly(void);
 extern bool con_dyn_var(void);
+extern bool cond_exp_switch(void);
 extern bool eigen_array(void);
 extern bool eigen_det(void);
 extern bool erf(void);
@@ -128,6 +129,7 @@ extern bool log(void);
 extern bool log10(void);
 extern bool log1p(void);
 extern bool lu_vec_ad_ok(void);
+extern bool memory_info(void);
 extern bool mul_level(void);
 extern bool mul_level_adolc(void);
 extern bool mul_level_adolc_ode(void);
@@ -136,15 +138,19 @@ extern bool near_equal_ext(void);
 extern bool new_dynamic(void);
 extern bool num_limits(void);
 extern bool number_skip(void);
+extern bool op_profile(void);
 extern bool opt_val_hes(void);
 extern bool pow(void);
 extern bool pow_nan(void);
 extern bool print_for(void);
+extern bool record_reserve(void);
 extern bool rev_checkpoint(void);
 extern bool reverse_one(void);
 extern bool reverse_three(void);
 extern bool reverse_two(void);
+extern bool revolve(void);
 extern bool sign(void);
+extern bool taylor_high_water(void);
 extern bool taylor_ode(void);
 extern bool unary_minus(void);
 extern bool unary_plus(void);
@@ -226,6 +232,7 @@ int main(void)
    Run( change_param,      "change_param"     );
    Run( complex_poly,      "complex_poly"     );
    Run( con_dyn_var,       "con_dyn_var"      );
+   Run( cond_exp_switch,   "cond_exp_switch"  );
    Run( erf,               "erf"              );
    Run( erfc,              "erfc"             );
    Run( exp,               "exp"              );
@@ -242,20 +249,25 @@ int main(void)
    Run( log10,             "log10"            );
    Run( log1p,             "log1p"            );
    Run( lu_vec_ad_ok,      "lu_vec_ad_ok"     );
+   Run( memory_info,       "memory_info"      );
    Run( mul_level,         "mul_level"        );
    Run( mul_level_ode,     "mul_level_ode"    );
    Run( near_equal_ext,    "near_equal_ext"   );
    Run( new_dynamic,       "new_dynamic"      );
    Run( num_limits,        "num_limits"       );
    Run( number_skip,       "number_skip"      );
+   Run( op_profile,        "op_profile"       );
    Run( opt_val_hes,       "opt_val_hes"      );
    Run( pow,               "pow"              );
    Run( pow_nan,           "pow_nan"          );
+   Run( record_reserve,    "record_reserve"   );
    Run( rev_checkpoint,    "rev_checkpoint"   );
    Run( reverse_one,       "reverse_one"      );
    Run( reverse_three,     "reverse_three"    );
    Run( reverse_two,       "reverse_two"      );
+   Run( revolve,           "revolve"          );
    Run( sign,              "sign"             );
+   Run( taylor_high_water, "taylor_high_water");
    Run( taylor_ode,        "ode_taylor"       );
    Run( unary_minus,       "unary_minus"      );
    Run( unary_plus,        "unary_plus"       );
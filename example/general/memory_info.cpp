@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin memory_info.cpp}
+
+Memory Used by an ADFun Object: Example and Test
+################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end memory_info.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool memory_info(void)
+{  bool ok = true;
+   using CppAD::AD;
+   //
+   // f(x) = [ x_0 * x_1 , sin(x_2) ]
+   size_t n = 3, m = 2;
+   CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1);
+   CppAD::Independent(ax);
+   ay[0] = ax[0] * ax[1];
+   ay[1] = sin( ax[2] );
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // info
+   CppAD::fun_memory_info info = f.memory_info();
+   ok &= info.op_seq   == f.size_op_seq();
+   ok &= info.random   == f.size_random();
+   ok &= info.taylor   >= f.size_var() * sizeof(double);
+   ok &= info.sparsity == 0;
+   ok &= info.other    >  0;
+   ok &= info.total    == info.op_seq + info.random + info.taylor
+                        + info.sparsity + info.subgraph + info.other;
+   //
+   // forward Jacobian sparsity patterns are cached in f
+   CPPAD_TESTVECTOR(bool) r(n * n);
+   for(size_t i = 0; i < n * n; ++i)
+      r[i] = false;
+   for(size_t j = 0; j < n; ++j)
+      r[j * n + j] = true;
+   f.ForSparseJac(n, r);
+   info = f.memory_info();
+   ok  &= info.sparsity == f.size_forward_bool();
+   ok  &= info.sparsity >  0;
+   //
+   // free the sparsity patterns
+   f.size_forward_bool(0);
+   info = f.memory_info();
+   ok  &= info.sparsity == 0;
+   //
+   // subgraph reverse mode caches information in f
+   CPPAD_TESTVECTOR(bool) select_domain(n);
+   for(size_t j = 0; j < n; ++j)
+      select_domain[j] = true;
+   f.subgraph_reverse(select_domain);
+   CPPAD_TESTVECTOR(size_t) col;
+   CPPAD_TESTVECTOR(double) dw;
+   f.subgraph_reverse(1, 0, col, dw);
+   info = f.memory_info();
+   ok  &= info.random   > 0;
+   ok  &= info.subgraph > 0;
+   //
+   // free the subgraph information
+   f.clear_subgraph();
+   info = f.memory_info();
+   ok  &= info.random   == 0;
+   ok  &= info.subgraph == 0;
+   //
+   // free the Taylor coefficients
+   f.capacity_order(0);
+   info = f.memory_info();
+   ok  &= info.taylor == 0;
+   //
+   return ok;
+}
+// END C++
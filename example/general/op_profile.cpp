@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin op_profile.cpp}
+
+Profile the Operators in an ADFun Object: Example and Test
+##########################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end op_profile.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <sstream>
+
+bool op_profile(void)
+{  bool ok = true;
+   using CppAD::AD;
+   typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+   typedef CPPAD_TESTVECTOR( double )     d_vector;
+   //
+   // square
+   // atomic function that computes the square of its argument
+   a_vector au(1), av(1);
+   au[0] = 1.0;
+   CppAD::Independent(au);
+   av[0] = au[0] * au[0];
+   CppAD::ADFun<double> g(au, av);
+   CppAD::chkpoint_two<double> square(g, "square",
+      /* internal_bool = */ false,
+      /* use_hes_sparsity = */ true,
+      /* use_base2ad = */ false,
+      /* use_in_parallel = */ false
+   );
+   //
+   // f
+   size_t n = 2;
+   a_vector ax(n), ay(1);
+   ax[0] = 1.0;
+   ax[1] = 2.0;
+   CppAD::Independent(ax);
+   AD<double> asum = ax[0] * ax[1];
+   for(size_t k = 0; k < 3; ++k)
+   {  au[0] = sin(asum);
+      square(au, av);
+      asum += av[0];
+   }
+   ay[0] = asum;
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // profile zero order forward and first order reverse
+   f.op_profile(true);
+   d_vector x(n), w(1), dw(n);
+   x[0] = 3.0;
+   x[1] = 4.0;
+   w[0] = 1.0;
+   f.Forward(0, x);
+   dw = f.Reverse(1, w);
+   f.op_profile(false);
+   //
+   // table
+   std::stringstream table;
+   f.op_profile_table(table);
+   std::string table_str = table.str();
+   ok &= table_str.find("forward0") != std::string::npos;
+   ok &= table_str.find("reverse")  != std::string::npos;
+   ok &= table_str.find("Sin")      != std::string::npos;
+   ok &= table_str.find("square")   != std::string::npos;
+   //
+   // json
+   std::string json = f.op_profile_json();
+   //
+   // There are three sine operators in f and one zero order forward sweep.
+   // Note that the sine and cosine are both computed by the Sin operator.
+   std::string check =
+      "{ \"sweep\" : \"forward0\", \"op\" : \"Sin\", \"count\" : 3,";
+   ok &= json.find(check) != std::string::npos;
+   //
+   // There is one multiply in f and one reverse sweep.
+   check = "{ \"sweep\" : \"reverse\", \"op\" : \"Mulvv\", \"count\" : 1,";
+   ok &= json.find(check) != std::string::npos;
+   //
+   // There are three calls to the square atomic function in f.
+   check = "{ \"sweep\" : \"reverse\", \"name\" : \"square\", \"count\" : 3,";
+   ok &= json.find(check) != std::string::npos;
+   //
+   // Profiling is off so this sweep is not included.
+   f.Forward(0, x);
+   ok &= f.op_profile_json() == json;
+   //
+   // Turning profiling back on sets the counters to zero.
+   f.op_profile(true);
+   std::string empty = "{\n   \"op\" : [\n   ],\n   \"atomic\" : [\n   ]\n}\n";
+   ok &= f.op_profile_json() == empty;
+   //
+   // sparsity sweeps are also included
+   CppAD::sparse_rc< CPPAD_TESTVECTOR(size_t) > pattern_in, pattern_out;
+   pattern_in.resize(n, n, n);
+   for(size_t j = 0; j < n; ++j)
+      pattern_in.set(j, j, j);
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern_out
+   );
+   json = f.op_profile_json();
+   check = "{ \"sweep\" : \"for_jac\", \"op\" : \"Sin\", \"count\" : 3,";
+   ok &= json.find(check) != std::string::npos;
+   f.op_profile(false);
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin record_reserve.cpp}
+
+Reserve Memory for a Recording: Example and Test
+################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end record_reserve.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   typedef CppAD::AD<double> a_double;
+   //
+   // record_f
+   // f(x) = sum_i c_i * x_0 + sum_i c_i * x_1 where c_i = 2 + i
+   void record_f(
+      size_t n_c, size_t n_op, size_t n_arg, CppAD::ADFun<double>& f
+   )
+   {  CPPAD_TESTVECTOR(a_double) ax(2), ay(1);
+      ax[0] = 1.0;
+      ax[1] = 2.0;
+      CppAD::Independent(ax);
+      if( n_op > 0 )
+         a_double::record_reserve(n_op, n_arg);
+      ay[0] = 0.0;
+      for(size_t j = 0; j < 2; ++j)
+      {  for(size_t i = 0; i < n_c; ++i)
+            ay[0] += double(2 + i) * ax[j];
+      }
+      f.Dependent(ax, ay);
+   }
+}
+
+bool record_reserve(void)
+{  bool ok = true;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // n_c
+   // use more constants than CPPAD_HASH_TABLE_SIZE so that
+   // some of them have the same hash code
+   size_t n_c = 2 * CPPAD_HASH_TABLE_SIZE + 1;
+   //
+   // f
+   // record without reserving memory
+   CppAD::ADFun<double> f;
+   record_f(n_c, 0, 0, f);
+   //
+   // each constant c_i is only stored once in the recording
+   // (the parameter with index zero is not used)
+   ok &= f.size_par() == 1 + n_c;
+   //
+   // g
+   // record the same function reserving memory for its operators
+   // and arguments
+   CppAD::ADFun<double> g;
+   record_f(n_c, f.size_op(), f.size_op_arg(), g);
+   ok &= g.size_op()     == f.size_op();
+   ok &= g.size_op_arg() == f.size_op_arg();
+   ok &= g.size_par()    == f.size_par();
+   //
+   // check g
+   CPPAD_TESTVECTOR(double) x(2), y(1);
+   x[0] = 3.0;
+   x[1] = 4.0;
+   y    = g.Forward(0, x);
+   double sum = double(n_c) * double(n_c + 3) / 2.0;
+   ok  &= CppAD::NearEqual(y[0], sum * (x[0] + x[1]), eps99, eps99);
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin revolve.cpp}
+
+Binomial Checkpointing Through Time Steps: Example and Test
+###########################################################
+
+Step Function
+*************
+The state is :math:`x = ( y_0 , y_1 , a )` and the step function is
+one Euler step, with step size :math:`h`, for the ODE
+
+.. math::
+
+   y_0^{(1)} (t) = a \; y_1 (t) \; , \;
+   y_1^{(1)} (t) = - \sin [ y_0 (t) ]
+
+where :math:`a` is a constant (so its step just copies it).
+
+Check
+*****
+The derivative computed using :ref:`revolve-name` is checked
+using the derivative of a recording of all the time steps.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end revolve.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   template <class Scalar>
+   void euler_step(double h, CppAD::vector<Scalar>& x)
+   {  Scalar y_0 = x[0];
+      Scalar y_1 = x[1];
+      Scalar a   = x[2];
+      x[0]       = y_0 + h * a * y_1;
+      x[1]       = y_1 - h * sin(y_0);
+   }
+}
+
+bool revolve(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   using CppAD::vector;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // n, n_step, h
+   size_t n      = 3;
+   size_t n_step = 50;
+   double h      = 1.0 / double(n_step);
+   //
+   // x_0, w
+   vector<double> x_0(n), w(n);
+   x_0[0] = 0.5;
+   x_0[1] = 0.0;
+   x_0[2] = 2.0;
+   w[0]   = 1.0;
+   w[1]   = 2.0;
+   w[2]   = 0.0;
+   //
+   // step
+   vector< AD<double> > ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = x_0[j];
+   CppAD::Independent(ax);
+   vector< AD<double> > ay = ax;
+   euler_step(h, ay);
+   CppAD::ADFun<double> step(ax, ay);
+   //
+   // all_step
+   // recording of all the steps (used to check the revolve results)
+   CppAD::Independent(ax);
+   ay = ax;
+   for(size_t k = 0; k < n_step; ++k)
+      euler_step(h, ay);
+   CppAD::ADFun<double> all_step(ax, ay);
+   vector<double> check_x = all_step.Forward(0, x_0);
+   vector<double> check_dw = all_step.Reverse(1, w);
+   //
+   // n_snap
+   for(size_t n_snap = 1; n_snap < 7; ++n_snap)
+   {  //
+      // x_final, dw
+      vector<double> x_final, dw;
+      size_t n_forward = CppAD::revolve(
+         step, n_step, n_snap, x_0, w, x_final, dw
+      );
+      for(size_t j = 0; j < n; ++j)
+      {  ok &= NearEqual(x_final[j], check_x[j],  eps99, eps99);
+         ok &= NearEqual(dw[j],      check_dw[j], eps99, eps99);
+      }
+      //
+      // n_rep
+      // smallest value such that n_step <= (n_snap + n_rep)! / (n_snap! n_rep!)
+      size_t n_rep = 0;
+      size_t range = 1;
+      while( range < n_step )
+      {  ++n_rep;
+         range = range * (n_snap + n_rep) / n_rep;
+      }
+      //
+      // each step is evaluated at most n_rep + 1 times
+      ok &= n_step <= n_forward;
+      ok &= n_forward <= (n_rep + 1) * n_step;
+   }
+   //
+   // with one snapshot, all the steps are recomputed for each reverse step
+   vector<double> x_final, dw;
+   size_t n_forward = CppAD::revolve(step, n_step, 1, x_0, w, x_final, dw);
+   ok &= n_forward == n_step * (n_step + 1) / 2;
+   //
+   // with n_step snapshots, each step is evaluated twice
+   n_forward = CppAD::revolve(step, n_step, n_step, x_0, w, x_final, dw);
+   ok &= n_forward <= 2 * n_step;
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin taylor_high_water.cpp}
+
+Automatic Release of Taylor Coefficient Memory: Example and Test
+################################################################
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end taylor_high_water.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool taylor_high_water(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::NearEqual;
+   double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+   //
+   // f(x) = x^3 using enough variables so the memory is easy to see
+   size_t n = 1, m = 1;
+   CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+   ax[0] = 1.0;
+   CppAD::Independent(ax);
+   ay[0] = 0.0;
+   for(size_t i = 0; i < 10; ++i)
+      ay[0] += ax[0] * ax[0] * ax[0];
+   ay[0] = ay[0] / 10.0;
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // the default value for the high water mark
+   ok &= f.taylor_high_water() == std::numeric_limits<size_t>::max();
+   //
+   // second order forward mode
+   CPPAD_TESTVECTOR(double) x(n), y(m), dx(n), ddx(n), w(m), dw(n);
+   x[0]   = 0.5;
+   dx[0]  = 1.0;
+   ddx[0] = 0.0;
+   f.Forward(0, x);
+   f.Forward(1, dx);
+   y = f.Forward(2, ddx);
+   ok &= NearEqual(y[0], 3.0 * x[0], eps, eps);
+   size_t taylor_2 = f.memory_info().taylor;
+   //
+   // by default, the memory for three orders is retained
+   f.Forward(0, x);
+   ok &= f.size_order() == 1;
+   ok &= f.memory_info().taylor == taylor_2;
+   //
+   // setting the high water mark to zero only retains the zero order
+   f.taylor_high_water(0);
+   size_t taylor_0 = f.memory_info().taylor;
+   ok &= taylor_0 < taylor_2;
+   //
+   // reverse mode only needs the zero order coefficients
+   w[0] = 1.0;
+   dw   = f.Reverse(1, w);
+   ok  &= NearEqual(dw[0], 3.0 * x[0] * x[0], eps, eps);
+   //
+   // a first order forward allocates memory for order one,
+   // all the coefficients computed are retained for use by reverse mode
+   f.Forward(1, dx);
+   ok &= taylor_0 < f.memory_info().taylor;
+   dw = f.Reverse(2, w);
+   ok &= NearEqual(dw[1], 6.0 * x[0], eps, eps);
+   //
+   // this zero order forward releases the memory for order one
+   f.Forward(0, x);
+   ok &= f.memory_info().taylor == taylor_0;
+   //
+   // with a high water mark above taylor_2, memory is retained
+   f.taylor_high_water(taylor_2);
+   f.Forward(1, dx);
+   f.Forward(2, ddx);
+   f.Forward(0, x);
+   ok &= f.memory_info().taylor == taylor_2;
+   //
+   return ok;
+}
+// END C++
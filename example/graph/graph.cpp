@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin graph.cpp}
@@ -49,6 +49,7 @@ extern bool cexp_op(void);
 extern bool comp_op(void);
 extern bool discrete_op(void);
 extern bool div_op(void);
+extern bool merge_graph(void);
 extern bool mul_op(void);
 extern bool pow_op(void);
 extern bool print_graph(void);
@@ -77,6 +78,7 @@ int main(void)
    Run( comp_op,              "comp_op"         );
    Run( discrete_op,          "discrete_op"     );
    Run( div_op,               "div_op"          );
+   Run( merge_graph,          "merge_graph"     );
    Run( mul_op,               "mul_op"          );
    Run( pow_op,               "pow_op"          );
    Run( print_graph,          "print_graph"     );
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin merge_graph.cpp}
+
+Merge C++ AD Graphs: Example and Test
+#####################################
+
+Function
+********
+The merged function is
+
+.. math::
+
+   f(p, x) = \left[ \begin{array}{c}
+      g( p , x_0 , x_2 ) \\
+      g( p , x_1 , x_2 )
+   \end{array} \right]
+   \; \R{where} \;
+   g( p , u , v ) = p_0 \sin( u ) + 3 v^2
+
+Each :math:`g` is recorded separately (this could be done by
+different threads) and the merged function is checked by comparing it
+with a recording of :math:`f` .
+
+Source Code
+***********
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end merge_graph.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   typedef CppAD::AD<double> a_double;
+   //
+   // g(p, u, v)
+   a_double g(const a_double& p, const a_double& u, const a_double& v)
+   {  return p * sin(u) + 3.0 * v * v; }
+   //
+   // record_block
+   // records g(p, x[k], x[2]) and returns the corresponding graph
+   // and number of parameters
+   size_t record_block(size_t k, CppAD::cpp_graph& graph_obj)
+   {  CPPAD_TESTVECTOR(a_double) ap(1), ax(2), ay(1);
+      ap[0] = 1.0;
+      ax[0] = double(k + 1);
+      ax[1] = 3.0;
+      size_t abort_op_index = 0;
+      bool   record_compare = true;
+      CppAD::Independent(ax, abort_op_index, record_compare, ap);
+      ay[0] = g(ap[0], ax[0], ax[1]);
+      CppAD::ADFun<double> g_k(ax, ay);
+      //
+      // optimizing the block before merging reduces the merged recording
+      g_k.optimize();
+      g_k.to_graph(graph_obj);
+      return g_k.size_par();
+   }
+}
+
+bool merge_graph(void)
+{  bool ok = true;
+   using CppAD::vector;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // n_block, n_dynamic_ind, n_variable_ind
+   size_t n_block        = 2;
+   size_t n_dynamic_ind  = 1;
+   size_t n_variable_ind = 3;
+   //
+   // graph_vec, dyn_index, var_index, size_par
+   vector<CppAD::cpp_graph>    graph_vec(n_block);
+   vector< vector<size_t> >    dyn_index(n_block), var_index(n_block);
+   size_t                      size_par = 0;
+   for(size_t k = 0; k < n_block; ++k)
+   {  size_par = record_block(k, graph_vec[k]);
+      //
+      // p^k = p
+      dyn_index[k].resize(1);
+      dyn_index[k][0] = 0;
+      //
+      // x^k = ( x[k], x[2] )
+      var_index[k].resize(2);
+      var_index[k][0] = k;
+      var_index[k][1] = 2;
+   }
+   //
+   // f
+   CppAD::cpp_graph graph_obj;
+   CppAD::merge_graph(
+      graph_obj, n_dynamic_ind, n_variable_ind, graph_vec, dyn_index, var_index
+   );
+   CppAD::ADFun<double> f;
+   f.from_graph(graph_obj);
+   ok &= f.size_dyn_ind() == n_dynamic_ind;
+   ok &= f.Domain()       == n_variable_ind;
+   ok &= f.Range()        == n_block;
+   //
+   // the blocks have the same parameters and they are only stored once in f
+   ok &= f.size_par() == size_par;
+   //
+   // check
+   // a recording of the merged function
+   CPPAD_TESTVECTOR(a_double) ap(1), ax(3), ay(2);
+   ap[0] = 1.0;
+   for(size_t j = 0; j < n_variable_ind; ++j)
+      ax[j] = 1.0;
+   size_t abort_op_index = 0;
+   bool   record_compare = true;
+   CppAD::Independent(ax, abort_op_index, record_compare, ap);
+   ay[0] = g(ap[0], ax[0], ax[2]);
+   ay[1] = g(ap[0], ax[1], ax[2]);
+   CppAD::ADFun<double> check(ax, ay);
+   //
+   // compare function values
+   CPPAD_TESTVECTOR(double) p(1), x(3), y(2), y_check(2);
+   p[0] = 2.0;
+   x[0] = 0.5;
+   x[1] = 1.0;
+   x[2] = 1.5;
+   f.new_dynamic(p);
+   check.new_dynamic(p);
+   y       = f.Forward(0, x);
+   y_check = check.Forward(0, x);
+   for(size_t i = 0; i < 2; ++i)
+      ok &= CppAD::NearEqual(y[i], y_check[i], eps99, eps99);
+   //
+   // compare derivatives
+   CPPAD_TESTVECTOR(double) J       = f.Jacobian(x);
+   CPPAD_TESTVECTOR(double) J_check = check.Jacobian(x);
+   for(size_t i = 0; i < 2 * n_variable_ind; ++i)
+      ok &= CppAD::NearEqual(J[i], J_check[i], eps99, eps99);
+   //
+   return ok;
+}
+// END C++
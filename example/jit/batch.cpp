@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin jit_batch.cpp}
+
+JIT Batch Function: Example and Test
+####################################
+
+Purpose
+*******
+This example uses the :ref:`to_csrc@options@batch_size` option
+to create a function that evaluates many points in one call.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end jit_batch.cpp}
+-------------------------------------------------------------------------------
+*/
+// BEGIN C++
+
+# include <cstddef>
+# include <iostream>
+# include <fstream>
+# include <map>
+
+// DLL_EXT
+# ifdef _WIN32
+# define DLL_EXT ".dll"
+# else
+# define DLL_EXT ".so"
+# endif
+
+# include <cppad/cppad.hpp>
+bool batch(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::ADFun;
+   using CppAD::Independent;
+   using CppAD::NearEqual;
+   //
+   // np, nx, ny
+   size_t np = 1, nx = 2, ny = 2;
+   //
+   // f
+   // f_0 (x) = p_0 * exp( x_0 ) + x_0 * sin( x_1 )
+   // f_1 (x) = x_0 + x_1
+   // There is also a comparison operator x_0 < x_1 in f.
+   CPPAD_TESTVECTOR( AD<double> ) ap(np), ax(nx), ay(ny);
+   ap[0] = 1.0;
+   ax[0] = 0.5;
+   ax[1] = 1.0;
+   size_t abort_op_index = 0;
+   bool   record_compare = true;
+   Independent(ax, abort_op_index, record_compare, ap);
+   ay[0] = ap[0] * exp( ax[0] ) + ax[0] * sin( ax[1] );
+   if( ax[0] < ax[1] )
+      ay[1] = ax[0] + ax[1];
+   else
+      ay[1] = ax[0] + ax[1];
+   ADFun<double> f(ax, ay);
+   f.function_name_set("f");
+   //
+   // csrc_file
+   // created in std::filesystem::current_path
+   std::map<std::string, std::string> csrc_options;
+   csrc_options["batch_size"] = "4";
+   std::string c_type    = "double";
+   std::string csrc_file = "batch.c";
+   std::ofstream ofs;
+   ofs.open(csrc_file , std::ofstream::out);
+   f.to_csrc(ofs, c_type, csrc_options);
+   ofs.close();
+   //
+   // dll_file
+   // created in std::filesystem::current_path
+   std::string dll_file = "jit_batch" DLL_EXT;
+   CPPAD_TESTVECTOR( std::string) csrc_files(1);
+   csrc_files[0] = csrc_file;
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cerr << "jit_batch: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_batch: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // void_ptr
+   std::string function_name = "cppad_jit_batch_f";
+   void* void_ptr = dll_linker(function_name, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_batch: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // f_ptr
+   using CppAD::jit_batch_double;
+   jit_batch_double f_ptr =
+      reinterpret_cast<jit_batch_double>(void_ptr);
+   //
+   // n_point, nu, u
+   // u is stored by component; i.e., u[j * n_point + k]
+   // is component j of point k. Note that n_point is not a multiple
+   // of the batch size.
+   size_t n_point = 10;
+   size_t nu      = np + nx;
+   std::vector<double> u(nu * n_point), y(ny * n_point);
+   for(size_t k = 0; k < n_point; ++k)
+   {  u[0 * n_point + k] = 2.0;                 // p_0
+      u[1 * n_point + k] = double(k) / 10.0;    // x_0
+      u[2 * n_point + k] = 0.5;                 // x_1
+   }
+   //
+   // y
+   size_t compare_change = 0;
+   int flag = f_ptr(n_point, nu, u.data(), ny, y.data(), &compare_change);
+   ok &= flag == 0;
+   //
+   // ok
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   size_t n_change = 0;
+   for(size_t k = 0; k < n_point; ++k)
+   {  double p0 = u[0 * n_point + k];
+      double x0 = u[1 * n_point + k];
+      double x1 = u[2 * n_point + k];
+      double check = p0 * std::exp(x0) + x0 * std::sin(x1);
+      ok &= NearEqual(y[0 * n_point + k], check, eps99, eps99);
+      check = x0 + x1;
+      ok &= NearEqual(y[1 * n_point + k], check, eps99, eps99);
+      if( ! (x0 < x1) )
+         ++n_change;
+   }
+   //
+   // ok
+   // comparison changes from the value x_0 < x_1 during recording
+   ok &= compare_change == n_change;
+   //
+   return ok;
+}
+// END C++
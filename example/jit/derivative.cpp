@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin jit_derivative.cpp}
+
+JIT C Source for Derivatives: Example and Test
+##############################################
+
+Purpose
+*******
+This example uses the :ref:`to_csrc@derivative` argument to create
+C source code for the function, a forward directional derivative,
+a reverse mode derivative, and a sparse Jacobian.
+All of these are compiled and linked into one library.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end jit_derivative.cpp}
+-------------------------------------------------------------------------------
+*/
+// BEGIN C++
+
+# include <cstddef>
+# include <iostream>
+# include <fstream>
+# include <map>
+
+// DLL_EXT
+# ifdef _WIN32
+# define DLL_EXT ".dll"
+# else
+# define DLL_EXT ".so"
+# endif
+
+# include <cppad/cppad.hpp>
+
+namespace {
+   // get_jit_double
+   CppAD::jit_double get_jit_double(
+      CppAD::link_dll_lib& dll_linker, const std::string& function_name )
+   {  std::string err_msg;
+      void* void_ptr = dll_linker(function_name, err_msg);
+      if( err_msg != "" )
+      {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+         return nullptr;
+      }
+      return reinterpret_cast<CppAD::jit_double>(void_ptr);
+   }
+}
+
+bool derivative(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::ADFun;
+   using CppAD::Independent;
+   using CppAD::NearEqual;
+   typedef CppAD::vector<size_t> s_vector;
+   //
+   // np, nx, ny
+   size_t np = 1, nx = 3, ny = 2;
+   //
+   // f
+   // f_0 (x) = p_0 * x_0 * x_1
+   // f_1 (x) = sin( x_2 )
+   CPPAD_TESTVECTOR( AD<double> ) ap(np), ax(nx), ay(ny);
+   ap[0] = 2.0;
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = double(j + 1);
+   Independent(ax, ap);
+   ay[0] = ap[0] * ax[0] * ax[1];
+   ay[1] = sin( ax[2] );
+   ADFun<double> f(ax, ay);
+   f.function_name_set("f");
+   //
+   // pattern
+   // sparsity pattern for the Jacobian of f
+   CppAD::sparse_rc<s_vector> pattern_in(nx, nx, nx), pattern;
+   for(size_t k = 0; k < nx; ++k)
+      pattern_in.set(k, k, k);
+   bool transpose     = false;
+   bool dependency    = false;
+   bool internal_bool = false;
+   f.for_jac_sparsity(
+      pattern_in, transpose, dependency, internal_bool, pattern
+   );
+   size_t nnz = pattern.nnz();
+   ok &= nnz == 3;
+   //
+   // csrc_files
+   // created in std::filesystem::current_path
+   // (each C source file can only contain one function)
+   std::string c_type    = "double";
+   std::string coloring  = "cppad";
+   CPPAD_TESTVECTOR( std::string) csrc_files(5);
+   for(size_t i = 0; i < csrc_files.size(); ++i)
+   {  csrc_files[i] = "derivative_" + CppAD::to_string(i) + ".c";
+      std::ofstream ofs;
+      ofs.open(csrc_files[i] , std::ofstream::out);
+      switch(i)
+      {  case 0:
+         f.to_csrc(ofs, c_type);
+         break;
+
+         case 1:
+         f.to_csrc(ofs, c_type, "for_one");
+         break;
+
+         case 2:
+         f.to_csrc(ofs, c_type, "rev_one");
+         break;
+
+         case 3:
+         f.to_csrc(ofs, c_type, "sparse_jac_for", pattern, coloring);
+         break;
+
+         case 4:
+         f.to_csrc(ofs, c_type, "sparse_jac_rev", pattern, coloring);
+         break;
+      }
+      ofs.close();
+   }
+   //
+   // dll_file
+   // created in std::filesystem::current_path
+   std::string dll_file = "jit_derivative" DLL_EXT;
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_derivative: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // f_ptr, for_one_ptr, rev_one_ptr, jac_for_ptr, jac_rev_ptr
+   CppAD::jit_double f_ptr       = get_jit_double(dll_linker, "cppad_jit_f");
+   CppAD::jit_double for_one_ptr =
+      get_jit_double(dll_linker, "cppad_jit_f_for_one");
+   CppAD::jit_double rev_one_ptr =
+      get_jit_double(dll_linker, "cppad_jit_f_rev_one");
+   CppAD::jit_double jac_for_ptr =
+      get_jit_double(dll_linker, "cppad_jit_f_sparse_jac_for");
+   CppAD::jit_double jac_rev_ptr =
+      get_jit_double(dll_linker, "cppad_jit_f_sparse_jac_rev");
+   if( f_ptr == nullptr || for_one_ptr == nullptr || rev_one_ptr == nullptr )
+      return false;
+   if( jac_for_ptr == nullptr || jac_rev_ptr == nullptr )
+      return false;
+   //
+   // p, x, jac
+   double p = 0.5;
+   double x[3] = { 0.3, 0.7, 0.9 };
+   double jac[3][3] = {
+      { p * x[1], p * x[0], 0.0              } ,
+      { 0.0,      0.0,      std::cos( x[2] ) } ,
+      { 0.0,      0.0,      0.0              }
+   };
+   //
+   // eps99
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // compare_change
+   size_t compare_change = 0;
+   //
+   // ok
+   // for_one: u = (p, x, dx), y = (f, df)
+   {  std::vector<double> u(np + 2 * nx), y(2 * ny);
+      u[0] = p;
+      for(size_t j = 0; j < nx; ++j)
+      {  u[np + j]      = x[j];
+         u[np + nx + j] = double(j + 1);
+      }
+      int flag = for_one_ptr(u.size(), u.data(), y.size(), y.data(),
+         &compare_change
+      );
+      ok &= flag == 0;
+      ok &= NearEqual(y[0], p * x[0] * x[1], eps99, eps99);
+      ok &= NearEqual(y[1], std::sin( x[2] ), eps99, eps99);
+      for(size_t i = 0; i < ny; ++i)
+      {  double check = 0.0;
+         for(size_t j = 0; j < nx; ++j)
+            check += jac[i][j] * u[np + nx + j];
+         ok &= NearEqual(y[ny + i], check, eps99, eps99);
+      }
+   }
+   //
+   // ok
+   // rev_one: u = (p, x, w), y = (f, dw)
+   {  std::vector<double> u(np + nx + ny), y(ny + nx);
+      u[0] = p;
+      for(size_t j = 0; j < nx; ++j)
+         u[np + j] = x[j];
+      for(size_t i = 0; i < ny; ++i)
+         u[np + nx + i] = double(i + 2);
+      int flag = rev_one_ptr(u.size(), u.data(), y.size(), y.data(),
+         &compare_change
+      );
+      ok &= flag == 0;
+      ok &= NearEqual(y[0], p * x[0] * x[1], eps99, eps99);
+      for(size_t j = 0; j < nx; ++j)
+      {  double check = 0.0;
+         for(size_t i = 0; i < ny; ++i)
+            check += u[np + nx + i] * jac[i][j];
+         ok &= NearEqual(y[ny + j], check, eps99, eps99);
+      }
+   }
+   //
+   // ok
+   // sparse_jac_for, sparse_jac_rev: u = (p, x), y = Jacobian values
+   {  std::vector<double> u(np + nx), y_for(nnz), y_rev(nnz);
+      u[0] = p;
+      for(size_t j = 0; j < nx; ++j)
+         u[np + j] = x[j];
+      int flag = jac_for_ptr(u.size(), u.data(), nnz, y_for.data(),
+         &compare_change
+      );
+      ok &= flag == 0;
+      flag = jac_rev_ptr(u.size(), u.data(), nnz, y_rev.data(),
+         &compare_change
+      );
+      ok &= flag == 0;
+      const s_vector& row( pattern.row() );
+      const s_vector& col( pattern.col() );
+      for(size_t k = 0; k < nnz; ++k)
+      {  double check = jac[ row[k] ][ col[k] ];
+         ok &= NearEqual(y_for[k], check, eps99, eps99);
+         ok &= NearEqual(y_rev[k], check, eps99, eps99);
+      }
+   }
+   //
+   // ok
+   ok &= compare_change == 0;
+   //
+   return ok;
+}
+// END C++
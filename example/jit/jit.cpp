@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin jit.cpp}
@@ -44,10 +44,13 @@ an different version of make; e.g., ``ninja`` .
 
 // BEGIN_SORT_THIS_LINE_PLUS_1
 extern bool atomic(void);
+extern bool batch(void);
 extern bool compare_change(void);
 extern bool compile(void);
+extern bool derivative(void);
 extern bool dynamic(void);
 extern bool get_started(void);
+extern bool translation_unit(void);
 // END_SORT_THIS_LINE_MINUS_1
 
 // main program that runs all the tests
@@ -67,10 +70,13 @@ int main(void)
 
    // BEGIN_SORT_THIS_LINE_PLUS_1
    Run( atomic,              "atomic"                );
+   Run( batch,               "batch"                 );
    Run( compare_change,      "compare_change"        );
    Run( compile,             "compile"               );
+   Run( derivative,          "derivative"            );
    Run( dynamic,             "dynamic"               );
    Run( get_started,         "get_started"           );
+   Run( translation_unit,    "translation_unit"      );
    // END_SORT_THIS_LINE_MINUS_1
 
    // check for memory leak
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin jit_translation_unit.cpp}
+
+JIT Function in Multiple Translation Units: Example and Test
+############################################################
+
+Purpose
+*******
+This example uses the :ref:`to_csrc@csrc_vec` argument to split
+the C source code for a function into several translation units.
+These are compiled in parallel using the *n_job* option
+to :ref:`create_dll_lib-name` and then linked into one library.
+
+ODE
+***
+The function is the solution of the ODE
+:math:`z'(t) = - x_0 z(t)^2 + x_1` , :math:`z(0) = 1` ,
+at :math:`t = 1` , which is approximated using :ref:`Runge45-name` .
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end jit_translation_unit.cpp}
+-------------------------------------------------------------------------------
+*/
+// BEGIN C++
+
+# include <cstddef>
+# include <iostream>
+# include <fstream>
+# include <map>
+
+// DLL_EXT
+# ifdef _WIN32
+# define DLL_EXT ".dll"
+# else
+# define DLL_EXT ".so"
+# endif
+
+# include <cppad/cppad.hpp>
+
+namespace {
+   // ode
+   template <class Scalar> class ode {
+   private:
+      const CPPAD_TESTVECTOR(Scalar) x_;
+   public:
+      ode(const CPPAD_TESTVECTOR(Scalar)& x) : x_(x)
+      { }
+      void Ode(
+         const Scalar&                   t ,
+         const CPPAD_TESTVECTOR(Scalar)& z ,
+         CPPAD_TESTVECTOR(Scalar)&       f )
+      {  f[0] = - x_[0] * z[0] * z[0] + x_[1]; }
+   };
+}
+
+bool translation_unit(void)
+{  bool ok = true;
+   //
+   using CppAD::AD;
+   using CppAD::ADFun;
+   using CppAD::Independent;
+   using CppAD::NearEqual;
+   typedef CPPAD_TESTVECTOR( AD<double> ) a_vector;
+   //
+   // nx, ny
+   size_t nx = 2, ny = 1;
+   //
+   // f
+   a_vector ax(nx), az(ny);
+   ax[0] = 1.0;
+   ax[1] = 0.5;
+   Independent(ax);
+   ode< AD<double> > fun(ax);
+   size_t     n_step = 10;
+   AD<double> ti     = 0.0;
+   AD<double> tf     = 1.0;
+   a_vector   azi(ny), ae(ny);
+   azi[0] = 1.0;
+   az = CppAD::Runge45(fun, n_step, ti, tf, azi, ae);
+   ADFun<double> f(ax, az);
+   f.function_name_set("f");
+   //
+   // csrc_files
+   // created in std::filesystem::current_path
+   size_t n_unit = 3;
+   CPPAD_TESTVECTOR( std::string ) csrc_vec(n_unit), csrc_files(n_unit);
+   std::map<std::string, std::string> csrc_options;
+   std::string c_type = "double";
+   f.to_csrc(csrc_vec, c_type, csrc_options);
+   for(size_t i = 0; i < n_unit; ++i)
+   {  csrc_files[i] = "translation_unit_" + CppAD::to_string(i) + ".c";
+      std::ofstream ofs;
+      ofs.open(csrc_files[i] , std::ofstream::out);
+      ofs << csrc_vec[i];
+      ofs.close();
+   }
+   //
+   // dll_file
+   // created in std::filesystem::current_path
+   std::string dll_file = "jit_translation_unit" DLL_EXT;
+   std::map< std::string, std::string > options;
+   options["n_job"] = CppAD::to_string(n_unit);
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cerr << "jit_translation_unit: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_translation_unit: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // void_ptr
+   std::string function_name = "cppad_jit_f";
+   void* void_ptr = dll_linker(function_name, err_msg);
+   if( err_msg != "" )
+   {  std::cerr << "jit_translation_unit: err_msg = " << err_msg << "\n";
+      return false;
+   }
+   //
+   // f_ptr
+   using CppAD::jit_double;
+   jit_double f_ptr = reinterpret_cast<jit_double>(void_ptr);
+   //
+   // x, z
+   std::vector<double> x(nx), z(ny);
+   x[0] = 0.5;
+   x[1] = 2.0;
+   size_t compare_change = 0;
+   int flag = f_ptr(nx, x.data(), ny, z.data(), &compare_change);
+   ok &= flag == 0;
+   ok &= compare_change == 0;
+   //
+   // ok
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   std::vector<double> check = f.Forward(0, x);
+   ok &= NearEqual(z[0], check[0], eps99, eps99);
+   //
+   return ok;
+}
+// END C++
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -124,6 +124,10 @@ namespace {
    // (zero means one thread with no multi-threading setup)
    size_t num_threads_ = 0;
 
+   // Memory in use by the checkpoint function for the threads other
+   // than thread zero, set by multi_chkpoint_two_takedown
+   size_t chkpoint_inuse_ = 0;
+
    // We can use one checkpoint function for all threads because
    // there is no member data that gets changed during worker call.
    // This needs to stay in scope for as long as a recording will use it.
@@ -355,6 +359,7 @@ bool multi_chkpoint_two_takedown(vector<double>& square_root)
 {  bool ok            = true;
    ok                &= thread_alloc::thread_num() == 0;
    size_t num_threads = std::max(num_threads_, size_t(1));
+   chkpoint_inuse_    = 0;
    //
    // extract square roots in original order
    square_root.resize(0);
@@ -386,6 +391,7 @@ bool multi_chkpoint_two_takedown(vector<double>& square_root)
       // thread_alloc::inuse(thread_num) cannot be zero until it is deleted
       if( thread_num > 0 )
       {  ok &= thread_alloc::inuse(thread_num) > 0;
+         chkpoint_inuse_ += thread_alloc::inuse(thread_num);
          //
          // return all memory that is not in use and
          // but being held for future use by this thread
@@ -486,7 +492,7 @@ Syntax
 ******
 
 | *ok* = ``multi_chkpoint_two_time`` (
-| |tab| *time_out* , *test_time* , *num_threads* , *num_solve*
+| |tab| *time_out* , *inuse_out* , *test_time* , *num_threads* , *num_solve*
 | )
 
 Thread
@@ -516,6 +522,19 @@ is reached.
 The reported *time_out* is the total wall clock time divided by the
 number of repeats.
 
+inuse_out
+*********
+This argument has prototype
+
+   ``size_t&`` *inuse_out*
+
+Its input value of the argument does not matter.
+Upon return it is the number of bytes of memory,
+for the threads other than thread zero,
+that are in use by the checkpoint function at the end of the test.
+(This does not include the memory for the checkpoint function that is
+shared by all the threads.)
+
 num_threads
 ***********
 This argument has prototype
@@ -575,7 +594,11 @@ namespace {
 }
 // This is the only routine that is accessible outside of this file
 bool multi_chkpoint_two_time(
-   double& time_out, double test_time, size_t num_threads, size_t num_solve
+   double& time_out  ,
+   size_t& inuse_out ,
+   double  test_time ,
+   size_t  num_threads,
+   size_t  num_solve
 )
 {  bool ok = true;
    //
@@ -622,6 +645,9 @@ bool multi_chkpoint_two_time(
 
    // run the test case and set the time return value
    time_out = CppAD::time_test(test_repeat, test_time);
+   //
+   // memory used by the checkpoint function for threads other than zero
+   inuse_out = chkpoint_inuse_;
 
    // destroy team of threads
    if( num_threads > 0 )
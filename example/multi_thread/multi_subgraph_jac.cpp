@@ -0,0 +1,565 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin multi_subgraph_jac_common}
+
+Multi-Threaded subgraph_jac_rev Common Information
+##################################################
+
+Purpose
+*******
+This source code defines the common variables that are used by
+the ``multi_subgraph_jac_`` *name* functions.
+
+Function
+********
+The function :math:`F : \B{R}^n \rightarrow \B{R}^n` is defined by
+
+.. math::
+
+   F_i (x) = x_i x_{i+1} + \sin( x_i )
+
+for :math:`i = 0 , \ldots , n-1` where :math:`x_n` is defined to be
+:math:`x_0` .
+Each row of the Jacobian of :math:`F` has two possibly non-zero elements.
+
+Source
+******
+{xrst_literal
+   // BEGIN COMMON C++
+   // END COMMON C++
+}
+
+{xrst_end multi_subgraph_jac_common}
+*/
+// BEGIN COMMON C++
+// includes used by all source code in multi_subgraph_jac.cpp file
+# include <cppad/cppad.hpp>
+# include "multi_subgraph_jac.hpp"
+# include "team_thread.hpp"
+//
+namespace {
+   using CppAD::thread_alloc; // fast multi-threading memory allocator
+   using CppAD::vector;       // uses thread_alloc
+   //
+   typedef CppAD::AD<double>                             a_double;
+   typedef CppAD::sparse_rcv< vector<size_t>, vector<double> > sparse_matrix;
+   //
+   // Number of threads, set by multi_subgraph_jac_time
+   // (zero means one thread with no multi-threading setup)
+   size_t num_threads_ = 0;
+   //
+   // The function F(x). All the threads use this one function object
+   // because subgraph_jac_rev with a work argument does not change it.
+   // It is created and deleted by multi_subgraph_jac_time.
+   CppAD::ADFun<double>* fun_ = nullptr;
+   //
+   // structure with information for one thread
+   typedef struct {
+      // work space for subgraph_jac_rev, used by worker
+      CppAD::subgraph_work<double>* work;
+      //
+      // rows of the Jacobian for this thread, set by worker
+      sparse_matrix* jac;
+      //
+      // false if an error occurs, true otherwise, set by worker
+      bool ok;
+   } work_one_t;
+   //
+   // Vector with information for all threads
+   // (uses pointers instead of values to avoid false sharing)
+   // allocated by multi_subgraph_jac_setup, freed by multi_subgraph_jac_takedown
+   work_one_t* work_all_[CPPAD_MAX_NUM_THREADS];
+}
+// END COMMON C++
+/*
+-------------------------------------------------------------------------------
+{xrst_begin multi_subgraph_jac_setup}
+
+Multi-Threaded subgraph_jac_rev Set Up
+######################################
+
+Syntax
+******
+*ok* = ``multi_subgraph_jac_setup`` ( *x* )
+
+Purpose
+*******
+This routine computes the information in the function object
+that is shared by all the threads and allocates the information
+for each thread.
+
+Thread
+******
+It is assumed that this function is called by thread zero
+and all the other threads are blocked (waiting).
+
+x
+*
+This argument has prototype
+
+   ``const vector<double>&`` *x*
+
+It is the point at which we are computing the Jacobian.
+
+ok
+**
+This return value has prototype
+
+   ``bool`` *ok*
+
+If it is false,
+``multi_subgraph_jac_setup`` detected an error.
+
+Source
+******
+{xrst_literal
+   // BEGIN SETUP C++
+   // END SETUP C++
+}
+
+{xrst_end multi_subgraph_jac_setup}
+*/
+// BEGIN SETUP C++
+namespace {
+bool multi_subgraph_jac_setup(const vector<double>& x)
+{  size_t num_threads = std::max(num_threads_, size_t(1));
+   bool   ok          = num_threads == thread_alloc::num_threads();
+   ok                &= thread_alloc::thread_num() == 0;
+   ok                &= ! thread_alloc::in_parallel();
+   //
+   // zero order Taylor coefficients for all the threads
+   fun_->Forward(0, x);
+   //
+   // subgraph information for all the threads
+   vector<bool> select_domain( x.size() );
+   for(size_t j = 0; j < x.size(); ++j)
+      select_domain[j] = true;
+   fun_->subgraph_reverse(select_domain);
+   //
+   for(size_t thread_num = 0; thread_num < num_threads; thread_num++)
+   {  // allocate separate memory for each thread to avoid false sharing
+      size_t min_bytes(sizeof(work_one_t)), cap_bytes;
+      void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+      work_all_[thread_num] = static_cast<work_one_t*>(v_ptr);
+      //
+      // Run constructors. These objects do not allocate any memory
+      // until they are used by the corresponding thread.
+      work_all_[thread_num]->work = new CppAD::subgraph_work<double>;
+      work_all_[thread_num]->jac  = new sparse_matrix;
+      //
+      // set to false in case this thread's worker does not get called
+      work_all_[thread_num]->ok = false;
+   }
+   return ok;
+}
+}
+// END SETUP C++
+/*
+------------------------------------------------------------------------------
+{xrst_begin multi_subgraph_jac_worker}
+
+Multi-Threaded subgraph_jac_rev Worker
+######################################
+
+Purpose
+*******
+This routine computes the rows of the Jacobian for one thread.
+Thread number *k* computes the rows with index :math:`i` where
+:math:`i \bmod p = k` and :math:`p` is the number of threads.
+
+Source
+******
+{xrst_literal
+   // BEGIN WORKER C++
+   // END WORKER C++
+}
+
+{xrst_end multi_subgraph_jac_worker}
+*/
+// BEGIN WORKER C++
+namespace {
+void multi_subgraph_jac_worker(void)
+{  size_t thread_num  = thread_alloc::thread_num();
+   size_t num_threads = std::max(num_threads_, size_t(1));
+   bool   ok          = thread_num < num_threads;
+   //
+   // select_range
+   size_t m = fun_->Range();
+   vector<bool> select_range(m);
+   for(size_t i = 0; i < m; ++i)
+      select_range[i] = i % num_threads == thread_num;
+   //
+   // jac
+   // rows of the Jacobian for this thread
+   const CppAD::ADFun<double>& fun( *fun_ );
+   fun.subgraph_jac_rev(
+      select_range, *work_all_[thread_num]->jac, *work_all_[thread_num]->work
+   );
+   work_all_[thread_num]->ok = ok;
+}
+}
+// END WORKER C++
+/*
+------------------------------------------------------------------------------
+{xrst_begin multi_subgraph_jac_takedown}
+
+Multi-Threaded subgraph_jac_rev Take Down
+#########################################
+
+Syntax
+******
+*ok* = ``multi_subgraph_jac_takedown`` ( *jac* )
+
+Purpose
+*******
+This routine gathers up the results for each thread and
+frees memory that was allocated by :ref:`multi_subgraph_jac_setup-name`
+and by the threads.
+
+Thread
+******
+It is assumed that this function is called by thread zero
+and all the other threads are blocked (waiting).
+
+jac
+***
+This argument has prototype
+
+   ``vector<double>&`` *jac*
+
+The input value of *jac* does not matter.
+Upon return, it has size :math:`2 n` and for :math:`i = 0, \ldots , n-1`,
+*jac* [ 2 * *i* ] is the partial of :math:`F_i (x)` w.r.t. :math:`x_i`
+and
+*jac* [ 2 * *i* + 1 ] is the partial of :math:`F_i (x)` w.r.t.
+:math:`x_{i+1}` .
+
+ok
+**
+This return value has prototype
+
+   ``bool`` *ok*
+
+If it is false,
+``multi_subgraph_jac_takedown`` detected an error.
+
+Source
+******
+{xrst_literal
+   // BEGIN TAKEDOWN C++
+   // END TAKEDOWN C++
+}
+
+{xrst_end multi_subgraph_jac_takedown}
+*/
+// BEGIN TAKEDOWN C++
+namespace {
+bool multi_subgraph_jac_takedown(vector<double>& jac)
+{  bool ok            = true;
+   ok                &= thread_alloc::thread_num() == 0;
+   size_t num_threads = std::max(num_threads_, size_t(1));
+   size_t n           = fun_->Domain();
+   //
+   // extract the Jacobian values in original order
+   jac.resize(2 * n);
+   size_t nnz_total = 0;
+   for(size_t thread_num = 0; thread_num < num_threads; thread_num++)
+   {  // results for this thread
+      const sparse_matrix& matrix( *work_all_[thread_num]->jac );
+      ok &= matrix.nr() == n;
+      ok &= matrix.nc() == n;
+      for(size_t k = 0; k < matrix.nnz(); ++k)
+      {  size_t i = matrix.row()[k];
+         size_t j = matrix.col()[k];
+         ok &= i % num_threads == thread_num;
+         if( j == i )
+            jac[2 * i] = matrix.val()[k];
+         else
+         {  ok &= j == (i + 1) % n;
+            jac[2 * i + 1] = matrix.val()[k];
+         }
+      }
+      nnz_total += matrix.nnz();
+   }
+   ok &= nnz_total == 2 * n;
+   //
+   // go down so that free memory for other threads before memory for master
+   size_t thread_num = num_threads;
+   while(thread_num--)
+   {  // check that this tread was ok with the work it did
+      ok  &= work_all_[thread_num]->ok;
+      //
+      // run destructors for this thread
+      delete work_all_[thread_num]->work;
+      delete work_all_[thread_num]->jac;
+      //
+      // delete problem specific information
+      void* v_ptr = static_cast<void*>( work_all_[thread_num] );
+      thread_alloc::return_memory( v_ptr );
+      //
+      // all the memory used by the other threads has been returned
+      if( thread_num > 0 )
+      {  ok &= thread_alloc::inuse(thread_num) == 0;
+         //
+         // return all memory that is not in use and
+         // but being held for future use by this thread
+         thread_alloc::free_available(thread_num);
+      }
+   }
+   return ok;
+}
+}
+// END TAKEDOWN C++
+/*
+{xrst_begin multi_subgraph_jac_run}
+
+Run Multi-Threaded subgraph_jac_rev Calculation
+###############################################
+
+Syntax
+******
+*ok* = ``multi_subgraph_jac_run`` ( *x* , *jac* )
+
+Thread
+******
+It is assumed that this function is called by thread zero
+and all the other threads are blocked (waiting).
+
+x
+*
+This argument has prototype
+
+   ``const vector<double>&`` *x*
+
+It is the point at which we are computing the Jacobian.
+
+jac
+***
+This argument has prototype
+
+   ``vector<double>&`` *jac*
+
+The input value of *jac* does not matter.
+Upon return, it contains the Jacobian values; see
+:ref:`multi_subgraph_jac_takedown@jac` .
+
+ok
+**
+This return value has prototype
+
+   ``bool`` *ok*
+
+If it is false,
+``multi_subgraph_jac_run`` detected an error.
+
+Source
+******
+{xrst_literal
+   // BEGIN RUN C++
+   // END RUN C++
+}
+
+{xrst_end multi_subgraph_jac_run}
+------------------------------------------------------------------------------
+*/
+// BEGIN RUN C++
+namespace {
+bool multi_subgraph_jac_run(
+   const vector<double>& x   ,
+   vector<double>&       jac )
+{
+   bool ok = true;
+   ok     &= thread_alloc::thread_num() == 0;
+
+   // setup the work for multi-threading
+   ok &= multi_subgraph_jac_setup(x);
+
+   // now do the work for each thread
+   if( num_threads_ > 0 )
+      team_work( multi_subgraph_jac_worker );
+   else
+      multi_subgraph_jac_worker();
+
+   // combine the result for each thread and takedown the multi-threading.
+   ok &= multi_subgraph_jac_takedown(jac);
+
+   return ok;
+}
+}
+// END RUN C++
+/*
+------------------------------------------------------------------------------
+{xrst_begin multi_subgraph_jac_time}
+
+Timing Test for Multi-Threaded subgraph_jac_rev Calculation
+###########################################################
+
+Syntax
+******
+
+| *ok* = ``multi_subgraph_jac_time`` (
+| |tab| *time_out* , *test_time* , *num_threads* , *num_row*
+| )
+
+Thread
+******
+It is assumed that this function is called by thread zero in sequential
+mode; i.e., not :ref:`in_parallel<ta_in_parallel-name>` .
+
+time_out
+********
+This argument has prototype
+
+   ``double&`` *time_out*
+
+Its input value of the argument does not matter.
+Upon return it is the number of wall clock seconds
+used by :ref:`multi_subgraph_jac_run-name` .
+
+test_time
+*********
+This argument has prototype
+
+   ``double`` *test_time*
+
+and is the minimum amount of wall clock time that the test should take.
+The number of repeats for the test will be increased until this time
+is reached.
+The reported *time_out* is the total wall clock time divided by the
+number of repeats.
+
+num_threads
+***********
+This argument has prototype
+
+   ``size_t`` *num_threads*
+
+It specifies the number of threads that are available for this test.
+If it is zero, the test is run without the multi-threading environment and
+
+   1 == ``thread_alloc::num_threads`` ()
+
+If it is non-zero, the test is run with the multi-threading and
+
+   *num_threads* = ``thread_alloc::num_threads`` ()
+
+num_row
+*******
+This specifies the number of rows in the Jacobian; i.e.,
+the value of :math:`n` in the
+:ref:`multi_subgraph_jac_common@Function` .
+It must be greater than or equal two.
+
+ok
+**
+The return value has prototype
+
+   ``bool`` *ok*
+
+If it is true,
+``multi_subgraph_jac_time`` passed the correctness test and
+did not detect an error.
+Otherwise it is false.
+
+{xrst_end multi_subgraph_jac_time}
+*/
+
+// BEGIN TIME C++
+namespace {
+   // point at which we are computing the Jacobian
+   vector<double> x_;
+
+   // Jacobian values
+   vector<double> jac_;
+   //
+   void test_once(void)
+   {  bool ok = multi_subgraph_jac_run(x_, jac_);
+      if( ! ok )
+      {  std::cerr << "multi_subgraph_jac_run: error" << std::endl;
+         exit(1);
+      }
+      return;
+   }
+   //
+   void test_repeat(size_t repeat)
+   {  size_t i;
+      for(i = 0; i < repeat; i++)
+         test_once();
+      return;
+   }
+}
+// This is the only routine that is accessible outside of this file
+bool multi_subgraph_jac_time(
+   double& time_out    ,
+   double  test_time   ,
+   size_t  num_threads ,
+   size_t  num_row     )
+{  bool ok = num_row >= 2;
+   //
+   size_t initial_inuse = thread_alloc::inuse(0);
+
+   // number of threads, zero for no multi-threading
+   num_threads_ = num_threads;
+
+   // point at which we are computing the Jacobian
+   size_t n = num_row;
+   x_.resize(n);
+   for(size_t j = 0; j < n; ++j)
+      x_[j] = double(j + 1) / double(n);
+
+   // create fun_ in sequential mode
+   {  vector<a_double> ax(n), ay(n);
+      for(size_t j = 0; j < n; ++j)
+         ax[j] = x_[j];
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < n; ++i)
+         ay[i] = ax[i] * ax[(i + 1) % n] + sin( ax[i] );
+      fun_ = new CppAD::ADFun<double>(ax, ay);
+   }
+
+   // create team of threads
+   ok &= thread_alloc::in_parallel() == false;
+   if( num_threads > 0 )
+   {  team_create(num_threads);
+      ok &= num_threads == thread_alloc::num_threads();
+   }
+   else
+   {  ok &= 1 == thread_alloc::num_threads();
+   }
+
+   // run the test case and set the time return value
+   time_out = CppAD::time_test(test_repeat, test_time);
+
+   // destroy team of threads
+   if( num_threads > 0 )
+      team_destroy();
+   ok &= thread_alloc::in_parallel() == false;
+
+   // must delete fun_ in sequential mode
+   delete fun_;
+   fun_ = nullptr;
+
+   // correctness check
+   ok &= jac_.size() == 2 * n;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   for(size_t i = 0; i < n; i++)
+   {  double xi   = x_[i];
+      double xip1 = x_[(i + 1) % n];
+      ok &= CppAD::NearEqual(jac_[2 * i], xip1 + std::cos(xi), eps99, eps99);
+      ok &= CppAD::NearEqual(jac_[2 * i + 1], xi, eps99, eps99);
+   }
+   //
+   // free memory in CppAD vectors that are still in scope
+   x_.clear();
+   jac_.clear();
+   //
+   // check that no static variables in this file are holding onto memory
+   ok &= initial_inuse == thread_alloc::inuse(0);
+   //
+   return ok;
+}
+// END TIME C++
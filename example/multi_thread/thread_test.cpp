@@ -57,6 +57,7 @@ you can execute the following commands:
 | ./ *program* ``atomic_three`` *test_time* *max_threads* *num_solve*
 | ./ *program* ``chkpoint_one`` *test_time* *max_threads* *num_solve*
 | ./ *program* ``chkpoint_two`` *test_time* *max_threads* *num_solve*
+| ./ *program* ``subgraph_jac`` *test_time* *max_threads* *num_row*
 | ./ *program* ``multi_newton`` *test_time* *max_threads*  \\
 | |tab| *num_zero* *num_sub* *num_sum* *use_ad*
 
@@ -76,6 +77,7 @@ as the *test_case* below.
    example/multi_thread/multi_atomic_three.xrst
    example/multi_thread/multi_chkpoint_two.xrst
    example/multi_thread/multi_newton.xrst
+   example/multi_thread/multi_subgraph_jac.xrst
    example/multi_thread/team_thread.hpp
 }
 
@@ -171,6 +173,28 @@ The command line argument *num_solve*
 is an integer specifying the number of solves; see
 :ref:`multi_atomic_two_time@num_solve` in ``multi_atomic_two_time`` .
 
+inuse_all
+=========
+The ``chkpoint_two`` test case also outputs the vector *inuse_all* .
+For each number of threads, it is the memory used by the
+checkpoint function for the threads other than thread zero; see
+:ref:`multi_chkpoint_two_time@inuse_out` .
+
+{xrst_comment -------------------------------------------------------------- }
+
+subgraph_jac
+************
+The *test_case* ``subgraph_jac`` runs the
+:ref:`multi_subgraph_jac.cpp-name` example.
+This preforms a timing test for computing the rows of a sparse Jacobian,
+using :ref:`subgraph_jac_thread-name` and a team of threads.
+
+num_row
+=======
+The command line argument *num_row*
+is an integer greater than or equal two and has the same meaning as in
+:ref:`multi_subgraph_jac_time<multi_subgraph_jac_time@num_row>` .
+
 {xrst_comment -------------------------------------------------------------- }
 
 multi_newton
@@ -242,6 +266,7 @@ Source
 # include "multi_chkpoint_one.hpp"
 # include "multi_chkpoint_two.hpp"
 # include "multi_newton.hpp"
+# include "multi_subgraph_jac.hpp"
 
 extern bool a11c(void);
 extern bool get_started(void);
@@ -287,6 +312,7 @@ int main(int argc, char *argv[])
    "./<program> atomic_three test_time max_threads num_solve\n"
    "./<program> chkpoint_one test_time max_threads num_solve\n"
    "./<program> chkpoint_two test_time max_threads num_solve\n"
+   "./<program> subgraph_jac test_time max_threads num_row\n"
    "./<program> multi_newton test_time max_threads \\\n"
    "   num_zero num_sub num_sum use_ad\\\n"
    "where <program> is example_multi_thread_<threading>\n"
@@ -330,6 +356,7 @@ int main(int argc, char *argv[])
    bool run_atomic_three = std::strcmp(test_name, "atomic_three")     == 0;
    bool run_chkpoint_one = std::strcmp(test_name, "chkpoint_one")     == 0;
    bool run_chkpoint_two = std::strcmp(test_name, "chkpoint_two")     == 0;
+   bool run_subgraph_jac = std::strcmp(test_name, "subgraph_jac")     == 0;
    bool run_multi_newton = std::strcmp(test_name, "multi_newton")     == 0;
    if( run_a11c || run_get_started || run_team_example )
       ok = (argc == 2);
@@ -337,7 +364,8 @@ int main(int argc, char *argv[])
    || run_atomic_two
    || run_atomic_three
    || run_chkpoint_one
-   || run_chkpoint_two )
+   || run_chkpoint_two
+   || run_subgraph_jac )
       ok = (argc == 5);
    else if( run_multi_newton )
       ok = (argc == 8);
@@ -378,6 +406,7 @@ int main(int argc, char *argv[])
 
    size_t mega_sum  = 0; // assignment to avoid compiler warning
    size_t num_solve = 0;
+   size_t num_row   = 0;
    if( run_harmonic )
    {  // mega_sum
       mega_sum = arg2size_t( *++argv, 1,
@@ -393,6 +422,12 @@ int main(int argc, char *argv[])
          "run: num_solve is less than one"
       );
    }
+   else if( run_subgraph_jac )
+   {  // num_row
+      num_row = arg2size_t( *++argv, 2,
+         "run: num_row is less than two"
+      );
+   }
    else
    {  ok &= run_multi_newton;
       if( ! ok )
@@ -429,10 +464,13 @@ int main(int argc, char *argv[])
    }
 
    // run the test for each number of threads
+   // (use std::vector so it does not hold thread_alloc memory)
+   std::vector<size_t> inuse_all(max_threads + 1);
    cout << "time_all  = [" << endl;
    for(size_t num_threads = 0; num_threads <= max_threads; num_threads++)
    {  double time_out;
       bool this_ok;
+      inuse_all[num_threads] = 0;
 
       // run the requested test
       if( run_harmonic ) this_ok = harmonic_time(
@@ -448,7 +486,10 @@ int main(int argc, char *argv[])
          time_out, test_time, num_threads, num_solve
       );
       else if( run_chkpoint_two ) this_ok = multi_chkpoint_two_time(
-         time_out, test_time, num_threads, num_solve
+         time_out, inuse_all[num_threads], test_time, num_threads, num_solve
+      );
+      else if( run_subgraph_jac ) this_ok = multi_subgraph_jac_time(
+         time_out, test_time, num_threads, num_row
       );
       else
       {  assert( run_multi_newton);
@@ -477,6 +518,17 @@ int main(int argc, char *argv[])
       ok &= this_ok;
    }
    cout << "];" << endl;
+   if( run_chkpoint_two )
+   {  cout << "inuse_all = [" << endl;
+      for(size_t num_threads = 0; num_threads <= max_threads; num_threads++)
+      {  cout << std::setw(20) << inuse_all[num_threads] << " % ";
+         if( num_threads == 0 )
+            cout << "no threading" << endl;
+         else
+            cout << num_threads << " threads" << endl;
+      }
+      cout << "];" << endl;
+   }
    //
    if( thread_alloc::free_all() )
       cout << "free_all      = true;"  << endl;
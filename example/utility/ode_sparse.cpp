@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin ode_sparse.cpp}
+
+Rosen34 and OdeGear With Sparse Jacobians: Example and Test
+###########################################################
+
+ODE
+***
+This example uses the reaction diffusion equation
+
+.. math::
+
+   x_i^\prime (t) =
+   d ( x_{i-1} - 2 x_i + x_{i+1} ) + x_i ( 1 - x_i )
+
+for :math:`i = 0 , \ldots , n-1` where :math:`x_{-1} = x_n = 0` .
+The Jacobian of the right hand side is tri-diagonal.
+
+Fun
+***
+The ``Fun`` class records the right hand side as an
+:ref:`ADFun-name` object and computes the sparse Jacobian using
+:ref:`sparse_jac_for<sparse_jac-name>` .
+The coloring in its ``sparse_jac_work`` object is computed once
+and reused for every Jacobian.
+It also computes the dense Jacobian so that the results can be
+compared with the dense versions of :ref:`Rosen34-name` and
+:ref:`OdeGear-name` .
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end ode_sparse.cpp}
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+namespace {
+   typedef CppAD::vector<double>                 d_vector;
+   typedef CppAD::vector<size_t>                 s_vector;
+   typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+   //
+   class Fun {
+   private:
+      CppAD::ADFun<double>        fun_;
+      CppAD::sparse_rc<s_vector>  pattern_;
+      CppAD::sparse_jac_work      work_;
+   public:
+      // number of Jacobian evaluations
+      size_t n_jac;
+      //
+      // constructor
+      Fun(size_t n, double d) : n_jac(0)
+      {  using CppAD::AD;
+         CppAD::vector< AD<double> > ax(n), af(n);
+         for(size_t i = 0; i < n; ++i)
+            ax[i] = 0.0;
+         CppAD::Independent(ax);
+         for(size_t i = 0; i < n; ++i)
+         {  af[i] = ax[i] * (1.0 - ax[i]) - 2.0 * d * ax[i];
+            if( 0 < i )
+               af[i] += d * ax[i-1];
+            if( i + 1 < n )
+               af[i] += d * ax[i+1];
+         }
+         fun_.Dependent(ax, af);
+         //
+         // pattern_
+         CppAD::sparse_rc<s_vector> pattern_in(n, n, n);
+         for(size_t i = 0; i < n; ++i)
+            pattern_in.set(i, i, i);
+         fun_.for_jac_sparsity(pattern_in, false, false, false, pattern_);
+      }
+      // f(t, x)
+      void Ode(const double& t, const d_vector& x, d_vector& f)
+      {  f = fun_.Forward(0, x); }
+      //
+      // f_t (t, x)
+      void Ode_ind(const double& t, const d_vector& x, d_vector& f_t)
+      {  for(size_t i = 0; i < size_t( x.size() ); ++i)
+            f_t[i] = 0.0;
+      }
+      // dense f_x (t, x)
+      void Ode_dep(const double& t, const d_vector& x, d_vector& f_x)
+      {  ++n_jac;
+         f_x = fun_.Jacobian(x);
+      }
+      // sparse f_x (t, x)
+      void Ode_dep(const double& t, const d_vector& x, sparse_matrix& f_x)
+      {  ++n_jac;
+         if( f_x.nr() == 0 )
+            f_x = sparse_matrix(pattern_);
+         size_t group_max = 1;
+         fun_.sparse_jac_for(group_max, x, f_x, pattern_, "cppad", work_);
+      }
+   };
+}
+
+bool ode_sparse(void)
+{  bool ok = true;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // n, d, xi
+   size_t n = 20;
+   double d = 50.0;
+   d_vector xi(n);
+   for(size_t i = 0; i < n; ++i)
+      xi[i] = double(i + 1) / double(n + 1);
+   //
+   // ti, tf, M
+   double ti = 0.0;
+   double tf = 1.0;
+   size_t M  = 10;
+   //
+   // Rosen34: dense and sparse Jacobians give the same solution
+   Fun F(n, d);
+   CppAD::ode_sparse_work<s_vector, d_vector> work;
+   d_vector e_dense(n), e_sparse(n);
+   d_vector x_dense  = CppAD::Rosen34(F, M, ti, tf, xi, e_dense);
+   d_vector x_sparse = CppAD::Rosen34(F, M, ti, tf, xi, e_sparse, work);
+   for(size_t i = 0; i < n; ++i)
+   {  ok &= NearEqual(x_dense[i], x_sparse[i], eps99, eps99);
+      ok &= NearEqual(e_dense[i], e_sparse[i], eps99, eps99);
+   }
+   //
+   // OdeGear: use m = 1, 2, 2, ... for the first, second, ... steps
+   size_t m_max = 2;
+   double h     = (tf - ti) / double(M);
+   size_t n_reuse = 3;
+   d_vector x_gear[3];
+   size_t   n_jac[3];
+   for(size_t method = 0; method < 3; ++method)
+   {  // method 0: dense, method 1: sparse, method 2: sparse with reuse
+      work.clear();
+      work.reuse = 1;
+      if( method == 2 )
+         work.reuse = n_reuse;
+      F.n_jac = 0;
+      //
+      d_vector T(m_max + 1), X( (m_max + 1) * n ), e(n);
+      d_vector x_previous( m_max * n );
+      for(size_t i = 0; i < n; ++i)
+         x_previous[i] = xi[i];
+      for(size_t step = 1; step <= M; ++step)
+      {  size_t m = std::min(step, m_max);
+         for(size_t j = 0; j <= m; ++j)
+            T[j] = ti + double(step + j - m) * h;
+         for(size_t ell = 0; ell < m * n; ++ell)
+            X[ell] = x_previous[ell];
+         if( method == 0 )
+            CppAD::OdeGear(F, m, n, T, X, e);
+         else
+            CppAD::OdeGear(F, m, n, T, X, e, work);
+         //
+         // x_previous: last m_max values of x
+         size_t m_next = std::min(step + 1, m_max);
+         for(size_t ell = 0; ell < m_next * n; ++ell)
+            x_previous[ell] = X[ (m + 1 - m_next) * n + ell ];
+      }
+      x_gear[method].resize(n);
+      for(size_t i = 0; i < n; ++i)
+         x_gear[method][i] = X[m_max * n + i];
+      n_jac[method] = F.n_jac;
+   }
+   //
+   // dense and sparse Jacobians give the same solution
+   for(size_t i = 0; i < n; ++i)
+      ok &= NearEqual(x_gear[0][i], x_gear[1][i], 1e-10, 1e-10);
+   ok &= n_jac[0] == M;
+   ok &= n_jac[1] == M;
+   //
+   // The modified Newton method evaluates the Jacobian at steps 1, 4, 7, 10.
+   // Step 2 recomputes the factorization, using the Jacobian from step 1,
+   // because the order, and hence alpha[m], changes.
+   // OdeGear uses a fixed number of Newton iterations, so the solution
+   // changes by an amount that is small relative to the truncation error.
+   ok &= n_jac[2] == 4;
+   for(size_t i = 0; i < n; ++i)
+      ok &= NearEqual(x_gear[1][i], x_gear[2][i], 1e-4, 1e-4);
+   //
+   // compare with the Rosen34 solution
+   for(size_t i = 0; i < n; ++i)
+      ok &= NearEqual(x_gear[1][i], x_sparse[i], 1e-2, 1e-2);
+   //
+   return ok;
+}
+// END C++
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin runge_45_batch.cpp}
+
+Runge45Batch: Example and Test
+##############################
+
+ODE
+***
+This example solves the ODE
+
+.. math::
+
+   \frac{d}{dt} \left( \begin{array}{c}
+      x_0 \\ x_1 \\ x_2
+   \end{array} \right)
+   =
+   \left( \begin{array}{c}
+      x_1 \\ - x_2 x_0 \\ 0
+   \end{array} \right)
+
+for ten initial values
+:math:`x_0 (0) = 1` , :math:`x_1 (0) = 0` , :math:`x_2 (0) = p_k` .
+The component :math:`x_2 (t) = p_k` is a parameter that is different
+for each trajectory, and the solution is
+:math:`x_0 (t) = \cos( \sqrt{p_k} t )` .
+
+valvector_fun
+*************
+The ``valvector_fun`` class tapes the right hand side of the ODE once
+using ``AD<valvector>`` .
+Its ``Ode`` function evaluates the tape for all the trajectories
+in a block using one ``Forward`` call.
+
+Check
+*****
+The solution for each trajectory is compared with the solution
+computed by :ref:`OdeErrControl-name` using :ref:`Runge45-name`
+(one trajectory at a time).
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end runge_45_batch.cpp}
+*/
+// BEGIN C++
+// valvector must be included before cppad.hpp
+# include <cppad/example/valvector/class.hpp>
+# include <cppad/cppad.hpp>
+# include <cppad/utility/runge_45_batch.hpp>
+
+namespace {
+   typedef CppAD::vector<double> d_vector;
+   typedef CppAD::vector<size_t> s_vector;
+   //
+   // n: number of components in the ODE
+   const size_t n = 3;
+   //
+   // valvector_fun
+   class valvector_fun {
+   private:
+      // g(t, x) = F(t, x)
+      CppAD::ADFun<valvector> g_;
+   public:
+      valvector_fun(void)
+      {  typedef CppAD::AD<valvector> ad_valvector;
+         CPPAD_TESTVECTOR( ad_valvector ) atx(n + 1), af(n);
+         for(size_t j = 0; j <= n; ++j)
+            atx[j] = valvector(0.0);
+         CppAD::Independent(atx);
+         af[0] = atx[2];
+         af[1] = - atx[3] * atx[1];
+         af[2] = valvector(0.0);
+         g_.Dependent(atx, af);
+      }
+      void Ode(const d_vector& t, const d_vector& x, d_vector& f)
+      {  size_t n_b = t.size();
+         //
+         // tx: time followed by the components of x
+         CPPAD_TESTVECTOR( valvector ) tx(n + 1), vf(n);
+         tx[0].resize(n_b);
+         for(size_t k = 0; k < n_b; ++k)
+            tx[0][k] = t[k];
+         for(size_t i = 0; i < n; ++i)
+         {  tx[i + 1].resize(n_b);
+            for(size_t k = 0; k < n_b; ++k)
+               tx[i + 1][k] = x[i * n_b + k];
+         }
+         //
+         // f
+         vf = g_.Forward(0, tx);
+         for(size_t i = 0; i < n; ++i)
+         {  // a constant dependent variable has size one
+            size_t size_i = vf[i].size();
+            for(size_t k = 0; k < n_b; ++k)
+               f[i * n_b + k] = vf[i][ k % size_i ];
+         }
+      }
+   };
+   //
+   // double_fun
+   class double_fun {
+   public:
+      void Ode(const double& t, const d_vector& x, d_vector& f)
+      {  f[0] = x[1];
+         f[1] = - x[2] * x[0];
+         f[2] = 0.0;
+      }
+   };
+   //
+   // method
+   class method {
+   public:
+      double_fun F;
+      void step(
+         double ta, double tb, d_vector& xa, d_vector& xb, d_vector& eb)
+      {  xb = CppAD::Runge45(F, 1, ta, tb, xa, eb);
+      }
+      size_t order(void)
+      {  return 4; }
+   };
+}
+
+bool runge_45_batch(void)
+{  bool ok = true;
+   using CppAD::NearEqual;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   //
+   // n_traj, xi
+   size_t n_traj = 10;
+   d_vector xi(n * n_traj);
+   for(size_t k = 0; k < n_traj; ++k)
+   {  xi[0 * n_traj + k] = 1.0;
+      xi[1 * n_traj + k] = 0.0;
+      xi[2 * n_traj + k] = double(k + 1);
+   }
+   //
+   // ti, tf, smin, smax, scur, eabs, erel
+   double ti   = 0.0;
+   double tf   = 2.0;
+   double smin = 1e-4;
+   double smax = 1.0;
+   double erel = 0.0;
+   d_vector scur(n_traj), eabs(n);
+   for(size_t k = 0; k < n_traj; ++k)
+      scur[k] = 0.5;
+   for(size_t i = 0; i < n; ++i)
+      eabs[i] = 1e-6;
+   //
+   // xf, ef, nstep
+   // use blocks of size 4, 4 and 2 trajectories
+   valvector_fun F;
+   size_t   n_block  = 4;
+   size_t   n_thread = 1;
+   d_vector ef(n * n_traj);
+   s_vector nstep(n_traj);
+   d_vector xf = CppAD::Runge45Batch(F, n_traj, ti, tf, xi,
+      smin, smax, scur, eabs, erel, ef, nstep, n_block, n_thread
+   );
+   //
+   // check each trajectory
+   method M;
+   d_vector xi_k(n), ef_k(n), maxabs_k(n);
+   for(size_t k = 0; k < n_traj; ++k)
+   {  for(size_t i = 0; i < n; ++i)
+         xi_k[i] = xi[i * n_traj + k];
+      double scur_k = 0.5;
+      size_t nstep_k;
+      d_vector xf_k = CppAD::OdeErrControl(M, ti, tf, xi_k,
+         smin, smax, scur_k, eabs, erel, ef_k, maxabs_k, nstep_k
+      );
+      //
+      // same as solving one trajectory at a time
+      ok &= nstep[k] == nstep_k;
+      ok &= NearEqual(scur[k], scur_k, eps99, eps99);
+      for(size_t i = 0; i < n; ++i)
+      {  ok &= NearEqual(xf[i * n_traj + k], xf_k[i], eps99, eps99);
+         ok &= NearEqual(ef[i * n_traj + k], ef_k[i], eps99, eps99);
+      }
+      //
+      // compare with the solution of the ODE
+      double p     = double(k + 1);
+      double check = std::cos( std::sqrt(p) * tf );
+      ok &= NearEqual(xf[0 * n_traj + k], check, 1e-4, 1e-4);
+   }
+   //
+   // larger values of p require more steps
+   ok &= nstep[0] < nstep[n_traj - 1];
+   //
+   return ok;
+}
+// END C++
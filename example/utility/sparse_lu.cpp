@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+/*
+{xrst_begin sparse_lu.cpp}
+
+sparse_lu: Example and Test
+###########################
+This example factors and solves with two matrices that have the same
+sparsity pattern (using one symbolic analysis).
+It then records the solution of :math:`A x = b` ,
+as a function of the values in :math:`A` , using ``AD<double>`` .
+
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end sparse_lu.cpp}
+*/
+
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include <cppad/utility/sparse_lu.hpp>
+
+namespace {
+   // A is an arrowhead matrix: diagonal plus the first row and column
+   template <class Vector>
+   CppAD::sparse_rcv<CppAD::vector<size_t>, Vector> arrowhead(
+      size_t n, const Vector& diag, const Vector& first_row,
+      const Vector& first_col )
+   {  typedef CppAD::vector<size_t> SizeVector;
+      size_t nnz = n + 2 * (n - 1);
+      CppAD::sparse_rc<SizeVector> pattern(n, n, nnz);
+      size_t k = 0;
+      for(size_t i = 0; i < n; ++i)
+         pattern.set(k++, i, i);
+      for(size_t j = 1; j < n; ++j)
+         pattern.set(k++, 0, j);
+      for(size_t i = 1; i < n; ++i)
+         pattern.set(k++, i, 0);
+      CppAD::sparse_rcv<SizeVector, Vector> matrix(pattern);
+      k = 0;
+      for(size_t i = 0; i < n; ++i)
+         matrix.set(k++, diag[i]);
+      for(size_t j = 0; j < n - 1; ++j)
+         matrix.set(k++, first_row[j]);
+      for(size_t i = 0; i < n - 1; ++i)
+         matrix.set(k++, first_col[i]);
+      return matrix;
+   }
+   // check that A x = b
+   template <class Vector>
+   bool check_solution(
+      const CppAD::sparse_rcv<CppAD::vector<size_t>, Vector>& matrix ,
+      const Vector& x                                               ,
+      const Vector& b                                               )
+   {  bool ok  = true;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      size_t n = x.size();
+      Vector Ax(n);
+      for(size_t i = 0; i < n; ++i)
+         Ax[i] = 0.0;
+      for(size_t k = 0; k < matrix.nnz(); ++k)
+         Ax[ matrix.row()[k] ] += matrix.val()[k] * x[ matrix.col()[k] ];
+      for(size_t i = 0; i < n; ++i)
+         ok &= CppAD::NearEqual(Ax[i], b[i], eps99, eps99);
+      return ok;
+   }
+}
+
+bool sparse_lu(void)
+{  bool ok = true;
+   using CppAD::AD;
+   typedef CppAD::vector<double>       d_vector;
+   typedef CppAD::vector< AD<double> > a_vector;
+   //
+   // diag, first_row, first_col, b
+   size_t n = 6;
+   d_vector diag(n), first_row(n-1), first_col(n-1), b(n);
+   for(size_t i = 0; i < n; ++i)
+   {  diag[i] = double(n + i);
+      b[i]    = double(i + 1);
+   }
+   for(size_t j = 0; j < n - 1; ++j)
+   {  first_row[j] = double(j + 1);
+      first_col[j] = - double(j + 2);
+   }
+   //
+   // matrix
+   CppAD::sparse_rcv<CppAD::vector<size_t>, d_vector> matrix =
+      arrowhead(n, diag, first_row, first_col);
+   //
+   // lu
+   // With the natural ordering the first pivot fills in all of L + U.
+   // The minimum degree ordering eliminates the first row and column last
+   // so there is no fill in.
+   CppAD::sparse_lu<double> lu;
+   lu.analyze(matrix.pat(), "natural");
+   ok &= lu.nnz() == n * n;
+   lu.analyze(matrix.pat(), "minimum_degree");
+   ok &= lu.n() == n;
+   ok &= lu.nnz() == matrix.nnz();
+   //
+   // solve A x = b
+   d_vector x(n);
+   ok &= lu.factor(matrix);
+   lu.solve(b, x);
+   ok &= check_solution(matrix, x, b);
+   //
+   // new values for A with the same sparsity pattern (no new analysis)
+   for(size_t k = 0; k < matrix.nnz(); ++k)
+      matrix.set(k, matrix.val()[k] + 1.0);
+   ok &= lu.factor(matrix);
+   lu.solve(b, x);
+   ok &= check_solution(matrix, x, b);
+   //
+   // a zero pivot
+   d_vector zero_diag(n);
+   for(size_t i = 0; i < n; ++i)
+      zero_diag[i] = 0.0;
+   ok &= ! lu.factor( arrowhead(n, zero_diag, first_row, first_col) );
+   //
+   // record x = f(diag), the solution as a function of the diagonal of A
+   a_vector a_diag(n), a_first_row(n-1), a_first_col(n-1), a_b(n), a_x(n);
+   for(size_t i = 0; i < n; ++i)
+   {  a_diag[i] = diag[i];
+      a_b[i]    = b[i];
+   }
+   for(size_t j = 0; j < n - 1; ++j)
+   {  a_first_row[j] = first_row[j];
+      a_first_col[j] = first_col[j];
+   }
+   CppAD::Independent(a_diag);
+   CppAD::sparse_rcv<CppAD::vector<size_t>, a_vector> a_matrix =
+      arrowhead(n, a_diag, a_first_row, a_first_col);
+   CppAD::sparse_lu< AD<double> > a_lu;
+   a_lu.analyze(a_matrix.pat(), "minimum_degree");
+   ok &= a_lu.factor(a_matrix);
+   a_lu.solve(a_b, a_x);
+   CppAD::ADFun<double> f(a_diag, a_x);
+   //
+   // evaluate f at a different diagonal and check it solves A x = b
+   for(size_t i = 0; i < n; ++i)
+      diag[i] = double(2 * n - i);
+   x = f.Forward(0, diag);
+   matrix = arrowhead(n, diag, first_row, first_col);
+   ok &= check_solution(matrix, x, b);
+   //
+   // derivative of x w.r.t. diag[0]: A dx = - e_0 x[0]
+   d_vector dx(n), ddiag(n), rhs(n);
+   for(size_t i = 0; i < n; ++i)
+   {  ddiag[i] = 0.0;
+      rhs[i]   = 0.0;
+   }
+   ddiag[0] = 1.0;
+   rhs[0]   = - x[0];
+   dx = f.Forward(1, ddiag);
+   ok &= check_solution(matrix, dx, rhs);
+   //
+   return ok;
+}
+// END C++
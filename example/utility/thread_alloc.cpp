@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -48,6 +48,9 @@ bool raw_allocate(void)
       std::vector<void*> v_ptr(n_inner);
       // cap_bytes will be set by get_memory
       size_t cap_bytes = 0; // set here to avoid MSC warning
+      // start measuring the maximum memory inuse for this iteration
+      thread = thread_alloc::thread_num();
+      thread_alloc::reset_inuse_max(thread);
       for(size_t j = 0; j < n_inner; j++)
       {  // allocate enough memory for min_size_t size_t objects
          v_ptr[j]    = thread_alloc::get_memory(min_bytes, cap_bytes);
@@ -73,6 +76,9 @@ bool raw_allocate(void)
       // and none are in use
       ok &= thread_alloc::inuse(thread) == static_inuse;
       ok &= thread_alloc::available(thread) == n_inner * cap_bytes;
+      // the maximum inuse was reached before the memory was returned
+      ok &= thread_alloc::inuse_max(thread) ==
+         n_inner * cap_bytes + static_inuse;
    }
    thread_alloc::free_available(thread);
 
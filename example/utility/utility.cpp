@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin utility.cpp}
@@ -55,12 +55,15 @@ extern bool SimpleVector(void);
 extern bool dll_lib(void);
 extern bool index_sort(void);
 extern bool nan(void);
+extern bool ode_sparse(void);
 extern bool poly(void);
 extern bool pow_int(void);
 extern bool rosen_34(void);
 extern bool runge_45(void);
 extern bool runge_45_1(void);
+extern bool runge_45_batch(void);
 extern bool set_union(void);
+extern bool sparse_lu(void);
 extern bool sparse_rc(void);
 extern bool sparse_rcv(void);
 extern bool thread_alloc(void);
@@ -94,12 +97,15 @@ int main(void)
    Run( SimpleVector,           "SimpleVector" );
    Run( index_sort,             "index_sort" );
    Run( nan,                    "nan" );
+   Run( ode_sparse,             "ode_sparse" );
    Run( poly,                   "poly" );
    Run( pow_int,                "pow_int" );
    Run( rosen_34,               "rosen_34" );
    Run( runge_45,               "runge_45" );
    Run( runge_45_1,             "runge_45_1" );
+   Run( runge_45_batch,         "runge_45_batch" );
    Run( set_union,              "set_union" );
+   Run( sparse_lu,              "sparse_lu" );
    Run( sparse_rc,              "sparse_rc" );
    Run( sparse_rcv,             "sparse_rcv" );
    Run( thread_alloc,           "thread_alloc" );
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_AD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 // simple AD operations that must be defined for AD as well as base class
@@ -252,6 +252,9 @@ public:
    // abort current AD<Base> recording
    static void        abort_recording(void);
 
+   // reserve memory for the current AD<Base> recording
+   static void        record_reserve(size_t n_op, size_t n_arg);
+
    // set the maximum number of OpenMP threads (deprecated)
    static void        omp_max_thread(size_t number);
 
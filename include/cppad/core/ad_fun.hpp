@@ -2,7 +2,7 @@
 # define CPPAD_CORE_AD_FUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin ADFun}
@@ -25,6 +25,8 @@ Contents
    include/cppad/core/optimize.hpp
    include/cppad/core/fun_check.hpp
    include/cppad/core/check_for_nan.hpp
+   include/cppad/core/op_profile.hpp
+   include/cppad/core/memory_info.hpp
    include/cppad/core/to_csrc.hpp
 }
 
@@ -54,6 +56,9 @@ template <class Base, class RecBase>
 class ADFun {
    // ADFun<Base> must be a friend of ADFun< AD<Base> > for base2ad to work.
    template <class Base2, class RecBase2> friend class ADFun;
+   //
+   // chkpoint_two evaluates a shared ADFun using its own work space.
+   template <class Base2> friend class chkpoint_two;
 private:
    // ------------------------------------------------------------
    // Private member variables
@@ -94,6 +99,9 @@ private:
    /// number of directions stored in taylor_
    size_t num_direction_taylor_;
 
+   /// maximum number of bytes retained in taylor_ after a forward pass
+   size_t taylor_high_water_;
+
    /// number of variables in the recording (play_)
    size_t num_var_tape_;
 
@@ -146,6 +154,10 @@ private:
    template <class ADvector>
    void Dependent(local::ADTape<Base> *tape, const ADvector &y);
 
+   /// reduce taylor_ memory if it is above taylor_high_water_
+   /// (doxygen in cppad/core/taylor_high_water.hpp)
+   void taylor_high_water_check(void);
+
    // vector of bool version of ForSparseJac
    // (doxygen in cppad/core/for_sparse_jac.hpp)
    template <class SetVector>
@@ -307,6 +319,29 @@ public:
    void to_graph(cpp_graph& graph_obj);
    std::string to_json(void);
    void to_csrc(std::ostream& os, const std::string& type);
+   void to_csrc(
+      std::ostream&                             os       ,
+      const std::string&                        type     ,
+      const std::map<std::string, std::string>& options
+   );
+   void to_csrc(
+      CppAD::vector<std::string>&               csrc_vec ,
+      const std::string&                        type     ,
+      const std::map<std::string, std::string>& options
+   );
+   void to_csrc(
+      std::ostream&       os         ,
+      const std::string&  type       ,
+      const std::string&  derivative
+   );
+   template <class SizeVector>
+   void to_csrc(
+      std::ostream&                os          ,
+      const std::string&           type        ,
+      const std::string&           derivative  ,
+      const sparse_rc<SizeVector>& pattern     ,
+      const std::string&           coloring
+   );
    //
    // value graph routines
    void fun2val( local::val_graph::tape_t<Base>& val_tape );
@@ -340,6 +375,15 @@ public:
    /// get check_for_nan
    bool check_for_nan(void) const;
 
+   /// turn operator profiling on or off
+   void op_profile(bool on);
+
+   /// write operator profile as a table
+   void op_profile_table(std::ostream& os) const;
+
+   /// operator profile as a json string
+   std::string op_profile_json(void) const;
+
    /// assign a new operation sequence
    template <class ADvector>
    void Dependent(const ADvector &x, const ADvector &y);
@@ -395,6 +439,20 @@ public:
       BaseVector&                          dw
    );
 
+   // subgraph_reverse: compute derivative using the specified work space
+   // (doxygen in cppad/core/subgraph_reverse.hpp)
+   template <class Addr, class BaseVector, class SizeVector>
+   void subgraph_reverse_helper(
+      local::subgraph::subgraph_info&      info          ,
+      local::pod_vector<addr_t>&           subgraph      ,
+      local::pod_vector_maybe<Base>&       partial       ,
+      local::play::atom_work<Base>*        atom_work_ptr ,
+      size_t                               q             ,
+      size_t                               ell           ,
+      SizeVector&                          col           ,
+      BaseVector&                          dw
+   ) const;
+
    // subgraph_reverse: compute derivative
    // (doxygen in cppad/core/subgraph_reverse.hpp)
    template <class BaseVector, class SizeVector>
@@ -423,6 +481,15 @@ public:
       sparse_rcv<SizeVector, BaseVector>&  matrix_out
    );
 
+   // subgraph_jac_rev: compute Jacobian rows using the specified work space
+   // (doxygen in cppad/core/subgraph_jac_thread.hpp)
+   template <class BoolVector, class SizeVector, class BaseVector>
+   void subgraph_jac_rev(
+      const BoolVector&                    select_range  ,
+      sparse_rcv<SizeVector, BaseVector>&  matrix_out    ,
+      subgraph_work<Base>&                 work
+   ) const;
+
 
    // compute sparse Jacobian using forward mode
    // (doxygen in cppad/core/sparse_jac.hpp)
@@ -655,6 +722,15 @@ public:
    /// set number of orders and directions currently allocated
    void capacity_order(size_t c, size_t r);
 
+   /// set maximum number of bytes retained for taylor_
+   void taylor_high_water(size_t max_byte);
+
+   /// get maximum number of bytes retained for taylor_
+   size_t taylor_high_water(void) const;
+
+   /// number of bytes allocated for each component of this object
+   fun_memory_info memory_info(void) const;
+
    /// number of variables in conditional expressions that can be skipped
    size_t number_skip(void);
 
@@ -801,6 +877,9 @@ public:
 
    // clear all subgraph information
    void clear_subgraph(void);
+
+   // turn caching of per row subgraphs on or off
+   void subgraph_cache(bool use_cache);
    // ------------------- Deprecated -----------------------------
 
    /// deprecated: assign a new operation sequence
@@ -861,8 +940,11 @@ public:
 # include <cppad/local/sweep/rev_jac.hpp>
 # include <cppad/local/sweep/rev_hes.hpp>
 # include <cppad/local/sweep/for_hes.hpp>
+// chkpoint_two shared tape evaluation uses the sweeps
+# include <cppad/core/chkpoint_two/shared.hpp>
 # include <cppad/core/graph/from_graph.hpp>
 # include <cppad/core/graph/to_graph.hpp>
+# include <cppad/core/graph/merge_graph.hpp>
 
 // user interfaces
 # include <cppad/core/parallel_ad.hpp>
@@ -871,8 +953,12 @@ public:
 # include <cppad/core/fun_construct.hpp>
 # include <cppad/core/base2ad.hpp>
 # include <cppad/core/abort_recording.hpp>
+# include <cppad/core/record_reserve.hpp>
 # include <cppad/core/fun_eval.hpp>
 # include <cppad/core/drivers.hpp>
+# include <cppad/core/revolve.hpp>
+# include <cppad/core/taylor_high_water.hpp>
+# include <cppad/core/memory_info.hpp>
 # include <cppad/core/fun_check.hpp>
 # include <cppad/core/omp_max_thread.hpp>
 # include <cppad/core/optimize.hpp>
@@ -880,6 +966,7 @@ public:
 # include <cppad/core/graph/from_json.hpp>
 # include <cppad/core/graph/to_json.hpp>
 # include <cppad/core/to_csrc.hpp>
+# include <cppad/core/op_profile.hpp>
 
 // 2DO: move to core directory
 # include <cppad/local/val_graph/val_optimize.hpp>
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_AD_VALUED_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -19,6 +19,7 @@ Contents
    include/cppad/core/arithmetic.hpp
    include/cppad/core/standard_math.hpp
    include/cppad/core/cond_exp.hpp
+   include/cppad/core/cond_exp_switch.hpp
    include/cppad/core/discrete/user.xrst
    include/cppad/core/numeric_limits.hpp
    include/cppad/core/atomic/atomic.xrst
@@ -34,6 +35,7 @@ Contents
 # include <cppad/core/standard_math.hpp>
 # include <cppad/core/azmul.hpp>
 # include <cppad/core/cond_exp.hpp>
+# include <cppad/core/cond_exp_switch.hpp>
 # include <cppad/core/discrete/discrete.hpp>
 # include <cppad/core/atomic/four/atomic.hpp>
 # include <cppad/core/atomic/three/atomic.hpp>
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_FOUR_ATOMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_define}
@@ -42,6 +42,12 @@ Callbacks
 | *ok* = *afun* . ``reverse`` ( *call_id* ,
 | |tab| *select_x* , *order_up* , *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
 | )
+| *ok* = *afun* . ``forward_batch`` ( *call_id* ,
+| |tab| *select_y* , *order_low* , *order_up* , *taylor_x* , *taylor_y*
+| )
+| *ok* = *afun* . ``reverse_batch`` ( *call_id* ,
+| |tab| *select_x* , *order_up* , *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
+| )
 | *ok* = *afun* . ``jac_sparsity`` ( *call_id* ,
 | |tab| *dependency* , *ident_zero_x* , *select_x* *select_y* , *pattern_out*
 | )
@@ -112,6 +118,7 @@ Contents
    include/cppad/core/atomic/four/for_type.hpp
    include/cppad/core/atomic/four/forward.hpp
    include/cppad/core/atomic/four/reverse.hpp
+   include/cppad/core/atomic/four/batch.hpp
    include/cppad/core/atomic/four/jac_sparsity.hpp
    include/cppad/core/atomic/four/hes_sparsity.hpp
    include/cppad/core/atomic/four/rev_depend.hpp
@@ -150,6 +157,10 @@ private:
    /// (set by constructor and not changed; i.e., effectively const)
    size_t index_;
    //
+   /// should the sweeps use the batch callbacks for this atomic function
+   /// (set by constructor and not changed; i.e., effectively const)
+   bool batch_;
+   //
    // -----------------------------------------------------
    //
    /// temporary work space used by call member functions, declared here
@@ -165,6 +176,12 @@ private:
       vector< AD<Base> >          ataylor_y;
       //
       vector<bool>                select_y;
+      //
+      // used by the sparsity calculations during a sweep
+      vector<bool>                sparsity_select_x;
+      vector<bool>                sparsity_select_y;
+      sparse_rc< vector<size_t> > pattern_jac;
+      sparse_rc< vector<size_t> > pattern_hes;
    };
    // Use pointers, to avoid false sharing between threads.
    // Not using: vector<work_struct*> work_;
@@ -178,6 +195,11 @@ public:
    // include/cppad/core/atomic/four/devel/devel.xrst
    size_t atomic_index(void) const
    { return index_; }
+   //
+   // batch
+   // Needed by local::sweep::atomic_batch and not documented.
+   bool batch(void) const
+   { return batch_; }
    // =====================================================================
    // In User API
    // =====================================================================
@@ -186,6 +208,7 @@ public:
    // constructors
    atomic_four(void);
    atomic_four(const std::string& name);
+   atomic_four(const std::string& name, bool batch);
 
    // ------------------------------------------------------------------------
    template <class ADVector> void operator()(
@@ -242,6 +265,27 @@ public:
       vector< AD<Base> >&          apartial_x  ,
       const vector< AD<Base> >&    apartial_y
    );
+   // ------------------------------------------------------------------------
+   // forward_batch
+   virtual bool forward_batch(
+      const vector<size_t>&        call_id     ,
+      const vector<bool>&          select_y    ,
+      size_t                       order_low   ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      vector<Base>&                taylor_y
+   );
+   // ------------------------------------------------------------------------
+   // reverse_batch
+   virtual bool reverse_batch(
+      const vector<size_t>&        call_id     ,
+      const vector<bool>&          select_x    ,
+      size_t                       order_up    ,
+      const vector<Base>&          taylor_x    ,
+      const vector<Base>&          taylor_y    ,
+      vector<Base>&                partial_x   ,
+      const vector<Base>&          partial_y
+   );
    // ------------------------------------------------------------
    // jac_sparsity
    virtual bool jac_sparsity(
@@ -426,6 +470,7 @@ public:
 # include <cppad/core/atomic/four/rev_depend.hpp>
 # include <cppad/core/atomic/four/forward.hpp>
 # include <cppad/core/atomic/four/reverse.hpp>
+# include <cppad/core/atomic/four/batch.hpp>
 # include <cppad/core/atomic/four/jac_sparsity.hpp>
 # include <cppad/core/atomic/four/hes_sparsity.hpp>
 
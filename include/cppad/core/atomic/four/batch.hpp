@@ -0,0 +1,170 @@
+# ifndef CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+# define CPPAD_CORE_ATOMIC_FOUR_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_four_batch}
+
+Atomic Function Batched Forward and Reverse Mode
+################################################
+
+Syntax
+******
+| *ok* = *afun* . ``forward_batch`` (
+| |tab| *call_id* , *select_y* , *order_low* , *order_up* , *taylor_x* , *taylor_y*
+| )
+| *ok* = *afun* . ``reverse_batch`` (
+| |tab| *call_id* , *select_x* , *order_up* ,
+| |tab| *taylor_x* , *taylor_y* , *partial_x* , *partial_y*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_FORWARD_BATCH
+   // END_FORWARD_BATCH
+}
+{xrst_literal
+   // BEGIN_REVERSE_BATCH
+   // END_REVERSE_BATCH
+}
+
+Purpose
+*******
+If an atomic function is called many times during the recording of
+a function *f* , each call results in a separate
+:ref:`atomic_four_forward-name` or :ref:`atomic_four_reverse-name`
+callback during *f* . ``Forward`` and *f* . ``Reverse`` .
+These batch callbacks hand the atomic function a group of calls at once,
+so that it can evaluate them using vector operations or an
+optimized library.
+
+Batch
+*****
+A batch is a sequence of calls to *afun* that are next to each other in
+the operation sequence for *f* , have the same number of arguments,
+have the same number of results,
+and where none of the arguments is a result of a previous call in the batch.
+The batch callbacks are only used when
+
+#. The :ref:`atomic_four_ctor@atomic_four@batch` argument to the
+   ``atomic_four`` constructor is true.
+#. The batch has two or more calls.
+#. The calculation is a zero order forward, one direction forward,
+   or a reverse mode calculation for an ``ADFun`` < *Base* > object
+   (not for an ``ADFun`` < ``AD`` < *Base* > , *Base* > object).
+
+Otherwise the single call versions of
+``forward`` and ``reverse`` are used.
+
+Base
+****
+see :ref:`atomic_four_call@Base` .
+
+vector
+******
+is the :ref:`CppAD_vector-name` template class.
+
+n_call
+******
+We use *n_call* for the number of calls in the batch
+(it is greater than one).
+The calls are in the order they appear in the operation sequence.
+
+n, m
+****
+We use *n* ( *m* ) for the number of arguments (results) for each
+of the calls in the batch.
+
+call_id
+*******
+This vector has size *n_call* and
+*call_id* [ *c* ] is the :ref:`atomic_four_call@call_id`
+for the *c*-th call in the batch.
+
+q
+*
+We use *q* = *order_up* + 1 below.
+In the case of ``forward_batch`` , *order_low* and *order_up*
+have the same meaning as for :ref:`atomic_four_forward-name` .
+
+forward_batch
+*************
+The vectors *select_y* , *taylor_x* and *taylor_y* have size
+*n_call* * *m* , *n_call* * *n* * *q* and *n_call* * *m* * *q*
+respectively.
+For each *c* less than *n_call* ,
+the elements with index *c* * *m* + *i* ,
+( *c* * *n* + *j* ) * *q* + *k* , and
+( *c* * *m* + *i* ) * *q* + *k* ,
+have the same meaning as the elements with index
+*i* , *j* * *q* + *k* , and *i* * *q* + *k* in the
+:ref:`atomic_four_forward-name` callback for the *c*-th call.
+
+reverse_batch
+*************
+The vectors *select_x* , *taylor_x* , *taylor_y* ,
+*partial_x* and *partial_y* have size
+*n_call* * *n* , *n_call* * *n* * *q* , *n_call* * *m* * *q* ,
+*n_call* * *n* * *q* , and *n_call* * *m* * *q* respectively.
+For each *c* less than *n_call* ,
+the elements with index *c* * *n* + *j* ,
+( *c* * *n* + *j* ) * *q* + *k* , and
+( *c* * *m* + *i* ) * *q* + *k* ,
+have the same meaning as the elements with index
+*j* , *j* * *q* + *k* , and *i* * *q* + *k* in the
+:ref:`atomic_four_reverse-name` callback for the *c*-th call.
+
+ok
+**
+If *ok* is true, the calculation for all the calls in the batch
+has been completed.
+If it is false, nothing has been computed and
+the single call version ``forward`` (``reverse`` ) is used for each call.
+The default implementation of these callbacks returns false.
+Thus one can implement the batch callback for only the orders that
+matter for speed (for example *order_up* == 0 ).
+
+Example
+*******
+{xrst_toc_hidden
+   example/atomic_four/batch.cpp
+}
+The file :ref:`atomic_four_batch.cpp-name` contains an example and test
+of these callbacks.
+
+{xrst_end atomic_four_batch}
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_FORWARD_BATCH
+template <class Base>
+bool atomic_four<Base>::forward_batch(
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_y    ,
+   size_t                       order_low   ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   vector<Base>&                taylor_y    )
+// END_FORWARD_BATCH
+{  return false; }
+
+// BEGIN_REVERSE_BATCH
+template <class Base>
+bool atomic_four<Base>::reverse_batch(
+   const vector<size_t>&        call_id     ,
+   const vector<bool>&          select_x    ,
+   size_t                       order_up    ,
+   const vector<Base>&          taylor_x    ,
+   const vector<Base>&          taylor_y    ,
+   vector<Base>&                partial_x   ,
+   const vector<Base>&          partial_y   )
+// END_REVERSE_BATCH
+{  return false; }
+
+} // END_CPPAD_NAMESPACE
+# endif
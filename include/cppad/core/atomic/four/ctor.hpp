@@ -2,7 +2,7 @@
 # define CPPAD_CORE_ATOMIC_FOUR_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin atomic_four_ctor}
@@ -18,6 +18,7 @@ Syntax
 | |tab| *atomic_user* ( *ctor_arg_list* ) : ``CppAD::atomic_four<`` *Base* >( *name* )
 | |tab| ...
 | };
+| *atomic_user* ( *ctor_arg_list* ) : ``CppAD::atomic_four<`` *Base* >( *name* , *batch* )
 | *atomic_user afun* ( *ctor_arg_list* )
 
 Prototype
@@ -85,6 +86,16 @@ It is the name for this atomic function and is used for error reporting.
 The suggested value for *name* is *afun* or *atomic_user* ,
 i.e., the name of the corresponding atomic object or class.
 
+batch
+=====
+This ``atomic_four`` constructor argument has the following prototype
+
+   ``bool`` *batch*
+
+If it is true, the sweeps pass groups of calls to *afun* to the
+:ref:`batch callbacks<atomic_four_batch-name>` .
+If it is not present, it is false and the batch callbacks are not used.
+
 Example
 *******
 The following is an example constructor definition taken from
@@ -109,9 +120,15 @@ atomic_four<Base>::atomic_four(void)
 }
 
 // atomic_four(name)
-// BEGIN_PROTOTYPE
 template <class Base>
 atomic_four<Base>::atomic_four(const std::string& name )
+: atomic_four(name, false)
+{ }
+
+// atomic_four(name, batch)
+// BEGIN_PROTOTYPE
+template <class Base>
+atomic_four<Base>::atomic_four(const std::string& name, bool batch)
 // END_PROTOTYPE
 {  CPPAD_ASSERT_KNOWN(
       ! thread_alloc::in_parallel() ,
@@ -128,6 +145,9 @@ atomic_four<Base>::atomic_four(const std::string& name )
       set_null, index, type, &copy_name, copy_this
    );
    //
+   // batch_
+   batch_ = batch;
+   //
    // work_
    for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
       work_[thread] = nullptr;
@@ -123,22 +123,29 @@ bool atomic_four<Base>::for_hes_sparsity(
    size_t n      = x_index.size();
    size_t m      = y_index.size();
    //
+   // work space for this thread
+   size_t thread = thread_alloc::thread_num();
+   allocate_work(thread);
+   vector<bool>& select_x( work_[thread]->sparsity_select_x );
+   vector<bool>& select_y( work_[thread]->sparsity_select_y );
+   sparse_rc< vector<size_t> >& pattern_out( work_[thread]->pattern_jac );
+   select_x.resize(n);
+   select_y.resize(m);
+   pattern_out.resize(0, 0, 0);
+   //
    // select_x
-   vector<bool> select_x(n);
    for(size_t j = 0; j < n; j++)
    {  // check if should compute pattern w.r.t x[j]
       select_x[j] = for_sparsity.number_elements(np1 + x_index[j]) > 0;
    }
    //
    // bool select_y
-   vector<bool> select_y(m);
    for(size_t i = 0; i < m; i++)
    {  // check if we should include y[i]
       select_y[i] = rev_jac_pattern.number_elements(y_index[i]) > 0;
    }
    // ------------------------------------------------------------------------
    // call user's version of atomic function for Jacobian
-   sparse_rc< vector<size_t> > pattern_out;
    bool dependency = false;
    bool ok = jac_sparsity( call_id,
       dependency, ident_zero_x, select_x, select_y, pattern_out
@@ -294,19 +301,28 @@ bool atomic_four<Base>::rev_hes_sparsity(
    size_t n      = x_index.size();
    size_t m      = y_index.size();
    //
+   // work space for this thread
+   size_t thread = thread_alloc::thread_num();
+   allocate_work(thread);
+   vector<bool>& select_x( work_[thread]->sparsity_select_x );
+   vector<bool>& select_y( work_[thread]->sparsity_select_y );
+   sparse_rc< vector<size_t> >& pattern_jac( work_[thread]->pattern_jac );
+   sparse_rc< vector<size_t> >& pattern_hes( work_[thread]->pattern_hes );
+   select_x.resize(n);
+   select_y.resize(m);
+   pattern_jac.resize(0, 0, 0);
+   pattern_hes.resize(0, 0, 0);
+   //
    // select_x
-   vector<bool> select_x(n);
    for(size_t j = 0; j < n; j++)
       select_x[j] = for_jac_pattern.number_elements( x_index[j] ) > 0;
    //
    // select_y
-   vector<bool> select_y(m);
    for(size_t i = 0; i < m; i++)
       select_y[i] = rev_jac_flag[ y_index[i] ];
    //
    // call atomic function for Jacobain sparsity
    bool dependency = false;
-   sparse_rc< vector<size_t> > pattern_jac;
    bool ok = jac_sparsity( call_id,
       dependency, ident_zero_x, select_x, select_y, pattern_jac
    );
@@ -320,7 +336,6 @@ bool atomic_four<Base>::rev_hes_sparsity(
       return ok;
    //
    // call atomic function for Hessian sparsity
-   sparse_rc< vector<size_t> > pattern_hes;
    ok = hes_sparsity(
       call_id, ident_zero_x, select_x, select_y, pattern_hes
    );
@@ -84,13 +84,21 @@ bool atomic_four<Base>::for_jac_sparsity(
    size_t n = x_index.size();
    size_t m = y_index.size();
 
+   // work space for this thread
+   size_t thread = thread_alloc::thread_num();
+   allocate_work(thread);
+   vector<bool>& select_x( work_[thread]->sparsity_select_x );
+   vector<bool>& select_y( work_[thread]->sparsity_select_y );
+   sparse_rc< vector<size_t> >& pattern_out( work_[thread]->pattern_jac );
+   select_x.resize(n);
+   select_y.resize(m);
+   pattern_out.resize(0, 0, 0);
+
    // select_y
-   vector<bool> select_y(m);
    for(size_t i = 0; i < m; ++i)
       select_y[i] = y_index[i] != 0;
 
    // determine select_x
-   vector<bool> select_x(n);
    for(size_t j = 0; j < n; ++j)
    {  if( x_index[j] == 0 )
          select_x[j] = false;
@@ -101,7 +109,6 @@ bool atomic_four<Base>::for_jac_sparsity(
          select_x[j] = ell < var_sparsity.end();
       }
    }
-   sparse_rc< vector<size_t> > pattern_out;
    bool ok = jac_sparsity( call_id,
       dependency, ident_zero_x, select_x, select_y, pattern_out
    );
@@ -228,8 +235,15 @@ bool atomic_four<Base>::rev_jac_sparsity(
    size_t n = x_index.size();
    size_t m = y_index.size();
 
-   // selection vectors
-   vector<bool> select_x(n), select_y(m);
+   // work space for this thread
+   size_t thread = thread_alloc::thread_num();
+   allocate_work(thread);
+   vector<bool>& select_x( work_[thread]->sparsity_select_x );
+   vector<bool>& select_y( work_[thread]->sparsity_select_y );
+   sparse_rc< vector<size_t> >& pattern_out( work_[thread]->pattern_jac );
+   select_x.resize(n);
+   select_y.resize(m);
+   pattern_out.resize(0, 0, 0);
 
    // select_x
    for(size_t j = 0; j < n; ++j)
@@ -246,7 +260,6 @@ bool atomic_four<Base>::rev_jac_sparsity(
          select_y[i] = ell < var_sparsity.end();
       }
    }
-   sparse_rc< vector<size_t> > pattern_out;
    bool ok = jac_sparsity( call_id,
       dependency, ident_zero_x, select_x, select_y, pattern_out
    );
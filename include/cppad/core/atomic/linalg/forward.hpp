@@ -0,0 +1,191 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_FORWARD_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_FORWARD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+// ---------------------------------------------------------------------------
+// forward_mat_mul
+// C_k = sum_{ell=0}^k A_ell * B_{k-ell}
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::forward_mat_mul(
+   const call_struct&    call      ,
+   size_t                order_low ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   vector<Scalar>&       taylor_y  )
+{  size_t n_left   = call.n_left;
+   size_t n_middle = call.n_middle;
+   size_t n_right  = call.n_right;
+   size_t q        = order_up + 1;
+   size_t offset   = n_left * n_middle;
+   size_t size_b   = n_middle * n_right;
+   //
+   vector<Scalar> a, b, c, sum(n_left * n_right);
+   for(size_t k = order_low; k < q; ++k)
+   {  for(size_t i = 0; i < sum.size(); ++i)
+         sum[i] = Scalar(0);
+      for(size_t ell = 0; ell <= k; ++ell)
+      {  local::linalg::get_taylor(taylor_x, 0, offset, q, ell, a);
+         local::linalg::get_taylor(taylor_x, offset, size_b, q, k - ell, b);
+         linalg_mul(false, false, n_left, n_middle, n_right, a, b, c);
+         for(size_t i = 0; i < sum.size(); ++i)
+            sum[i] += c[i];
+      }
+      local::linalg::set_taylor(sum, 0, q, k, taylor_y);
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// forward_solve
+// X_k = S_0^{-1} * ( B_k - sum_{ell=1}^k S_ell * X_{k-ell} )
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::forward_solve(
+   const call_struct&    call      ,
+   size_t                order_low ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   vector<Scalar>&       taylor_y  )
+{  op_enum_t op      = call.op;
+   size_t    n       = call.n_left;
+   size_t    n_right = call.n_right;
+   size_t    q       = order_up + 1;
+   size_t    size_a  = n * n;
+   size_t    size_b  = n * n_right;
+   //
+   // a_0
+   vector<Scalar> a_0;
+   local::linalg::get_taylor(taylor_x, 0, size_a, q, 0, a_0);
+   //
+   // s[ell] for ell = 1, ..., order_up
+   vector< vector<Scalar> > s(q);
+   vector<Scalar> a_ell;
+   for(size_t ell = 1; ell < q; ++ell)
+   {  local::linalg::get_taylor(taylor_x, 0, size_a, q, ell, a_ell);
+      structure(op, n, a_ell, s[ell]);
+   }
+   //
+   // x[k] for k < order_low
+   vector< vector<Scalar> > x(q);
+   for(size_t k = 0; k < order_low; ++k)
+      local::linalg::get_taylor(taylor_y, 0, size_b, q, k, x[k]);
+   //
+   // x[k] for k = order_low, ..., order_up
+   vector<Scalar> rhs, prod;
+   for(size_t k = order_low; k < q; ++k)
+   {  local::linalg::get_taylor(taylor_x, size_a, size_b, q, k, rhs);
+      for(size_t ell = 1; ell <= k; ++ell)
+      {  linalg_mul(false, false, n, n, n_right, s[ell], x[k - ell], prod);
+         for(size_t i = 0; i < size_b; ++i)
+            rhs[i] -= prod[i];
+      }
+      linalg_solve(op, false, n, n_right, a_0, rhs, x[k]);
+      local::linalg::set_taylor(x[k], 0, q, k, taylor_y);
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// forward_log_det
+// B_0 = A_0^{-1} , B_j = - A_0^{-1} * sum_{ell=1}^j A_ell * B_{j-ell}
+// y_k = (1/k) * sum_{ell=1}^k ell * trace( B_{k-ell} * A_ell )
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::forward_log_det(
+   const call_struct&    call      ,
+   size_t                order_low ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   vector<Scalar>&       taylor_y  )
+{  size_t n      = call.n_left;
+   size_t q      = order_up + 1;
+   size_t size_a = n * n;
+   //
+   // a[ell]
+   vector< vector<Scalar> > a(q);
+   for(size_t ell = 0; ell < q; ++ell)
+      local::linalg::get_taylor(taylor_x, 0, size_a, q, ell, a[ell]);
+   //
+   // order zero
+   if( order_low == 0 )
+   {  Scalar log_det, sign;
+      linalg_log_det(n, a[0], log_det, sign);
+      taylor_y[0 * q + 0] = log_det;
+      taylor_y[1 * q + 0] = sign;
+   }
+   if( order_up == 0 )
+      return true;
+   //
+   // b[j] for j = 0, ..., order_up - 1
+   vector< vector<Scalar> > b(order_up);
+   vector<Scalar> eye(size_a), sum(size_a), prod;
+   for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+         eye[i * n + j] = Scalar( i == j ? 1.0 : 0.0 );
+   linalg_solve(lu_solve_enum, false, n, n, a[0], eye, b[0]);
+   for(size_t j = 1; j < order_up; ++j)
+   {  for(size_t i = 0; i < size_a; ++i)
+         sum[i] = Scalar(0);
+      for(size_t ell = 1; ell <= j; ++ell)
+      {  linalg_mul(false, false, n, n, n, a[ell], b[j - ell], prod);
+         for(size_t i = 0; i < size_a; ++i)
+            sum[i] -= prod[i];
+      }
+      linalg_solve(lu_solve_enum, false, n, n, a[0], sum, b[j]);
+   }
+   //
+   // y_k for k = max(order_low, 1), ..., order_up
+   for(size_t k = std::max(order_low, size_t(1)); k < q; ++k)
+   {  Scalar y_k = Scalar(0);
+      for(size_t ell = 1; ell <= k; ++ell)
+      {  // trace( B_{k-ell} * A_ell )
+         const vector<Scalar>& b_kl( b[k - ell] );
+         Scalar trace = Scalar(0);
+         for(size_t i = 0; i < n; ++i)
+            for(size_t j = 0; j < n; ++j)
+               trace += b_kl[i * n + j] * a[ell][j * n + i];
+         y_k += Scalar( double(ell) ) * trace;
+      }
+      taylor_y[0 * q + k] = y_k / Scalar( double(k) );
+      taylor_y[1 * q + k] = Scalar(0);
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// forward_any
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::forward_any(
+   size_t                call_id   ,
+   size_t                order_low ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   vector<Scalar>&       taylor_y  )
+{  // call
+   // a copy because the AD<Base> recurrences add call_id values
+   call_struct call = get_call(call_id);
+   switch( call.op )
+   {  case mat_mul_enum:
+      return forward_mat_mul(call, order_low, order_up, taylor_x, taylor_y);
+
+      case lower_solve_enum:
+      case upper_solve_enum:
+      case lu_solve_enum:
+      case chol_solve_enum:
+      return forward_solve(call, order_low, order_up, taylor_x, taylor_y);
+
+      case log_det_enum:
+      return forward_log_det(call, order_low, order_up, taylor_x, taylor_y);
+
+      default:
+      CPPAD_ASSERT_UNKNOWN( false );
+   }
+   return false;
+}
+} // END_CPPAD_NAMESPACE
+
+# endif
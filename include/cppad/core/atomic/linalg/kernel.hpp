@@ -0,0 +1,309 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_KERNEL_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_KERNEL_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_linalg_kernel}
+{xrst_spell
+   lda
+   ldb
+   ldc
+   ldt
+   ldx
+}
+
+Dense Matrix Kernels Used by atomic_linalg
+##########################################
+
+Syntax
+******
+| ``local::linalg::mat_mul_add`` (
+| |tab| *trans_a* , *trans_b* , *n_left* , *n_middle* , *n_right* ,
+| |tab| *alpha* , *a* , *lda* , *b* , *ldb* , *c* , *ldc*
+| )
+| ``local::linalg::tri_solve`` (
+| |tab| *lower* , *trans* , *unit* , *n* , *n_right* , *t* , *ldt* , *x* , *ldx*
+| )
+| *sign* = ``local::linalg::lu_factor`` ( *n* , *a* , *pivot* )
+| ``local::linalg::lu_solve`` ( *trans* , *n* , *n_right* , *a* , *pivot* , *x* )
+| *ok* = ``local::linalg::chol_factor`` ( *n* , *a* )
+| ``local::linalg::chol_solve`` ( *n* , *n_right* , *a* , *x* )
+
+Storage
+*******
+All the matrices are stored in row major order using ``Base*`` pointers.
+The leading dimension arguments *lda* , *ldb* , *ldc* , *ldt* and *ldx*
+are the distance between the start of two rows.
+The factorization routines use *n* for the leading dimension.
+
+mat_mul_add
+***********
+This computes *C* += *alpha* * op( *A* ) * op( *B* ) where
+op( *A* ) is *A* ( its transpose ) if *trans_a* is false ( true ) and
+op( *B* ) is *B* ( its transpose ) if *trans_b* is false ( true ) .
+The row and column dimension of op( *A* ) is *n_left* and *n_middle* ,
+the row and column dimension of op( *B* ) is *n_middle* and *n_right* .
+The loops are blocked so that the blocks of the three matrices
+fit in cache at the same time.
+In addition, the inner most loop accesses memory with unit stride.
+
+tri_solve
+*********
+This replaces *X* by the solution of op( *T* ) * *X* = *X*
+where *T* is lower (upper) triangular if *lower* is true (false)
+and op( *T* ) is *T* ( its transpose ) if *trans* is false ( true ).
+The elements of *T* in the other triangle are not used.
+If *unit* is true, the diagonal of *T* is not used and is treated as one.
+The row updates of *X* are done with unit stride.
+
+lu_factor
+*********
+This replaces *A* by its LU factorization, with partial pivoting,
+:math:`P A = L U` where *L* is unit lower triangular and *U* is upper
+triangular.
+The vector *pivot* must have size *n* and for each *k* ,
+rows *k* and *pivot* [ *k* ] were swapped during step *k* .
+The return value is the sign of the permutation (plus or minus one)
+or zero if a zero pivot was found.
+In the later case, the factorization is not complete.
+
+lu_solve
+********
+Given the factorization computed by ``lu_factor`` ,
+this replaces *X* by the solution of op( *A* ) * *X* = *X* .
+
+chol_factor
+***********
+This replaces the lower triangle of *A* by the Cholesky factor *L* ;
+i.e., :math:`A = L L^\R{T}` .
+Only the lower triangle of *A* is used.
+The return value is false if *A* is not positive definite.
+
+chol_solve
+**********
+Given the factorization computed by ``chol_factor`` ,
+this replaces *X* by the solution of *A* * *X* = *X* .
+
+{xrst_end atomic_linalg_kernel}
+*/
+# include <algorithm>
+# include <cppad/local/pod_vector.hpp>
+
+// BEGIN_CPPAD_LOCAL_LINALG_NAMESPACE
+namespace CppAD { namespace local { namespace linalg {
+
+// block_size
+// number of rows or columns in a block used by mat_mul_add
+const size_t block_size = 64;
+
+// mat_mul_add
+template <class Base>
+void mat_mul_add(
+   bool        trans_a  ,
+   bool        trans_b  ,
+   size_t      n_left   ,
+   size_t      n_middle ,
+   size_t      n_right  ,
+   const Base& alpha    ,
+   const Base* a        ,
+   size_t      lda      ,
+   const Base* b        ,
+   size_t      ldb      ,
+   Base*       c        ,
+   size_t      ldc      )
+{  for(size_t i0 = 0; i0 < n_left; i0 += block_size)
+   {  size_t i1 = std::min(i0 + block_size, n_left);
+      for(size_t k0 = 0; k0 < n_middle; k0 += block_size)
+      {  size_t k1 = std::min(k0 + block_size, n_middle);
+         for(size_t j0 = 0; j0 < n_right; j0 += block_size)
+         {  size_t j1 = std::min(j0 + block_size, n_right);
+            if( ! trans_b )
+            {  // C_{i,j} += ( alpha * op(A)_{i,k} ) * B_{k,j}
+               for(size_t i = i0; i < i1; ++i)
+               {  Base* c_i = c + i * ldc;
+                  for(size_t k = k0; k < k1; ++k)
+                  {  Base a_ik;
+                     if( trans_a )
+                        a_ik = alpha * a[k * lda + i];
+                     else
+                        a_ik = alpha * a[i * lda + k];
+                     const Base* b_k = b + k * ldb;
+                     for(size_t j = j0; j < j1; ++j)
+                        c_i[j] += a_ik * b_k[j];
+                  }
+               }
+            }
+            else if( ! trans_a )
+            {  // C_{i,j} += alpha * sum_k A_{i,k} * B_{j,k}
+               for(size_t i = i0; i < i1; ++i)
+               {  const Base* a_i = a + i * lda;
+                  for(size_t j = j0; j < j1; ++j)
+                  {  const Base* b_j = b + j * ldb;
+                     Base sum = Base(0);
+                     for(size_t k = k0; k < k1; ++k)
+                        sum += a_i[k] * b_j[k];
+                     c[i * ldc + j] += alpha * sum;
+                  }
+               }
+            }
+            else
+            {  // C_{i,j} += alpha * sum_k A_{k,i} * B_{j,k}
+               for(size_t i = i0; i < i1; ++i)
+               {  for(size_t j = j0; j < j1; ++j)
+                  {  const Base* b_j = b + j * ldb;
+                     Base sum = Base(0);
+                     for(size_t k = k0; k < k1; ++k)
+                        sum += a[k * lda + i] * b_j[k];
+                     c[i * ldc + j] += alpha * sum;
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+// tri_solve
+template <class Base>
+void tri_solve(
+   bool        lower    ,
+   bool        trans    ,
+   bool        unit     ,
+   size_t      n        ,
+   size_t      n_right  ,
+   const Base* t        ,
+   size_t      ldt      ,
+   Base*       x        ,
+   size_t      ldx      )
+{  // M = op(T) is lower triangular if and only if forward is true
+   bool forward = lower != trans;
+   for(size_t ell = 0; ell < n; ++ell)
+   {  // i
+      size_t i = forward ? ell : n - 1 - ell;
+      Base*  x_i = x + i * ldx;
+      //
+      // k_begin, k_end: the off diagonal elements M_{i,k}
+      size_t k_begin = forward ? 0 : i + 1;
+      size_t k_end   = forward ? i : n;
+      for(size_t k = k_begin; k < k_end; ++k)
+      {  Base m_ik = trans ? t[k * ldt + i] : t[i * ldt + k];
+         const Base* x_k = x + k * ldx;
+         for(size_t j = 0; j < n_right; ++j)
+            x_i[j] -= m_ik * x_k[j];
+      }
+      if( ! unit )
+      {  Base m_ii = t[i * ldt + i];
+         for(size_t j = 0; j < n_right; ++j)
+            x_i[j] /= m_ii;
+      }
+   }
+}
+
+// lu_factor
+template <class Base>
+int lu_factor(size_t n, Base* a, pod_vector<size_t>& pivot)
+{  CPPAD_ASSERT_UNKNOWN( pivot.size() == n );
+   int sign = 1;
+   for(size_t k = 0; k < n; ++k)
+   {  // p: row with largest pivot element
+      size_t p = k;
+      for(size_t i = k + 1; i < n; ++i)
+      {  if( ! abs_geq( a[p * n + k], a[i * n + k] ) )
+            p = i;
+      }
+      pivot[k] = p;
+      if( a[p * n + k] == Base(0) )
+         return 0;
+      if( p != k )
+      {  sign = - sign;
+         for(size_t j = 0; j < n; ++j)
+            std::swap( a[k * n + j], a[p * n + j] );
+      }
+      // eliminate below the pivot using unit stride row updates
+      const Base* a_k = a + k * n;
+      for(size_t i = k + 1; i < n; ++i)
+      {  Base* a_i  = a + i * n;
+         Base  l_ik = a_i[k] / a_k[k];
+         a_i[k]     = l_ik;
+         for(size_t j = k + 1; j < n; ++j)
+            a_i[j] -= l_ik * a_k[j];
+      }
+   }
+   return sign;
+}
+
+// lu_solve
+template <class Base>
+void lu_solve(
+   bool                      trans   ,
+   size_t                    n       ,
+   size_t                    n_right ,
+   const Base*               a       ,
+   const pod_vector<size_t>& pivot   ,
+   Base*                     x       )
+{  if( ! trans )
+   {  // P * X
+      for(size_t k = 0; k < n; ++k) if( pivot[k] != k )
+      {  for(size_t j = 0; j < n_right; ++j)
+            std::swap( x[k * n_right + j], x[pivot[k] * n_right + j] );
+      }
+      // L^{-1} * P * X
+      tri_solve(true, false, true, n, n_right, a, n, x, n_right);
+      // U^{-1} * L^{-1} * P * X
+      tri_solve(false, false, false, n, n_right, a, n, x, n_right);
+      return;
+   }
+   // U^{-T} * X
+   tri_solve(false, true, false, n, n_right, a, n, x, n_right);
+   // L^{-T} * U^{-T} * X
+   tri_solve(true, true, true, n, n_right, a, n, x, n_right);
+   // P^T * L^{-T} * U^{-T} * X
+   for(size_t ell = 0; ell < n; ++ell)
+   {  size_t k = n - 1 - ell;
+      if( pivot[k] != k )
+      {  for(size_t j = 0; j < n_right; ++j)
+            std::swap( x[k * n_right + j], x[pivot[k] * n_right + j] );
+      }
+   }
+}
+
+// chol_factor
+template <class Base>
+bool chol_factor(size_t n, Base* a)
+{  for(size_t j = 0; j < n; ++j)
+   {  Base* a_j = a + j * n;
+      //
+      // L_{j,j}
+      Base d = a_j[j];
+      for(size_t k = 0; k < j; ++k)
+         d -= a_j[k] * a_j[k];
+      if( ! GreaterThanZero(d) )
+         return false;
+      a_j[j] = sqrt(d);
+      //
+      // L_{i,j} for i > j (dot products with unit stride)
+      for(size_t i = j + 1; i < n; ++i)
+      {  Base* a_i = a + i * n;
+         Base sum  = a_i[j];
+         for(size_t k = 0; k < j; ++k)
+            sum -= a_i[k] * a_j[k];
+         a_i[j] = sum / a_j[j];
+      }
+   }
+   return true;
+}
+
+// chol_solve
+template <class Base>
+void chol_solve(size_t n, size_t n_right, const Base* a, Base* x)
+{  // L^{-1} * X
+   tri_solve(true, false, false, n, n_right, a, n, x, n_right);
+   // L^{-T} * L^{-1} * X
+   tri_solve(true, true, false, n, n_right, a, n, x, n_right);
+}
+
+} } } // END_CPPAD_LOCAL_LINALG_NAMESPACE
+
+# endif
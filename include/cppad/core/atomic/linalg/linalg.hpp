@@ -0,0 +1,435 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_LINALG_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_LINALG_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin atomic_linalg}
+{xrst_spell
+   cholesky
+   nan
+}
+
+Atomic Dense Linear Algebra Functions
+#####################################
+
+Syntax
+******
+| ``# include <cppad/core/atomic/linalg/linalg.hpp>``
+| ``atomic_linalg`` < *Base* > *linalg* ( *name* )
+| *call_id* = *linalg* . ``set_mat_mul`` ( *n_left* , *n_middle* , *n_right* )
+| *call_id* = *linalg* . ``set_solve`` ( *op* , *n* , *n_right* )
+| *call_id* = *linalg* . ``set_log_det`` ( *n* )
+| *linalg* . ``get`` ( *call_id* , *op* , *n_left* , *n_middle* , *n_right* )
+| *linalg* ( *call_id* , *ax* , *ay* )
+
+Purpose
+*******
+Recording a dense matrix operation one scalar operation at a time
+creates a recording with size proportional to the number of floating point
+operations; e.g., :math:`n^3` for the product of two *n* by *n* matrices.
+The ``atomic_linalg`` class records each of the operations below as one
+:ref:`atomic_four-name` function call.
+The size of the recording is then proportional to the number of matrix
+elements and the numerical work is done by the blocked, unit stride,
+kernels in :ref:`atomic_linalg_kernel-name` .
+
+Include
+*******
+This class is not included by ``cppad/cppad.hpp`` .
+It is included by the file ``cppad/core/atomic/linalg/linalg.hpp`` .
+
+Base
+****
+This is the base type for the :ref:`ADFun-name` objects that use
+this atomic function.
+It must support the :ref:`base_ordered-name` operations
+and the ``sqrt`` and ``log``  :ref:`base_std_math-name` functions.
+
+name
+****
+This is the name used for this atomic function during error reporting.
+
+op
+**
+The type of *op* is ``atomic_linalg`` < *Base* >:: ``op_enum_t`` .
+In the table below, all the matrices are stored in row major order and
+the arguments are stored one after the other in the vector *ax* .
+For example, for the ``mat_mul_enum`` operation,
+
+| |tab| *A* ( *i* , *k* ) = *ax* [ *i* * *n_middle* + *k* ]
+| |tab| *B* ( *k* , *j* ) = *ax* [ *n_left* * *n_middle* + *k* * *n_right* + *j* ]
+| |tab| *C* ( *i* , *j* ) = *ay* [ *i* * *n_right* + *j* ]
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   *op*,              *ax*,       *ay*,      description
+   ``mat_mul_enum``,  *A* *B*,    *C*,       *C* = *A* * *B*
+   ``lower_solve_enum``, *A* *B*, *X*, *X* = *L*:sup:`-1` *B* where *L* is the lower triangle of *A*
+   ``upper_solve_enum``, *A* *B*, *X*, *X* = *U*:sup:`-1` *B* where *U* is the upper triangle of *A*
+   ``lu_solve_enum``, *A* *B*,    *X*,       *X* = *A*:sup:`-1` *B* using LU factorization with partial pivoting
+   ``chol_solve_enum``, *A* *B*,  *X*,       *X* = *S*:sup:`-1` *B* using a Cholesky factorization of *S*
+   ``log_det_enum``,  *A*,        *d* *s*,   *d* = log \| det( *A* ) \| and *s* = sign( det( *A* ) )
+
+#. The elements of *A* above (below) the diagonal are not used
+   by ``lower_solve_enum`` ( ``upper_solve_enum`` ).
+#. For ``chol_solve_enum`` , *S* is the symmetric matrix with the
+   same lower triangle as *A* and it must be positive definite.
+   The elements of *A* above the diagonal are not used.
+#. For ``log_det_enum`` , the sign result *s* is plus or minus one and
+   its derivatives are zero.
+#. If a factorization fails (a zero pivot or *S* is not positive definite)
+   the solve results are nan and the ``log_det_enum`` results are
+   *d* = minus infinity and *s* = 0.
+
+Dimensions
+**********
+The matrix *A* is *n_left* by *n_middle* and *B* is *n_middle* by *n_right*
+for ``mat_mul_enum`` .
+For the other operations, *A* is *n* by *n*
+and *B* is *n* by *n_right* .
+The ``get`` function returns
+*n_left* = *n_middle* = *n* for these operations and
+*n_right* = 0 for ``log_det_enum`` .
+
+call_id
+*******
+The ``set`` functions return the *call_id* that identifies an
+operation and its dimensions.
+The same *call_id* is returned each time the same operation and dimensions
+are requested by the same thread.
+A *call_id* can only be used by the thread that created it.
+
+Derivatives
+***********
+All the operations support forward mode for all orders.
+All the operations, except ``log_det_enum`` , support reverse mode for
+all orders.
+The ``log_det_enum`` operation supports reverse mode with
+*order_up* less than or equal one; i.e., the derivatives needed
+to compute a Hessian.
+The ``AD`` < *Base* > versions of the forward and reverse callbacks
+are implemented using this atomic function and so
+:ref:`base2ad-name` can be used with functions that contain these operations.
+
+Sparsity
+********
+The sparsity patterns only use the triangular structure of the operations;
+i.e., they do not depend on which elements of *A* are zero.
+The Hessian sparsity patterns use the fact that the solve operations
+are linear in *B* .
+
+Example
+*******
+The file :ref:`atomic_linalg.cpp-name`
+contains an example and test of these operations.
+
+{xrst_toc_hidden
+   include/cppad/core/atomic/linalg/kernel.hpp
+   example/atomic_four/linalg.cpp
+}
+
+{xrst_end atomic_linalg}
+*/
+# include <map>
+# include <cppad/cppad.hpp>
+# include <cppad/core/atomic/linalg/kernel.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+template <class Base>
+class atomic_linalg : public atomic_four<Base> {
+public:
+   // op_enum_t
+   enum op_enum_t {
+      mat_mul_enum,
+      lower_solve_enum,
+      upper_solve_enum,
+      lu_solve_enum,
+      chol_solve_enum,
+      log_det_enum,
+      number_op_enum
+   };
+   //
+   // ctor
+   atomic_linalg(const std::string& name) :
+   atomic_four<Base>(name)
+   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+         work_[thread] = nullptr;
+   }
+   // destructor
+   ~atomic_linalg(void)
+   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; ++thread)
+      {  if( work_[thread] != nullptr )
+         {  // allocated in set member function
+            delete work_[thread];
+         }
+      }
+   }
+   // set_mat_mul
+   size_t set_mat_mul(size_t n_left, size_t n_middle, size_t n_right)
+   {  return set(mat_mul_enum, n_left, n_middle, n_right); }
+   //
+   // set_solve
+   size_t set_solve(op_enum_t op, size_t n, size_t n_right)
+   {  CPPAD_ASSERT_KNOWN(
+         op == lower_solve_enum || op == upper_solve_enum ||
+         op == lu_solve_enum    || op == chol_solve_enum ,
+         "atomic_linalg::set_solve: op is not a solve operation"
+      );
+      return set(op, n, n, n_right);
+   }
+   //
+   // set_log_det
+   size_t set_log_det(size_t n)
+   {  return set(log_det_enum, n, n, 0); }
+   //
+   // get
+   void get(
+      size_t     call_id   ,
+      op_enum_t& op        ,
+      size_t&    n_left    ,
+      size_t&    n_middle  ,
+      size_t&    n_right
+   );
+private:
+   //
+   // call_struct
+   // operation and dimensions corresponding to a call_id
+   struct call_struct {
+      op_enum_t op; size_t n_left; size_t n_middle; size_t n_right;
+   };
+   // call_less
+   // order used to find the call_id for a call_struct
+   struct call_less {
+      bool operator()(const call_struct& left, const call_struct& right) const
+      {  if( left.op != right.op )
+            return left.op < right.op;
+         if( left.n_left != right.n_left )
+            return left.n_left < right.n_left;
+         if( left.n_middle != right.n_middle )
+            return left.n_middle < right.n_middle;
+         return left.n_right < right.n_right;
+      }
+   };
+   // thread_struct
+   struct thread_struct {
+      // map from call_id to operation and dimensions
+      vector<call_struct>                     call_vec;
+      // map from operation and dimensions to call_id
+      std::map<call_struct, size_t, call_less> call_map;
+   };
+   //
+   // Use pointers, to avoid false sharing between threads.
+   thread_struct* work_[CPPAD_MAX_NUM_THREADS];
+   //
+   // set
+   size_t set(op_enum_t op, size_t n_left, size_t n_middle, size_t n_right);
+   //
+   // get_call
+   const call_struct& get_call(size_t call_id);
+   //
+   // -----------------------------------------------------------------------
+   // matrix operations used by the Taylor coefficient recurrences
+   // (the AD<Base> versions record calls to this atomic function)
+   // -----------------------------------------------------------------------
+   //
+   // linalg_mul: c = op(a) * op(b)
+   void linalg_mul(
+      bool trans_a, bool trans_b,
+      size_t n_left, size_t n_middle, size_t n_right,
+      const vector<Base>& a, const vector<Base>& b, vector<Base>& c
+   );
+   void linalg_mul(
+      bool trans_a, bool trans_b,
+      size_t n_left, size_t n_middle, size_t n_right,
+      const vector< AD<Base> >& a,
+      const vector< AD<Base> >& b,
+      vector< AD<Base> >&       c
+   );
+   //
+   // linalg_solve: x = op(S)^{-1} * b where S is defined by op and a
+   void linalg_solve(
+      op_enum_t op, bool trans, size_t n, size_t n_right,
+      const vector<Base>& a, const vector<Base>& b, vector<Base>& x
+   );
+   void linalg_solve(
+      op_enum_t op, bool trans, size_t n, size_t n_right,
+      const vector< AD<Base> >& a,
+      const vector< AD<Base> >& b,
+      vector< AD<Base> >&       x
+   );
+   //
+   // linalg_log_det: log_det = log | det(a) |, sign = sign( det(a) )
+   void linalg_log_det(
+      size_t n, const vector<Base>& a, Base& log_det, Base& sign
+   );
+   void linalg_log_det(
+      size_t n, const vector< AD<Base> >& a,
+      AD<Base>& log_det, AD<Base>& sign
+   );
+   //
+   // -----------------------------------------------------------------------
+   // Taylor coefficient recurrences for Base and AD<Base>
+   // -----------------------------------------------------------------------
+   template <class Scalar> bool forward_mat_mul(
+      const call_struct& call, size_t order_low, size_t order_up,
+      const vector<Scalar>& taylor_x, vector<Scalar>& taylor_y
+   );
+   template <class Scalar> bool forward_solve(
+      const call_struct& call, size_t order_low, size_t order_up,
+      const vector<Scalar>& taylor_x, vector<Scalar>& taylor_y
+   );
+   template <class Scalar> bool forward_log_det(
+      const call_struct& call, size_t order_low, size_t order_up,
+      const vector<Scalar>& taylor_x, vector<Scalar>& taylor_y
+   );
+   template <class Scalar> bool reverse_mat_mul(
+      const call_struct& call, size_t order_up,
+      const vector<Scalar>& taylor_x, const vector<Scalar>& taylor_y,
+      vector<Scalar>& partial_x, const vector<Scalar>& partial_y
+   );
+   template <class Scalar> bool reverse_solve(
+      const call_struct& call, size_t order_up,
+      const vector<Scalar>& taylor_x, const vector<Scalar>& taylor_y,
+      vector<Scalar>& partial_x, const vector<Scalar>& partial_y
+   );
+   template <class Scalar> bool reverse_log_det(
+      const call_struct& call, size_t order_up,
+      const vector<Scalar>& taylor_x, const vector<Scalar>& taylor_y,
+      vector<Scalar>& partial_x, const vector<Scalar>& partial_y
+   );
+   template <class Scalar> bool forward_any(
+      size_t call_id, size_t order_low, size_t order_up,
+      const vector<Scalar>& taylor_x, vector<Scalar>& taylor_y
+   );
+   template <class Scalar> bool reverse_any(
+      size_t call_id, size_t order_up,
+      const vector<Scalar>& taylor_x, const vector<Scalar>& taylor_y,
+      vector<Scalar>& partial_x, const vector<Scalar>& partial_y
+   );
+   //
+   // -----------------------------------------------------------------------
+   // dependency structure
+   // -----------------------------------------------------------------------
+   //
+   // use_a: is the (r, c) element of A used by this solve operation
+   static bool use_a(op_enum_t op, size_t r, size_t c);
+   //
+   // row_range: rows of A and B that the i-th row of a solve depends on
+   static void row_range(
+      op_enum_t op, size_t n, size_t i, size_t& r_begin, size_t& r_end
+   );
+   //
+   // structure: the matrix S that a solve operation uses for A
+   template <class Scalar> static void structure(
+      op_enum_t op, size_t n, const vector<Scalar>& a, vector<Scalar>& s
+   );
+   //
+   // structure_partial: partials w.r.t A given the partials w.r.t. S
+   template <class Scalar> static void structure_partial(
+      op_enum_t op, size_t n, const vector<Scalar>& ps, vector<Scalar>& pa
+   );
+   //
+   // -----------------------------------------------------------------------
+   // overrides
+   // -----------------------------------------------------------------------
+   //
+   // for_type
+   bool for_type(
+      size_t                                        call_id,
+      const CppAD::vector<CppAD::ad_type_enum>&     type_x,
+      CppAD::vector<CppAD::ad_type_enum>&           type_y
+   ) override;
+   //
+   // Base forward
+   bool forward(
+      size_t                                           call_id,
+      const CppAD::vector<bool>&                       select_y,
+      size_t                                           order_low,
+      size_t                                           order_up,
+      const CppAD::vector<Base>&                       taylor_x,
+      CppAD::vector<Base>&                             taylor_y
+   ) override
+   {  return forward_any(call_id, order_low, order_up, taylor_x, taylor_y); }
+   //
+   // AD<Base> forward
+   bool forward(
+      size_t                                           call_id,
+      const CppAD::vector<bool>&                       select_y,
+      size_t                                           order_low,
+      size_t                                           order_up,
+      const CppAD::vector< CppAD::AD<Base> >&          ataylor_x,
+      CppAD::vector< CppAD::AD<Base> >&                ataylor_y
+   ) override
+   {  return forward_any(call_id, order_low, order_up, ataylor_x, ataylor_y); }
+   //
+   // Base reverse
+   bool reverse(
+      size_t                                           call_id,
+      const CppAD::vector<bool>&                       select_x,
+      size_t                                           order_up,
+      const CppAD::vector<Base>&                       taylor_x,
+      const CppAD::vector<Base>&                       taylor_y,
+      CppAD::vector<Base>&                             partial_x,
+      const CppAD::vector<Base>&                       partial_y
+   ) override
+   {  return reverse_any(
+         call_id, order_up, taylor_x, taylor_y, partial_x, partial_y
+      );
+   }
+   //
+   // AD<Base> reverse
+   bool reverse(
+      size_t                                           call_id,
+      const CppAD::vector<bool>&                       select_x,
+      size_t                                           order_up,
+      const CppAD::vector< CppAD::AD<Base> >&          ataylor_x,
+      const CppAD::vector< CppAD::AD<Base> >&          ataylor_y,
+      CppAD::vector< CppAD::AD<Base> >&                apartial_x,
+      const CppAD::vector< CppAD::AD<Base> >&          apartial_y
+   ) override
+   {  return reverse_any(
+         call_id, order_up, ataylor_x, ataylor_y, apartial_x, apartial_y
+      );
+   }
+   //
+   // jac_sparsity
+   bool jac_sparsity(
+      size_t                                         call_id,
+      bool                                           dependency,
+      const CppAD::vector<bool>&                     ident_zero_x,
+      const CppAD::vector<bool>&                     select_x,
+      const CppAD::vector<bool>&                     select_y,
+      CppAD::sparse_rc< CppAD::vector<size_t> >&     pattern_out
+   ) override;
+   //
+   // hes_sparsity
+   bool hes_sparsity(
+      size_t                                         call_id,
+      const CppAD::vector<bool>&                     ident_zero_x,
+      const CppAD::vector<bool>&                     select_x,
+      const CppAD::vector<bool>&                     select_y,
+      CppAD::sparse_rc< CppAD::vector<size_t> >&     pattern_out
+   ) override;
+   //
+   // rev_depend
+   bool rev_depend(
+      size_t                                         call_id,
+      const CppAD::vector<bool>&                     ident_zero_x,
+      CppAD::vector<bool>&                           depend_x,
+      const CppAD::vector<bool>&                     depend_y
+   ) override;
+};
+} // END_CPPAD_NAMESPACE
+
+# include <cppad/core/atomic/linalg/set_get.hpp>
+# include <cppad/core/atomic/linalg/mat_op.hpp>
+# include <cppad/core/atomic/linalg/forward.hpp>
+# include <cppad/core/atomic/linalg/reverse.hpp>
+# include <cppad/core/atomic/linalg/sparsity.hpp>
+
+# endif
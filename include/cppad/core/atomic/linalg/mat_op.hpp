@@ -0,0 +1,270 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_MAT_OP_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_MAT_OP_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+// BEGIN_CPPAD_LOCAL_LINALG_NAMESPACE
+namespace CppAD { namespace local { namespace linalg {
+//
+// get_taylor
+// mat[i] = taylor[ (offset + i) * q + k ] for i = 0, ..., size-1
+template <class Scalar>
+void get_taylor(
+   const vector<Scalar>& taylor ,
+   size_t                offset ,
+   size_t                size   ,
+   size_t                q      ,
+   size_t                k      ,
+   vector<Scalar>&       mat    )
+{  mat.resize(size);
+   for(size_t i = 0; i < size; ++i)
+      mat[i] = taylor[ (offset + i) * q + k ];
+}
+//
+// set_taylor
+// taylor[ (offset + i) * q + k ] = mat[i] for i = 0, ..., size-1
+template <class Scalar>
+void set_taylor(
+   const vector<Scalar>& mat    ,
+   size_t                offset ,
+   size_t                q      ,
+   size_t                k      ,
+   vector<Scalar>&       taylor )
+{  for(size_t i = 0; i < mat.size(); ++i)
+      taylor[ (offset + i) * q + k ] = mat[i];
+}
+//
+// add_taylor
+// taylor[ (offset + i) * q + k ] += mat[i] for i = 0, ..., size-1
+template <class Scalar>
+void add_taylor(
+   const vector<Scalar>& mat    ,
+   size_t                offset ,
+   size_t                q      ,
+   size_t                k      ,
+   vector<Scalar>&       taylor )
+{  for(size_t i = 0; i < mat.size(); ++i)
+      taylor[ (offset + i) * q + k ] += mat[i];
+}
+//
+// transpose
+// at = a^T where a is n_row by n_col
+template <class Scalar>
+void transpose(
+   size_t                n_row ,
+   size_t                n_col ,
+   const vector<Scalar>& a     ,
+   vector<Scalar>&       at    )
+{  at.resize(n_row * n_col);
+   for(size_t i = 0; i < n_row; ++i)
+      for(size_t j = 0; j < n_col; ++j)
+         at[ j * n_row + i ] = a[ i * n_col + j ];
+}
+} } } // END_CPPAD_LOCAL_LINALG_NAMESPACE
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+// ---------------------------------------------------------------------------
+// structure
+template <class Base>
+template <class Scalar>
+void atomic_linalg<Base>::structure(
+   op_enum_t op, size_t n, const vector<Scalar>& a, vector<Scalar>& s
+)
+{  s.resize(n * n);
+   for(size_t r = 0; r < n; ++r)
+   {  for(size_t c = 0; c < n; ++c)
+      {  if( op == chol_solve_enum && r < c )
+            s[r * n + c] = a[c * n + r];
+         else if( use_a(op, r, c) )
+            s[r * n + c] = a[r * n + c];
+         else
+            s[r * n + c] = Scalar(0);
+      }
+   }
+}
+// structure_partial
+template <class Base>
+template <class Scalar>
+void atomic_linalg<Base>::structure_partial(
+   op_enum_t op, size_t n, const vector<Scalar>& ps, vector<Scalar>& pa
+)
+{  pa.resize(n * n);
+   for(size_t r = 0; r < n; ++r)
+   {  for(size_t c = 0; c < n; ++c)
+      {  if( ! use_a(op, r, c) )
+            pa[r * n + c] = Scalar(0);
+         else if( op == chol_solve_enum && c < r )
+            pa[r * n + c] = ps[r * n + c] + ps[c * n + r];
+         else
+            pa[r * n + c] = ps[r * n + c];
+      }
+   }
+}
+// ---------------------------------------------------------------------------
+// linalg_mul
+template <class Base>
+void atomic_linalg<Base>::linalg_mul(
+   bool trans_a, bool trans_b,
+   size_t n_left, size_t n_middle, size_t n_right,
+   const vector<Base>& a, const vector<Base>& b, vector<Base>& c
+)
+{  size_t lda = trans_a ? n_left   : n_middle;
+   size_t ldb = trans_b ? n_middle : n_right;
+   c.resize(n_left * n_right);
+   for(size_t i = 0; i < c.size(); ++i)
+      c[i] = Base(0);
+   local::linalg::mat_mul_add(
+      trans_a, trans_b, n_left, n_middle, n_right,
+      Base(1), a.data(), lda, b.data(), ldb, c.data(), n_right
+   );
+}
+template <class Base>
+void atomic_linalg<Base>::linalg_mul(
+   bool trans_a, bool trans_b,
+   size_t n_left, size_t n_middle, size_t n_right,
+   const vector< AD<Base> >& a,
+   const vector< AD<Base> >& b,
+   vector< AD<Base> >&       c
+)
+{  // ax = [ op(a), op(b) ]
+   size_t offset = n_left * n_middle;
+   vector< AD<Base> > ax( offset + n_middle * n_right ), at;
+   if( trans_a )
+      local::linalg::transpose(n_middle, n_left, a, at);
+   const vector< AD<Base> >& op_a( trans_a ? at : a );
+   for(size_t i = 0; i < offset; ++i)
+      ax[i] = op_a[i];
+   if( trans_b )
+      local::linalg::transpose(n_right, n_middle, b, at);
+   const vector< AD<Base> >& op_b( trans_b ? at : b );
+   for(size_t i = 0; i < n_middle * n_right; ++i)
+      ax[offset + i] = op_b[i];
+   //
+   // c
+   c.resize(n_left * n_right);
+   size_t call_id = set_mat_mul(n_left, n_middle, n_right);
+   (*this)(call_id, ax, c);
+}
+// ---------------------------------------------------------------------------
+// linalg_solve
+template <class Base>
+void atomic_linalg<Base>::linalg_solve(
+   op_enum_t op, bool trans, size_t n, size_t n_right,
+   const vector<Base>& a, const vector<Base>& b, vector<Base>& x
+)
+{  x = b;
+   switch( op )
+   {  case lower_solve_enum:
+      case upper_solve_enum:
+      local::linalg::tri_solve(
+         op == lower_solve_enum, trans, false,
+         n, n_right, a.data(), n, x.data(), n_right
+      );
+      return;
+
+      case lu_solve_enum:
+      {  vector<Base> lu(a);
+         local::pod_vector<size_t> pivot(n);
+         int sign = local::linalg::lu_factor(n, lu.data(), pivot);
+         if( sign != 0 )
+         {  local::linalg::lu_solve(
+               trans, n, n_right, lu.data(), pivot, x.data()
+            );
+            return;
+         }
+      }
+      break;
+
+      case chol_solve_enum:
+      {  vector<Base> llt(a);
+         if( local::linalg::chol_factor(n, llt.data()) )
+         {  local::linalg::chol_solve(n, n_right, llt.data(), x.data());
+            return;
+         }
+      }
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN( false );
+   }
+   // the factorization failed
+   Base nan = numeric_limits<Base>::quiet_NaN();
+   for(size_t i = 0; i < x.size(); ++i)
+      x[i] = nan;
+}
+template <class Base>
+void atomic_linalg<Base>::linalg_solve(
+   op_enum_t op, bool trans, size_t n, size_t n_right,
+   const vector< AD<Base> >& a,
+   const vector< AD<Base> >& b,
+   vector< AD<Base> >&       x
+)
+{  // op_t, a_t: solve with the transpose of S
+   // (the matrix S is symmetric for a Cholesky solve)
+   op_enum_t          op_t = op;
+   vector< AD<Base> > a_t;
+   if( trans && op != chol_solve_enum )
+   {  if( op == lower_solve_enum )
+         op_t = upper_solve_enum;
+      else if( op == upper_solve_enum )
+         op_t = lower_solve_enum;
+      local::linalg::transpose(n, n, a, a_t);
+   }
+   const vector< AD<Base> >& op_a( a_t.size() > 0 ? a_t : a );
+   //
+   // ax = [ op(a), b ]
+   size_t offset = n * n;
+   vector< AD<Base> > ax( offset + n * n_right );
+   for(size_t i = 0; i < offset; ++i)
+      ax[i] = op_a[i];
+   for(size_t i = 0; i < n * n_right; ++i)
+      ax[offset + i] = b[i];
+   //
+   // x
+   x.resize(n * n_right);
+   size_t call_id = set_solve(op_t, n, n_right);
+   (*this)(call_id, ax, x);
+}
+// ---------------------------------------------------------------------------
+// linalg_log_det
+template <class Base>
+void atomic_linalg<Base>::linalg_log_det(
+   size_t n, const vector<Base>& a, Base& log_det, Base& sign
+)
+{  vector<Base> lu(a);
+   local::pod_vector<size_t> pivot(n);
+   int sign_p = local::linalg::lu_factor(n, lu.data(), pivot);
+   if( sign_p == 0 )
+   {  log_det = - numeric_limits<Base>::infinity();
+      sign    = Base(0);
+      return;
+   }
+   // log_det, sign
+   log_det = Base(0);
+   sign    = Base( double(sign_p) );
+   for(size_t i = 0; i < n; ++i)
+   {  Base u_ii = lu[i * n + i];
+      if( LessThanZero(u_ii) )
+      {  sign    = - sign;
+         log_det += log( - u_ii );
+      }
+      else
+         log_det += log( u_ii );
+   }
+}
+template <class Base>
+void atomic_linalg<Base>::linalg_log_det(
+   size_t n, const vector< AD<Base> >& a, AD<Base>& log_det, AD<Base>& sign
+)
+{  vector< AD<Base> > ay(2);
+   size_t call_id = set_log_det(n);
+   (*this)(call_id, a, ay);
+   log_det = ay[0];
+   sign    = ay[1];
+}
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -0,0 +1,222 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_REVERSE_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_REVERSE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+// ---------------------------------------------------------------------------
+// reverse_mat_mul
+// C_k = sum_{ell=0}^k A_ell * B_{k-ell}
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::reverse_mat_mul(
+   const call_struct&    call      ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   const vector<Scalar>& taylor_y  ,
+   vector<Scalar>&       partial_x ,
+   const vector<Scalar>& partial_y )
+{  size_t n_left   = call.n_left;
+   size_t n_middle = call.n_middle;
+   size_t n_right  = call.n_right;
+   size_t q        = order_up + 1;
+   size_t offset   = n_left * n_middle;
+   size_t size_b   = n_middle * n_right;
+   size_t size_c   = n_left * n_right;
+   //
+   vector<Scalar> a, b, pc, prod;
+   for(size_t k = 0; k < q; ++k)
+   {  local::linalg::get_taylor(partial_y, 0, size_c, q, k, pc);
+      for(size_t ell = 0; ell <= k; ++ell)
+      {  local::linalg::get_taylor(taylor_x, 0, offset, q, ell, a);
+         local::linalg::get_taylor(taylor_x, offset, size_b, q, k - ell, b);
+         //
+         // PA_ell += PC_k * B_{k-ell}^T
+         linalg_mul(false, true, n_left, n_right, n_middle, pc, b, prod);
+         local::linalg::add_taylor(prod, 0, q, ell, partial_x);
+         //
+         // PB_{k-ell} += A_ell^T * PC_k
+         linalg_mul(true, false, n_middle, n_left, n_right, a, pc, prod);
+         local::linalg::add_taylor(prod, offset, q, k - ell, partial_x);
+      }
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// reverse_solve
+// X_k = S_0^{-1} * ( B_k - sum_{ell=1}^k S_ell * X_{k-ell} )
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::reverse_solve(
+   const call_struct&    call      ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   const vector<Scalar>& taylor_y  ,
+   vector<Scalar>&       partial_x ,
+   const vector<Scalar>& partial_y )
+{  op_enum_t op      = call.op;
+   size_t    n       = call.n_left;
+   size_t    n_right = call.n_right;
+   size_t    q       = order_up + 1;
+   size_t    size_a  = n * n;
+   size_t    size_b  = n * n_right;
+   //
+   // a_0, s[ell]
+   vector<Scalar> a_0, a_ell;
+   vector< vector<Scalar> > s(q);
+   local::linalg::get_taylor(taylor_x, 0, size_a, q, 0, a_0);
+   for(size_t ell = 1; ell < q; ++ell)
+   {  local::linalg::get_taylor(taylor_x, 0, size_a, q, ell, a_ell);
+      structure(op, n, a_ell, s[ell]);
+   }
+   //
+   // x[k], px[k]
+   vector< vector<Scalar> > x(q), px(q);
+   for(size_t k = 0; k < q; ++k)
+   {  local::linalg::get_taylor(taylor_y, 0, size_b, q, k, x[k]);
+      local::linalg::get_taylor(partial_y, 0, size_b, q, k, px[k]);
+   }
+   //
+   // ps[ell]: partial w.r.t. S_ell
+   vector< vector<Scalar> > ps(q);
+   for(size_t ell = 0; ell < q; ++ell)
+   {  ps[ell].resize(size_a);
+      for(size_t i = 0; i < size_a; ++i)
+         ps[ell][i] = Scalar(0);
+   }
+   //
+   vector<Scalar> w, prod;
+   for(size_t ell_k = 0; ell_k < q; ++ell_k)
+   {  size_t k = order_up - ell_k;
+      //
+      // W = S_0^{-T} * PX_k
+      linalg_solve(op, true, n, n_right, a_0, px[k], w);
+      //
+      // PB_k += W
+      local::linalg::add_taylor(w, size_a, q, k, partial_x);
+      //
+      // PS_0 -= W * X_k^T
+      linalg_mul(false, true, n, n_right, n, w, x[k], prod);
+      for(size_t i = 0; i < size_a; ++i)
+         ps[0][i] -= prod[i];
+      //
+      for(size_t ell = 1; ell <= k; ++ell)
+      {  // PS_ell -= W * X_{k-ell}^T
+         linalg_mul(false, true, n, n_right, n, w, x[k - ell], prod);
+         for(size_t i = 0; i < size_a; ++i)
+            ps[ell][i] -= prod[i];
+         //
+         // PX_{k-ell} -= S_ell^T * W
+         linalg_mul(true, false, n, n, n_right, s[ell], w, prod);
+         for(size_t i = 0; i < size_b; ++i)
+            px[k - ell][i] -= prod[i];
+      }
+   }
+   //
+   // PA_ell
+   vector<Scalar> pa;
+   for(size_t ell = 0; ell < q; ++ell)
+   {  structure_partial(op, n, ps[ell], pa);
+      local::linalg::add_taylor(pa, 0, q, ell, partial_x);
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// reverse_log_det
+// y_0 = log | det( A_0 ) | , y_1 = trace( A_0^{-1} * A_1 )
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::reverse_log_det(
+   const call_struct&    call      ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   const vector<Scalar>& taylor_y  ,
+   vector<Scalar>&       partial_x ,
+   const vector<Scalar>& partial_y )
+{  if( order_up > 1 )
+      return false;
+   size_t n      = call.n_left;
+   size_t q      = order_up + 1;
+   size_t size_a = n * n;
+   //
+   // b_0 = A_0^{-1}
+   vector<Scalar> a_0, eye(size_a), b_0;
+   local::linalg::get_taylor(taylor_x, 0, size_a, q, 0, a_0);
+   for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+         eye[i * n + j] = Scalar( i == j ? 1.0 : 0.0 );
+   linalg_solve(lu_solve_enum, false, n, n, a_0, eye, b_0);
+   //
+   // PA_0 = py_0 * B_0^T
+   const Scalar& py_0( partial_y[0 * q + 0] );
+   for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+         partial_x[ (i * n + j) * q + 0 ] += py_0 * b_0[j * n + i];
+   if( order_up == 0 )
+      return true;
+   //
+   // PA_1 = py_1 * B_0^T
+   const Scalar& py_1( partial_y[0 * q + 1] );
+   for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+         partial_x[ (i * n + j) * q + 1 ] += py_1 * b_0[j * n + i];
+   //
+   // PA_0 -= py_1 * ( B_0 * A_1 * B_0 )^T
+   vector<Scalar> a_1, b_a1, b_a1_b;
+   local::linalg::get_taylor(taylor_x, 0, size_a, q, 1, a_1);
+   linalg_solve(lu_solve_enum, false, n, n, a_0, a_1, b_a1);
+   linalg_mul(false, false, n, n, n, b_a1, b_0, b_a1_b);
+   for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+         partial_x[ (i * n + j) * q + 0 ] -= py_1 * b_a1_b[j * n + i];
+   return true;
+}
+// ---------------------------------------------------------------------------
+// reverse_any
+template <class Base>
+template <class Scalar>
+bool atomic_linalg<Base>::reverse_any(
+   size_t                call_id   ,
+   size_t                order_up  ,
+   const vector<Scalar>& taylor_x  ,
+   const vector<Scalar>& taylor_y  ,
+   vector<Scalar>&       partial_x ,
+   const vector<Scalar>& partial_y )
+{  // call
+   // a copy because the AD<Base> recurrences add call_id values
+   call_struct call = get_call(call_id);
+   //
+   // partial_x
+   for(size_t i = 0; i < partial_x.size(); ++i)
+      partial_x[i] = Scalar(0);
+   //
+   switch( call.op )
+   {  case mat_mul_enum:
+      return reverse_mat_mul(
+         call, order_up, taylor_x, taylor_y, partial_x, partial_y
+      );
+
+      case lower_solve_enum:
+      case upper_solve_enum:
+      case lu_solve_enum:
+      case chol_solve_enum:
+      return reverse_solve(
+         call, order_up, taylor_x, taylor_y, partial_x, partial_y
+      );
+
+      case log_det_enum:
+      return reverse_log_det(
+         call, order_up, taylor_x, taylor_y, partial_x, partial_y
+      );
+
+      default:
+      CPPAD_ASSERT_UNKNOWN( false );
+   }
+   return false;
+}
+} // END_CPPAD_NAMESPACE
+
+# endif
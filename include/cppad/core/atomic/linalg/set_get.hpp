@@ -0,0 +1,75 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_SET_GET_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_SET_GET_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+//
+// set
+template <class Base>
+size_t atomic_linalg<Base>::set(
+   op_enum_t op, size_t n_left, size_t n_middle, size_t n_right
+)
+{  CPPAD_ASSERT_UNKNOWN( op < number_op_enum );
+   //
+   // thread
+   size_t thread = thread_alloc::thread_num();
+   //
+   // work_[thread]
+   if( work_[thread] == nullptr )
+      work_[thread] = new thread_struct;
+   thread_struct& work = *work_[thread];
+   //
+   // call
+   call_struct call;
+   call.op       = op;
+   call.n_left   = n_left;
+   call.n_middle = n_middle;
+   call.n_right  = n_right;
+   //
+   // call_id
+   // reuse the call_id if this operation and dimensions have been set
+   typename std::map<call_struct, size_t, call_less>::iterator itr =
+      work.call_map.find(call);
+   if( itr != work.call_map.end() )
+      return itr->second;
+   size_t call_id = work.call_vec.size();
+   work.call_vec.push_back(call);
+   work.call_map[call] = call_id;
+   //
+   return call_id;
+}
+//
+// get_call
+template <class Base>
+const typename atomic_linalg<Base>::call_struct&
+atomic_linalg<Base>::get_call(size_t call_id)
+{  size_t thread = thread_alloc::thread_num();
+   CPPAD_ASSERT_KNOWN(
+      work_[thread] != nullptr && call_id < work_[thread]->call_vec.size(),
+      "atomic_linalg: call_id was not created by a set function "
+      "for this thread"
+   );
+   return work_[thread]->call_vec[call_id];
+}
+//
+// get
+template <class Base>
+void atomic_linalg<Base>::get(
+   size_t     call_id   ,
+   op_enum_t& op        ,
+   size_t&    n_left    ,
+   size_t&    n_middle  ,
+   size_t&    n_right   )
+{  const call_struct& call = get_call(call_id);
+   op       = call.op;
+   n_left   = call.n_left;
+   n_middle = call.n_middle;
+   n_right  = call.n_right;
+}
+} // END_CPPAD_NAMESPACE
+
+# endif
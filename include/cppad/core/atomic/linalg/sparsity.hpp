@@ -0,0 +1,334 @@
+# ifndef CPPAD_CORE_ATOMIC_LINALG_SPARSITY_HPP
+# define CPPAD_CORE_ATOMIC_LINALG_SPARSITY_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+// ---------------------------------------------------------------------------
+// use_a
+template <class Base>
+bool atomic_linalg<Base>::use_a(op_enum_t op, size_t r, size_t c)
+{  switch( op )
+   {  case lower_solve_enum:
+      case chol_solve_enum:
+      return c <= r;
+
+      case upper_solve_enum:
+      return r <= c;
+
+      default:
+      break;
+   }
+   return true;
+}
+// row_range
+template <class Base>
+void atomic_linalg<Base>::row_range(
+   op_enum_t op, size_t n, size_t i, size_t& r_begin, size_t& r_end
+)
+{  // row i of X = S^{-1} B depends on rows [r_begin, r_end) of S and B
+   r_begin = 0;
+   r_end   = n;
+   if( op == lower_solve_enum )
+      r_end = i + 1;
+   else if( op == upper_solve_enum )
+      r_begin = i;
+}
+// ---------------------------------------------------------------------------
+// for_type override
+template <class Base>
+bool atomic_linalg<Base>::for_type(
+   size_t                                     call_id     ,
+   const CppAD::vector<CppAD::ad_type_enum>&  type_x      ,
+   CppAD::vector<CppAD::ad_type_enum>&        type_y      )
+{  call_struct call = get_call(call_id);
+   op_enum_t op     = call.op;
+   size_t n_left    = call.n_left;
+   size_t n_middle  = call.n_middle;
+   size_t n_right   = call.n_right;
+   size_t offset    = n_left * n_middle;
+   CPPAD_ASSERT_UNKNOWN(
+      op == log_det_enum || type_x.size() == offset + n_middle * n_right
+   );
+   //
+   if( op == mat_mul_enum )
+   {  // treat multiplication by zero like absolute zero
+      for(size_t i = 0; i < n_left; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  ad_type_enum type_ij = identical_zero_enum;
+            for(size_t k = 0; k < n_middle; ++k)
+            {  ad_type_enum type_ik = type_x[i * n_middle + k];
+               ad_type_enum type_kj = type_x[offset + k * n_right + j];
+               if( type_ik != identical_zero_enum &&
+                   type_kj != identical_zero_enum )
+               {  type_ij = std::max(type_ij, type_ik);
+                  type_ij = std::max(type_ij, type_kj);
+               }
+            }
+            type_y[i * n_right + j] = type_ij;
+         }
+      }
+      return true;
+   }
+   //
+   size_t n = n_left;
+   if( op == log_det_enum )
+   {  // log_det and sign
+      ad_type_enum type = constant_enum;
+      for(size_t k = 0; k < n * n; ++k)
+         type = std::max(type, type_x[k]);
+      type_y[0] = type;
+      type_y[1] = type;
+      return true;
+   }
+   //
+   // solve: X(i, j) is identically zero when the rows of B it depends on
+   // are identically zero
+   for(size_t i = 0; i < n; ++i)
+   {  size_t r_begin, r_end;
+      row_range(op, n, i, r_begin, r_end);
+      //
+      // type_a
+      ad_type_enum type_a = identical_zero_enum;
+      for(size_t r = r_begin; r < r_end; ++r)
+      {  for(size_t c = 0; c < n; ++c) if( use_a(op, r, c) )
+            type_a = std::max(type_a, type_x[r * n + c]);
+      }
+      for(size_t j = 0; j < n_right; ++j)
+      {  ad_type_enum type_b = identical_zero_enum;
+         for(size_t r = r_begin; r < r_end; ++r)
+            type_b = std::max(type_b, type_x[offset + r * n_right + j]);
+         if( type_b == identical_zero_enum )
+            type_y[i * n_right + j] = identical_zero_enum;
+         else
+            type_y[i * n_right + j] = std::max(type_a, type_b);
+      }
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// jac_sparsity override
+template <class Base>
+bool atomic_linalg<Base>::jac_sparsity(
+   size_t                                         call_id      ,
+   bool                                           dependency   ,
+   const CppAD::vector<bool>&                     ident_zero_x ,
+   const CppAD::vector<bool>&                     select_x     ,
+   const CppAD::vector<bool>&                     select_y     ,
+   CppAD::sparse_rc< CppAD::vector<size_t> >&     pattern_out  )
+{  call_struct call = get_call(call_id);
+   op_enum_t op     = call.op;
+   size_t n_left    = call.n_left;
+   size_t n_middle  = call.n_middle;
+   size_t n_right   = call.n_right;
+   size_t offset    = n_left * n_middle;
+   //
+   // pattern_out
+   size_t nx = select_x.size();
+   size_t ny = select_y.size();
+   pattern_out.resize(ny, nx, 0);
+   //
+   if( op == mat_mul_enum )
+   {  for(size_t i = 0; i < n_left; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  size_t ij = i * n_right + j;               // C_{i,j} = y[ij]
+            if( select_y[ij] ) for(size_t k = 0; k < n_middle; ++k)
+            {  size_t ik = i * n_middle + k;          // A_{i,k} = x[ik]
+               size_t kj = offset + k * n_right + j;  // B_{k,j} = x[kj]
+               if( select_x[ik] && ! ident_zero_x[kj] )
+                  pattern_out.push_back(ij, ik);
+               if( select_x[kj] && ! ident_zero_x[ik] )
+                  pattern_out.push_back(ij, kj);
+            }
+         }
+      }
+      return true;
+   }
+   //
+   size_t n = n_left;
+   if( op == log_det_enum )
+   {  // the derivative of the sign is zero
+      for(size_t i = 0; i < 2; ++i)
+      {  if( select_y[i] && (i == 0 || dependency) )
+         {  for(size_t k = 0; k < n * n; ++k) if( select_x[k] )
+               pattern_out.push_back(i, k);
+         }
+      }
+      return true;
+   }
+   //
+   // solve
+   for(size_t i = 0; i < n; ++i)
+   {  size_t r_begin, r_end;
+      row_range(op, n, i, r_begin, r_end);
+      for(size_t j = 0; j < n_right; ++j)
+      {  size_t ij = i * n_right + j;                   // X_{i,j} = y[ij]
+         if( select_y[ij] )
+         {  for(size_t r = r_begin; r < r_end; ++r)
+            {  for(size_t c = 0; c < n; ++c)
+               {  size_t rc = r * n + c;               // A_{r,c} = x[rc]
+                  if( use_a(op, r, c) && select_x[rc] )
+                     pattern_out.push_back(ij, rc);
+               }
+               size_t rj = offset + r * n_right + j;   // B_{r,j} = x[rj]
+               if( select_x[rj] )
+                  pattern_out.push_back(ij, rj);
+            }
+         }
+      }
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// hes_sparsity override
+template <class Base>
+bool atomic_linalg<Base>::hes_sparsity(
+   size_t                                         call_id      ,
+   const CppAD::vector<bool>&                     ident_zero_x ,
+   const CppAD::vector<bool>&                     select_x     ,
+   const CppAD::vector<bool>&                     select_y     ,
+   CppAD::sparse_rc< CppAD::vector<size_t> >&     pattern_out  )
+{  call_struct call = get_call(call_id);
+   op_enum_t op     = call.op;
+   size_t n_left    = call.n_left;
+   size_t n_middle  = call.n_middle;
+   size_t n_right   = call.n_right;
+   size_t offset    = n_left * n_middle;
+   //
+   // pattern_out
+   size_t nx = select_x.size();
+   pattern_out.resize(nx, nx, 0);
+   //
+   if( op == mat_mul_enum )
+   {  for(size_t i = 0; i < n_left; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  size_t ij = i * n_right + j;               // C_{i,j} = y[ij]
+            if( select_y[ij] ) for(size_t k = 0; k < n_middle; ++k)
+            {  size_t ik = i * n_middle + k;          // A_{i,k} = x[ik]
+               size_t kj = offset + k * n_right + j;  // B_{k,j} = x[kj]
+               if( select_x[ik] && select_x[kj] )
+               {  // an (ik, kj) pair can only occur once in this loop
+                  pattern_out.push_back(ik, kj);
+                  pattern_out.push_back(kj, ik);
+               }
+            }
+         }
+      }
+      return true;
+   }
+   //
+   size_t n = n_left;
+   if( op == log_det_enum )
+   {  // the sign is piecewise constant
+      if( select_y[0] )
+      {  for(size_t k = 0; k < n * n; ++k) if( select_x[k] )
+         {  for(size_t ell = 0; ell < n * n; ++ell) if( select_x[ell] )
+               pattern_out.push_back(k, ell);
+         }
+      }
+      return true;
+   }
+   //
+   // solve: X = S^{-1} * B is linear in B so there are no B-B terms.
+   //
+   // a_begin, a_end, b_begin[j], b_end[j]
+   // rows of A and of column j of B that the selected results depend on
+   size_t a_begin = n, a_end = 0;
+   vector<size_t> b_begin(n_right), b_end(n_right);
+   for(size_t j = 0; j < n_right; ++j)
+   {  b_begin[j] = n;
+      b_end[j]   = 0;
+      for(size_t i = 0; i < n; ++i) if( select_y[i * n_right + j] )
+      {  size_t r_begin, r_end;
+         row_range(op, n, i, r_begin, r_end);
+         b_begin[j] = std::min(b_begin[j], r_begin);
+         b_end[j]   = std::max(b_end[j], r_end);
+      }
+      a_begin = std::min(a_begin, b_begin[j]);
+      a_end   = std::max(a_end, b_end[j]);
+   }
+   //
+   // A-A and A-B terms
+   for(size_t r = a_begin; r < a_end; ++r)
+   {  for(size_t c = 0; c < n; ++c)
+      {  size_t rc = r * n + c;                         // A_{r,c} = x[rc]
+         if( use_a(op, r, c) && select_x[rc] )
+         {  for(size_t s = a_begin; s < a_end; ++s)
+            {  for(size_t d = 0; d < n; ++d)
+               {  size_t sd = s * n + d;                // A_{s,d} = x[sd]
+                  if( use_a(op, s, d) && select_x[sd] )
+                     pattern_out.push_back(rc, sd);
+               }
+            }
+            for(size_t j = 0; j < n_right; ++j)
+            {  for(size_t s = b_begin[j]; s < b_end[j]; ++s)
+               {  size_t sj = offset + s * n_right + j; // B_{s,j} = x[sj]
+                  if( select_x[sj] )
+                  {  pattern_out.push_back(rc, sj);
+                     pattern_out.push_back(sj, rc);
+                  }
+               }
+            }
+         }
+      }
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// rev_depend override
+template <class Base>
+bool atomic_linalg<Base>::rev_depend(
+   size_t                         call_id      ,
+   const CppAD::vector<bool>&     ident_zero_x ,
+   CppAD::vector<bool>&           depend_x     ,
+   const CppAD::vector<bool>&     depend_y     )
+{  call_struct call = get_call(call_id);
+   op_enum_t op     = call.op;
+   size_t n_left    = call.n_left;
+   size_t n_middle  = call.n_middle;
+   size_t n_right   = call.n_right;
+   size_t offset    = n_left * n_middle;
+   //
+   if( op == mat_mul_enum )
+   {  for(size_t i = 0; i < n_left; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  if( depend_y[i * n_right + j] )
+            {  for(size_t k = 0; k < n_middle; ++k)
+               {  depend_x[i * n_middle + k]           = true;
+                  depend_x[offset + k * n_right + j]   = true;
+               }
+            }
+         }
+      }
+      return true;
+   }
+   //
+   size_t n = n_left;
+   if( op == log_det_enum )
+   {  if( depend_y[0] || depend_y[1] )
+      {  for(size_t k = 0; k < n * n; ++k)
+            depend_x[k] = true;
+      }
+      return true;
+   }
+   //
+   // solve
+   for(size_t i = 0; i < n; ++i)
+   {  size_t r_begin, r_end;
+      row_range(op, n, i, r_begin, r_end);
+      for(size_t j = 0; j < n_right; ++j) if( depend_y[i * n_right + j] )
+      {  for(size_t r = r_begin; r < r_end; ++r)
+         {  for(size_t c = 0; c < n; ++c) if( use_a(op, r, c) )
+               depend_x[r * n + c] = true;
+            depend_x[offset + r * n_right + j] = true;
+         }
+      }
+   }
+   return true;
+}
+} // END_CPPAD_NAMESPACE
+
+# endif
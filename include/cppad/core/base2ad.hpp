@@ -2,7 +2,7 @@
 # define CPPAD_CORE_BASE2AD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin base2ad}
@@ -84,6 +84,7 @@ ADFun< AD<Base>, RecBase > ADFun<Base,RecBase>::base2ad(void) const
    CPPAD_ASSERT_UNKNOWN( fun.num_order_taylor_ == 0 ) ;
    CPPAD_ASSERT_UNKNOWN( fun.cap_order_taylor_ == 0 );
    CPPAD_ASSERT_UNKNOWN( fun.num_direction_taylor_ == 0 );
+   fun.taylor_high_water_         = taylor_high_water_;
    fun.num_var_tape_              = num_var_tape_;
    //
    // pod_vector objects
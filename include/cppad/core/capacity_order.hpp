@@ -22,7 +22,9 @@ Syntax
 
 See Also
 ========
-:ref:`fun_property-name`
+:ref:`fun_property-name` ,
+:ref:`taylor_high_water-name` ,
+:ref:`memory_info-name`
 
 Purpose
 *******
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_CHKPOINT_TWO_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
@@ -119,6 +119,11 @@ private:
    /// can this checkpoint function be used in parallel mode
    const bool use_in_parallel_;
    //
+   /// If true, all the threads evaluate g_ and ag_ using a separate
+   /// work space for each thread (instead of a separate copy of g_ and ag_).
+   /// This is set by the constructor and constant after that.
+   bool shared_tape_;
+   //
    /// Jacobian sparsity for g(x) with dependncy true.
    /// This is set by the constructor and constant after that.
    sparse_rc< vector<size_t> > jac_sparsity_;
@@ -135,16 +140,42 @@ private:
    /// If use_in_parallel_, this is constant after the constructor.
    ADFun< AD<Base>, Base>  ag_;
    // ------------------------------------------------------------------------
+   // shared_work
+   // ------------------------------------------------------------------------
+   /// Work space used to evaluate the shared tape for one thread.
+   template <class Scalar>
+   struct shared_work {
+      /// Taylor coefficients for all the variables in the tape
+      local::pod_vector_maybe<Scalar> taylor;
+      //
+      /// Partial derivatives for all the variables in the tape
+      local::pod_vector_maybe<Scalar> partial;
+      //
+      /// which operations can be conditionally skipped
+      local::pod_vector<bool> cskip_op;
+      //
+      /// variable corresponding to each vecad load operation
+      local::pod_vector<addr_t> load_op2var;
+   };
+   // ------------------------------------------------------------------------
    // member_
    // ------------------------------------------------------------------------
    /// If use_in_parallel_ is true, must have a separate copy member data
    /// that is not constant.
    struct member_struct {
       //
-      /// function corresponding to this checkpoint object
+      /// If shared_tape_ is true, work space for evaluating g_
+      shared_work<Base>           work_;
+      //
+      /// If shared_tape_ is true, work space for evaluating ag_
+      shared_work< AD<Base> >     awork_;
+      //
+      /// If copy_g_ is true, g_ is a copy of the function corresponding
+      /// to this checkpoint object and it is used by this thread.
+      bool                        copy_g_;
       ADFun<Base>                 g_;
       //
-      /// AD version of this function object
+      /// If shared_tape_ is false, AD version of this function object
       ADFun< AD<Base>, Base >     ag_;
       //
    };
@@ -166,14 +197,40 @@ private:
          // call member_struct constructor
          new( member_[thread] ) member_struct;
          //
-         // The thread has a copy of corresponding information.
-         member_[thread]->g_  = g_;
-         member_[thread]->ag_ = ag_;
+         // If the tape is not shared,
+         // the thread has a copy of corresponding information.
+         member_[thread]->copy_g_ = ! shared_tape_;
+         if( ! shared_tape_ )
+         {  member_[thread]->g_  = g_;
+            member_[thread]->ag_ = ag_;
+         }
       }
       return;
    }
    //
    // ------------------------------------------------------------------------
+   // shared_forward
+   template <class Scalar>
+   static void shared_forward(
+      const ADFun<Scalar, Base>&   fun       ,
+      shared_work<Scalar>&         work      ,
+      size_t                       order_up  ,
+      const vector<Scalar>&        taylor_x  ,
+      vector<Scalar>&              taylor_y
+   );
+   // shared_reverse
+   template <class Scalar>
+   static void shared_reverse(
+      const ADFun<Scalar, Base>&   fun       ,
+      shared_work<Scalar>&         work      ,
+      size_t                       order_up  ,
+      const vector<Scalar>&        taylor_x  ,
+      const vector<Scalar>&        taylor_y  ,
+      vector<Scalar>&              partial_x ,
+      const vector<Scalar>&        partial_y
+   );
+   //
+   // ------------------------------------------------------------------------
    /// free member_ for this thread
    void free_member(size_t thread)
    {  if( member_[thread] != nullptr )
@@ -287,9 +344,12 @@ public:
    use_hes_sparsity_ ( other.use_hes_sparsity_ ) ,
    use_base2ad_      ( other.use_base2ad_ ) ,
    use_in_parallel_  ( other.use_in_parallel_ ) ,
+   shared_tape_      ( other.shared_tape_ ) ,
    jac_sparsity_     ( other.jac_sparsity_ ) ,
    hes_sparsity_     ( other.hes_sparsity_ )
-   {  g_  = other.g_;
+   {  for(size_t thread = 0; thread < CPPAD_MAX_NUM_THREADS; thread++)
+         member_[thread] = nullptr;
+      g_  = other.g_;
       ag_ = other.ag_;
    }
    //
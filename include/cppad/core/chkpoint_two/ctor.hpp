@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_CTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin chkpoint_two_ctor}
@@ -74,7 +74,21 @@ use_in_parallel
 ***************
 If this is true, *chk_fun* can be used
 :ref:`ta_parallel_setup@in_parallel` .
-This requires some extra memory for a constant copy of the *fun*
+
+Shared Tape
+===========
+If *fun* does not contain any atomic function calls,
+all the threads use the same constant copy of the *fun* operation sequence.
+Each thread that uses *chk_fun* only has its own work space for
+the Taylor coefficients and partial derivatives that it computes.
+This requires much less memory than a copy of *fun* for each thread.
+A thread that calls :ref:`chkpoint_two_dynamic-name` gets its own copy
+of *fun* (because it is changing its dynamic parameters).
+
+Separate Tapes
+==============
+If *fun* contains atomic function calls,
+this requires some extra memory for a constant copy of the *fun*
 information and a separate copy (that changes) for each thread.
 
 chk_fun
@@ -150,6 +164,11 @@ use_in_parallel_ ( use_in_parallel )
    if( use_base2ad )
       ag_ = g_.base2ad();
    //
+   // shared_tape_
+   // The sweeps use work space in the tape for atomic function calls,
+   // so a tape with atomic function calls cannot be shared.
+   shared_tape_ = use_in_parallel && ! g_.play_.has_atom_call();
+   //
    // jac_sparsity__
    size_t n = g_.Domain();
    size_t m = g_.Range();
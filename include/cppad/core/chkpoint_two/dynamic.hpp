@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_DYNAMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin chkpoint_two_dynamic}
@@ -54,7 +54,9 @@ This only affects the copy of *fun* used by *chk_fun* .
 Multi-Threading
 ***************
 If one is using :ref:`in_parallel<ta_in_parallel-name>` ,
-there is a separate copy of *fun* for each thread.
+the first call to ``new_dynamic`` by a thread
+creates a separate copy of *fun* for that thread; see
+:ref:`chkpoint_two_ctor@use_in_parallel` .
 In this case, only the dynamic parameters in the copy for the current
 :ref:`thread number<ta_thread_num-name>` are changed.
 
@@ -86,6 +88,13 @@ void chkpoint_two<Base>::new_dynamic(const BaseVector& dynamic)
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
+      //
+      // This thread's dynamic parameters are different from the shared
+      // tape, so it needs its own copy of g_.
+      if( ! member_[thread]->copy_g_ )
+      {  member_[thread]->g_      = g_;
+         member_[thread]->copy_g_ = true;
+      }
       g_ptr = &(member_[thread]->g_);
    }
 # ifndef NDEBUG
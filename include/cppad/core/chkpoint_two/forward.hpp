@@ -2,7 +2,7 @@
 # define CPPAD_CORE_CHKPOINT_TWO_FORWARD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -48,6 +48,13 @@ bool chkpoint_two<Base>::forward(
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
+      if( ! member_[thread]->copy_g_ )
+      {  // use the shared tape and this thread's work space
+         shared_forward(
+            g_, member_[thread]->work_, order_up, taylor_x, taylor_y
+         );
+         return true;
+      }
       g_ptr = &(member_[thread]->g_);
    }
 # ifndef NDEBUG
@@ -104,6 +111,13 @@ bool chkpoint_two<Base>::forward(
    if( use_in_parallel_ )
    {  size_t thread = thread_alloc::thread_num();
       allocate_member(thread);
+      if( shared_tape_ )
+      {  // use the shared tape and this thread's work space
+         shared_forward(
+            ag_, member_[thread]->awork_, order_up, ataylor_x, ataylor_y
+         );
+         return true;
+      }
       ag_ptr = &(member_[thread]->ag_);
    }
 # ifndef NDEBUG
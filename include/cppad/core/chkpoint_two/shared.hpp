@@ -0,0 +1,209 @@
+# ifndef CPPAD_CORE_CHKPOINT_TWO_SHARED_HPP
+# define CPPAD_CORE_CHKPOINT_TWO_SHARED_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file chkpoint_two/shared.hpp
+Evaluate a checkpoint function tape that is shared by all the threads.
+*/
+/*!
+Forward mode using a shared tape and a work space for this thread
+
+\tparam Scalar
+is Base or AD<Base>.
+
+\param fun [in]
+is the function, g_ or ag_, corresponding to this checkpoint object.
+The tape in fun is not modified and can be used by other threads
+at the same time.
+
+\param work [in,out]
+is the work space for this thread. Upon return, work.taylor contains
+orders zero through order_up for all the variables in fun.
+
+\param order_up [in]
+highest order for this forward mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients, orders zero through order_up, for the domain of fun.
+
+\param taylor_y [out]
+Taylor coefficients, orders zero through order_up, for the range of fun.
+*/
+template <class Base>
+template <class Scalar>
+void chkpoint_two<Base>::shared_forward(
+   const ADFun<Scalar, Base>&   fun       ,
+   shared_work<Scalar>&         work      ,
+   size_t                       order_up  ,
+   const vector<Scalar>&        taylor_x  ,
+   vector<Scalar>&              taylor_y  )
+{  // used to identify the RecBase type in calls to sweeps
+   Base not_used_rec_base(0.0);
+   //
+   // n, m, num_var, C
+   size_t n       = fun.ind_taddr_.size();
+   size_t m       = fun.dep_taddr_.size();
+   size_t num_var = fun.num_var_tape_;
+   size_t C       = order_up + 1;
+   CPPAD_ASSERT_UNKNOWN( taylor_x.size() == n * C );
+   //
+   // work
+   // the vectors only allocate memory when they need to grow
+   const local::player<Scalar>& play( fun.play_ );
+   work.taylor.resize(num_var * C);
+   work.cskip_op.resize( play.num_op_rec() );
+   work.load_op2var.resize( play.num_var_load_rec() );
+   //
+   // The optimizer may skip a step that does not affect dependent variables.
+   // Initilaizing zero order coefficients avoids following valgrind warning:
+   // "Conditional jump or move depends on uninitialised value(s)".
+   for(size_t i = 0; i < num_var * C; ++i)
+      work.taylor[i] = CppAD::numeric_limits<Scalar>::quiet_NaN();
+   //
+   // set Taylor coefficients for independent variables
+   for(size_t j = 0; j < n; ++j)
+   {  for(size_t k = 0; k < C; ++k)
+         work.taylor[ C * fun.ind_taddr_[j] + k] = taylor_x[ C * j + k];
+   }
+   //
+   // compare_change_count
+   // zero means do not check for comparison changes
+   size_t compare_change_count    = 0;
+   size_t compare_change_number   = 0;
+   size_t compare_change_op_index = 0;
+   //
+   // evaluate the derivatives
+   if( order_up == 0 )
+   {  local::sweep::forward0(&play, std::cout, true,
+         n, num_var, C,
+         work.taylor.data(), work.cskip_op.data(), work.load_op2var,
+         compare_change_count,
+         compare_change_number,
+         compare_change_op_index,
+         not_used_rec_base
+      );
+   }
+   else
+   {  size_t p = 0;
+      local::sweep::forward1(&play, std::cout, true, p, order_up,
+         n, num_var, C,
+         work.taylor.data(), work.cskip_op.data(), work.load_op2var,
+         compare_change_count,
+         compare_change_number,
+         compare_change_op_index,
+         not_used_rec_base
+      );
+   }
+   //
+   // taylor_y
+   CPPAD_ASSERT_UNKNOWN( taylor_y.size() == m * C );
+   for(size_t i = 0; i < m; ++i)
+   {  for(size_t k = 0; k < C; ++k)
+         taylor_y[ C * i + k] = work.taylor[ C * fun.dep_taddr_[i] + k ];
+   }
+   return;
+}
+/*!
+Reverse mode using a shared tape and a work space for this thread
+
+\tparam Scalar
+is Base or AD<Base>.
+
+\param fun [in]
+is the function, g_ or ag_, corresponding to this checkpoint object.
+The tape in fun is not modified and can be used by other threads
+at the same time.
+
+\param work [in,out]
+is the work space for this thread.
+
+\param order_up [in]
+highest order for this reverse mode calculation.
+
+\param taylor_x [in]
+Taylor coefficients, orders zero through order_up, for the domain of fun.
+
+\param taylor_y [in]
+Taylor coefficients, orders zero through order_up, for the range of fun.
+
+\param partial_x [out]
+partial derivatives with respect to the Taylor coefficients for the domain.
+
+\param partial_y [in]
+partial derivatives with respect to the Taylor coefficients for the range.
+*/
+template <class Base>
+template <class Scalar>
+void chkpoint_two<Base>::shared_reverse(
+   const ADFun<Scalar, Base>&   fun       ,
+   shared_work<Scalar>&         work      ,
+   size_t                       order_up  ,
+   const vector<Scalar>&        taylor_x  ,
+   const vector<Scalar>&        taylor_y  ,
+   vector<Scalar>&              partial_x ,
+   const vector<Scalar>&        partial_y )
+{  // used to identify the RecBase type in calls to sweeps
+   Base not_used_rec_base(0.0);
+   //
+   // n, m, num_var, q
+   size_t n       = fun.ind_taddr_.size();
+   size_t m       = fun.dep_taddr_.size();
+   size_t num_var = fun.num_var_tape_;
+   size_t q       = order_up + 1;
+   //
+   // compute forward mode Taylor coefficient orders 0 through order_up
+   vector<Scalar> check(m * q);
+   shared_forward(fun, work, order_up, taylor_x, check);
+# ifndef NDEBUG
+   CPPAD_ASSERT_UNKNOWN( taylor_y.size() == check.size() )
+   for(size_t i = 0; i < taylor_y.size(); ++i)
+      CPPAD_ASSERT_UNKNOWN( taylor_y[i] == check[i] );
+# endif
+   //
+   // work.partial
+   Scalar zero(0);
+   work.partial.resize(num_var * q);
+   for(size_t i = 0; i < num_var * q; ++i)
+      work.partial[i] = zero;
+   //
+   // set the dependent variable direction
+   // (use += because two dependent variables can point to same location)
+   for(size_t i = 0; i < m; ++i)
+   {  for(size_t k = 0; k < q; ++k)
+         work.partial[ fun.dep_taddr_[i] * q + k ] += partial_y[i * q + k];
+   }
+   //
+   // evaluate the derivatives
+   const local::player<Scalar>& play( fun.play_ );
+   local::play::const_sequential_iterator play_itr = play.end();
+   local::sweep::reverse(
+      order_up,
+      n,
+      num_var,
+      &play,
+      q,
+      work.taylor.data(),
+      q,
+      work.partial.data(),
+      work.cskip_op.data(),
+      work.load_op2var,
+      play_itr,
+      not_used_rec_base
+   );
+   //
+   // partial_x
+   CPPAD_ASSERT_UNKNOWN( partial_x.size() == n * q );
+   for(size_t j = 0; j < n; ++j)
+   {  for(size_t k = 0; k < q; ++k)
+         partial_x[j * q + k] = work.partial[ fun.ind_taddr_[j] * q + k ];
+   }
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,180 @@
+# ifndef CPPAD_CORE_COND_EXP_SWITCH_HPP
+# define CPPAD_CORE_COND_EXP_SWITCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+-------------------------------------------------------------------------------
+{xrst_begin CondExpSwitch}
+
+AD Multi-Way Conditional Expression
+###################################
+
+Syntax
+******
+*result* = ``CondExpSwitch`` ( *x* , *breakpoint* , *value* )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+Record,
+as part of an AD of *Base*
+:ref:`operation sequence<glossary@Operation@Sequence>` ,
+the piecewise result
+
+.. math::
+
+   \R{result} = \left\{ \begin{array}{ll}
+      \R{value}_0     & \R{if} \; x < \R{breakpoint}_0
+      \\
+      \R{value}_k     & \R{if} \;
+         \R{breakpoint}_{k-1} \leq x < \R{breakpoint}_k
+      \\
+      \R{value}_{K-1} & \R{if} \; \R{breakpoint}_{K-2} \leq x
+   \end{array} \right.
+
+where :math:`K` is the number of values.
+The choice of *value* is made each time
+:ref:`f.Forward<Forward-name>` is used to evaluate the zero order Taylor
+coefficients; i.e., the piecewise function can be evaluated
+at any *x* without re-recording it.
+
+Vector
+******
+The type *Vector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``AD`` < *Base* > .
+
+x
+*
+This is the argument that selects the piece of the function.
+
+breakpoint
+**********
+This vector has size :math:`K-1` and its elements must be in
+increasing order; i.e., *breakpoint* [ *k* - 1 ] < *breakpoint* [ *k* ] .
+
+value
+*****
+This vector has size :math:`K` which must be greater than zero.
+The element *value* [ *k* ] is the result
+when *x* is in the *k*-th interval defined by *breakpoint* .
+
+Operation Sequence
+******************
+The result is recorded as a balanced binary tree of
+:ref:`CondExpLt<CondExp-name>` operations.
+Each operation compares *x* with one of the breakpoints.
+Hence :math:`K-1` conditional expressions are recorded,
+but only the comparisons on one path through the tree
+(about :math:`\log_2 (K)` comparisons) are required to compute the result.
+
+Optimize
+********
+The :ref:`optimize-name` method will optimize conditional expressions
+so that only the operations required for the active piece are computed;
+see :ref:`CondExp@Optimize` .
+For this to work, the operations that compute *value* [ *k* ]
+must only be used by ``CondExpSwitch`` .
+The :ref:`number_skip-name` function can be used to check how many
+variables are skipped for a particular value of *x* .
+The use of a binary tree means that the number of comparisons that are
+not skipped grows like :math:`\log_2 (K)`
+(instead of :math:`K` for a sequence of nested ``CondExpLt`` operations).
+
+Speed
+*****
+The program :ref:`speed_cond_exp-name` compares the speed of this
+function with a sequence of nested ``CondExpLt`` operations.
+{xrst_toc_hidden
+   example/general/cond_exp_switch.cpp
+}
+Example
+*******
+The file
+:ref:`cond_exp_switch.cpp-name`
+contains an example and test of this function.
+
+{xrst_end CondExpSwitch}
+-------------------------------------------------------------------------------
+*/
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+\file cond_exp_switch.hpp
+Multi-way conditional expression.
+*/
+
+/*!
+Record the multi-way conditional expression for a range of values.
+
+\param x
+is the argument that selects the piece of the function.
+
+\param breakpoint
+is the vector of breakpoints (see CondExpSwitch).
+
+\param value
+is the vector of values (see CondExpSwitch).
+
+\param begin
+is the index in value for the first value in this range.
+
+\param end
+is one greater than the index in value for the last value in this range
+(begin < end).
+
+\return
+is value[k] where k is the index in the range [begin, end)
+selected by x. Only breakpoint[k-1] for begin < k < end are used.
+*/
+template <class Base, class Vector>
+AD<Base> cond_exp_switch(
+   const AD<Base>& x          ,
+   const Vector&   breakpoint ,
+   const Vector&   value      ,
+   size_t          begin      ,
+   size_t          end        )
+{  CPPAD_ASSERT_UNKNOWN( begin < end );
+   if( end - begin == 1 )
+      return value[begin];
+   //
+   // mid
+   // index in value of first element in the upper half of the range
+   size_t mid = (begin + end) / 2;
+   //
+   AD<Base> lower = cond_exp_switch(x, breakpoint, value, begin, mid);
+   AD<Base> upper = cond_exp_switch(x, breakpoint, value, mid, end);
+   return CondExpLt(x, breakpoint[mid - 1], lower, upper);
+}
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_PROTOTYPE
+template <class Base, class Vector>
+AD<Base> CondExpSwitch(
+   const AD<Base>& x          ,
+   const Vector&   breakpoint ,
+   const Vector&   value      )
+// END_PROTOTYPE
+{  size_t n_value = size_t( value.size() );
+   CPPAD_ASSERT_KNOWN(
+      n_value > 0,
+      "CondExpSwitch: the size of value is zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( breakpoint.size() ) + 1 == n_value,
+      "CondExpSwitch: size of breakpoint plus one not equal size of value"
+   );
+   return local::cond_exp_switch(x, breakpoint, value, 0, n_value);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -296,6 +296,9 @@ BaseVector ADFun<Base,RecBase>::Forward(
    // now we have q + 1  taylor_ coefficient orders per variable
    num_order_taylor_ = q + 1;
 
+   // release memory for orders that are not needed by reverse mode
+   taylor_high_water_check();
+
    return yq;
 }
 /*
@@ -499,6 +502,9 @@ BaseVector ADFun<Base,RecBase>::Forward(
    // now we have q + 1  taylor_ coefficient orders per variable
    num_order_taylor_ = q + 1;
 
+   // release memory for orders that are not needed by reverse mode
+   taylor_high_water_check();
+
    return yq;
 }
 
@@ -253,6 +253,7 @@ compare_change_op_index_(0),
 num_order_taylor_(0),
 cap_order_taylor_(0),
 num_direction_taylor_(0),
+taylor_high_water_( std::numeric_limits<size_t>::max() ),
 num_var_tape_(0)
 { }
 //
@@ -305,6 +306,7 @@ void ADFun<Base,RecBase>::operator=(const ADFun& f)
    num_order_taylor_          = f.num_order_taylor_;
    cap_order_taylor_          = f.cap_order_taylor_;
    num_direction_taylor_      = f.num_direction_taylor_;
+   taylor_high_water_         = f.taylor_high_water_;
    num_var_tape_              = f.num_var_tape_;
    //
    // pod_vector objects
@@ -349,6 +351,7 @@ void ADFun<Base,RecBase>::swap(ADFun& f)
    std::swap( num_order_taylor_          , f.num_order_taylor_);
    std::swap( cap_order_taylor_          , f.cap_order_taylor_);
    std::swap( num_direction_taylor_      , f.num_direction_taylor_);
+   std::swap( taylor_high_water_         , f.taylor_high_water_);
    std::swap( num_var_tape_              , f.num_var_tape_);
    //
    // pod_vector objects
@@ -461,6 +464,7 @@ ADFun<Base,RecBase>::ADFun(const ADVector &x, const ADVector &y)
 
    // ad_fun.hpp member values not set by dependent
    check_for_nan_       = true;
+   taylor_high_water_   = std::numeric_limits<size_t>::max();
 
    // allocate memory for one zero order taylor_ coefficient
    CPPAD_ASSERT_UNKNOWN( num_order_taylor_ == 0 );
@@ -0,0 +1,318 @@
+# ifndef CPPAD_CORE_GRAPH_MERGE_GRAPH_HPP
+# define CPPAD_CORE_GRAPH_MERGE_GRAPH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <cppad/core/graph/cpp_graph.hpp>
+
+/*
+------------------------------------------------------------------------------
+{xrst_begin merge_graph}
+{xrst_spell
+   dyn
+}
+
+Merge C++ AD Graphs Into One Graph
+##################################
+
+Syntax
+******
+| ``merge_graph`` (
+| |tab| *graph_obj* , *n_dynamic_ind* , *n_variable_ind* ,
+| |tab| *graph_vec* , *dyn_index* , *var_index*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+Suppose that :math:`g^k (p^k, x^k)` , for :math:`k = 0, \ldots, K-1` ,
+are the functions corresponding to the graphs *graph_vec* [ *k* ] .
+Here :math:`p^k` ( :math:`x^k` ) is the vector of
+independent dynamic parameters (independent variables) for the
+*k*-th function.
+Each component of :math:`p^k` ( :math:`x^k` ) is a component of
+the vector :math:`p` ( :math:`x` ) for the merged function.
+This routine creates the graph for the merged function
+
+.. math::
+
+   f(p, x) = \left[ \begin{array}{c}
+      g^0 ( p^0 , x^0 ) \\
+      \vdots \\
+      g^{K-1} ( p^{K-1} , x^{K-1} )
+   \end{array} \right]
+
+Parallel Recording
+******************
+The recording of each function :math:`g^k` can be done using a
+different thread; see :ref:`parallel_ad-name` .
+Each thread records its function in its own ``ADFun`` object
+and then uses :ref:`to_graph-name` to convert it to a graph.
+After the threads are done and execution is
+:ref:`sequential<ta_in_parallel-name>` ,
+``merge_graph`` creates the graph for :math:`f` and
+:ref:`from_graph-name` converts this graph to an ``ADFun`` object.
+The graph objects must be deleted while in sequential execution mode
+(because each one uses memory that was allocated by its thread).
+
+Parameters
+==========
+The ``from_graph`` routine records the merged function.
+Hence constant parameters that are used by more than one :math:`g^k`
+have one copy in the merged function; see
+:ref:`fun_property@size_par` .
+
+graph_obj
+*********
+The input value of this graph does not matter.
+Upon return, it is the graph corresponding to :math:`f(p, x)` .
+Its :ref:`cpp_ad_graph@function_name` is empty.
+
+n_dynamic_ind
+*************
+is the number of independent dynamic parameters in the merged function;
+i.e., the size of :math:`p` .
+
+n_variable_ind
+**************
+is the number of independent variables in the merged function;
+i.e., the size of :math:`x` .
+
+graph_vec
+*********
+This is the vector of graphs that are merged.
+The :ref:`cpp_ad_graph@atomic_name_vec` ,
+:ref:`cpp_ad_graph@discrete_name_vec` , and
+:ref:`cpp_ad_graph@print_text_vec` for these graphs are merged
+(with each name or text appearing once in the merged graph).
+
+dyn_index
+*********
+This vector has the same size as *graph_vec* and
+*dyn_index* [ *k* ] has size equal to the
+:ref:`cpp_ad_graph@n_dynamic_ind` for *graph_vec* [ *k* ] .
+For each valid *j* ,
+the independent dynamic parameter with index *j* for *graph_vec* [ *k* ]
+is the independent dynamic parameter with index
+*dyn_index* [ *k* ][ *j* ] for the merged function.
+Each element of *dyn_index* [ *k* ] must be less than *n_dynamic_ind* .
+
+var_index
+*********
+This vector has the same size as *graph_vec* and
+*var_index* [ *k* ] has size equal to the
+:ref:`cpp_ad_graph@n_variable_ind` for *graph_vec* [ *k* ] .
+For each valid *j* ,
+the independent variable with index *j* for *graph_vec* [ *k* ]
+is the independent variable with index
+*var_index* [ *k* ][ *j* ] for the merged function.
+Each element of *var_index* [ *k* ] must be less than *n_variable_ind* .
+
+{xrst_toc_hidden
+   example/graph/merge_graph.cpp
+}
+Example
+*******
+The file :ref:`merge_graph.cpp-name` contains an example and test
+of this operation.
+
+{xrst_end merge_graph}
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file merge_graph.hpp
+Merge C++ AD graphs into one graph.
+*/
+
+// BEGIN_PROTOTYPE
+inline void merge_graph(
+   cpp_graph&                       graph_obj      ,
+   size_t                           n_dynamic_ind  ,
+   size_t                           n_variable_ind ,
+   const vector<cpp_graph>&         graph_vec      ,
+   const vector< vector<size_t> >&  dyn_index      ,
+   const vector< vector<size_t> >&  var_index      )
+// END_PROTOTYPE
+{  using namespace CppAD::graph;
+   typedef cpp_graph::const_iterator const_iterator;
+   //
+   // n_graph
+   size_t n_graph = graph_vec.size();
+   CPPAD_ASSERT_KNOWN(
+      dyn_index.size() == n_graph && var_index.size() == n_graph,
+      "merge_graph: dyn_index or var_index size not equal graph_vec size"
+   );
+   //
+   // n_constant, n_result
+   // number of constant nodes and result nodes for each graph
+   vector<size_t> n_constant(n_graph), n_result(n_graph);
+   for(size_t k = 0; k < n_graph; ++k)
+   {  const cpp_graph& graph_k = graph_vec[k];
+      CPPAD_ASSERT_KNOWN(
+         dyn_index[k].size() == graph_k.n_dynamic_ind_get() ,
+         "merge_graph: dyn_index[k].size() != n_dynamic_ind for graph k"
+      );
+      CPPAD_ASSERT_KNOWN(
+         var_index[k].size() == graph_k.n_variable_ind_get() ,
+         "merge_graph: var_index[k].size() != n_variable_ind for graph k"
+      );
+      n_constant[k] = graph_k.constant_vec_size();
+      n_result[k]   = 0;
+      size_t n_op = graph_k.operator_vec_size();
+      const_iterator itr;
+      for(size_t op_index = 0; op_index < n_op; ++op_index)
+      {  if( op_index == 0 )
+            itr = graph_k.begin();
+         else
+            ++itr;
+         n_result[k] += (*itr).n_result;
+      }
+   }
+   //
+   // graph_obj
+   graph_obj.initialize();
+   graph_obj.n_dynamic_ind_set(n_dynamic_ind);
+   graph_obj.n_variable_ind_set(n_variable_ind);
+   //
+   // graph_obj: constant_vec
+   for(size_t k = 0; k < n_graph; ++k)
+   {  const cpp_graph& graph_k = graph_vec[k];
+      for(size_t i = 0; i < n_constant[k]; ++i)
+         graph_obj.constant_vec_push_back( graph_k.constant_vec_get(i) );
+   }
+   //
+   // first_constant, first_result
+   // node index in graph_obj for first constant and first result of graph k
+   size_t first_constant = 1 + n_dynamic_ind + n_variable_ind;
+   size_t first_result   = first_constant + graph_obj.constant_vec_size();
+   //
+   // node_map
+   // maps node indices for graph k to node indices for graph_obj
+   vector<size_t> node_map;
+   //
+   for(size_t k = 0; k < n_graph; ++k)
+   {  const cpp_graph& graph_k = graph_vec[k];
+      size_t n_dynamic_k  = graph_k.n_dynamic_ind_get();
+      size_t n_variable_k = graph_k.n_variable_ind_get();
+      //
+      // node_map
+      // node index zero is not used
+      size_t n_node_k = 1 + n_dynamic_k + n_variable_k;
+      n_node_k       += n_constant[k] + n_result[k];
+      node_map.resize(n_node_k);
+      size_t node_k = 1;
+      for(size_t j = 0; j < n_dynamic_k; ++j)
+      {  CPPAD_ASSERT_KNOWN( dyn_index[k][j] < n_dynamic_ind,
+            "merge_graph: an element of dyn_index[k] >= n_dynamic_ind"
+         );
+         node_map[node_k++] = 1 + dyn_index[k][j];
+      }
+      for(size_t j = 0; j < n_variable_k; ++j)
+      {  CPPAD_ASSERT_KNOWN( var_index[k][j] < n_variable_ind,
+            "merge_graph: an element of var_index[k] >= n_variable_ind"
+         );
+         node_map[node_k++] = 1 + n_dynamic_ind + var_index[k][j];
+      }
+      for(size_t i = 0; i < n_constant[k]; ++i)
+         node_map[node_k++] = first_constant + i;
+      for(size_t i = 0; i < n_result[k]; ++i)
+         node_map[node_k++] = first_result + i;
+      CPPAD_ASSERT_UNKNOWN( node_k == n_node_k );
+      //
+      // graph_obj: operator_vec, operator_arg
+      size_t n_op = graph_k.operator_vec_size();
+      const_iterator itr;
+      for(size_t op_index = 0; op_index < n_op; ++op_index)
+      {  if( op_index == 0 )
+            itr = graph_k.begin();
+         else
+            ++itr;
+         const_iterator::value_type itr_value = *itr;
+         graph_op_enum         op_enum   = itr_value.op_enum;
+         const vector<size_t>& str_index = *itr_value.str_index_ptr;
+         const vector<size_t>& arg_node  = *itr_value.arg_node_ptr;
+         size_t                n_arg     = arg_node.size();
+         //
+         // arguments that come before the node arguments
+         graph_obj.operator_vec_push_back(op_enum);
+         switch( op_enum )
+         {  // name_index
+            case discrete_graph_op:
+            {  const std::string& name =
+                  graph_k.discrete_name_vec_get( str_index[0] );
+               size_t name_index = graph_obj.discrete_name_vec_find(name);
+               if( name_index == graph_obj.discrete_name_vec_size() )
+                  graph_obj.discrete_name_vec_push_back(name);
+               graph_obj.operator_arg_push_back(name_index);
+            }
+            break;
+
+            // name_index, [call_id,] n_result, n_arg
+            case atom_graph_op:
+            case atom4_graph_op:
+            {  const std::string& name =
+                  graph_k.atomic_name_vec_get( str_index[0] );
+               size_t name_index = graph_obj.atomic_name_vec_find(name);
+               if( name_index == graph_obj.atomic_name_vec_size() )
+                  graph_obj.atomic_name_vec_push_back(name);
+               graph_obj.operator_arg_push_back(name_index);
+               if( op_enum == atom4_graph_op )
+                  graph_obj.operator_arg_push_back(itr_value.call_id);
+               graph_obj.operator_arg_push_back(itr_value.n_result);
+               graph_obj.operator_arg_push_back(n_arg);
+            }
+            break;
+
+            // before_index, after_index
+            case print_graph_op:
+            for(size_t i = 0; i < 2; ++i)
+            {  const std::string& text =
+                  graph_k.print_text_vec_get( str_index[i] );
+               size_t text_index = graph_obj.print_text_vec_find(text);
+               if( text_index == graph_obj.print_text_vec_size() )
+                  graph_obj.print_text_vec_push_back(text);
+               graph_obj.operator_arg_push_back(text_index);
+            }
+            break;
+
+            // n_arg
+            case sum_graph_op:
+            graph_obj.operator_arg_push_back(n_arg);
+            break;
+
+            default:
+            CPPAD_ASSERT_UNKNOWN( str_index.size() == 0 );
+            break;
+         }
+         //
+         // node arguments
+         for(size_t i = 0; i < n_arg; ++i)
+         {  CPPAD_ASSERT_UNKNOWN( arg_node[i] < n_node_k );
+            graph_obj.operator_arg_push_back( node_map[ arg_node[i] ] );
+         }
+      }
+      //
+      // graph_obj: dependent_vec
+      for(size_t i = 0; i < graph_k.dependent_vec_size(); ++i)
+         graph_obj.dependent_vec_push_back(
+            node_map[ graph_k.dependent_vec_get(i) ]
+         );
+      //
+      // first_constant, first_result
+      first_constant += n_constant[k];
+      first_result   += n_result[k];
+   }
+   return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
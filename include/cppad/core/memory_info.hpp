@@ -0,0 +1,156 @@
+# ifndef CPPAD_CORE_MEMORY_INFO_HPP
+# define CPPAD_CORE_MEMORY_INFO_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin memory_info}
+{xrst_spell
+   subgraph
+}
+
+Memory Used by Each Component of an ADFun Object
+################################################
+
+Syntax
+******
+| *info* = *f* . ``memory_info`` ()
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+This reports the number of bytes of memory that are currently
+allocated for each component of the function object *f* .
+It can be used to budget memory when there are many
+``ADFun`` objects in one process.
+
+f
+*
+The object *f* has prototype
+
+   ``const ADFun`` < *Base* > *f*
+
+info
+****
+The structure *info* has the following fields
+(all of which have type ``size_t`` ):
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   Field, Bytes used by
+   ``op_seq``, the operation sequence; see :ref:`fun_property@size_op_seq`
+   ``random``, random access information for the operation sequence
+   ``taylor``, the Taylor coefficients; see :ref:`capacity_order-name`
+   ``sparsity``, cached forward Jacobian sparsity patterns
+   ``subgraph``, cached information used by :ref:`subgraph_reverse-name`
+   ``other``, other vectors; see below
+   ``total``, the sum of all the fields above
+
+The ``random`` field is also reported by
+:ref:`fun_property@size_random` .
+The ``sparsity`` field is the sum of
+:ref:`ForSparseJac@size_forward_bool` and
+:ref:`ForSparseJac@size_forward_set` .
+The ``other`` field includes the vectors that have one element
+for each independent variable, dependent variable, operator,
+or VecAD load operation.
+
+Capacity
+========
+The values correspond to the capacity of each vector
+(not its current size) because that is the memory that is allocated.
+This memory is obtained using :ref:`thread_alloc-name` .
+If :ref:`ta_hold_memory-name` is true, memory that is freed
+is held by thread_alloc for future use by the same thread
+and is not included in these values.
+
+Reducing Memory
+***************
+The ``taylor`` field can be reduced using :ref:`capacity_order-name`
+and :ref:`taylor_high_water-name` .
+The ``sparsity`` field can be set to zero using
+*f* . ``size_forward_bool`` (0) and *f* . ``size_forward_set`` (0) .
+The ``random`` and ``subgraph`` fields can be set to zero using
+:ref:`subgraph_reverse@clear_subgraph` .
+
+{xrst_toc_hidden
+   example/general/memory_info.cpp
+}
+Example
+*******
+The file :ref:`memory_info.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end memory_info}
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file memory_info.hpp
+Memory used by each component of an ADFun object.
+*/
+
+/// number of bytes allocated for each component of an ADFun object
+struct fun_memory_info {
+   /// operation sequence
+   size_t op_seq;
+   /// random access information for the operation sequence
+   size_t random;
+   /// Taylor coefficients
+   size_t taylor;
+   /// forward Jacobian sparsity patterns
+   size_t sparsity;
+   /// subgraph information and partials
+   size_t subgraph;
+   /// other per independent, dependent, operator, and load vectors
+   size_t other;
+   /// sum of all the other fields
+   size_t total;
+};
+
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase>
+fun_memory_info ADFun<Base,RecBase>::memory_info(void) const
+// END_PROTOTYPE
+{  fun_memory_info info;
+   //
+   // op_seq, random
+   info.op_seq   = play_.size_op_seq();
+   info.random   = play_.size_random();
+   //
+   // taylor
+   info.taylor   = taylor_.capacity() * sizeof(Base);
+   //
+   // sparsity
+   info.sparsity = for_jac_sparse_pack_.memory()
+                 + for_jac_sparse_set_.memory();
+   //
+   // subgraph
+   info.subgraph = subgraph_info_.memory()
+                 + subgraph_partial_.capacity() * sizeof(Base);
+   //
+   // other
+   info.other    = ind_taddr_.capacity()     * sizeof(size_t)
+                 + dep_taddr_.capacity()     * sizeof(size_t)
+                 + dep_parameter_.capacity() * sizeof(bool)
+                 + cskip_op_.capacity()      * sizeof(bool)
+                 + load_op2var_.capacity()   * sizeof(addr_t);
+   //
+   // total
+   info.total    = info.op_seq + info.random + info.taylor
+                 + info.sparsity + info.subgraph + info.other;
+   //
+   return info;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
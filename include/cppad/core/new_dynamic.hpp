@@ -2,7 +2,7 @@
 # define CPPAD_CORE_NEW_DYNAMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -118,6 +118,7 @@ void ADFun<Base,RecBase>::new_dynamic(const BaseVector& dynamic)
       dyn_ind2par_ind     ,
       dyn_par_op          ,
       dyn_par_arg         ,
+      play_.op_profile_ptr() ,
       not_used_rec_base
    );
 
@@ -0,0 +1,333 @@
+# ifndef CPPAD_CORE_OP_PROFILE_HPP
+# define CPPAD_CORE_OP_PROFILE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin op_profile}
+{xrst_spell
+   rdtsc
+}
+
+Profile the Operators in an ADFun Object
+########################################
+
+Syntax
+******
+| *f* . ``op_profile`` ( *on* )
+| *f* . ``op_profile_table`` ( *os* )
+| *json* = *f* . ``op_profile_json`` ()
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_OP_PROFILE
+   // END_OP_PROFILE
+}
+{xrst_literal
+   // BEGIN_OP_PROFILE_TABLE
+   // END_OP_PROFILE_TABLE
+}
+{xrst_literal
+   // BEGIN_OP_PROFILE_JSON
+   // END_OP_PROFILE_JSON
+}
+
+Purpose
+*******
+When profiling is on, every sweep through the operation sequence
+for *f* records, for each operator and for each
+:ref:`atomic function<atomic_three-name>` ,
+the number of times it was executed,
+the number of cycles it took, and an estimate of the bytes it touched.
+This can be used to decide which parts of a function should be
+replaced by an atomic function, or to see if
+:ref:`optimize-name` has reduced the work for the important operators.
+
+Sweeps
+======
+The following sweeps are profiled:
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   sweep,     called by
+   forward0,  zero order :ref:`Forward-name`
+   forward1,  :ref:`Forward-name` with one direction
+   forward2,  :ref:`Forward-name` with multiple directions
+   reverse,   :ref:`Reverse-name`
+   for_jac,   :ref:`for_jac_sparsity-name` and :ref:`ForSparseJac-name`
+   rev_jac,   :ref:`rev_jac_sparsity-name` and :ref:`RevSparseJac-name`
+   for_hes,   :ref:`for_hes_sparsity-name` and :ref:`ForSparseHes-name`
+   rev_hes,   :ref:`rev_hes_sparsity-name` and :ref:`RevSparseHes-name`
+   dynamic,   :ref:`new_dynamic-name`
+
+Cycles
+======
+If the processor has a time stamp counter (rdtsc),
+it is used to measure the cycles for each operator.
+Otherwise the number of nanoseconds reported by
+``std::chrono::steady_clock`` is used.
+The cycles for an operator in the forward, reverse, and sparsity sweeps
+are measured from the start of the operator to the start of the next
+operator; i.e., they include the overhead of the sweep loop.
+The cycles for an atomic function call are also included
+in the cycles for the ``AFun`` operator (the ``atom`` operator
+in the dynamic sweep).
+
+Bytes
+=====
+The bytes for one execution of an operator is estimated as
+the number of arguments plus results for the operator
+times the number of bytes per variable for the sweep.
+For example, in the ``forward1`` sweep of order *q* ,
+the bytes per variable is ``(`` *q* + 1 ``) * sizeof`` ( *Base* ) .
+The sparsity sweeps do not report bytes.
+
+Speed
+=====
+When profiling is off, the only cost is one test for each operator.
+When it is on, the cycle counter is read and the counters are updated
+for each operator, so the profile for very cheap operators
+may be dominated by this overhead.
+
+f
+*
+The object *f* has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+Profiling data is not copied when *f* is assigned to another
+``ADFun`` object.
+
+on
+**
+If *on* is true, profiling is turned on and all of the counters
+are set to zero.
+Otherwise, profiling is turned off and the counters keep their values
+(so that they can be reported).
+
+os
+**
+The table is written to this output stream.
+It has one row for each (sweep, operator) pair that was executed,
+sorted by decreasing cycles, with the columns
+``sweep`` , ``op`` , ``count`` , ``cycles`` , ``bytes`` .
+This is followed by one row for each (sweep, atomic function) pair
+with the columns
+``sweep`` , ``atomic`` , ``count`` , ``cycles`` .
+
+json
+****
+The return value is a string containing a JSON object with the same
+information as the table; i.e.,
+
+| ``{``
+| |tab| ``"op"`` : [ ``{`` ``"sweep"`` : *sweep* , ``"op"`` : *op* ,
+  ``"count"`` : *count* , ``"cycles"`` : *cycles* , ``"bytes"`` : *bytes*
+  ``}`` , ... ] ,
+| |tab| ``"atomic"`` : [ ``{`` ``"sweep"`` : *sweep* , ``"name"`` : *name* ,
+  ``"count"`` : *count* , ``"cycles"`` : *cycles* ``}`` , ... ]
+| ``}``
+
+Example
+*******
+{xrst_toc_hidden
+   example/general/op_profile.cpp
+}
+The file
+:ref:`op_profile.cpp-name`
+contains an example and test of these operations.
+
+{xrst_end op_profile}
+*/
+
+# include <algorithm>
+# include <sstream>
+# include <iomanip>
+# include <cppad/local/play/op_profile.hpp>
+
+namespace CppAD { namespace local { namespace play {
+   // op_profile_row
+   // one row of the profile table
+   struct op_profile_row {
+      size_t        sweep;
+      std::string   name;
+      size_t        count;
+      std::uint64_t cycle;
+      std::uint64_t byte;
+   };
+   //
+   // op_profile_greater
+   // sort by decreasing cycles
+   inline bool op_profile_greater(
+      const op_profile_row& left, const op_profile_row& right
+   )
+   {  return left.cycle > right.cycle; }
+   //
+   // op_profile_rows
+   // rows for the operators and rows for the atomic functions
+   template <class RecBase>
+   void op_profile_rows(
+      const op_profile&              profile  ,
+      CppAD::vector<op_profile_row>& op_row   ,
+      CppAD::vector<op_profile_row>& atom_row )
+   {  op_row.resize(0);
+      atom_row.resize(0);
+      if( ! profile.has_data() )
+         return;
+      //
+      // op_row
+      for(size_t sweep = 0; sweep < size_t(number_sweep); ++sweep)
+      {  size_t n_op = size_t(NumberOp);
+         if( sweep == size_t(dynamic_sweep) )
+            n_op = size_t(number_dyn);
+         for(size_t op = 0; op < n_op; ++op)
+         {  const op_profile::op_record& rec = profile.op_data(sweep, op);
+            if( rec.count > 0 )
+            {  op_profile_row row;
+               row.sweep = sweep;
+               if( sweep == size_t(dynamic_sweep) )
+                  row.name = op_name_dyn( op_code_dyn(op) );
+               else
+                  row.name = OpName( OpCode(op) );
+               row.count = rec.count;
+               row.cycle = rec.cycle;
+               row.byte  = rec.byte;
+               op_row.push_back(row);
+            }
+         }
+      }
+      std::stable_sort(op_row.data(), op_row.data() + op_row.size(),
+         op_profile_greater
+      );
+      //
+      // atom_row
+      typedef std::map< std::pair<size_t, size_t>, op_profile::op_record >
+         atom_map;
+      const atom_map& atom_data = profile.atom_data();
+      typename atom_map::const_iterator itr;
+      for(itr = atom_data.begin(); itr != atom_data.end(); ++itr)
+      {  std::string name;
+         {  bool   set_null = false;
+            size_t type;
+            void*  ptr;
+            CppAD::local::atomic_index<RecBase>(
+               set_null, itr->first.second, type, &name, ptr
+            );
+         }
+         op_profile_row row;
+         row.sweep = itr->first.first;
+         row.name  = name;
+         row.count = itr->second.count;
+         row.cycle = itr->second.cycle;
+         row.byte  = itr->second.byte;
+         atom_row.push_back(row);
+      }
+      std::stable_sort(atom_row.data(), atom_row.data() + atom_row.size(),
+         op_profile_greater
+      );
+   }
+} } }
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+// BEGIN_OP_PROFILE
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::op_profile(bool on)
+// END_OP_PROFILE
+{  if( on )
+      play_.op_profile_obj().clear();
+   play_.op_profile_obj().on(on);
+}
+
+// BEGIN_OP_PROFILE_TABLE
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::op_profile_table(std::ostream& os) const
+// END_OP_PROFILE_TABLE
+{  using local::play::op_profile_row;
+   using local::play::sweep_name;
+   //
+   // op_row, atom_row
+   CppAD::vector<op_profile_row> op_row, atom_row;
+   local::play::op_profile_rows<RecBase>(
+      play_.op_profile_obj(), op_row, atom_row
+   );
+   //
+   // operators
+   os << std::left  << std::setw(10) << "sweep";
+   os << std::left  << std::setw(12) << "op";
+   os << std::right << std::setw(12) << "count";
+   os << std::right << std::setw(16) << "cycles";
+   os << std::right << std::setw(16) << "bytes" << "\n";
+   for(size_t i = 0; i < op_row.size(); ++i)
+   {  os << std::left  << std::setw(10) << sweep_name( op_row[i].sweep );
+      os << std::left  << std::setw(12) << op_row[i].name;
+      os << std::right << std::setw(12) << op_row[i].count;
+      os << std::right << std::setw(16) << op_row[i].cycle;
+      os << std::right << std::setw(16) << op_row[i].byte << "\n";
+   }
+   //
+   // atomic functions
+   if( atom_row.size() == 0 )
+      return;
+   os << "\n";
+   os << std::left  << std::setw(10) << "sweep";
+   os << std::left  << std::setw(20) << "atomic";
+   os << std::right << std::setw(12) << "count";
+   os << std::right << std::setw(16) << "cycles" << "\n";
+   for(size_t i = 0; i < atom_row.size(); ++i)
+   {  os << std::left  << std::setw(10) << sweep_name( atom_row[i].sweep );
+      os << std::left  << std::setw(20) << atom_row[i].name;
+      os << std::right << std::setw(12) << atom_row[i].count;
+      os << std::right << std::setw(16) << atom_row[i].cycle << "\n";
+   }
+}
+
+// BEGIN_OP_PROFILE_JSON
+template <class Base, class RecBase>
+std::string ADFun<Base,RecBase>::op_profile_json(void) const
+// END_OP_PROFILE_JSON
+{  using local::play::op_profile_row;
+   using local::play::sweep_name;
+   //
+   // op_row, atom_row
+   CppAD::vector<op_profile_row> op_row, atom_row;
+   local::play::op_profile_rows<RecBase>(
+      play_.op_profile_obj(), op_row, atom_row
+   );
+   //
+   // result
+   std::stringstream ss;
+   ss << "{\n";
+   ss << "   \"op\" : [";
+   for(size_t i = 0; i < op_row.size(); ++i)
+   {  if( i > 0 )
+         ss << ",";
+      ss << "\n      { ";
+      ss << "\"sweep\" : \"" << sweep_name( op_row[i].sweep ) << "\", ";
+      ss << "\"op\" : \"" << op_row[i].name << "\", ";
+      ss << "\"count\" : " << op_row[i].count << ", ";
+      ss << "\"cycles\" : " << op_row[i].cycle << ", ";
+      ss << "\"bytes\" : " << op_row[i].byte << " }";
+   }
+   ss << "\n   ],\n";
+   ss << "   \"atomic\" : [";
+   for(size_t i = 0; i < atom_row.size(); ++i)
+   {  if( i > 0 )
+         ss << ",";
+      ss << "\n      { ";
+      ss << "\"sweep\" : \"" << sweep_name( atom_row[i].sweep ) << "\", ";
+      ss << "\"name\" : \"" << atom_row[i].name << "\", ";
+      ss << "\"count\" : " << atom_row[i].count << ", ";
+      ss << "\"cycles\" : " << atom_row[i].cycle << " }";
+   }
+   ss << "\n   ]\n";
+   ss << "}\n";
+   return ss.str();
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
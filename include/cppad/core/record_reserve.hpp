@@ -0,0 +1,94 @@
+# ifndef CPPAD_CORE_RECORD_RESERVE_HPP
+# define CPPAD_CORE_RECORD_RESERVE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin record_reserve}
+
+Reserve Memory for the Current Recording
+########################################
+
+Syntax
+******
+``AD`` < *Base* >:: ``record_reserve`` ( *n_op* , *n_arg* )
+
+Purpose
+*******
+While an operation sequence is being recorded, the vectors that hold
+its operators and their arguments grow as needed.
+Each time one of these vectors grows, its memory is reallocated and
+its elements are copied.
+If the size of the recording is known in advance,
+this routine can be used to allocate the memory once
+and thereby speed up the recording.
+
+Recording
+*********
+There must be an ``AD`` < *Base* > recording in progress
+for the current thread; i.e., this routine is called after
+:ref:`Independent-name` and before the recording is stopped.
+
+n_op
+****
+This argument has prototype
+
+   ``size_t`` *n_op*
+
+It is the number of operators that the recording can hold before
+its operator vector grows.
+If the same function is recorded again, or a function with a
+similar size, :ref:`fun_property@size_op` for the previous recording
+is a good value for *n_op* .
+
+n_arg
+*****
+This argument has prototype
+
+   ``size_t`` *n_arg*
+
+It is the number of operator arguments that the recording can hold
+before its argument vector grows.
+If the same function is recorded again,
+:ref:`fun_property@size_op_arg` for the previous recording
+is a good value for *n_arg* .
+
+Constant Parameters
+*******************
+Constant parameters that are identically equal are only stored once in the
+recording (independent of the use of ``record_reserve`` ).
+Hence the number of constant parameters in the recording does not
+depend on the order of the operations; see :ref:`fun_property@size_par` .
+
+Speed
+*****
+The program :ref:`speed_record-name` compares the speed of recording
+with and without using ``record_reserve`` .
+{xrst_toc_hidden
+   example/general/record_reserve.cpp
+}
+Example
+*******
+The file
+:ref:`record_reserve.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end record_reserve}
+----------------------------------------------------------------------------
+*/
+
+
+namespace CppAD {
+   template <class Base>
+   void AD<Base>::record_reserve(size_t n_op, size_t n_arg)
+   {  local::ADTape<Base>* tape = AD<Base>::tape_ptr();
+      CPPAD_ASSERT_KNOWN(
+         tape != nullptr,
+         "record_reserve: no AD<Base> recording in progress for this thread"
+      );
+      tape->Rec_.reserve(n_op, n_arg);
+   }
+}
+
+# endif
@@ -0,0 +1,296 @@
+# ifndef CPPAD_CORE_REVOLVE_HPP
+# define CPPAD_CORE_REVOLVE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin revolve}
+{xrst_spell
+   dw
+   griewank
+   revolve
+   walther
+}
+
+Reverse Mode Through Many Time Steps Using Binomial Checkpointing
+#################################################################
+
+Syntax
+******
+| *n_forward* = ``revolve`` (
+| |tab| *step* , *n_step* , *n_snap* , *x_0* , *w* , *x_final* , *dw*
+| )
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_PROTOTYPE
+   // END_PROTOTYPE
+}
+
+Purpose
+*******
+We use :math:`S : \B{R}^n \rightarrow \B{R}^n` to denote the
+:ref:`glossary@AD Function` corresponding to *step* and define
+:math:`x_{k+1} = S( x_k )` for :math:`k = 0 , \ldots , N-1`
+where :math:`N` is *n_step* .
+This routine computes :math:`x_N` and the derivative of
+:math:`w^\R{T} x_N` with respect to :math:`x_0` .
+Recording all the steps in one ``ADFun`` object requires memory
+proportional to :math:`N` times the size of the step recording.
+This routine only uses the step recording and at most *n_snap*
+state vectors :math:`x_k` ,
+at the cost of recomputing some of the steps.
+
+Schedule
+********
+The checkpoint schedule is the binomial schedule of Griewank and Walther
+(Revolve); i.e., for the given *n_step* and *n_snap*
+it minimizes the number of step evaluations.
+If :math:`t` is the smallest integer such that
+:math:`N \leq ( s + t )! / ( s! t! )` ,
+where :math:`s` is *n_snap* ,
+each step is evaluated at most :math:`t + 1` times.
+
+Base
+****
+is the base type for the ``ADFun`` object *step* .
+
+BaseVector
+**********
+The type *BaseVector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+step
+****
+This is the function :math:`S(x)`.
+Its :ref:`fun_property@Domain` and :ref:`fun_property@Range`
+dimensions must both be equal to :math:`n` .
+Parameters that do not change during the time steps,
+and the time itself, can be included as components of the state
+(with :math:`S(x)` copying or incrementing them).
+The Taylor coefficients stored in *step* are changed by this routine.
+
+n_step
+******
+This is the number of times, :math:`N`, that :math:`S` is applied.
+It must be greater than zero.
+
+n_snap
+******
+This is the maximum number of state vectors :math:`x_k`
+that are stored at the same time (including :math:`x_0`).
+It must be greater than zero.
+Using more snapshots reduces the number of step evaluations;
+if *n_snap* is greater than or equal *n_step* ,
+each step is evaluated at most twice.
+
+x_0
+***
+This is the initial state :math:`x_0` and its size is :math:`n` .
+
+w
+*
+This vector has size :math:`n` and
+specifies the linear combination of the final state that we are
+computing the derivative of.
+
+x_final
+*******
+The input size and value of this vector do not matter.
+Upon return, it has size :math:`n` and is the final state :math:`x_N` .
+
+dw
+**
+The input size and value of this vector do not matter.
+Upon return, it has size :math:`n` and
+
+.. math::
+
+   dw = \D{ w^\R{T} x_N }{ x_0 }
+
+n_forward
+*********
+The return value is the total number of zero order forward mode
+evaluations of *step* .
+The number of reverse mode evaluations of *step* is always *n_step* .
+
+{xrst_toc_hidden
+   example/general/revolve.cpp
+}
+Example
+*******
+The file :ref:`revolve.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end revolve}
+*/
+# include <cppad/utility/vector.hpp>
+
+namespace CppAD { namespace local { // BEGIN_CPPAD_LOCAL_NAMESPACE
+/*!
+Number of steps to advance before taking the next snapshot
+
+\param n_left [in]
+is the number of steps between the last snapshot and the next state
+that needs a derivative (must be greater than one).
+
+\param n_snap [in]
+is the number of snapshots available for these steps, including the
+last snapshot (must be greater than one).
+
+\return
+is the number of steps to advance from the last snapshot to the next
+snapshot. This is the choice in the Revolve algorithm of
+Griewank and Walther and minimizes the total number of steps.
+*/
+inline size_t revolve_split(size_t n_left, size_t n_snap)
+{  CPPAD_ASSERT_UNKNOWN( 1 < n_left && 1 < n_snap );
+   //
+   // n_rep, range
+   // smallest n_rep such that n_left <= range = beta(n_snap, n_rep)
+   // where beta(s, t) = (s + t)! / ( s! t! )
+   size_t n_rep = 0;
+   size_t range = 1;
+   while( range < n_left )
+   {  ++n_rep;
+      range = range * (n_rep + n_snap) / n_rep;
+   }
+   //
+   // bino1 = beta(n_snap, n_rep - 1)
+   size_t bino1 = range * n_rep / (n_snap + n_rep);
+   //
+   // bino2 = beta(n_snap - 1, n_rep - 1)
+   size_t bino2 = bino1 * n_snap / (n_snap + n_rep - 1);
+   //
+   // bino3 = beta(n_snap - 2, n_rep - 1)
+   size_t bino3 = 1;
+   if( 2 < n_snap )
+      bino3 = bino2 * (n_snap - 1) / (n_snap + n_rep - 2);
+   //
+   // bino4 = beta(n_snap, n_rep - 2)
+   size_t bino4 = bino2 * (n_rep - 1) / n_snap;
+   //
+   // bino5 = beta(n_snap - 3, n_rep - 1)
+   size_t bino5 = 0;
+   if( 3 < n_snap )
+      bino5 = bino3 * (n_snap - 2) / n_rep;
+   else if( 3 == n_snap )
+      bino5 = 1;
+   //
+   // n_advance
+   size_t n_advance;
+   if( n_left <= bino1 + bino3 )
+      n_advance = bino4;
+   else if( n_left >= range - bino5 )
+      n_advance = bino1;
+   else
+      n_advance = n_left - bino2 - bino3;
+   //
+   return std::max(n_advance, size_t(1));
+}
+} } // END_CPPAD_LOCAL_NAMESPACE
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+// BEGIN_PROTOTYPE
+template <class Base, class RecBase, class BaseVector>
+size_t revolve(
+   ADFun<Base, RecBase>& step     ,
+   size_t                n_step   ,
+   size_t                n_snap   ,
+   const BaseVector&     x_0      ,
+   const BaseVector&     w        ,
+   BaseVector&           x_final  ,
+   BaseVector&           dw       )
+// END_PROTOTYPE
+{  //
+   // n
+   size_t n = step.Domain();
+   CPPAD_ASSERT_KNOWN( step.Range() == n,
+      "revolve: step.Range() is not equal to step.Domain()"
+   );
+   CPPAD_ASSERT_KNOWN( 0 < n_step, "revolve: n_step is zero" );
+   CPPAD_ASSERT_KNOWN( 0 < n_snap, "revolve: n_snap is zero" );
+   CPPAD_ASSERT_KNOWN( size_t( x_0.size() ) == n,
+      "revolve: x_0.size() is not equal to step.Domain()"
+   );
+   CPPAD_ASSERT_KNOWN( size_t( w.size() ) == n,
+      "revolve: w.size() is not equal to step.Domain()"
+   );
+   //
+   // snap_index, snap_state, n_stack
+   // stack of snapshots; snap_state[k] is the state with index snap_index[k]
+   vector<size_t>          snap_index(n_snap);
+   vector< vector<Base> >  snap_state(n_snap);
+   size_t                  n_stack = 1;
+   snap_index[0] = 0;
+   snap_state[0].resize(n);
+   for(size_t j = 0; j < n; ++j)
+      snap_state[0][j] = x_0[j];
+   //
+   // x, y, adjoint
+   vector<Base> x(n), y(n), adjoint(n);
+   for(size_t j = 0; j < n; ++j)
+      adjoint[j] = w[j];
+   //
+   // x_final
+   x_final.resize(n);
+   //
+   // n_forward, n_end
+   // adjoint is the derivative of w^T x_N with respect to x_{n_end}
+   size_t n_forward = 0;
+   size_t n_end     = n_step;
+   while( 0 < n_end )
+   {  //
+      // top, n_left, n_free
+      size_t top    = n_stack - 1;
+      size_t n_left = n_end - snap_index[top];
+      size_t n_free = n_snap - top;
+      //
+      // x
+      x = snap_state[top];
+      if( 1 < n_left && 1 < n_free )
+      {  // advance to the next snapshot
+         size_t n_advance = local::revolve_split(n_left, n_free);
+         for(size_t k = 0; k < n_advance; ++k)
+            x = step.Forward(0, x);
+         n_forward += n_advance;
+         //
+         // push x on the snapshot stack
+         snap_index[n_stack] = snap_index[top] + n_advance;
+         snap_state[n_stack] = x;
+         ++n_stack;
+      }
+      else
+      {  // advance to n_end - 1
+         for(size_t k = 0; k < n_left - 1; ++k)
+            x = step.Forward(0, x);
+         //
+         // reverse through the step from n_end - 1 to n_end
+         y          = step.Forward(0, x);
+         n_forward += n_left;
+         if( n_end == n_step )
+         {  for(size_t j = 0; j < n; ++j)
+               x_final[j] = y[j];
+         }
+         adjoint = step.Reverse(1, adjoint);
+         --n_end;
+         //
+         // pop snapshot that is no longer needed
+         if( n_end == snap_index[top] && 0 < top )
+            --n_stack;
+      }
+   }
+   //
+   // dw
+   dw.resize(n);
+   for(size_t j = 0; j < n; ++j)
+      dw[j] = adjoint[j];
+   //
+   return n_forward;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SPARSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 //
@@ -27,5 +27,6 @@
 # include <cppad/core/subgraph_sparsity.hpp>
 # include <cppad/core/subgraph_reverse.hpp>
 # include <cppad/core/subgraph_jac_rev.hpp>
+# include <cppad/core/subgraph_jac_thread.hpp>
 
 # endif
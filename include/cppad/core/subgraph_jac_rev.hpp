@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SUBGRAPH_JAC_REV_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin subgraph_jac_rev}
@@ -25,7 +25,8 @@ Syntax
 
 See Also
 ********
-:ref:`subgraph_reverse@clear_subgraph` .
+:ref:`subgraph_reverse@clear_subgraph` ,
+:ref:`subgraph_reverse@use_cache` .
 
 Purpose
 *******
@@ -54,6 +55,9 @@ it creates a subgraph of the operation sequence
 containing the variables that affect the dependent variable.
 This avoids the overhead of performing set operations
 that is inherent in other methods for computing sparsity patterns.
+If the Jacobian is computed many times with the same *select_domain* ,
+turning on :ref:`subgraph_reverse@use_cache` avoids recomputing
+the subgraphs for each call.
 
 BaseVector
 **********
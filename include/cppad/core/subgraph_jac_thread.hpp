@@ -0,0 +1,330 @@
+# ifndef CPPAD_CORE_SUBGRAPH_JAC_THREAD_HPP
+# define CPPAD_CORE_SUBGRAPH_JAC_THREAD_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin subgraph_jac_thread}
+{xrst_spell
+   subgraphs
+}
+
+Compute Sparse Jacobian Rows Using Subgraphs in Parallel
+########################################################
+
+Syntax
+******
+| ``subgraph_work`` < *Base* > *work*
+| *f* . ``Forward`` (0, *x* )
+| *f* . ``subgraph_reverse`` ( *select_domain* )
+| *f* . ``subgraph_jac_rev`` ( *select_range* , *matrix_out* , *work* )
+| *work* . ``clear`` ()
+
+Purpose
+*******
+We use :math:`F : \B{R}^n \rightarrow \B{R}^m` to denote the
+function corresponding to *f* .
+This computes the same rows of the Jacobian as the
+:ref:`subgraph_jac_rev-name` syntax that has a *select_range* argument.
+The difference is that this version of ``subgraph_jac_rev``
+does not modify *f* .
+All of the information that changes while computing a row of the Jacobian
+is in *work* .
+Hence different threads can compute different rows of the Jacobian
+at the same time, provided that each thread uses its own *work* object;
+see :ref:`multi_thread-name` .
+
+Method
+******
+This routine uses the same subgraph technique as ``subgraph_jac_rev`` ;
+i.e., one reverse sweep over a subgraph for each selected row.
+Each thread partitions its rows by the *select_range* argument;
+e.g., thread *k* selects rows :math:`i` with
+:math:`i \bmod p = k` where :math:`p` is the number of threads.
+If :ref:`subgraph_reverse@use_cache` is true for *f* ,
+the subgraphs that were cached by previous sequential mode calculations
+are used by the threads (but the threads do not add to the cache).
+
+Base
+****
+The type *Base* is the base type for the function *f* .
+
+f
+*
+This object has prototype
+
+   ``ADFun`` < *Base* > *f*
+
+It is ``const`` for the ``subgraph_jac_rev`` syntax above.
+It can not be modified while any thread is using it with the syntax above;
+e.g., ``Forward`` and ``subgraph_reverse`` must be called in sequential mode
+before the threads compute their rows.
+In addition, :ref:`op_profile-name` must not be on for *f*
+and any :ref:`atomic functions<atomic-name>` in *f*
+must support being used by different threads at the same time.
+
+x
+*
+The zero order Taylor coefficients in *f* must correspond to the value of
+*x* at which we are computing the Jacobian; see :ref:`forward_zero-name` .
+This is the last call to ``Forward`` before the Jacobian rows are computed.
+
+select_domain
+*************
+This argument has prototype
+
+   ``const`` *BoolVector* & *select_domain*
+
+It has size :math:`n` and specifies which independent variables
+to include; see :ref:`subgraph_reverse@select_domain` .
+This call initializes the subgraph information in *f* that is shared
+by all the threads (it also sets up a random access iterator for *f* ).
+
+select_range
+************
+This argument has prototype
+
+   ``const`` *BoolVector* & *select_range*
+
+It has size :math:`m` and specifies which rows of the Jacobian
+are computed by this call.
+
+matrix_out
+**********
+This argument has prototype
+
+   ``sparse_rcv`` < *SizeVector* , *BaseVector* >& *matrix_out*
+
+This input value of *matrix_out* does not matter.
+Upon return *matrix_out* is a
+:ref:`sparse matrix<sparse_rcv-name>` representation of the selected rows of
+:math:`F^{(1)} (x)`.
+The matrix has :math:`m` rows, :math:`n` columns,
+and the same possibly non-zero elements as the corresponding
+:ref:`subgraph_jac_rev@matrix_out` for ``subgraph_jac_rev`` .
+
+work
+****
+This argument has prototype
+
+   ``subgraph_work`` < *Base* >& *work*
+
+It holds a copy of the subgraph information, the subgraph for the current row,
+the partial derivatives, and the atomic function work space.
+The memory in *work* is reused by the next call with the same *work*
+so different calls should use the same *work* object.
+It can also be used for different functions *f* .
+
+clear
+*****
+This frees the memory in *work* .
+If *work* is used in parallel mode, its memory must be freed
+(by ``clear`` or by destroying *work* )
+by the same thread or in sequential mode.
+
+BaseVector
+**********
+The type *BaseVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+*Base* .
+
+SizeVector
+**********
+The type *SizeVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``size_t`` .
+
+BoolVector
+**********
+The type *BoolVector* is a :ref:`SimpleVector-name` class with
+:ref:`elements of type<SimpleVector@Elements of Specified Type>`
+``bool`` .
+
+Example
+*******
+The file :ref:`multi_subgraph_jac.cpp-name`
+is an example and test that computes the rows of a Jacobian
+using multiple threads.
+
+{xrst_end subgraph_jac_thread}
+-----------------------------------------------------------------------------
+*/
+# include <cppad/core/ad_fun.hpp>
+# include <cppad/local/subgraph/info.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+
+/*!
+\file subgraph_jac_thread.hpp
+Compute rows of a sparse Jacobian using subgraphs and separate work space.
+*/
+
+/*!
+class used by subgraph_jac_rev to hold the information that changes
+while computing the rows of a Jacobian.
+*/
+template <class Base>
+class subgraph_work {
+   public:
+      /// copy of the subgraph information for the function
+      local::subgraph::subgraph_info info;
+      /// subgraph for the current row
+      local::pod_vector<addr_t> subgraph;
+      /// partial derivatives for the current row
+      local::pod_vector_maybe<Base> partial;
+      /// work space used to call atomic functions
+      local::play::atom_work<Base> atom_work;
+      /// row, column and value for each possibly non-zero element
+      local::pod_vector<size_t>     row;
+      local::pod_vector<size_t>     col;
+      local::pod_vector_maybe<Base> val;
+      //
+      /// constructor
+      subgraph_work(void)
+      { }
+      /// free the memory in this work space
+      void clear(void)
+      {  info.clear();
+         subgraph.clear();
+         partial.clear();
+         local::play::atom_work<Base> empty;
+         atom_work.swap(empty);
+         row.clear();
+         col.clear();
+         val.clear();
+      }
+};
+
+/*!
+Compute the selected rows of a sparse Jacobian using subgraphs
+and the specified work space.
+
+\tparam BoolVector
+a simple vector class with elements of type bool.
+
+\tparam SizeVector
+a simple vector class with elements of type size_t.
+
+\tparam BaseVector
+a simple vector class with elements of type Base.
+
+\param select_range
+is the set of dependent variables (rows of the Jacobian) to compute.
+
+\param matrix_out
+is the sparse matrix representation of the selected rows of the Jacobian.
+
+\param work
+is the work space used for this calculation.
+This function object is not modified, so different threads
+can call this routine at the same time using different work space.
+*/
+template <class Base, class RecBase>
+template <class BoolVector, class SizeVector, class BaseVector>
+void ADFun<Base,RecBase>::subgraph_jac_rev(
+   const BoolVector&                   select_range   ,
+   sparse_rcv<SizeVector, BaseVector>& matrix_out     ,
+   subgraph_work<Base>&                work           ) const
+{  size_t m = Range();
+   size_t n = Domain();
+   //
+   CPPAD_ASSERT_KNOWN(
+      size_t( select_range.size() ) == m,
+      "subgraph_jac_rev: select_range size not equal range dimension for f"
+   );
+   CPPAD_ASSERT_KNOWN(
+      subgraph_info_.select_domain().size() == n,
+      "subgraph_jac_rev: f.subgraph_reverse(select_domain) has not been"
+      " called\nsince f was created or its subgraph information cleared."
+   );
+   CPPAD_ASSERT_KNOWN(
+      play_.op_profile_ptr() == nullptr,
+      "subgraph_jac_rev: operator profiling is on for f"
+   );
+   //
+   // work.info
+   // The subgraph information is modified as each row is computed.
+   // The subgraphs cached in f are used, but not added to, by this thread.
+   work.info.assign_no_cache(subgraph_info_);
+   //
+   // work.row, work.col, work.val
+   work.row.resize(0);
+   work.col.resize(0);
+   work.val.resize(0);
+   //
+   // memory used to hold subgraph_reverse results
+   BaseVector dw;
+   SizeVector col;
+   //
+   // loop through selected dependent variables
+   for(size_t i = 0; i < m; ++i) if( select_range[i] )
+   {  // compute Jacobian and sparsity for this dependent variable
+      size_t q   = 1;
+      switch( play_.address_type() )
+      {
+         case local::play::unsigned_short_enum:
+         subgraph_reverse_helper<unsigned short>(
+            work.info, work.subgraph, work.partial, &work.atom_work,
+            q, i, col, dw
+         );
+         break;
+
+         case local::play::unsigned_int_enum:
+         subgraph_reverse_helper<unsigned int>(
+            work.info, work.subgraph, work.partial, &work.atom_work,
+            q, i, col, dw
+         );
+         break;
+
+         case local::play::size_t_enum:
+         subgraph_reverse_helper<size_t>(
+            work.info, work.subgraph, work.partial, &work.atom_work,
+            q, i, col, dw
+         );
+         break;
+
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+      }
+      CPPAD_ASSERT_UNKNOWN( size_t( dw.size() ) == n );
+      //
+      // offset for this dependent variable
+      size_t index = work.row.size();
+      CPPAD_ASSERT_UNKNOWN( work.col.size() == index );
+      CPPAD_ASSERT_UNKNOWN( work.val.size() == index );
+      //
+      // extend vectors to hold results for this dependent variable
+      size_t col_size = size_t( col.size() );
+      work.row.extend( col_size );
+      work.col.extend( col_size );
+      work.val.extend( col_size );
+      //
+      // store results for this dependent variable
+      for(size_t c = 0; c < col_size; ++c)
+      {  work.row[index + c] = i;
+         work.col[index + c] = col[c];
+         work.val[index + c] = dw[ col[c] ];
+      }
+   }
+   //
+   // create sparsity pattern corresponding to work.row, work.col
+   size_t nr  = m;
+   size_t nc  = n;
+   size_t nnz = work.row.size();
+   sparse_rc<SizeVector> pattern(nr, nc, nnz);
+   for(size_t k = 0; k < nnz; ++k)
+      pattern.set(k, work.row[k], work.col[k]);
+   //
+   // create sparse matrix
+   sparse_rcv<SizeVector, BaseVector> matrix(pattern);
+   for(size_t k = 0; k < nnz; ++k)
+      matrix.set(k,  work.val[k]);
+   //
+   // return matrix
+   matrix_out = matrix;
+   //
+   return;
+}
+} // END_CPPAD_NAMESPACE
+# endif
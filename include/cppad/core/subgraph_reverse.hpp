@@ -2,7 +2,7 @@
 # define CPPAD_CORE_SUBGRAPH_REVERSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin subgraph_reverse}
@@ -20,6 +20,7 @@ Syntax
 | *f* . ``subgraph_reverse`` ( *select_domain* )
 | *f* . ``subgraph_reverse`` ( *q* , *ell* , *col* , *dw* )
 | *f* . ``clear_subgraph`` ()
+| *f* . ``subgraph_cache`` ( *use_cache* )
 
 Purpose
 *******
@@ -145,6 +146,25 @@ it does not need to be recalculated.
 You cannot free this memory between calls that select the domain
 and corresponding calls that compute reverse mode derivatives.
 Some of this information is also used by :ref:`subgraph_sparsity-name` .
+It includes the cached subgraphs; see *use_cache* below.
+
+use_cache
+*********
+The argument *use_cache* has prototype
+
+   ``bool`` *use_cache*
+
+If it is true, the subgraph computed for each dependent variable
+index *ell* is saved in *f* .
+Future calls with the same *ell* skip the subgraph computation
+(and the corresponding pass over the operation sequence)
+as long as *select_domain* has the same value.
+This is useful when the derivative for the same rows are computed
+many times at different Taylor coefficients; e.g., repeated calls
+to :ref:`subgraph_jac_rev-name` .
+The cached subgraphs are freed when *use_cache* is false,
+when *select_domain* changes, and when ``clear_subgraph`` is called.
+The default value for *use_cache* is false.
 
 Example
 *******
@@ -171,6 +191,11 @@ void ADFun<Base,RecBase>::clear_subgraph(void)
    subgraph_partial_.clear();
 }
 
+/// turn caching of the per row subgraphs on or off
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::subgraph_cache(bool use_cache)
+{  subgraph_info_.set_use_cache(use_cache); }
+
 /*!
 Initialize reverse mode derivative computation on subgraphs.
 
@@ -190,6 +215,9 @@ This vector is set equal to the select_domain argument.
 
 \par subgraph_info.process_range()
 This vector is initialized to have size Range() and its elements are false.
+
+\par play_
+The random iterator for this player is set up.
 */
 
 template <class Base, class RecBase>
@@ -233,9 +261,30 @@ void ADFun<Base,RecBase>::subgraph_reverse( const BoolVector& select_domain )
       CPPAD_ASSERT_UNKNOWN(false);
    }
    CPPAD_ASSERT_UNKNOWN(
-      subgraph_info_.in_subgraph().size() == play_.num_op_rec()
+      subgraph_info_.in_subgraph().size() == play_.num_op_rec() ||
+      subgraph_info_.in_subgraph().size() == 0
    );
 
+   // set up random iterator for this player
+   // (so that subgraph_reverse_helper with a work space can be const)
+   switch( play_.address_type() )
+   {
+      case local::play::unsigned_short_enum:
+      play_.template setup_random<unsigned short>();
+      break;
+
+      case local::play::unsigned_int_enum:
+      play_.template setup_random<unsigned int>();
+      break;
+
+      case local::play::size_t_enum:
+      play_.template setup_random<size_t>();
+      break;
+
+      default:
+      CPPAD_ASSERT_UNKNOWN(false);
+   }
+
    return;
 }
 
@@ -284,10 +333,10 @@ where the matrix \f$ x \f$ is the value for \f$ u \f$
 that corresponding to the forward mode Taylor coefficients
 for the independent variables as specified by previous calls to Forward.
 
-\par subgraph_info.process_range()
+\par subgraph_info_.process_range()
 The element process_range[ell] is set to true by this operation.
 
-\par subgraph_info.in_subgraph_
+\par subgraph_info_.in_subgraph_
 some of the elements of this vector are set to have value ell
 (so it can not longer be used to determine the subgraph corresponding to
 the ell-th dependent variable).
@@ -299,12 +348,73 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
    size_t      ell ,
    SizeVector& col ,
    BaseVector& dw  )
-{  using local::pod_vector;
-   // used to identify the RecBase type in calls to sweeps
+{  // set up a random iterator for this player
+   play_.template setup_random<Addr>();
+   //
+   // use the work space in this ADFun object
+   local::pod_vector<addr_t> subgraph;
+   local::play::atom_work<Base>* atom_work_ptr = nullptr;
+   subgraph_reverse_helper<Addr>(
+      subgraph_info_, subgraph, subgraph_partial_, atom_work_ptr,
+      q, ell, col, dw
+   );
+}
+/*!
+Use reverse mode to compute derivative of Taylor coefficients on a subgraph
+using the specified work space.
+
+This routine does not modify this ADFun object.
+Hence it can be called by different threads at the same time
+provided that each thread uses different work space.
+
+\param info
+is the subgraph information for this function.
+It is initialized by subgraph_reverse(select_domain)
+(a copy of subgraph_info_ may be used).
+The element info.process_range()[ell] is set to true
+and some of the elements of info.in_subgraph() are set to ell.
+
+\param subgraph
+The input size and value of this vector does not matter.
+Upon return it contains the subgraph for the dependent variable ell.
+
+\param partial
+is work space used to hold the partial derivatives.
+
+\param atom_work_ptr
+is the work space used for atomic function calls.
+If it is null, the work space in the player for this function is used.
+
+\param q
+see the other subgraph_reverse_helper.
+
+\param ell
+see the other subgraph_reverse_helper.
+
+\param col
+see the other subgraph_reverse_helper.
+
+\param dw
+see the other subgraph_reverse_helper.
+
+\par play_
+The random iterator for this player must be set up.
+*/
+template <class Base, class RecBase>
+template <class Addr, class BaseVector, class SizeVector>
+void ADFun<Base,RecBase>::subgraph_reverse_helper(
+   local::subgraph::subgraph_info& info          ,
+   local::pod_vector<addr_t>&      subgraph      ,
+   local::pod_vector_maybe<Base>&  partial       ,
+   local::play::atom_work<Base>*   atom_work_ptr ,
+   size_t                          q             ,
+   size_t                          ell           ,
+   SizeVector&                     col           ,
+   BaseVector&                     dw            ) const
+{  // used to identify the RecBase type in calls to sweeps
    RecBase not_used_rec_base(0.0);
    //
    // get a random iterator for this player
-   play_.template setup_random<Addr>();
    typename local::play::const_random_iterator<Addr> random_itr =
       play_.template get_random<Addr>();
 
@@ -329,28 +439,34 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
       "dependent variable index in to large for this function"
    );
    CPPAD_ASSERT_KNOWN(
-      subgraph_info_.process_range()[ell] == false,
+      info.process_range()[ell] == false,
       "This dependent variable index has already been processed\n"
       "after the previous subgraph_reverse(select_domain)."
    );
 
    // subgraph of operators connected to dependent variable ell
-   pod_vector<addr_t> subgraph;
-   subgraph_info_.get_rev(
-      random_itr, dep_taddr_, addr_t(ell), subgraph
-   );
-
-   // Add all the atomic function call operators
-   // for calls that have first operator in the subgraph
-   local::subgraph::entire_call(random_itr, subgraph);
-
-   // First add the BeginOp and EndOp to the subgraph and then sort it
-   // sort the subgraph
    addr_t i_op_begin_op = 0;
    addr_t i_op_end_op   = addr_t( play_.num_op_rec() - 1);
-   subgraph.push_back(i_op_begin_op);
-   subgraph.push_back(i_op_end_op);
-   std::sort( subgraph.data(), subgraph.data() + subgraph.size() );
+   if( subgraph_info_.get_cache(addr_t(ell), subgraph) )
+      info.set_process_range( addr_t(ell) );
+   else
+   {  info.get_rev(
+         random_itr, dep_taddr_, addr_t(ell), subgraph
+      );
+
+      // Add all the atomic function call operators
+      // for calls that have first operator in the subgraph
+      local::subgraph::entire_call(random_itr, subgraph);
+
+      // First add the BeginOp and EndOp to the subgraph and then sort it
+      // sort the subgraph
+      subgraph.push_back(i_op_begin_op);
+      subgraph.push_back(i_op_end_op);
+      std::sort( subgraph.data(), subgraph.data() + subgraph.size() );
+      //
+      // cache this subgraph (if info.use_cache() is true)
+      info.put_cache(addr_t(ell), subgraph);
+   }
    CPPAD_ASSERT_UNKNOWN( subgraph[0] == i_op_begin_op );
    CPPAD_ASSERT_UNKNOWN( subgraph[subgraph.size()-1] == i_op_end_op );
    /*
@@ -364,9 +480,9 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
    std::cout << "}\n";
    */
 
-   // initialize subgraph_partial_ matrix to zero on subgraph
+   // initialize partial matrix to zero on subgraph
    Base zero(0);
-   subgraph_partial_.resize(num_var_tape_ * q);
+   partial.resize(num_var_tape_ * q);
    for(size_t k = 0; k < subgraph.size(); ++k)
    {
       size_t               i_op = size_t( subgraph[k] );
@@ -388,13 +504,13 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
          size_t j_var = i_var + 1 - NumRes(op);
          for(size_t i = j_var; i <= i_var; ++i)
          {  for(size_t j = 0; j < q; ++j)
-               subgraph_partial_[i * q + j] = zero;
+               partial[i * q + j] = zero;
          }
       }
    }
 
    // set partial to one for component we are differentiating
-   subgraph_partial_[ dep_taddr_[ell] * q + q - 1] = Base(1);
+   partial[ dep_taddr_[ell] * q + q - 1] = Base(1);
 
    // evaluate the derivatives
    CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
@@ -412,11 +528,12 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
       cap_order_taylor_,
       taylor_.data(),
       q,
-      subgraph_partial_.data(),
+      partial.data(),
       cskip_op_.data(),
       load_op2var_,
       subgraph_itr,
-      not_used_rec_base
+      not_used_rec_base,
+      atom_work_ptr
    );
 
    // number of non-zero in return value
@@ -448,7 +565,7 @@ void ADFun<Base,RecBase>::subgraph_reverse_helper(
       // return paritial for this independent variable
       col[c] = j;
       for(size_t k = 0; k < q; k++)
-         dw[j * q + k ] = subgraph_partial_[ind_taddr_[j] * q + k];
+         dw[j * q + k ] = partial[ind_taddr_[j] * q + k];
    }
    //
    CPPAD_ASSERT_KNOWN( ! ( hasnan(dw) && check_for_nan_ ) ,
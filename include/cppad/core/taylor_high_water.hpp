@@ -0,0 +1,160 @@
+# ifndef CPPAD_CORE_TAYLOR_HIGH_WATER_HPP
+# define CPPAD_CORE_TAYLOR_HIGH_WATER_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin taylor_high_water}
+{xrst_spell
+   xq
+   yq
+}
+
+Automatic Release of Taylor Coefficient Memory
+##############################################
+
+Syntax
+******
+| *f* . ``taylor_high_water`` ( *max_byte* )
+| *max_byte* = *f* . ``taylor_high_water`` ()
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN_SET_PROTOTYPE
+   // END_SET_PROTOTYPE
+}
+{xrst_literal
+   // BEGIN_GET_PROTOTYPE
+   // END_GET_PROTOTYPE
+}
+
+See Also
+========
+:ref:`capacity_order-name` ,
+:ref:`memory_info-name`
+
+Purpose
+*******
+The memory that holds the Taylor coefficients in *f*
+grows when :ref:`Forward-name` computes higher orders or more directions.
+It is not reduced by subsequent lower order ``Forward`` calls,
+because the extra orders may be used again.
+For example, after a call to ``Forward`` ( 2 , *xq* ) ,
+the memory for three orders is retained even if all the subsequent calls
+are ``Forward`` (0, *xq* ) followed by ``Reverse`` (1, *w* ) .
+This routine sets a limit on the memory that is retained.
+
+max_byte
+********
+This is the maximum number of bytes for the Taylor coefficients
+that is retained by *f* between calls to ``Forward`` .
+The default value is ``std::numeric_limits<size_t>::max()`` ; i.e.,
+the memory is never automatically reduced.
+Each ``ADFun`` object has its own value for *max_byte* .
+It is not changed by :ref:`Dependent-name` , :ref:`optimize-name` ,
+or :ref:`new_dynamic-name` , and
+it is copied by the assignment operator.
+
+Policy
+******
+At the end of each call to ``Forward`` ,
+if the memory allocated for the Taylor coefficients is greater than
+*max_byte* ,
+it is reduced to the memory for the orders and directions that
+were just computed; i.e., the Taylor coefficients that can be used by the
+next call to :ref:`Reverse-name` .
+These coefficients are always kept, so the memory can be greater than
+*max_byte* .
+If *max_byte* is zero, the memory is reduced to the minimum
+after every call to ``Forward`` .
+Calling ``taylor_high_water`` with a value that is less than the
+current memory applies this policy immediately.
+
+Speed
+=====
+A ``Forward`` call that needs more orders than are allocated must
+allocate new memory and copy the lower orders.
+Hence *max_byte* should be large enough so that the memory is not
+reduced between the calls to ``Forward`` that are repeated
+for each new argument value.
+
+Idle Memory
+===========
+The memory that is freed is returned to :ref:`thread_alloc-name` .
+If :ref:`ta_hold_memory-name` is false, this memory is returned
+to the system immediately.
+Otherwise, it is held for future use by the same thread and can be
+returned to the system using :ref:`ta_free_available-name` .
+
+{xrst_toc_hidden
+   example/general/taylor_high_water.cpp
+}
+Example
+*******
+The file :ref:`taylor_high_water.cpp-name`
+contains an example and test of this operation.
+
+{xrst_end taylor_high_water}
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file taylor_high_water.hpp
+Automatic release of Taylor coefficient memory.
+*/
+
+/*!
+Set the maximum number of bytes retained for Taylor coefficients.
+
+\param max_byte
+is the new value for taylor_high_water_.
+If the memory currently allocated for taylor_ is greater than max_byte,
+it is reduced to the orders and directions that have been computed.
+*/
+// BEGIN_SET_PROTOTYPE
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::taylor_high_water(size_t max_byte)
+// END_SET_PROTOTYPE
+{  taylor_high_water_ = max_byte;
+   taylor_high_water_check();
+}
+
+/// Get the maximum number of bytes retained for Taylor coefficients.
+// BEGIN_GET_PROTOTYPE
+template <class Base, class RecBase>
+size_t ADFun<Base,RecBase>::taylor_high_water(void) const
+// END_GET_PROTOTYPE
+{  return taylor_high_water_; }
+
+/*!
+If the memory allocated for taylor_ is greater than taylor_high_water_,
+reduce its capacity to the num_order_taylor_ orders and
+num_direction_taylor_ directions that have been computed.
+*/
+template <class Base, class RecBase>
+void ADFun<Base,RecBase>::taylor_high_water_check(void)
+{  //
+   // check if memory is below the high water mark
+   if( taylor_.capacity() * sizeof(Base) <= taylor_high_water_ )
+      return;
+   //
+   // check if there are orders allocated that have not been computed
+   size_t c = num_order_taylor_;
+   if( cap_order_taylor_ <= c )
+      return;
+   //
+   // r
+   size_t r = num_direction_taylor_;
+   if( c <= 1 )
+      r = c;
+   //
+   // reduce the capacity to c orders and r directions
+   capacity_order(c, r);
+   CPPAD_ASSERT_UNKNOWN( num_order_taylor_ == c );
+   CPPAD_ASSERT_UNKNOWN( cap_order_taylor_ == c );
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -18,7 +18,13 @@
    cdecl
    declspec
    dllimport
+   dw
+   dx
+   nd
+   nnz
    ny
+   omp
+   simd
    typedef
    underbar
 }
@@ -29,7 +35,11 @@ C Source Code Corresponding to an ADFun Object
 Syntax
 ******
 
-   *fun* . ``to_csrc`` ( *os* , *c_type* )
+| *fun* . ``to_csrc`` ( *os* , *c_type* )
+| *fun* . ``to_csrc`` ( *os* , *c_type* , *options* )
+| *fun* . ``to_csrc`` ( *csrc_vec* , *c_type* , *options* )
+| *fun* . ``to_csrc`` ( *os* , *c_type* , *derivative* )
+| *fun* . ``to_csrc`` ( *os* , *c_type* , *derivative* , *pattern* , *coloring* )
 
 Prototype
 *********
@@ -37,6 +47,14 @@ Prototype
    // BEGIN_PROTOTYPE
    // END_PROTOTYPE
 }
+{xrst_literal
+   // BEGIN_CSRC_VEC_PROTOTYPE
+   // END_CSRC_VEC_PROTOTYPE
+}
+{xrst_literal
+   // BEGIN_DERIVATIVE_PROTOTYPE
+   // END_DERIVATIVE_PROTOTYPE
+}
 
 fun
 ***
@@ -56,11 +74,153 @@ os
 The C source code representation of the function *fun*
 is written to *os* .
 
+csrc_vec
+********
+If this argument is present (in place of *os* ),
+the C source code representation of *fun* is split into
+*n_unit* = *csrc_vec* . ``size`` () translation units;
+i.e., C source files that can be compiled separately and in parallel
+(see the *n_job* option for :ref:`create_dll_lib-name` ).
+The input value of the elements of *csrc_vec* does not matter.
+Upon return, *csrc_vec* [ *i* ] is the C source code for the *i*-th unit.
+The operations are split into parts; see
+:ref:`to_csrc@options@max_statement` .
+The parts are distributed between the units in order
+and the results of one part are passed to the next part using
+the :ref:`to_csrc@Temporary Vector` .
+If *max_statement* is not present and *n_unit* is greater than one,
+there is one part per translation unit.
+The :ref:`to_csrc@JIT Functions` , and the JIT batch function,
+are in *csrc_vec* [0] .
+
 c_type
 ******
 The possible values for this argument are:
 ``float`` , ``double`` , or ``long_double`` .
 
+options
+*******
+This argument has prototype
+
+   ``const std::map<std::string, std::string>&`` *options*
+
+The possible keys in this map are listed below
+(if a key is not present, the corresponding option is not used):
+
+batch_size
+==========
+If this key is present, its value is a positive integer *batch_size* ,
+and a :ref:`to_csrc@JIT Batch Functions` is written to *os*
+(in addition to the JIT function).
+The batch function evaluates the points in blocks of size *batch_size* .
+For each statement in the function, there is a loop over the
+points in the current block (preceded by ``# pragma omp simd`` when the
+iterations of the loop are independent).
+This enables the C compiler to vectorize the computation across points.
+Note that the temporary vector in the batch function is
+*batch_size* times as large as in the JIT function.
+
+max_statement
+=============
+If this key is present, its value is a positive integer *max_statement* .
+In this case, the operations in each JIT function are split into
+static C functions that each contain at most *max_statement* operations.
+The JIT function calls these parts in order.
+Large functions can take a long time, and a lot of memory, to compile;
+e.g., the C compiler optimizer does not scale linearly in the size of a
+function. Splitting bounds the size of the functions that the compiler sees.
+If the function has *max_statement* or fewer operations,
+it is not split.
+The parts can also be placed in separate translation units;
+see :ref:`to_csrc@csrc_vec` .
+
+Temporary Vector
+****************
+The temporary vector used by a JIT function holds the independent
+variables, the constants, and the results of the operations.
+An element that holds the result of an operation is reused
+after the last operation that uses the result; i.e.,
+its size is the maximum number of results that are needed at the same time
+(not the total number of results).
+
+derivative
+**********
+If this argument is present, the C source code for a derivative of *fun*
+is written to *os* (instead of the code for *fun* itself).
+The derivative is recorded using :ref:`base2ad-name` ,
+optimized, and then converted to C source code.
+Hence the derivative code is straight line code; i.e., there are no
+loops over the sparsity pattern or the colors.
+This must be called when there is no tape currently recording
+on this thread.
+The possible values for this argument are listed below:
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   *derivative*,    *nu*,                 *ny*
+   ``for_one``,        *nd* + 2 * *nx* , 2 * *m*
+   ``rev_one``,        *nd* + *nx* + *m* , *m* + *nx*
+   ``sparse_jac_for``, *nd* + *nx* ,       *nnz*
+   ``sparse_jac_rev``, *nd* + *nx* ,       *nnz*
+
+where *nd* is the number of independent dynamic parameters,
+*nx* is the number of independent variables,
+*m* is the number of dependent variables,
+and *nnz* is the number of possibly non-zero elements in *pattern* .
+The vectors *u* and *y* in the
+:ref:`to_csrc@JIT Functions` are partitioned as follows:
+
+for_one
+=======
+The vector *u* is ( *p* , *x* , *dx* ) and *y* is ( *f* , *df* ) where
+*df* = *f'* ( *x* ) * *dx*
+is the first order forward mode directional derivative in the direction
+*dx* ; see :ref:`forward_one-name` .
+
+rev_one
+=======
+The vector *u* is ( *p* , *x* , *w* ) and *y* is ( *f* , *dw* ) where
+*dw* = *w* ^T *f'* ( *x* )
+is the first order reverse mode derivative for the range weights *w* ;
+see :ref:`reverse_one-name` .
+
+sparse_jac_for, sparse_jac_rev
+==============================
+The vector *u* is ( *p* , *x* ) and
+*y* [ *k* ] is the value of the Jacobian *f'* ( *x* ) at
+row *pattern* . ``row`` ()[ *k* ] and
+column *pattern* . ``col`` ()[ *k* ] .
+The Jacobian is computed using the corresponding
+:ref:`sparse_jac-name` routine.
+
+function_name
+=============
+If *derivative* is present, the C function is
+``cppad_jit_``\ *function_name*\ _\ *derivative* ; e.g.,
+if *function_name* is ``f`` and *derivative* is ``rev_one`` ,
+the C function is ``cppad_jit_f_rev_one`` .
+This way the function and its derivatives can be linked into the same
+library (each C source file should only contain one function).
+
+pattern
+*******
+This argument is only present when *derivative* is
+``sparse_jac_for`` or ``sparse_jac_rev`` .
+It is a :ref:`sparse_rc-name` pattern that must contain
+all the possibly non-zero elements of the Jacobian;
+see :ref:`for_jac_sparsity-name` .
+
+coloring
+********
+This argument is only present when *derivative* is
+``sparse_jac_for`` or ``sparse_jac_rev`` .
+It is the :ref:`sparse_jac@coloring` used to
+determine which directions are computed together.
+The number of colors determines how many forward (reverse)
+sweeps are recorded, and hence the size of the C source code.
+
 JIT Functions
 *************
 
@@ -92,6 +252,45 @@ for the function *fun* and
 see :ref:`function_name-name` .
 
 
+JIT Batch Functions
+*******************
+
+Function Type
+=============
+The function type ``jit_batch_``\ *c_type* is defined in the
+CppAD namespace as:
+
+| ``typedef int`` (* ``jit_batch_``\ *c_type* )(
+| |tab| ``size_t`` , ``size_t`` , ``const`` *type* * ,
+| |tab| ``size_t`` , *type* * , ``size_t`` *
+| )
+
+Syntax
+======
+| *flag* = ``cppad_jit_batch_``\ *function_name* (
+| |tab| *n_point* , *nu* , *u* , *ny* , *y* , *compare_change*
+| )
+
+A corresponding function call evaluates zero order forward mode
+for the function *fun* at *n_point* points.
+It only exists when the
+:ref:`to_csrc@options@batch_size` option is present.
+
+n_point
+=======
+is the number of points at which to evaluate the function.
+
+u, y
+====
+The arguments *nu* , *ny* , *compare_change* and the return value *flag*
+have the same meaning as for the JIT function.
+The vectors *u* and *y* have size *nu* * *n_point* and
+*ny* * *n_point* respectively and are stored by component
+(structure of arrays); i.e.,
+*u* [ *j* * *n_point* + *k* ] is component *j* of the *k*-th argument,
+and
+*y* [ *i* * *n_point* + *k* ] is component *i* of the *k*-th result.
+
 Atomic Callbacks
 ****************
 
@@ -168,6 +367,10 @@ Example
 *******
 The section :ref:`example_jit-name` contains examples and tests
 that use ``to_csrc`` .
+The :ref:`jit_derivative.cpp-name` example uses the *derivative*
+argument, the :ref:`jit_batch.cpp-name` example uses the
+*options* argument, and the :ref:`jit_translation_unit.cpp-name` example
+uses the *csrc_vec* argument.
 
 {xrst_end to_csrc}
 */
@@ -196,6 +399,17 @@ namespace CppAD {
          size_t, const long double*, size_t, long double*, size_t*
       );
       //
+      // jit_batch_c_type
+      CPPAD_IMPORT typedef int (CPPAD_FUN_TYPE *jit_batch_float)(
+         size_t, size_t, const float*, size_t, float*, size_t*
+      );
+      CPPAD_IMPORT typedef int (CPPAD_FUN_TYPE *jit_batch_double)(
+         size_t, size_t, const double*, size_t, double*, size_t*
+      );
+      CPPAD_IMPORT typedef int (CPPAD_FUN_TYPE *jit_batch_long_double)(
+         size_t, size_t, const long double*, size_t, long double*, size_t*
+      );
+      //
       // atomic_c_type
       CPPAD_IMPORT typedef int (CPPAD_FUN_TYPE *atomic_float)(
          size_t, size_t, const float*, size_t, float*, size_t*
@@ -215,9 +429,21 @@ namespace CppAD {
 // BEGIN_PROTOTYPE
 template <class Base, class RecBase>
 void CppAD::ADFun<Base,RecBase>::to_csrc(
-   std::ostream&      os     ,
-   const std::string& c_type )
+   std::ostream&                             os      ,
+   const std::string&                        c_type  ,
+   const std::map<std::string, std::string>& options )
 // END_PROTOTYPE
+{  CppAD::vector<std::string> csrc_vec(1);
+   to_csrc(csrc_vec, c_type, options);
+   os << csrc_vec[0];
+}
+// BEGIN_CSRC_VEC_PROTOTYPE
+template <class Base, class RecBase>
+void CppAD::ADFun<Base,RecBase>::to_csrc(
+   CppAD::vector<std::string>&               csrc_vec ,
+   const std::string&                        c_type   ,
+   const std::map<std::string, std::string>& options  )
+// END_CSRC_VEC_PROTOTYPE
 {  //
    // type
 # ifndef NDEBUG
@@ -236,10 +462,167 @@ void CppAD::ADFun<Base,RecBase>::to_csrc(
    // graph corresponding to this function
    to_graph(graph_obj);
    //
+   // csrc_vec
+   local::graph::csrc_writer(csrc_vec, graph_obj, c_type, options);
+   //
+   return;
+}
+template <class Base, class RecBase>
+void CppAD::ADFun<Base,RecBase>::to_csrc(
+   std::ostream&      os     ,
+   const std::string& c_type )
+{  std::map<std::string, std::string> options;
+   to_csrc(os, c_type, options);
+}
+// BEGIN_DERIVATIVE_PROTOTYPE
+template <class Base, class RecBase>
+template <class SizeVector>
+void CppAD::ADFun<Base,RecBase>::to_csrc(
+   std::ostream&                os          ,
+   const std::string&           c_type      ,
+   const std::string&           derivative  ,
+   const sparse_rc<SizeVector>& pattern     ,
+   const std::string&           coloring    )
+// END_DERIVATIVE_PROTOTYPE
+{  //
+   // for_one, rev_one, sparse_for, sparse_rev
+   bool for_one    = derivative == "for_one";
+   bool rev_one    = derivative == "rev_one";
+   bool sparse_for = derivative == "sparse_jac_for";
+   bool sparse_rev = derivative == "sparse_jac_rev";
+   CPPAD_ASSERT_KNOWN( for_one || rev_one || sparse_for || sparse_rev,
+      "f.to_csrc: derivative is not one of the following: "
+      "for_one, rev_one, sparse_jac_for, sparse_jac_rev"
+   );
+   CPPAD_ASSERT_KNOWN( function_name_ != "" ,
+      "to_csrc: Cannot convert a function with no name"
+   );
+   CPPAD_ASSERT_KNOWN(
+      AD<RecBase>::tape_ptr() == nullptr ,
+      "f.to_csrc: derivative is present and a tape is currently recording"
+   );
+   //
+   // nd, nx, m
+   size_t nd = size_dyn_ind();
+   size_t nx = Domain();
+   size_t m  = Range();
+   //
+   // a_base, ad_vector
+   typedef AD<RecBase>            a_base;
+   typedef vector<a_base>         ad_vector;
+   //
+   // af
+   ADFun<a_base, RecBase> af = base2ad();
+   af.check_for_nan(false);
+   //
+   // ap
+   // current value of the independent dynamic parameters
+   ad_vector ap(nd);
+   const local::pod_vector<addr_t>& dyn_ind2par_ind(
+      play_.dyn_ind2par_ind()
+   );
+   for(size_t j = 0; j < nd; ++j)
+      ap[j] = play_.GetPar( size_t( dyn_ind2par_ind[j] ) );
+   //
+   // x_value
+   // use zero order Taylor coefficients when they are available
+   vector<Base> x_value(nx);
+   size_t c = (cap_order_taylor_ - 1) * num_direction_taylor_ + 1;
+   for(size_t j = 0; j < nx; ++j)
+   {  if( num_order_taylor_ > 0 )
+         x_value[j] = taylor_[ ind_taddr_[j] * c + 0 ];
+      else
+         x_value[j] = Base(0);
+   }
+   //
+   // nu
+   size_t nu = nx;
+   if( for_one )
+      nu = 2 * nx;
+   if( rev_one )
+      nu = nx + m;
+   //
+   // au
+   ad_vector au(nu);
+   for(size_t j = 0; j < nx; ++j)
+      au[j] = x_value[j];
+   for(size_t j = nx; j < nu; ++j)
+      au[j] = Base(0);
+   //
+   // Independent
+   CppAD::Independent(au, ap);
+   af.new_dynamic(ap);
+   //
+   // ax
+   ad_vector ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = au[j];
+   //
+   // ay
+   ad_vector ay;
+   if( for_one )
+   {  ad_vector adx(nx);
+      for(size_t j = 0; j < nx; ++j)
+         adx[j] = au[nx + j];
+      ad_vector af_x  = af.Forward(0, ax);
+      ad_vector adf   = af.Forward(1, adx);
+      ay.resize(2 * m);
+      for(size_t i = 0; i < m; ++i)
+      {  ay[i]     = af_x[i];
+         ay[m + i] = adf[i];
+      }
+   }
+   if( rev_one )
+   {  ad_vector aw(m);
+      for(size_t i = 0; i < m; ++i)
+         aw[i] = au[nx + i];
+      ad_vector af_x  = af.Forward(0, ax);
+      ad_vector adw   = af.Reverse(1, aw);
+      ay.resize(m + nx);
+      for(size_t i = 0; i < m; ++i)
+         ay[i] = af_x[i];
+      for(size_t j = 0; j < nx; ++j)
+         ay[m + j] = adw[j];
+   }
+   if( sparse_for || sparse_rev )
+   {  CPPAD_ASSERT_KNOWN(
+         pattern.nr() == m && pattern.nc() == nx ,
+         "f.to_csrc: pattern does not have the same dimensions as the "
+         "Jacobian of f"
+      );
+      sparse_rcv<SizeVector, ad_vector> subset( pattern );
+      sparse_jac_work work;
+      if( sparse_for )
+      {  size_t group_max = 1;
+         af.sparse_jac_for(group_max, ax, subset, pattern, coloring, work);
+      }
+      else
+         af.sparse_jac_rev(ax, subset, pattern, coloring, work);
+      ay = subset.val();
+   }
+   //
+   // g
+   ADFun<Base, RecBase> g(au, ay);
+   g.optimize("no_conditional_skip no_print_for_op");
+   g.function_name_set( function_name_ + "_" + derivative );
+   //
    // os
-   local::graph::csrc_writer(os, graph_obj, c_type);
+   g.to_csrc(os, c_type);
    //
    return;
 }
+template <class Base, class RecBase>
+void CppAD::ADFun<Base,RecBase>::to_csrc(
+   std::ostream&                os          ,
+   const std::string&           c_type      ,
+   const std::string&           derivative  )
+{  CPPAD_ASSERT_KNOWN( derivative == "for_one" || derivative == "rev_one",
+      "f.to_csrc: pattern and coloring must be present when derivative "
+      "is sparse_jac_for or sparse_jac_rev"
+   );
+   sparse_rc< vector<size_t> > pattern;
+   std::string                 coloring;
+   to_csrc(os, c_type, derivative, pattern, coloring);
+}
 
 # endif
@@ -34,6 +34,33 @@ Other Examples
 The file :ref:`valvector.cpp-name` tests that all of the valvector examples
 git the expected results.
 
+Implementation
+**************
+
+Memory
+======
+The elements of a valvector with size greater than one are stored in
+memory obtained from :ref:`thread_alloc-name` and aligned on a
+``valvector::align_bytes`` boundary.
+Resizing a valvector does not return its memory to ``thread_alloc`` ,
+so the memory can be reused when it grows again.
+A valvector with size one does not allocate any memory.
+
+Loops
+=====
+The element-by-element operations loop over contiguous memory and
+do not check the size of their operands inside the loop.
+This enables the compiler to vectorize these loops
+(using the SIMD instructions for the target machine).
+An operand with size one is broadcast by these loops
+without creating a vector of its value.
+The compound assignment operators compute their results in place.
+
+Speed
+=====
+The program :ref:`speed_valvector-name` compares the speed of
+a valvector recording with the corresponding ``double`` recording.
+
 Operations
 **********
 {xrst_toc_table after
@@ -47,9 +74,12 @@ Operations
 {xrst_end valvector}
 */
 # include <cmath>
+# include <cstdint>
 # include <iostream>
 # include <cassert>
+# include <functional>
 # include <cppad/utility/vector.hpp>
+# include <cppad/utility/thread_alloc.hpp>
 # include <cppad/base_require.hpp>
 // ============================================================================
 // Macros
@@ -70,23 +100,24 @@ Operations
 //
 # define CPPAD_VALVECTOR_UNARY_STD_MATH(fun) \
    inline valvector fun(const valvector &x) \
-   {  valvector result; \
-      result.resize( x.size() ); \
-      for(size_t i = 0; i < x.size(); ++i) \
-         result[i] = std::fun( x[i] ); \
+   {  size_t n = x.size(); \
+      valvector result; \
+      result.resize(n); \
+      const valvector::scalar_type* x_ptr = x.data(); \
+      valvector::scalar_type*       r_ptr = result.data(); \
+      for(size_t i = 0; i < n; ++i) \
+         r_ptr[i] = std::fun( x_ptr[i] ); \
       return result; \
    }
 //
-# define CPPAD_VALVECTOR_BINARY_NUMERIC_OP(op, compound_op) \
+# define CPPAD_VALVECTOR_BINARY_NUMERIC_OP(op, compound_op, functor) \
    valvector operator op(const valvector& other) const \
    {  CPPAD_VALVECTOR_ASSERT_KNOWN(  \
          size() == 1 || other.size() == 1 || size() == other.size() , \
          "size error using " #op " operator" \
       ) \
       valvector result; \
-      result.resize( std::max( size(), other.size() ) );   \
-      for(size_t i = 0; i < result.size(); ++i) \
-         result[i] = (*this)[i] op other[i]; \
+      result.binary_assign(*this, other, functor<scalar_type>() ); \
       return result; \
    } \
    valvector& operator compound_op(const valvector& other) \
@@ -94,13 +125,7 @@ Operations
          size() == 1 || other.size() == 1 || size() == other.size() , \
          "size error using " #compound_op " operator" \
       ) \
-      if( size() == 1 && 1 < other.size()) \
-      {  vec_.resize( other.size() ); \
-         for(size_t i = 0; i < size(); ++i) \
-            vec_[i] = scalar_; \
-      } \
-      for(size_t i = 0; i < size(); ++i) \
-         (*this)[i] compound_op other[i]; \
+      binary_assign(*this, other, functor<scalar_type>() ); \
       return *this; \
    }
 # define CPPAD_VALVECTOR_BINARY_ORDER_OP(op) \
@@ -120,17 +145,115 @@ public:
    // scalar_type
    typedef double                     scalar_type;
    //
+   // align_bytes
+   // alignment for the elements of a valvector with size greater than one
+   static const size_t align_bytes = 64;
+   //
 private:
    //
-   // vector_type
-   typedef CppAD::vector<scalar_type> vector_type;
+   // size_
+   // number of elements in this valvector (never zero)
+   size_t size_;
+   //
+   // capacity_
+   // number of elements that can be stored at data_
+   size_t capacity_;
    //
-   // vec_
-   vector_type vec_;
+   // memory_
+   // memory obtained from thread_alloc (nullptr if capacity_ is zero)
+   void* memory_;
+   //
+   // data_
+   // aligned pointer into memory_ used for the elements when size_ > 1
+   scalar_type* data_;
    //
    // scalar_
+   // the element of this valvector when size_ == 1
    scalar_type scalar_;
+   //
+   // reserve
+   // make sure that capacity_ is greater than or equal n
+   // (the element values are not preserved when memory is allocated)
+   void reserve(size_t n)
+   {  if( n <= capacity_ )
+         return;
+      free_memory();
+      size_t min_bytes = n * sizeof(scalar_type) + align_bytes;
+      size_t cap_bytes;
+      memory_ = CppAD::thread_alloc::get_memory(min_bytes, cap_bytes);
+      //
+      // data_
+      std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory_);
+      size_t         offset  = align_bytes - address % align_bytes;
+      if( offset == align_bytes )
+         offset = 0;
+      data_     = reinterpret_cast<scalar_type*>( address + offset );
+      capacity_ = (cap_bytes - offset) / sizeof(scalar_type);
+   }
+   //
+   // free_memory
+   void free_memory(void)
+   {  if( memory_ != nullptr )
+         CppAD::thread_alloc::return_memory(memory_);
+      memory_   = nullptr;
+      data_     = nullptr;
+      capacity_ = 0;
+   }
+   //
+   // swap
+   void swap(valvector& other)
+   {  std::swap(size_,     other.size_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(memory_,   other.memory_);
+      std::swap(data_,     other.data_);
+      std::swap(scalar_,   other.scalar_);
+   }
 public:
+   //
+   // binary_assign
+   // Set this valvector to the element-by-element result of op(x, y).
+   // This valvector may be the same as x or y.
+   template <class Op>
+   void binary_assign(const valvector& x, const valvector& y, Op op)
+   {  //
+      // x_size, y_size, n
+      // (must be computed before this valvector is resized)
+      size_t x_size = x.size_;
+      size_t y_size = y.size_;
+      size_t n      = std::max(x_size, y_size);
+      if( n == 1 )
+      {  scalar_type value = op(x.scalar_, y.scalar_);
+         size_   = 1;
+         scalar_ = value;
+         return;
+      }
+      //
+      // x_scalar, y_scalar
+      scalar_type x_scalar = x.scalar_;
+      scalar_type y_scalar = y.scalar_;
+      //
+      // result
+      // this does not change x.data_ (y.data_) if x (y) is this valvector
+      // and its size is n
+      resize(n);
+      scalar_type*       r_ptr = data_;
+      const scalar_type* x_ptr = x.data_;
+      const scalar_type* y_ptr = y.data_;
+      //
+      if( x_size == 1 )
+      {  for(size_t i = 0; i < n; ++i)
+            r_ptr[i] = op(x_scalar, y_ptr[i]);
+      }
+      else if( y_size == 1 )
+      {  for(size_t i = 0; i < n; ++i)
+            r_ptr[i] = op(x_ptr[i], y_scalar);
+      }
+      else
+      {  for(size_t i = 0; i < n; ++i)
+            r_ptr[i] = op(x_ptr[i], y_ptr[i]);
+      }
+   }
+
    /*
    ---------------------------------------------------------------------------
    {xrst_begin valvector_ctor}
@@ -189,47 +312,56 @@ public:
    ---------------------------------------------------------------------------
    */
    // default ctor
-   valvector(void) : vec_(0), scalar_()
+   valvector(void)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr), scalar_()
    { }
    //
    // ctor of scalar
-   valvector(size_t s) : vec_(0), scalar_( scalar_type(s) )
+   valvector(size_t s)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr)
+   , scalar_( scalar_type(s) )
    { }
-   valvector(int s) : vec_(0), scalar_( scalar_type(s) )
+   valvector(int s)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr)
+   , scalar_( scalar_type(s) )
    { }
-   valvector(long int s) : vec_(0), scalar_( scalar_type(s) )
+   valvector(long int s)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr)
+   , scalar_( scalar_type(s) )
    { }
-   valvector(double s) : vec_(0), scalar_( scalar_type(s) )
+   valvector(double s)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr)
+   , scalar_( scalar_type(s) )
    { }
-   valvector(long double s) : vec_(0), scalar_( scalar_type(s) )
+   valvector(long double s)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr)
+   , scalar_( scalar_type(s) )
    { }
    //
    valvector(const valvector& other)
-   : vec_( other.vec_), scalar_( other.scalar_)
-   { }
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr), scalar_()
+   {  *this = other; }
    valvector(valvector&& other)
-   {  vec_.swap( other.vec_ );
-      scalar_ = other.scalar_;
-   }
-   valvector(std::initializer_list<scalar_type> list) : vec_(0)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr), scalar_()
+   {  swap(other); }
+   valvector(std::initializer_list<scalar_type> list)
+   : size_(1), capacity_(0), memory_(nullptr), data_(nullptr), scalar_()
    {  CPPAD_VALVECTOR_ASSERT_KNOWN(
          list.size() != 0,
          "Cannot create a valvector with size zero."
       )
-      std::initializer_list<scalar_type>::iterator itr;
-      if( list.size() == 1 )
-      {  itr     = list.begin();
-         scalar_ = *itr;
-      }
-      else
-      {  vec_.resize( list.size() );
-         itr = list.begin();
-         for(size_t i = 0; i < vec_.size(); ++i)
-         {  vec_[i] = *itr;
-            ++itr;
-         }
+      resize( list.size() );
+      scalar_type* ptr = data();
+      std::initializer_list<scalar_type>::iterator itr = list.begin();
+      for(size_t i = 0; i < list.size(); ++i)
+      {  ptr[i] = *itr;
+         ++itr;
       }
    }
+   //
+   // destructor
+   ~valvector(void)
+   {  free_memory(); }
    /*
    ----------------------------------------------------------------------------
    {xrst_begin valvector_resize}
@@ -263,6 +395,11 @@ public:
    Directly after this operation,
    none of the element values are specified.
 
+   Memory
+   ******
+   This operation does not free the memory for the elements
+   (so it can be reused if the size increases).
+
    {xrst_toc_hidden
       example/valvector/resize.cpp
    }
@@ -279,12 +416,9 @@ public:
    void resize(size_t n)
    // END_RESIZE
    {  assert( n != 0 );
-      if( n == size() )
-         return;
-      if( n == 1 )
-         vec_.clear();
-      else
-         vec_.resize(n);
+      if( 1 < n )
+         reserve(n);
+      size_ = n;
    }
    /*
    ----------------------------------------------------------------------------
@@ -315,15 +449,21 @@ public:
    // BEGIN_ASSIGN_ONE
    valvector& operator=(const valvector& other)
    // END_ASSIGN_ONE
-   {  vec_    = other.vec_;
+   {  if( this == &other )
+         return *this;
+      resize( other.size_ );
       scalar_ = other.scalar_;
+      if( 1 < size_ )
+      {  const scalar_type* o_ptr = other.data_;
+         for(size_t i = 0; i < size_; ++i)
+            data_[i] = o_ptr[i];
+      }
       return *this;
    }
    // BEGIN_ASSIGN_TWO
    valvector& operator=(valvector&& other)
    // END_ASSIGN_TWO
-   {  vec_.swap( other.vec_ );
-      scalar_ = other.scalar_;
+   {  swap(other);
       return *this;
    }
    /*
@@ -355,11 +495,7 @@ public:
    // BEGIN_SIZE
    size_t size(void) const
    // END_SIZE
-   {  assert( vec_.size() != 1 );
-      if( vec_.size() == 0 )
-         return 1;
-      return vec_.size();
-   }
+   {  return size_; }
    /*
    ----------------------------------------------------------------------------
    {xrst_begin valvector_sum}
@@ -389,9 +525,10 @@ public:
    // BEGIN_SUM
    scalar_type sum(void) const
    // END_SUM
-   {  scalar_type result = 0.0;
-      for(size_t i = 0; i < size(); ++i)
-         result += (*this)[i];
+   {  const scalar_type* ptr = data();
+      scalar_type result = 0.0;
+      for(size_t i = 0; i < size_; ++i)
+         result += ptr[i];
       return result;
    }
    /*
@@ -407,6 +544,8 @@ public:
    {xrst_literal ,
       // BEGIN_ELEMENT , // END_ELEMENT
       // BEGIN_CONST_ELEMENT , // END_CONST_ELEMENT
+      // BEGIN_DATA , // END_DATA
+      // BEGIN_CONST_DATA , // END_CONST_DATA
    }
 
    j
@@ -418,6 +557,13 @@ public:
    #. If the size of this valvector is not one, *j* must be less than
       its size and the return is the j-th element in this valvector.
 
+   data
+   ****
+   The return value of ``data()`` is a pointer to the first element
+   of this valvector and the other elements follow contiguously in memory.
+   This pointer is no longer valid after this valvector is resized
+   or assigned a new value.
+
    {xrst_toc_hidden
       example/valvector/element.cpp
    }
@@ -436,9 +582,9 @@ public:
          size() == 1 || j < size(),
          "size is not one and index is greater than or equal size"
       );
-      if( size() == 1 )
+      if( size_ == 1 )
          return scalar_;
-      return vec_[j];
+      return data_[j];
    }
    // BEGIN_CONST_ELEMENT
    const scalar_type& operator[](size_t j) const
@@ -447,9 +593,23 @@ public:
          size() == 1 || j < size(),
          "size is not one and index is greater than or equal size"
       );
-      if( size() == 1 )
+      if( size_ == 1 )
          return scalar_;
-      return vec_[j];
+      return data_[j];
+   }
+   // BEGIN_DATA
+   scalar_type* data(void)
+   // END_DATA
+   {  if( size_ == 1 )
+         return &scalar_;
+      return data_;
+   }
+   // BEGIN_CONST_DATA
+   const scalar_type* data(void) const
+   // END_CONST_DATA
+   {  if( size_ == 1 )
+         return &scalar_;
+      return data_;
    }
    /*
    ----------------------------------------------------------------------------
@@ -486,9 +646,11 @@ public:
    valvector operator-(void) const
    // END_MINUS
    {  valvector result;
-      result.resize( size() );
-      for(size_t i = 0; i < size(); ++i)
-         result[i] = - (*this)[i];
+      result.resize( size_ );
+      const scalar_type* x_ptr = data();
+      scalar_type*       r_ptr = result.data();
+      for(size_t i = 0; i < size_; ++i)
+         r_ptr[i] = - x_ptr[i];
       return result;
    }
    /*
@@ -570,10 +732,10 @@ public:
 
    {xrst_end valvector_compound_op}
    */
-   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(+, +=)
-   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(-, -=)
-   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(*, *=)
-   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(/, /=)
+   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(+, +=, std::plus)
+   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(-, -=, std::minus)
+   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(*, *=, std::multiplies)
+   CPPAD_VALVECTOR_BINARY_NUMERIC_OP(/, /=, std::divides)
    /*
    ----------------------------------------------------------------------------
    {xrst_begin valvector_compare_op}
@@ -841,10 +1003,12 @@ namespace CppAD {
          x.size() == 1 || y.size() == 1 || x.size() == y.size() ,
          "size error using pow function"
       )
+      struct pow_op {
+         double operator()(double x_i, double y_i) const
+         {  return std::pow(x_i, y_i); }
+      };
       valvector  result;
-      result.resize( std::max( x.size(), y.size() ) );
-      for(size_t i = 0; i < x.size(); ++i)
-         result[i] = std::pow( x[i] , y[i] );
+      result.binary_assign(x, y, pow_op() );
       return result;
    }
    /*
@@ -897,21 +1061,47 @@ namespace CppAD {
          "size error using azmul function"
       )
       //
+      // n, scalar_zero
+      size_t      n = std::max( x.size(), y.size() );
+      scalar_type scalar_zero(0);
+      //
       // special case
-      valvector vec_zero = valvector(0);
-      if( x == vec_zero )
-         return vec_zero;
+      if( x.size() == 1 && x[0] == scalar_zero )
+         return valvector(0);
       //
-      // elememt-by-element
-      scalar_type scalar_zero(0);
+      // result, all_zero
+      // elememt-by-element in one pass
       valvector  result;
-      result.resize( std::max( x.size(), y.size() ) );
-      for(size_t i = 0; i < result.size(); ++i)
-      {  if( x[i] == scalar_zero )
-            result[i] = scalar_zero;
-          else
-            result[i] = x[i] * y[i];
+      result.resize(n);
+      const scalar_type* x_ptr    = x.data();
+      const scalar_type* y_ptr    = y.data();
+      scalar_type*       r_ptr    = result.data();
+      bool               all_zero = true;
+      if( x.size() == 1 )
+      {  scalar_type x_0 = x_ptr[0];
+         for(size_t i = 0; i < n; ++i)
+            r_ptr[i] = x_0 * y_ptr[i];
+         all_zero = false;
       }
+      else if( y.size() == 1 )
+      {  scalar_type y_0 = y_ptr[0];
+         for(size_t i = 0; i < n; ++i)
+         {  bool zero_i = x_ptr[i] == scalar_zero;
+            r_ptr[i]    = zero_i ? scalar_zero : x_ptr[i] * y_0;
+            all_zero   &= zero_i;
+         }
+      }
+      else
+      {  for(size_t i = 0; i < n; ++i)
+         {  bool zero_i = x_ptr[i] == scalar_zero;
+            r_ptr[i]    = zero_i ? scalar_zero : x_ptr[i] * y_ptr[i];
+            all_zero   &= zero_i;
+         }
+      }
+      //
+      // special case
+      if( all_zero )
+         return valvector(0);
       return result;
    }
    /*
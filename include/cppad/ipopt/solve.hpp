@@ -125,6 +125,34 @@ If
 
 the Jacobians will be calculated using ``SparseJacobianReverse`` .
 
+Lagrangian
+==========
+You can set the Lagrangian Hessian flag with the following syntax:
+
+   ``Lagrangian`` *value*
+
+If the value is ``true`` , ``ipopt::solve`` will make a second recording
+of the Lagrangian
+
+.. math::
+
+   L( x ) = \sigma f(x) + \sum_{i=0}^{ng-1} \lambda_i g_i (x)
+
+where :math:`\sigma` and :math:`\lambda` are
+:ref:`dynamic parameters<glossary@Parameter@Dynamic>` .
+Each evaluation of the Hessian of the Lagrangian is then
+a call to :ref:`new_dynamic-name` (only when :math:`\sigma` or
+:math:`\lambda` has changed) followed by one call to
+:ref:`sparse_hes-name` that reuses the coloring and work
+from the previous calls.
+If the value is ``false`` , the Hessian is computed using a weighted
+sum of the components of :math:`[ f(x) , g(x) ]` for each evaluation.
+The sparsity pattern for the Hessian is the same in both cases.
+The extra recording has a small cost, so this is only faster when
+the number of variables *nx* is large.
+The default value is ``false`` .
+If Lagrangian is true, Sparse must also be true.
+
 String
 ======
 You can set any Ipopt string option using a line with the following syntax:
@@ -430,7 +458,9 @@ Ipopt options (are optional) and have one of the following forms
 \endcode
 The following other possible options are listed below:
 \code
-   Retape   value
+   Retape     value
+   Sparse     value direction
+   Lagrangian value
 \endcode
 
 
@@ -493,6 +523,7 @@ void solve(
    bool retape          = false;
    bool sparse_forward  = false;
    bool sparse_reverse  = false;
+   bool lagrangian      = false;
    while( begin_1 < options.size() )
    {  // split this line into tokens
       while( options[begin_1] == ' ')
@@ -565,6 +596,13 @@ void solve(
             sparse_reverse = tok_3 == "reverse";
          }
       }
+      else if( tok_1 == "Lagrangian" )
+      {  CPPAD_ASSERT_KNOWN(
+            (tok_2 == "true") || (tok_2 == "false") ,
+            "ipopt::solve: Lagrangian value is not true or false"
+         );
+         lagrangian = (tok_2 == "true");
+      }
       else if ( tok_1 == "String" )
          app->Options()->SetStringValue(tok_2.c_str(), tok_3.c_str());
       else if ( tok_1 == "Numeric" )
@@ -579,7 +617,7 @@ void solve(
          CPPAD_ASSERT_KNOWN(
          false,
          "ipopt::solve: First token is not one of\n"
-         "Retape, Sparse, String, Numeric, Integer"
+         "Retape, Sparse, Lagrangian, String, Numeric, Integer"
       );
 
       begin_1 = end_3;
@@ -596,6 +634,10 @@ void solve(
       ! ( retape & (sparse_forward | sparse_reverse) ) ,
       "ipopt::solve: retape and sparse both true is not supported."
    );
+   CPPAD_ASSERT_KNOWN(
+      ! lagrangian || sparse_forward || sparse_reverse ,
+      "ipopt::solve: Lagrangian is true and Sparse is false."
+   );
 
    // Initialize the IpoptApplication and process the options
    Ipopt::ApplicationReturnStatus status = app->Initialize();
@@ -622,6 +664,7 @@ void solve(
       retape,
       sparse_forward,
       sparse_reverse,
+      lagrangian,
       solution
    );
 
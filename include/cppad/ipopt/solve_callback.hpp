@@ -2,7 +2,7 @@
 # define CPPAD_IPOPT_SOLVE_CALLBACK_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/cppad.hpp>
@@ -75,6 +75,8 @@ private:
    /// Should sparse methods be used to compute Jacobians and Hessians
    /// with reverse mode used for Jacobian.
    bool                            sparse_reverse_;
+   /// Should the Hessian of the Lagrangian be computed using lag_fun_.
+   bool                            lagrangian_;
    /// final results are returned to this structure
    solve_result<Dvector>&          solution_;
    // ------------------------------------------------------------------
@@ -122,6 +124,21 @@ private:
    CppAD::vector<size_t>           col_hes_;
    /// Work vector used by SparseJacobian, stored here to avoid recalculation.
    CppAD::sparse_hessian_work      work_hes_;
+   // ----------------------------------------------------------------------
+   // Lagrangian information (only used when lagrangian_ is true)
+   // ----------------------------------------------------------------------
+   /// AD function object that evaluates x -> L(x) where
+   /// \f[ L(x) = \sum_i w_i [ f(x), g(x) ]_i \f]
+   /// and w = [ sigma, ..., sigma, lambda ] are dynamic parameters.
+   CppAD::ADFun<double>            lag_fun_;
+   /// value of the dynamic parameters w in lag_fun_.
+   Dvector                         lag_w_;
+   /// Sparsity pattern for the Hessian of L(x) (same as pattern_hes_).
+   CppAD::sparse_rc< CppAD::vector<size_t> >            lag_pattern_;
+   /// Lower triangle of Hessian of L(x) with same order as row_hes_.
+   CppAD::sparse_rcv< CppAD::vector<size_t>, Dvector >  lag_subset_;
+   /// Work used by sparse_hes, stored here so the coloring is only done once.
+   CppAD::sparse_hes_work          lag_work_;
    // ------------------------------------------------------------------
    // Private member functions
    // ------------------------------------------------------------------
@@ -208,6 +225,11 @@ public:
    with reverse mode for Jacobian.
    (sparse_forward and sparse_reverse cannot both be true).
 
+   \param lagrangian
+   should the Hessian of the Lagrangian be computed using a separate
+   recording of the Lagrangian where sigma and lambda are dynamic parameters.
+   (If lagrangian is true, sparse_forward or sparse_reverse must be true).
+
    \param solution
    object where final results are stored.
    */
@@ -224,6 +246,7 @@ public:
       bool                   retape          ,
       bool                   sparse_forward  ,
       bool                   sparse_reverse  ,
+      bool                   lagrangian      ,
       solve_result<Dvector>& solution ) :
    nf_ ( nf ),
    nx_ ( nx ),
@@ -237,8 +260,12 @@ public:
    retape_ ( retape ),
    sparse_forward_ ( sparse_forward ),
    sparse_reverse_ ( sparse_reverse ),
+   lagrangian_ ( lagrangian ),
    solution_ ( solution )
    {  CPPAD_ASSERT_UNKNOWN( ! ( sparse_forward_ & sparse_reverse_ ) );
+      CPPAD_ASSERT_UNKNOWN(
+         ! lagrangian_ || sparse_forward_ || sparse_reverse_
+      );
 
       size_t i, j;
       size_t nfg = nf_ + ng_;
@@ -430,6 +457,55 @@ public:
       // Column order indirect sort of the Jacobian indices
       col_order_jac_.resize( col_jac_.size() );
       index_sort( col_jac_, col_order_jac_ );
+
+      if( lagrangian_ )
+      {  // make lag_fun_ correspond to x -> sum_i w_i [ f(x), g(x) ]_i
+         ADvector a_x(nx_), a_w(nfg), a_fg(nfg), a_lag(1);
+         for(i = 0; i < nx_; i++)
+            a_x[i] = xi_[i];
+         for(i = 0; i < nfg; i++)
+            a_w[i] = 1.0;
+         CppAD::Independent(a_x, a_w);
+         fg_eval_(a_fg, a_x);
+         a_lag[0] = 0.0;
+         for(i = 0; i < nfg; i++)
+            a_lag[0] += a_w[i] * a_fg[i];
+         lag_fun_.Dependent(a_x, a_lag);
+         // optimize because we will make repeated use of this tape
+         lag_fun_.optimize();
+         //
+         // lag_w_ is nan so first call to eval_h sets dynamic parameters
+         lag_w_.resize(nfg);
+         for(i = 0; i < nfg; i++)
+            lag_w_[i] = std::numeric_limits<double>::quiet_NaN();
+         //
+         // lag_pattern_: same as pattern_hes_
+         CPPAD_ASSERT_UNKNOWN( pattern_hes_.size() == nx_ * nx_ );
+         size_t nnz = 0;
+         for(i = 0; i < nx_; i++)
+         {  for(j = 0; j < nx_; j++)
+               if( pattern_hes_[ i * nx_ + j ] )
+                  ++nnz;
+         }
+         lag_pattern_.resize(nx_, nx_, nnz);
+         size_t k = 0;
+         for(i = 0; i < nx_; i++)
+         {  for(j = 0; j < nx_; j++)
+               if( pattern_hes_[ i * nx_ + j ] )
+                  lag_pattern_.set(k++, i, j);
+         }
+         //
+         // lag_subset_: lower triangle in same order as row_hes_, col_hes_
+         size_t nk = row_hes_.size();
+         CppAD::sparse_rc< CppAD::vector<size_t> > subset_pattern(
+            nx_, nx_, nk
+         );
+         for(k = 0; k < nk; k++)
+            subset_pattern.set(k, row_hes_[k], col_hes_[k]);
+         lag_subset_ = CppAD::sparse_rcv< CppAD::vector<size_t>, Dvector >(
+            subset_pattern
+         );
+      }
    }
    // -----------------------------------------------------------------------
    /*!
@@ -911,7 +987,8 @@ public:
    \param[in] new_lambda
    is true if the previous call to eval_h had the same value for
    lambda and false otherwise.
-   (Not currently used.)
+   (Not currently used; when lagrangian_ is true, the dynamic parameters
+   are only changed if obj_factor or lambda is different.)
 
    \param[in] nele_hess
    is the number of possibly non-zero elements in the
@@ -992,7 +1069,27 @@ public:
       for(i = 0; i < ng_; i++)
          w[i + nf_] = lambda[i];
       //
-      if( sparse_forward_ | sparse_reverse_ )
+      if( lagrangian_ )
+      {  // change the dynamic parameters only if they are different
+         bool new_w = false;
+         for(i = 0; i < nf_ + ng_; i++)
+            new_w |= w[i] != lag_w_[i];
+         if( new_w )
+         {  lag_w_ = w;
+            lag_fun_.new_dynamic(lag_w_);
+         }
+         // Hessian of L(x) using coloring and work from previous calls
+         Dvector r(1);
+         r[0] = 1.0;
+         std::string coloring = "cppad.symmetric";
+         lag_fun_.sparse_hes(
+            x0_, r, lag_subset_, lag_pattern_, coloring, lag_work_
+         );
+         const Dvector& hes( lag_subset_.val() );
+         for(k = 0; k < nk; k++)
+            values[k] = hes[k];
+      }
+      else if( sparse_forward_ | sparse_reverse_ )
       {  Dvector hes(nk);
          adfun_.SparseHessian(
             x0_, w, pattern_hes_, row_hes_, col_hes_, hes, work_hes_
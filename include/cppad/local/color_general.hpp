@@ -137,14 +137,16 @@ void color_general_cppad(
    fact that only the entries (subset of the sparsity pattern) specified by
    row and col need to be computed.
    */
-   CppAD::vector<bool> forbidden(m);
+   //
+   // forbidden[ell] == i if color ell is forbidden for row i.
+   // This avoids resetting forbidden for each row, which would require
+   // order m^2 operations because the initial color for row i is order i.
+   CppAD::vector<size_t> forbidden(m);
+   for(ell = 0; ell < m; ell++)
+      forbidden[ell] = m;
    for(size_t i = 1; i < m; i++) // for each row that appears
    if( color[i] < m )
    {
-      // initial all colors as ok for this row
-      // (value of forbidden for ell > initial color[i] does not matter)
-      for(ell = 0; ell <= color[i]; ell++)
-         forbidden[ell] = false;
 
       // -----------------------------------------------------
       // Forbid colors for which this row would destroy results:
@@ -159,7 +161,7 @@ void color_general_cppad(
          while( r != c2r_appear.end() )
          {  // if this is not the same row, forbid its color
             if( (r < i) && (color[r] < m) )
-               forbidden[ color[r] ] = true;
+               forbidden[ color[r] ] = i;
             r = *(++c2r_itr);
          }
          j = *(++pattern_itr);
@@ -180,7 +182,7 @@ void color_general_cppad(
          while( r != not_appear.end() )
          {  // if this is not the same row, forbid its color
             if( (r < i) && (color[r] < m) )
-               forbidden[ color[r] ] = true;
+               forbidden[ color[r] ] = i;
             r = *(++not_itr);
          }
          j = *(++r2c_itr);
@@ -188,7 +190,7 @@ void color_general_cppad(
 
       // pick the color with smallest index
       ell = 0;
-      while( forbidden[ell] )
+      while( forbidden[ell] == i )
       {  ell++;
          CPPAD_ASSERT_UNKNOWN( ell <= color[i] );
       }
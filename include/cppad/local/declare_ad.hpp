@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_DECLARE_AD_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/configure.hpp>
@@ -41,6 +41,8 @@ namespace CppAD {
    class sparse_jac_work;
    class sparse_jacobian_work;
    class sparse_hessian_work;
+   template <class Base> class subgraph_work;
+   struct fun_memory_info;
    template <class Base> class AD;
    template <class Base, class RecBase=Base> class ADFun;
    template <class Base> class atomic_base;
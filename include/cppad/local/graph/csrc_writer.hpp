@@ -3,10 +3,12 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <string>
+# include <map>
+# include <cppad/utility/vector.hpp>
 # include <cppad/local/graph/cpp_graph_op.hpp>
 
 /*
@@ -17,7 +19,9 @@ Prototype for csrc_writer
 
 Syntax
 ******
-``csrc_writer`` ( *csrc* , *graph_obj* , *type*  )
+| ``csrc_writer`` ( *csrc* , *graph_obj* , *type*  )
+| ``csrc_writer`` ( *csrc* , *graph_obj* , *type* , *options* )
+| ``csrc_writer`` ( *csrc_vec* , *graph_obj* , *type* , *options* )
 
 Prototype
 *********
@@ -29,6 +33,18 @@ namespace CppAD { namespace local { namespace graph {
       const cpp_graph&    graph_obj   ,
       const std::string&  type
    );
+   CPPAD_LIB_EXPORT void csrc_writer(
+      std::ostream&                             os          ,
+      const cpp_graph&                          graph_obj   ,
+      const std::string&                        type        ,
+      const std::map<std::string, std::string>& options
+   );
+   CPPAD_LIB_EXPORT void csrc_writer(
+      CppAD::vector<std::string>&               csrc_vec    ,
+      const cpp_graph&                          graph_obj   ,
+      const std::string&                        type        ,
+      const std::map<std::string, std::string>& options
+   );
 } } }
 /* {xrst_code}
 {xrst_spell_on}
@@ -0,0 +1,165 @@
+# ifndef CPPAD_LOCAL_PLAY_ATOM_WORK_HPP
+# define CPPAD_LOCAL_PLAY_ATOM_WORK_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <cppad/utility/vector.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/core/ad_type.hpp>
+
+/*
+{xrst_begin atom_work dev}
+
+Work Space Used by the Sweeps to Call Atomic Functions
+######################################################
+
+Syntax
+******
+| ``play::atom_work`` < *Base* > *work*
+| *work* . ``reserve`` ( *n* , *m* , *n_coef* )
+| *work* . ``swap`` ( *other* )
+
+Purpose
+*******
+Each ``player`` object contains one of these objects.
+The sweeps use its vectors to pass the arguments and results of
+an atomic function call to the atomic function callbacks.
+This avoids allocating these vectors every time a sweep is run.
+The sweeps resize these vectors for each atomic function call,
+which does not allocate memory once they are large enough;
+see :ref:`CppAD_vector@resize` .
+
+Reentrance
+**********
+There is only one of these objects for each player.
+Thus a sweep for a player cannot be run by an atomic function
+callback that was called by another sweep for the same player.
+
+Threads
+*******
+The reverse sweep can be passed a separate one of these objects.
+In this case the player's object is not used and
+different threads can run reverse sweeps for the same player
+at the same time; see :ref:`subgraph_jac_thread-name` .
+
+reserve
+*******
+This ensures that all the vectors have enough capacity for an
+atomic function call with *n* arguments, *m* results, and
+*n_coef* coefficients for each argument and result.
+The player uses the maximum number of arguments and results
+for the atomic functions in its operation sequence for *n* and *m* .
+
+Vectors
+*******
+
+.. csv-table::
+   :widths: auto
+   :header-rows: 1
+
+   name,         type,                     size
+   par_x,        ``vector`` < *Base* >,         *n*
+   type_x,       ``vector<ad_type_enum>``,      *n*
+   ix,           ``vector<size_t>``,            *n*
+   sx,           ``vector<bool>``,              *n*
+   ident_zero_x, ``vector<bool>``,              *n*
+   x_index,      ``pod_vector<size_t>``,        *n*
+   iy,           ``vector<size_t>``,            *m*
+   sy,           ``vector<bool>``,              *m*
+   y_index,      ``pod_vector<size_t>``,        *m*
+   tx,           ``vector`` < *Base* >,         *n* * *n_coef*
+   px,           ``vector`` < *Base* >,         *n* * *n_coef*
+   tx_all,       ``vector`` < *Base* >,         *n* * *n_coef*
+   ty,           ``vector`` < *Base* >,         *m* * *n_coef*
+   py,           ``vector`` < *Base* >,         *m* * *n_coef*
+   ty_all,       ``vector`` < *Base* >,         *m* * *n_coef*
+
+The ``x_index`` and ``y_index`` vectors are used by the sparsity sweeps.
+The ``tx_all`` and ``ty_all`` vectors are used by the forward
+sweep with multiple directions.
+
+{xrst_end atom_work}
+*/
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+template <class Base>
+class atom_work {
+private:
+   // reserve_one
+   // resizing to zero first avoids copying the old elements
+   template <class Vector>
+   static void reserve_one(Vector& vec, size_t size)
+   {  vec.resize(0);
+      vec.resize(size);
+   }
+public:
+   // vectors with size equal to the number of arguments
+   vector<Base>         par_x;
+   vector<ad_type_enum> type_x;
+   vector<size_t>       ix;
+   vector<bool>         sx;
+   vector<bool>         ident_zero_x;
+   pod_vector<size_t>   x_index;
+   //
+   // vectors with size equal to the number of results
+   vector<size_t>       iy;
+   vector<bool>         sy;
+   pod_vector<size_t>   y_index;
+   //
+   // vectors of Taylor coefficients and partials
+   vector<Base>         tx;
+   vector<Base>         px;
+   vector<Base>         tx_all;
+   vector<Base>         ty;
+   vector<Base>         py;
+   vector<Base>         ty_all;
+   //
+   // reserve
+   void reserve(size_t n, size_t m, size_t n_coef)
+   {  reserve_one(par_x,        n);
+      reserve_one(type_x,       n);
+      reserve_one(ix,           n);
+      reserve_one(sx,           n);
+      reserve_one(ident_zero_x, n);
+      reserve_one(x_index,      n);
+      //
+      reserve_one(iy,      m);
+      reserve_one(sy,      m);
+      reserve_one(y_index, m);
+      //
+      reserve_one(tx,     n * n_coef);
+      reserve_one(px,     n * n_coef);
+      reserve_one(tx_all, n * n_coef);
+      reserve_one(ty,     m * n_coef);
+      reserve_one(py,     m * n_coef);
+      reserve_one(ty_all, m * n_coef);
+   }
+   //
+   // swap
+   void swap(atom_work& other)
+   {  par_x.swap(other.par_x);
+      type_x.swap(other.type_x);
+      ix.swap(other.ix);
+      sx.swap(other.sx);
+      ident_zero_x.swap(other.ident_zero_x);
+      x_index.swap(other.x_index);
+      //
+      iy.swap(other.iy);
+      sy.swap(other.sy);
+      y_index.swap(other.y_index);
+      //
+      tx.swap(other.tx);
+      px.swap(other.px);
+      tx_all.swap(other.tx_all);
+      ty.swap(other.ty);
+      py.swap(other.py);
+      ty_all.swap(other.ty_all);
+   }
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
@@ -0,0 +1,327 @@
+# ifndef CPPAD_LOCAL_PLAY_OP_PROFILE_HPP
+# define CPPAD_LOCAL_PLAY_OP_PROFILE_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <map>
+# include <chrono>
+# include <cstdint>
+# include <cppad/utility/vector.hpp>
+# include <cppad/local/op_code_var.hpp>
+# include <cppad/local/op_code_dyn.hpp>
+
+# if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define CPPAD_OP_PROFILE_RDTSC 1
+# elif defined(_M_X64) || defined(_M_IX86)
+# include <intrin.h>
+# define CPPAD_OP_PROFILE_RDTSC 1
+# else
+# define CPPAD_OP_PROFILE_RDTSC 0
+# endif
+
+// CPPAD_OP_PROFILE_NOINLINE
+// If next_op is inlined, the sweeps are about ten percent slower
+// even when profiling is off.
+# if defined(_MSC_VER)
+# define CPPAD_OP_PROFILE_NOINLINE __declspec(noinline)
+# elif defined(__GNUC__)
+# define CPPAD_OP_PROFILE_NOINLINE __attribute__((noinline))
+# else
+# define CPPAD_OP_PROFILE_NOINLINE
+# endif
+
+/*
+{xrst_begin op_profile_dev dev}
+{xrst_spell
+   rdtsc
+}
+
+Per Operator Profile of the Sweeps
+##################################
+
+Syntax
+******
+| ``play::op_profile`` *profile*
+| *profile* . ``on`` ( *flag* )
+| *flag* = *profile* . ``on`` ()
+| *profile* . ``clear`` ()
+| *start* = ``play::op_profile::cycle`` ()
+| *profile* . ``start_sweep`` ( *sweep* , *bytes_per_var* )
+| *profile* . ``next_op`` ( *op* , *atom_done* , *atom_index* )
+| *profile* . ``end_sweep`` ( *atom_done* , *atom_index* )
+| *profile* . ``record`` ( *op* , *start* )
+| *profile* . ``record_atomic`` ( *atom_index* , *start* )
+
+Purpose
+*******
+Each ``player`` object contains a profile object.
+If profiling is on, the sweeps record the number of times each
+operator is executed, the cycles it takes, and an estimate of the
+bytes it touches; see :ref:`op_profile-name` .
+
+sweep_enum
+**********
+This enum type identifies the sweeps:
+``forward0_sweep`` , ``forward1_sweep`` , ``forward2_sweep`` ,
+``reverse_sweep`` , ``for_jac_sweep`` , ``rev_jac_sweep`` ,
+``for_hes_sweep`` , ``rev_hes_sweep`` , ``dynamic_sweep`` .
+The value ``number_sweep`` is the number of sweeps.
+
+cycle
+*****
+returns the current value of the time stamp counter (rdtsc)
+if it is available, otherwise the number of nanoseconds
+according to ``std::chrono::steady_clock`` .
+
+start_sweep
+***********
+Sets the sweep that is currently being recorded and the number of bytes
+that are touched for each argument and result of an operator.
+
+next_op
+*******
+This is called by the variable sweeps before each operator is executed.
+It records the previous operator in this sweep (if there is one)
+and then starts the timer for *op* .
+If *atom_done* is true, the previous operator completed
+the call to the atomic function with index *atom_index*
+and the call is also recorded.
+Only one test of the profile pointer is required for each operator,
+and ``next_op`` is not inlined, so the cost is small when profiling is off.
+
+end_sweep
+*********
+This is called by the variable sweeps after the last operator
+and records the last operator in the same way as ``next_op`` .
+
+record
+******
+This is used by the dynamic parameter sweep after each operator
+is executed.
+Adds one to the count for *op* in the current sweep,
+adds ``cycle`` () - *start* to its cycles, and adds
+*bytes_per_var* times the number of arguments plus results for *op*
+to its bytes.
+In the ``dynamic_sweep`` case, *op* is an ``op_code_dyn`` value,
+otherwise it is an ``OpCode`` value.
+
+record_atomic
+*************
+Adds one to the count and ``cycle`` () - *start* to the cycles
+for the atomic function with index *atom_index* in the current sweep.
+
+{xrst_end op_profile_dev}
+*/
+
+// BEGIN_CPPAD_LOCAL_PLAY_NAMESPACE
+namespace CppAD { namespace local { namespace play {
+
+// sweep_enum
+enum sweep_enum {
+   forward0_sweep ,
+   forward1_sweep ,
+   forward2_sweep ,
+   reverse_sweep  ,
+   for_jac_sweep  ,
+   rev_jac_sweep  ,
+   for_hes_sweep  ,
+   rev_hes_sweep  ,
+   dynamic_sweep  ,
+   number_sweep
+};
+
+// sweep_name
+inline const char* sweep_name(size_t sweep)
+{  static const char* name[] = {
+      "forward0" ,
+      "forward1" ,
+      "forward2" ,
+      "reverse"  ,
+      "for_jac"  ,
+      "rev_jac"  ,
+      "for_hes"  ,
+      "rev_hes"  ,
+      "dynamic"
+   };
+   CPPAD_ASSERT_UNKNOWN(
+      size_t(number_sweep) == sizeof(name) / sizeof(name[0])
+   );
+   CPPAD_ASSERT_UNKNOWN( sweep < size_t(number_sweep) );
+   return name[sweep];
+}
+
+class op_profile {
+public:
+   // op_record
+   struct op_record {
+      size_t        count;
+      std::uint64_t cycle;
+      std::uint64_t byte;
+   };
+private:
+   //
+   // n_op_
+   // maximum number of operators in one sweep
+   static size_t n_op_(void)
+   {  if( size_t(NumberOp) < size_t(number_dyn) )
+         return size_t(number_dyn);
+      return size_t(NumberOp);
+   }
+   //
+   // on_
+   bool on_;
+   //
+   // sweep_, bytes_per_var_
+   size_t sweep_;
+   size_t bytes_per_var_;
+   //
+   // prev_op_, prev_start_
+   // previous operator in a variable sweep and the cycle when it started
+   // (prev_op_ is NumberOp when there is no previous operator)
+   size_t        prev_op_;
+   std::uint64_t prev_start_;
+   //
+   // record_prev
+   void record_prev(bool atom_done, size_t atom_index)
+   {  if( prev_op_ == size_t(NumberOp) )
+         return;
+      record(prev_op_, prev_start_);
+      if( atom_done && prev_op_ == size_t(AFunOp) )
+         record_atomic(atom_index, prev_start_);
+   }
+   //
+   // op_vec_
+   // op_vec_[ sweep * n_op_() + op ] is the record for op in sweep
+   CppAD::vector<op_record> op_vec_;
+   //
+   // atom_map_
+   // atom_map_[ (sweep, atom_index) ] is the record for the atomic function
+   std::map< std::pair<size_t, size_t>, op_record > atom_map_;
+public:
+   // ctor
+   op_profile(void)
+   : on_(false), sweep_(0), bytes_per_var_(0),
+     prev_op_( size_t(NumberOp) ), prev_start_(0)
+   { }
+   //
+   // cycle
+   static std::uint64_t cycle(void)
+   {
+# if CPPAD_OP_PROFILE_RDTSC
+      return std::uint64_t( __rdtsc() );
+# else
+      return std::uint64_t( std::chrono::duration_cast<
+         std::chrono::nanoseconds
+      >( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+# endif
+   }
+   //
+   // on
+   bool on(void) const
+   {  return on_; }
+   void on(bool flag)
+   {  on_ = flag;
+      if( on_ && op_vec_.size() == 0 )
+         clear();
+   }
+   //
+   // clear
+   void clear(void)
+   {  op_record zero = {0, 0, 0};
+      op_vec_.resize( size_t(number_sweep) * n_op_() );
+      for(size_t i = 0; i < op_vec_.size(); ++i)
+         op_vec_[i] = zero;
+      atom_map_.clear();
+   }
+   //
+   // start_sweep
+   void start_sweep(sweep_enum sweep, size_t bytes_per_var)
+   {  CPPAD_ASSERT_UNKNOWN( on_ );
+      sweep_         = size_t(sweep);
+      bytes_per_var_ = bytes_per_var;
+      prev_op_       = size_t(NumberOp);
+   }
+   //
+   // next_op
+   CPPAD_OP_PROFILE_NOINLINE
+   void next_op(size_t op, bool atom_done, size_t atom_index)
+   {  CPPAD_ASSERT_UNKNOWN( on_ );
+      CPPAD_ASSERT_UNKNOWN( sweep_ != size_t(dynamic_sweep) );
+      record_prev(atom_done, atom_index);
+      prev_op_    = op;
+      prev_start_ = cycle();
+   }
+   //
+   // end_sweep
+   CPPAD_OP_PROFILE_NOINLINE
+   void end_sweep(bool atom_done, size_t atom_index)
+   {  CPPAD_ASSERT_UNKNOWN( on_ );
+      record_prev(atom_done, atom_index);
+      prev_op_ = size_t(NumberOp);
+   }
+   //
+   // record
+   void record(size_t op, std::uint64_t start)
+   {  CPPAD_ASSERT_UNKNOWN( on_ );
+      size_t n_var;
+      if( sweep_ == size_t(dynamic_sweep) )
+      {  CPPAD_ASSERT_UNKNOWN( op < size_t(number_dyn) );
+         n_var = num_arg_dyn( op_code_dyn(op) ) + 1;
+      }
+      else
+      {  CPPAD_ASSERT_UNKNOWN( op < size_t(NumberOp) );
+         n_var = NumArg( OpCode(op) ) + NumRes( OpCode(op) );
+      }
+      op_record& rec = op_vec_[ sweep_ * n_op_() + op ];
+      rec.count += 1;
+      rec.cycle += cycle() - start;
+      rec.byte  += std::uint64_t( n_var * bytes_per_var_ );
+   }
+   //
+   // record_atomic
+   void record_atomic(size_t atom_index, std::uint64_t start)
+   {  CPPAD_ASSERT_UNKNOWN( on_ );
+      std::pair<size_t, size_t> key(sweep_, atom_index);
+      if( atom_map_.find(key) == atom_map_.end() )
+      {  op_record zero = {0, 0, 0};
+         atom_map_[key] = zero;
+      }
+      op_record& rec = atom_map_[key];
+      rec.count += 1;
+      rec.cycle += cycle() - start;
+   }
+   //
+   // has_data
+   // true if clear has been called at least once
+   bool has_data(void) const
+   {  return op_vec_.size() > 0; }
+   //
+   // op_data
+   // record for op in sweep
+   const op_record& op_data(size_t sweep, size_t op) const
+   {  CPPAD_ASSERT_UNKNOWN( op_vec_.size() > 0 );
+      return op_vec_[ sweep * n_op_() + op ];
+   }
+   //
+   // atom_data
+   const std::map< std::pair<size_t, size_t>, op_record >& atom_data(void)
+   const
+   {  return atom_map_; }
+   //
+   // swap
+   void swap(op_profile& other)
+   {  std::swap(on_,            other.on_);
+      std::swap(sweep_,         other.sweep_);
+      std::swap(bytes_per_var_, other.bytes_per_var_);
+      std::swap(prev_op_,       other.prev_op_);
+      std::swap(prev_start_,    other.prev_start_);
+      op_vec_.swap( other.op_vec_ );
+      atom_map_.swap( other.atom_map_ );
+   }
+};
+
+} } } // END_CPPAD_LOCAL_PLAY_NAMESPACE
+
+# endif
@@ -2,13 +2,15 @@
 # define CPPAD_LOCAL_PLAY_PLAYER_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/addr_enum.hpp>
 # include <cppad/local/play/sequential_iterator.hpp>
 # include <cppad/local/play/subgraph_iterator.hpp>
 # include <cppad/local/play/random_setup.hpp>
+# include <cppad/local/play/op_profile.hpp>
+# include <cppad/local/play/atom_work.hpp>
 # include <cppad/local/atom_state.hpp>
 # include <cppad/local/is_pod.hpp>
 
@@ -99,6 +101,20 @@ private:
    /// This value is valid (invalid) for primary (auxillary) variables.
    pod_vector<unsigned char> var2op_vec_;
 
+   // ----------------------------------------------------------------------
+   /// Operator profile for the sweeps that use this player
+   /// (mutable because the sweeps use a const player).
+   mutable play::op_profile profile_;
+
+   /// Maximum number of arguments and results for the atomic function calls
+   /// in the recording (used to size atom_work_).
+   size_t atom_max_n_;
+   size_t atom_max_m_;
+
+   /// Work space used by the sweeps to call atomic functions
+   /// (mutable because the sweeps use a const player).
+   mutable play::atom_work<Base> atom_work_;
+
 public:
    // =================================================================
    /// default constructor
@@ -108,7 +124,9 @@ public:
    num_dynamic_ind_(0)  ,
    num_var_rec_(0)      ,
    num_var_load_rec_(0)  ,
-   num_var_vecad_rec_(0)
+   num_var_vecad_rec_(0) ,
+   atom_max_n_(0)        ,
+   atom_max_m_(0)
    { }
    // move semantics constructor
    // (none of the default constructor values matter to the destructor)
@@ -224,6 +242,25 @@ public:
       // random access information
       clear_random();
 
+      // atom_max_n_, atom_max_m_
+      // The first and second AFunOp for each call have the same arguments.
+      atom_max_n_ = 0;
+      atom_max_m_ = 0;
+      {  play::const_sequential_iterator itr = begin();
+         OpCode        op;
+         const addr_t* arg;
+         size_t        var_index;
+         itr.op_info(op, arg, var_index);
+         CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+         while( op != EndOp )
+         {  (++itr).op_info(op, arg, var_index);
+            if( op == AFunOp )
+            {  atom_max_n_ = std::max(atom_max_n_, size_t( arg[2] ) );
+               atom_max_m_ = std::max(atom_max_m_, size_t( arg[3] ) );
+            }
+         }
+      }
+
       // some checks
       check_inv_op(n_ind);
       check_variable_dag();
@@ -496,6 +533,8 @@ public:
       num_var_rec_        = play.num_var_rec_;
       num_var_load_rec_   = play.num_var_load_rec_;
       num_var_vecad_rec_  = play.num_var_vecad_rec_;
+      atom_max_n_         = play.atom_max_n_;
+      atom_max_m_         = play.atom_max_m_;
       //
       // pod_vectors
       op_vec_             = play.op_vec_;
@@ -523,6 +562,8 @@ public:
       play.num_var_rec_        = num_var_rec_;
       play.num_var_load_rec_   = num_var_load_rec_;
       play.num_var_vecad_rec_  = num_var_vecad_rec_;
+      play.atom_max_n_         = atom_max_n_;
+      play.atom_max_m_         = atom_max_m_;
       //
       // pod_vectors
       play.op_vec_             = op_vec_;
@@ -553,6 +594,8 @@ public:
       std::swap(num_var_rec_,        other.num_var_rec_);
       std::swap(num_var_load_rec_,   other.num_var_load_rec_);
       std::swap(num_var_vecad_rec_,  other.num_var_vecad_rec_);
+      std::swap(atom_max_n_,         other.atom_max_n_);
+      std::swap(atom_max_m_,         other.atom_max_m_);
       //
       // pod_vectors
       op_vec_.swap(             other.op_vec_);
@@ -569,6 +612,12 @@ public:
       //
       // pod_maybe_vectors
       all_par_vec_.swap(    other.all_par_vec_);
+      //
+      // profile_
+      profile_.swap( other.profile_ );
+      //
+      // atom_work_
+      atom_work_.swap( other.atom_work_ );
    }
    // move semantics assignment
    void operator=(player&& play)
@@ -688,6 +737,33 @@ public:
    size_t num_dynamic_ind(void) const
    {  return num_dynamic_ind_; }
 
+   /// Are there any atomic function calls in the recording
+   bool has_atom_call(void) const
+   {  return atom_max_n_ + atom_max_m_ > 0; }
+
+   /// Fetch pointer to the operator profile (null when profiling is off)
+   play::op_profile* op_profile_ptr(void) const
+   {  if( profile_.on() )
+         return &profile_;
+      return nullptr;
+   }
+
+   /// Fetch the operator profile
+   play::op_profile& op_profile_obj(void) const
+   {  return profile_; }
+
+   /// Fetch the atomic function work space with enough capacity for
+   /// n_coef coefficients per argument and result.
+   /// If work is not null, it is used in place of the player's work space.
+   play::atom_work<Base>& atom_work_obj(
+      size_t n_coef, play::atom_work<Base>* work = nullptr
+   ) const
+   {  if( work == nullptr )
+         work = &atom_work_;
+      work->reserve(atom_max_n_, atom_max_m_, n_coef);
+      return *work;
+   }
+
    /// Fetch number of dynamic parameters in the recording
    size_t num_dynamic_par(void) const
    {  return dyn_par_op_.size(); }
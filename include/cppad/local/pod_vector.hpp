@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_POD_VECTOR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # if CPPAD_CSTDINT_HAS_8_TO_64
@@ -182,8 +182,8 @@ public:
    i.e., their constructor is not called. Otherwise, the constructor
    is called for each new element.
 
-   - This and resize are the only routine that allocate memory for
-   pod_vector. They uses thread_alloc for this allocation.
+   - This, reserve, and resize are the only routines that allocate memory
+   for pod_vector. They use thread_alloc for this allocation.
    */
    size_t extend(size_t n)
    {  size_t old_length   = byte_length_;
@@ -215,6 +215,39 @@ public:
    }
    // ----------------------------------------------------------------------
    /*!
+   Increase the capacity of this vector (existing elements are preserved).
+
+   \param n
+   is the number of elements that the vector can hold without
+   allocating more memory. If n <= capacity(), this operation has no effect.
+
+   - The length of the vector is not changed. Calls to extend that do not
+   increase the length above n will not allocate memory.
+   */
+   void reserve(size_t n)
+   {  size_t byte_reserve = n * sizeof(Type);
+      if( byte_reserve <= byte_capacity_ )
+         return;
+
+      // save old information
+      size_t old_capacity = byte_capacity_;
+      void* old_v_ptr     = reinterpret_cast<void*>(data_);
+
+      // get new memory and set capacity
+      void* v_ptr = thread_alloc::get_memory(byte_reserve, byte_capacity_);
+      data_       = reinterpret_cast<Type*>(v_ptr);
+
+      // copy old data to new
+      if( byte_length_ >  0 )
+         std::memcpy(v_ptr, old_v_ptr, byte_length_);
+
+      // return old memory to available pool
+      if( old_capacity > 0 )
+         thread_alloc::return_memory(old_v_ptr);
+      CPPAD_ASSERT_UNKNOWN( byte_reserve <= byte_capacity_ );
+   }
+   // ----------------------------------------------------------------------
+   /*!
    resize the vector (existing elements preserved when n <= capacity() ).
 
    \param n
@@ -230,8 +263,8 @@ public:
    i.e., their constructor is not called. Otherwise, the constructor
    is called for each new element.
 
-   - This and extend are the only routine that allocate memory for
-   pod_vector. They uses thread_alloc for this allocation.
+   - This, reserve, and extend are the only routines that allocate memory
+   for pod_vector. They use thread_alloc for this allocation.
    */
    void resize(size_t n)
    {  byte_length_ = n * sizeof(Type);
@@ -57,9 +57,17 @@ private:
    /// Character strings ('\\0' terminated) in the recording.
    pod_vector<char> text_vec_;
 
-   /// Hash table to reduced number of duplicate parameters in all_par_vec_
+   /// Hash table used to avoid duplicate constant parameters in
+   /// all_par_vec_. For each hash code, it is the index of the most recent
+   /// constant parameter with that code (zero if there is no such parameter).
    pod_vector<addr_t> par_hash_table_;
 
+   /// For each constant parameter index in all_par_vec_, index of the
+   /// previous constant parameter with the same hash code
+   /// (zero if there is no such parameter). The values for dynamic
+   /// parameter indices are not used.
+   pod_vector<addr_t> par_hash_next_;
+
    /// Vector containing all the parameters in the recording.
    /// Use pod_vector_maybe because Base may not be plain old data.
    pod_vector_maybe<Base> all_par_vec_;
@@ -84,8 +92,7 @@ public:
    par_hash_table_( CPPAD_HASH_TABLE_SIZE )
    {  record_compare_ = true;
       abort_op_index_ = 0;
-      // It does not matter if unitialized hash codes match but this
-      // initilaization is here to avoid valgrind warnings.
+      // zero is the end of the list of constants for each hash code
       void*  ptr   = static_cast<void*>( par_hash_table_.data() );
       int    value = 0;
       size_t num   = CPPAD_HASH_TABLE_SIZE * sizeof(addr_t);
@@ -104,6 +111,12 @@ public:
    void set_num_dynamic_ind(size_t num_dynamic_ind)
    {  num_dynamic_ind_ = num_dynamic_ind; }
 
+   /// Reserve memory for the operators and arguments in the recording
+   void reserve(size_t n_op, size_t n_arg)
+   {  op_vec_.reserve(n_op);
+      arg_vec_.reserve(n_arg);
+   }
+
    /// Get record_compare option
    bool get_record_compare(void) const
    {  return record_compare_; }
@@ -549,23 +562,26 @@ addr_t recorder<Base>::put_con_par(const Base &par)
    // get hash code for this value
    size_t code  = static_cast<size_t>( hash_code(par) );
 
-   // current index in all_par_vec_ corresponding to this hash code
+   // check the constant parameters that have this hash code
+   // (most recent first)
    size_t index = static_cast<size_t>( par_hash_table_[code] );
-
-   // check if the old parameter matches the new one
-   if( (0 < index) && (index < all_par_vec_.size()) )
-   {  if( ! dyn_par_is_[index] )
-         if( IdenticalEqualCon(all_par_vec_[index], par) )
-            return static_cast<addr_t>( index );
+   while( index != 0 )
+   {  CPPAD_ASSERT_UNKNOWN( ! dyn_par_is_[index] );
+      if( IdenticalEqualCon(all_par_vec_[index], par) )
+         return static_cast<addr_t>( index );
+      index = static_cast<size_t>( par_hash_next_[index] );
    }
    // ---------------------------------------------------------------------
-   // put paramerter in all_par_vec_ and replace hash entry for this codee
+   // put paramerter in all_par_vec_ and at front of list for this code
    //
    index = all_par_vec_.size();
    all_par_vec_.push_back( par );
    dyn_par_is_.push_back(false);
    //
-   // change the hash table for this code to point to new value
+   // par_hash_next_ has an element for each parameter (dynamic parameters
+   // were added since the last constant parameter)
+   par_hash_next_.extend( index + 1 - par_hash_next_.size() );
+   par_hash_next_[index] = par_hash_table_[code];
    par_hash_table_[code] = static_cast<addr_t>( index );
    //
    // return the parameter index
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SUBGRAPH_GET_REV_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/pod_vector.hpp>
@@ -50,7 +50,8 @@ if i_op != j_op then subgraph[i_op] != subgraph[j_op].
 This vector must be set.
 
 \par in_subgraph_
-has size equal to the number of operators in play.
+If this vector has size zero on input, it is computed using init_in_subgraph.
+Otherwise it has size equal to the number of operators in play.
 If in_subgraph[i_op] <= n_dep_,
 the result for this operator depends on the selected independent variables.
 In addition, upon input, there is no i_op such that in_subgraph[i_op] == i_dep.
@@ -83,6 +84,11 @@ void subgraph_info::get_rev(
 {  // check sizes
    CPPAD_ASSERT_UNKNOWN( map_user_op_.size()   == n_op_ );
 
+   // in_subgraph_
+   // (init_rev does not compute it when the cache may make it unnecessary)
+   if( in_subgraph_.size() == 0 )
+      init_in_subgraph(random_itr);
+
    // process_range_
    CPPAD_ASSERT_UNKNOWN( process_range_[i_dep] == false );
    process_range_[i_dep] = true;
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SUBGRAPH_INFO_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/random_iterator.hpp>
@@ -48,7 +48,7 @@ private:
    // -----------------------------------------------------------------------
 
    /// flags which operatiors are in subgraph
-   /// (size zero or n_op_).
+   /// (size zero or n_op_; see init_in_subgraph).
    pod_vector<addr_t> in_subgraph_;
 
    /// flags which dependent variables are selected
@@ -58,6 +58,33 @@ private:
    /// the previous init_rev
    pod_vector<bool> process_range_;
 
+   // -----------------------------------------------------------------------
+   // private member data for the subgraph cache
+   // -----------------------------------------------------------------------
+
+   /// should the subgraph for each dependent variable be cached
+   bool use_cache_;
+
+   /// select_domain that the cached subgraphs correspond to
+   /// (size zero or n_ind_).
+   pod_vector<bool> cache_domain_;
+
+   /// The cached subgraph for dependent variable i_dep is
+   /// cache_op_[k] for k = cache_begin_[i_dep], ... , cache_end_[i_dep]-1.
+   /// If cache_end_[i_dep] is zero, this subgraph has not been cached.
+   /// The subgraphs are stored in cache_op_ in the order they are computed.
+   /// (cache_begin_ and cache_end_ have size zero or n_dep_).
+   pod_vector<size_t> cache_begin_;
+   pod_vector<size_t> cache_end_;
+
+   /// operator indices for all the cached subgraphs
+   pod_vector<addr_t> cache_op_;
+
+   // -----------------------------------------------------------------------
+   // see init_rev.hpp
+   template <class Addr>
+   void init_in_subgraph(const play::const_random_iterator<Addr>& random_itr);
+
 public:
    // -----------------------------------------------------------------------
    // const public functions
@@ -90,21 +117,66 @@ public:
    const pod_vector<bool>& process_range(void) const
    {  return process_range_; }
 
+   /// should the subgraph for each dependent variable be cached
+   bool use_cache(void) const
+   {  return use_cache_; }
+
    /// amount of memory corresonding to this object
    size_t memory(void) const
    {  size_t sum = map_user_op_.size()   * sizeof(addr_t);
       sum       += in_subgraph_.size()   * sizeof(addr_t);
       sum       += select_domain_.size() * sizeof(bool);
       sum       += process_range_.size() * sizeof(bool);
+      sum       += cache_domain_.size()  * sizeof(bool);
+      sum       += cache_begin_.size()   * sizeof(size_t);
+      sum       += cache_end_.size()     * sizeof(size_t);
+      sum       += cache_op_.size()      * sizeof(addr_t);
       return sum;
    }
 
    /// free memory used for calculating subgraph
+   /// (the use_cache setting is not changed)
    void clear(void)
    {  map_user_op_.clear();
       in_subgraph_.clear();
       select_domain_.clear();
       process_range_.clear();
+      clear_cache();
+   }
+
+   /// free memory used for the cached subgraphs
+   void clear_cache(void)
+   {  cache_domain_.clear();
+      cache_begin_.clear();
+      cache_end_.clear();
+      cache_op_.clear();
+   }
+   // -----------------------------------------------------------------------
+   /*!
+   get a cached subgraph
+
+   \param i_dep
+   is the dependent variable index for this subgraph.
+
+   \param subgraph
+   If the return value is true, upon return it is the cached subgraph
+   for this dependent variable. Otherwise it is not modified.
+
+   \return
+   is true if the subgraph for this dependent variable is cached.
+   */
+   bool get_cache(addr_t i_dep, pod_vector<addr_t>& subgraph) const
+   {  if( cache_end_.size() == 0 )
+         return false;
+      CPPAD_ASSERT_UNKNOWN( size_t(i_dep) < n_dep_ );
+      size_t begin = cache_begin_[i_dep];
+      size_t end   = cache_end_[i_dep];
+      if( end == 0 )
+         return false;
+      subgraph.resize(end - begin);
+      for(size_t k = begin; k < end; ++k)
+         subgraph[k - begin] = cache_op_[k];
+      return true;
    }
    // -----------------------------------------------------------------------
    /*!
@@ -153,7 +225,7 @@ public:
 
    /// default constructor (all sizes are zero)
    subgraph_info(void)
-   : n_ind_(0), n_dep_(0), n_op_(0), n_var_(0)
+   : n_ind_(0), n_dep_(0), n_op_(0), n_var_(0), use_cache_(false)
    {  CPPAD_ASSERT_UNKNOWN( map_user_op_.size()   == 0 );
       CPPAD_ASSERT_UNKNOWN( in_subgraph_.size()   == 0 );
    }
@@ -168,6 +240,28 @@ public:
       in_subgraph_      = info.in_subgraph_;
       select_domain_    = info.select_domain_;
       process_range_    = info.process_range_;
+      use_cache_        = info.use_cache_;
+      cache_domain_     = info.cache_domain_;
+      cache_begin_      = info.cache_begin_;
+      cache_end_        = info.cache_end_;
+      cache_op_         = info.cache_op_;
+      return;
+   }
+   // -----------------------------------------------------------------------
+   /// assignment operator that does not copy the cache
+   /// (the cache in info can be used directly because it is not modified
+   /// when this object is used).
+   void assign_no_cache(const subgraph_info& info)
+   {  n_ind_            = info.n_ind_;
+      n_dep_            = info.n_dep_;
+      n_op_             = info.n_op_;
+      n_var_            = info.n_var_;
+      map_user_op_      = info.map_user_op_;
+      in_subgraph_      = info.in_subgraph_;
+      select_domain_    = info.select_domain_;
+      process_range_    = info.process_range_;
+      use_cache_        = false;
+      clear_cache();
       return;
    }
    // -----------------------------------------------------------------------
@@ -180,11 +274,18 @@ public:
       std::swap(n_op_  , info.n_op_);
       std::swap(n_var_ , info.n_var_);
       //
+      // bool objects
+      std::swap(use_cache_ , info.use_cache_);
+      //
       // pod_vectors
       map_user_op_.swap(   info.map_user_op_);
       in_subgraph_.swap(   info.in_subgraph_);
       select_domain_.swap( info.select_domain_);
       process_range_.swap( info.process_range_);
+      cache_domain_.swap(  info.cache_domain_);
+      cache_begin_.swap(   info.cache_begin_);
+      cache_end_.swap(     info.cache_end_);
+      cache_op_.swap(      info.cache_op_);
       //
       return;
    }
@@ -209,6 +310,9 @@ public:
 
    \par in_subgraph_
    is resized to zero.
+
+   \par cache
+   The cached subgraphs are freed (the use_cache setting is not changed).
    */
    void resize(size_t n_ind, size_t n_dep, size_t n_op, size_t n_var)
    {  CPPAD_ASSERT_UNKNOWN(
@@ -230,10 +334,67 @@ public:
       // in_subgraph_
       in_subgraph_.resize(0);
       //
+      // cache
+      clear_cache();
+      //
       return;
    }
    // -----------------------------------------------------------------------
    /*!
+   set the use_cache setting
+
+   \param use_cache
+   if true, the subgraph for each dependent variable is cached the first
+   time it is computed (for a select_domain).
+   If false, the cached subgraphs are freed.
+   */
+   void set_use_cache(bool use_cache)
+   {  use_cache_ = use_cache;
+      if( ! use_cache )
+         clear_cache();
+   }
+   // -----------------------------------------------------------------------
+   /*!
+   put a subgraph in the cache (if use_cache is true)
+
+   \param i_dep
+   is the dependent variable index for this subgraph.
+   Its subgraph must not already be in the cache.
+
+   \param subgraph
+   is the subgraph for this dependent variable and the select_domain
+   in the previous call to init_rev.
+   */
+   void put_cache(addr_t i_dep, const pod_vector<addr_t>& subgraph)
+   {  if( ! use_cache_ )
+         return;
+      CPPAD_ASSERT_UNKNOWN( size_t(i_dep) < n_dep_ );
+      CPPAD_ASSERT_UNKNOWN( cache_end_.size() == n_dep_ );
+      CPPAD_ASSERT_UNKNOWN( cache_end_[i_dep] == 0 );
+      CPPAD_ASSERT_UNKNOWN( subgraph.size() > 0 );
+      size_t begin = cache_op_.size();
+      cache_op_.extend( subgraph.size() );
+      for(size_t k = 0; k < subgraph.size(); ++k)
+         cache_op_[begin + k] = subgraph[k];
+      cache_begin_[i_dep] = begin;
+      cache_end_[i_dep]   = begin + subgraph.size();
+   }
+   // -----------------------------------------------------------------------
+   /*!
+   mark a dependent variable as processed
+   (used when its subgraph is obtained from the cache instead of get_rev).
+
+   \param i_dep
+   is the dependent variable index.
+   The value process_range_[i_dep] is checked to make sure it is false.
+   It is then set to have value true.
+   */
+   void set_process_range(addr_t i_dep)
+   {  CPPAD_ASSERT_UNKNOWN( process_range_[i_dep] == false );
+      process_range_[i_dep] = true;
+   }
+   // -----------------------------------------------------------------------
+   /*!
    set the value of map_user_op for this operation sequence
 
    \param play
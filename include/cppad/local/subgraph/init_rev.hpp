@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SUBGRAPH_INIT_REV_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/subgraph/info.hpp>
@@ -30,21 +30,14 @@ is a vector with, size equal to the number of independent variables
 in the recording. It determines the selected independent variables.
 
 \par in_subgraph_
-We use depend_yes (depend_no) for the value n_dep_ (n_dep_ + 1).
-The important properties are that depend_yes < depend_no and
-for a valid indpendent variable index i_ind < depend_yes.
-The input size and elements of in_subgraph_ do not matter.
-If in_subgraph_[i_op] == depend_yes (depend_no),
-the result for this operator depends (does not depend)
-on the selected independent variables.
-Note that for atomic function call operators i_op,
-in_subgraph[i_op] is depend_no except for the first AFunOp in the
-atomic function call sequence. For the first AFunOp,
-it is depend_yes (depend_no) if any of the results for the call sequence
-depend (do not depend) on the selected independent variables.
-Except for UserOP, only operators with NumRes(op) > 0 have in_subgraph_
-value depend_yes;
-e.g., comparison operators have in_subgraph_ value depend_no.
+If use_cache_ is true and select_domain is equal to cache_domain_,
+the size of in_subgraph_ is set to zero
+(it is computed by get_rev if it is needed).
+Otherwise it is computed using init_in_subgraph.
+
+\par cache
+If use_cache_ is true and select_domain is not equal to cache_domain_,
+the cache is cleared and cache_domain_ is set equal to select_domain.
 
 \par select_domain_
 This vector is is set equal to the select_domain argument.
@@ -62,10 +55,6 @@ void subgraph_info::init_rev(
    CPPAD_ASSERT_UNKNOWN( random_itr.num_op()   == n_op_ );
    CPPAD_ASSERT_UNKNOWN( size_t( select_domain.size() ) == n_ind_ );
 
-   // depend_yes and depend_no
-   addr_t depend_yes = addr_t( n_dep_ );
-   addr_t depend_no  = addr_t( n_dep_ + 1 );
-
    // select_domain_
    select_domain_.resize(n_ind_);
    for(size_t j = 0; j < n_ind_; ++j)
@@ -76,6 +65,73 @@ void subgraph_info::init_rev(
    for(size_t i = 0; i < n_dep_; ++i)
       process_range_[i] = false;
 
+   // cache
+   if( use_cache_ )
+   {  bool same = cache_domain_.size() == n_ind_;
+      for(size_t j = 0; j < n_ind_ && same; ++j)
+         same = cache_domain_[j] == select_domain_[j];
+      if( same )
+      {  // in_subgraph_ is only needed for subgraphs that are not cached
+         in_subgraph_.resize(0);
+         return;
+      }
+      // start a new cache for this select_domain
+      cache_domain_ = select_domain_;
+      cache_begin_.resize(n_dep_);
+      cache_end_.resize(n_dep_);
+      for(size_t i = 0; i < n_dep_; ++i)
+         cache_end_[i] = 0;
+      cache_op_.resize(0);
+   }
+
+   // in_subgraph_
+   init_in_subgraph(random_itr);
+   //
+   return;
+}
+// -----------------------------------------------------------------------
+/*!
+Initialize in_subgraph corresponding to the selected independent variables.
+
+\tparam Addr
+is the type used for indices in the random iterator.
+
+\param random_itr
+Is a random iterator for this operation sequence.
+
+\par select_domain_
+This vector determines the selected independent variables.
+
+\par in_subgraph_
+We use depend_yes (depend_no) for the value n_dep_ (n_dep_ + 1).
+The important properties are that depend_yes < depend_no and
+for a valid indpendent variable index i_ind < depend_yes.
+The input size and elements of in_subgraph_ do not matter.
+If in_subgraph_[i_op] == depend_yes (depend_no),
+the result for this operator depends (does not depend)
+on the selected independent variables.
+Note that for atomic function call operators i_op,
+in_subgraph[i_op] is depend_no except for the first AFunOp in the
+atomic function call sequence. For the first AFunOp,
+it is depend_yes (depend_no) if any of the results for the call sequence
+depend (do not depend) on the selected independent variables.
+Except for UserOP, only operators with NumRes(op) > 0 have in_subgraph_
+value depend_yes;
+e.g., comparison operators have in_subgraph_ value depend_no.
+*/
+template <class Addr>
+void subgraph_info::init_in_subgraph(
+   const local::play::const_random_iterator<Addr>&  random_itr    )
+{
+   // check sizes
+   CPPAD_ASSERT_UNKNOWN( map_user_op_.size()   == n_op_ );
+   CPPAD_ASSERT_UNKNOWN( random_itr.num_op()   == n_op_ );
+   CPPAD_ASSERT_UNKNOWN( select_domain_.size() == n_ind_ );
+
+   // depend_yes and depend_no
+   addr_t depend_yes = addr_t( n_dep_ );
+   addr_t depend_no  = addr_t( n_dep_ + 1 );
+
    // set in_subgraph to have proper size
    in_subgraph_.resize(n_op_);
 
@@ -104,7 +160,7 @@ void subgraph_info::init_rev(
             CPPAD_ASSERT_UNKNOWN( j < n_ind_ );
             //
             // set in_subgraph_[i_op]
-            if( select_domain[j] )
+            if( select_domain_[j] )
                in_subgraph_[i_op] = depend_yes;
          }
 # ifndef NDEBUG
@@ -150,9 +206,7 @@ void subgraph_info::init_rev(
          break;
       }
    }
-   CPPAD_ASSERT_UNKNOWN(
-      count_independent == size_t(select_domain.size())
-   );
+   CPPAD_ASSERT_UNKNOWN( count_independent == n_ind_ );
    //
    return;
 }
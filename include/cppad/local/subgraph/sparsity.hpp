@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SUBGRAPH_SPARSITY_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/pod_vector.hpp>
@@ -128,9 +128,11 @@ void subgraph_sparsity(
    pod_vector<addr_t> subgraph;
 
    // initialize a reverse mode subgraph calculation
+   // (in_subgraph has size zero when it is computed by get_rev)
    sub_info.init_rev(random_itr, select_domain);
    CPPAD_ASSERT_UNKNOWN(
-      sub_info.in_subgraph().size() == play->num_op_rec()
+      sub_info.in_subgraph().size() == play->num_op_rec() ||
+      sub_info.in_subgraph().size() == 0
    );
    //
 # ifndef NDEBUG
@@ -0,0 +1,542 @@
+# ifndef CPPAD_LOCAL_SWEEP_ATOMIC_BATCH_HPP
+# define CPPAD_LOCAL_SWEEP_ATOMIC_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+
+# include <limits>
+# include <cppad/local/atomic_index.hpp>
+# include <cppad/core/atomic/four/atomic.hpp>
+
+/*
+------------------------------------------------------------------------------
+{xrst_begin atomic_batch_sweep dev}
+
+Batched Atomic Function Calls in the Sweeps
+###########################################
+
+Syntax
+******
+| ``atomic_batch`` < *Base* , *RecBase* > *batch*
+| *batched* = *batch* . ``forward`` (
+| |tab| *itr* , *play* , *cskip_op* , *p* , *q* , *J* , *taylor*
+| )
+| *batched* = *batch* . ``reverse`` (
+| |tab| *itr* , *play* , *cskip_op* , *d* , *J* , *taylor* , *K* , *partial*
+| )
+
+Purpose
+*******
+Finds a batch of consecutive independent calls to an atomic_four function
+and evaluates them using the
+:ref:`batch callbacks<atomic_four_batch-name>` .
+The *batch* object holds the work space so that it can be
+declared once per sweep.
+
+Base, RecBase
+*************
+If *Base* is not the same as *RecBase* ,
+*batched* is always false.
+
+itr
+***
+For ``forward`` , the input value of this iterator must correspond to
+the first AFunOp for a call.
+For ``reverse`` , the input value must correspond to the second
+AFunOp for a call (the first one reached by a reverse sweep).
+If *batched* is false, *itr* is not changed.
+Otherwise, upon return it corresponds to the other AFunOp for the
+last call in the batch; i.e., the sweep continues with the
+operator after the batch.
+
+play
+****
+is the player for the sweep.
+
+cskip_op
+********
+A call is not included in the batch if *cskip_op* is true for its
+(first reached) AFunOp.
+
+p, q
+****
+is the lowest and highest order for the forward sweep
+(only one direction).
+
+d
+*
+is the highest order for the reverse sweep.
+
+J
+*
+is the number of Taylor coefficients for each variable
+in the *taylor* array.
+
+taylor
+******
+is the Taylor coefficient array for the sweep.
+For ``forward`` , the orders *p* through *q* for the results
+of the atomic functions in the batch are set.
+
+K
+*
+is the number of partials for each variable in the *partial* array.
+
+partial
+*******
+is the partial derivative array for the reverse sweep.
+The partials for the arguments of the atomic functions in the batch
+are updated.
+
+batched
+*******
+is true if a batch of two or more calls was evaluated.
+
+{xrst_end atomic_batch_sweep}
+------------------------------------------------------------------------------
+*/
+// BEGIN_CPAPD_LOCAL_SWEEP_NAMESPACE
+namespace CppAD { namespace local { namespace sweep {
+
+// atomic_batch
+// general case where Base is not RecBase; e.g., AD<RecBase>
+template <class Base, class RecBase>
+class atomic_batch {
+public:
+   template <class Iterator>
+   bool forward(
+      Iterator&                   itr      ,
+      const player<Base>*         play     ,
+      const bool*                 cskip_op ,
+      size_t                      p        ,
+      size_t                      q        ,
+      size_t                      J        ,
+      Base*                       taylor   )
+   {  return false; }
+   template <class Iterator>
+   bool reverse(
+      Iterator&                   itr      ,
+      const player<Base>*         play     ,
+      const bool*                 cskip_op ,
+      size_t                      d        ,
+      size_t                      J        ,
+      const Base*                 taylor   ,
+      size_t                      K        ,
+      Base*                       partial  )
+   {  return false; }
+};
+
+// atomic_batch<Base, Base>
+template <class Base>
+class atomic_batch<Base, Base> {
+private:
+   //
+   // call_id_
+   vector<size_t> call_id_;
+   //
+   // select_, index_
+   // forward: select_y and variable index for each result
+   // reverse: select_x and variable index for each argument
+   // (the variable index is zero for parameters)
+   vector<bool>   select_;
+   vector<size_t> index_;
+   //
+   // taylor_x_, taylor_y_, partial_x_, partial_y_
+   vector<Base>   taylor_x_;
+   vector<Base>   taylor_y_;
+   vector<Base>   partial_x_;
+   vector<Base>   partial_y_;
+   //
+   // one_select_, one_x_, one_y_, one_px_, one_py_
+   // work space used to call the single call callbacks
+   vector<bool>   one_select_;
+   vector<Base>   one_x_;
+   vector<Base>   one_y_;
+   vector<Base>   one_px_;
+   vector<Base>   one_py_;
+   //
+   // object
+   // atomic_four object that uses batching (nullptr if there is none)
+   static atomic_four<Base>* object(size_t atom_index)
+   {  bool         set_null = false;
+      size_t       type     = 0;
+      std::string* name_ptr = nullptr;
+      void*        v_ptr    = nullptr;
+      local::atomic_index<Base>(set_null, atom_index, type, name_ptr, v_ptr);
+      if( type != 4 || v_ptr == nullptr )
+         return nullptr;
+      atomic_four<Base>* afun = reinterpret_cast< atomic_four<Base>* >(v_ptr);
+      if( ! afun->batch() )
+         return nullptr;
+      return afun;
+   }
+   //
+   // resize
+   void resize(size_t n_call, size_t n, size_t m, size_t k1, bool reverse)
+   {  call_id_.resize(n_call);
+      taylor_x_.resize(n_call * n * k1);
+      taylor_y_.resize(n_call * m * k1);
+      if( reverse )
+      {  select_.resize(n_call * n);
+         index_.resize(n_call * n);
+         partial_x_.resize(n_call * n * k1);
+         partial_y_.resize(n_call * m * k1);
+      }
+      else
+      {  select_.resize(n_call * m);
+         index_.resize(n_call * m);
+      }
+   }
+   //
+   // error
+   static void error(size_t atom_index, const char* callback)
+   {  bool        set_null = false;
+      size_t      type     = 0;
+      std::string name;
+      void*       v_ptr    = nullptr;
+      local::atomic_index<Base>(set_null, atom_index, type, &name, v_ptr);
+      std::string msg = name + ": atomic " + callback + " returned false";
+      CPPAD_ASSERT_KNOWN(false, msg.c_str() );
+   }
+public:
+   // --------------------------------------------------------------------
+   // forward
+   template <class Iterator>
+   bool forward(
+      Iterator&                   itr      ,
+      const player<Base>*         play     ,
+      const bool*                 cskip_op ,
+      size_t                      p        ,
+      size_t                      q        ,
+      size_t                      J        ,
+      Base*                       taylor   )
+   {  //
+      // op, arg, i_var
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      itr.op_info(op, arg, i_var);
+      CPPAD_ASSERT_UNKNOWN( op == AFunOp );
+      //
+      // atom_index, n, m, afun
+      size_t atom_index = size_t( arg[0] );
+      size_t n          = size_t( arg[2] );
+      size_t m          = size_t( arg[3] );
+      atomic_four<Base>* afun = object(atom_index);
+      if( afun == nullptr )
+         return false;
+      //
+      // n_call, last
+      // first_result: first variable that is a result of a call in the batch
+      size_t   first_result = std::numeric_limits<size_t>::max();
+      Iterator next         = itr;
+      Iterator last         = itr;
+      size_t   n_call       = 0;
+      bool     more         = true;
+      while( more )
+      {  // next corresponds to the first AFunOp for a call
+         next.op_info(op, arg, i_var);
+         CPPAD_ASSERT_UNKNOWN( op == AFunOp );
+         more  = size_t( arg[0] ) == atom_index;
+         more &= size_t( arg[2] ) == n && size_t( arg[3] ) == m;
+         //
+         // arguments
+         Iterator it = next;
+         for(size_t j = 0; j < n && more; ++j)
+         {  (++it).op_info(op, arg, i_var);
+            if( op == FunavOp )
+               more = size_t( arg[0] ) < first_result;
+         }
+         if( more )
+         {  // results
+            for(size_t i = 0; i < m; ++i)
+            {  (++it).op_info(op, arg, i_var);
+               if( op == FunrvOp )
+                  first_result = std::min(first_result, i_var);
+            }
+            // second AFunOp for this call
+            ++it;
+            ++n_call;
+            last = it;
+            //
+            // next
+            next = it;
+            (++next).op_info(op, arg, i_var);
+            more = op == AFunOp && ! cskip_op[ next.op_index() ];
+         }
+      }
+      if( n_call < 2 )
+         return false;
+      //
+      // parameter, q1
+      const Base* parameter = play->GetPar();
+      size_t      q1        = q + 1;
+      //
+      // call_id_, select_, index_, taylor_x_, taylor_y_
+      resize(n_call, n, m, q1, false);
+      Iterator it = itr;
+      for(size_t c = 0; c < n_call; ++c)
+      {  // first AFunOp for this call
+         if( c > 0 )
+            ++it;
+         it.op_info(op, arg, i_var);
+         call_id_[c] = size_t( arg[1] );
+         //
+         // arguments
+         for(size_t j = 0; j < n; ++j)
+         {  (++it).op_info(op, arg, i_var);
+            Base* tx = taylor_x_.data() + (c * n + j) * q1;
+            if( op == FunapOp )
+            {  tx[0] = parameter[ arg[0] ];
+               for(size_t k = 1; k < q1; ++k)
+                  tx[k] = Base(0.0);
+            }
+            else
+            {  CPPAD_ASSERT_UNKNOWN( op == FunavOp );
+               const Base* t = taylor + size_t( arg[0] ) * J;
+               for(size_t k = 0; k < q1; ++k)
+                  tx[k] = t[k];
+            }
+         }
+         //
+         // results
+         for(size_t i = 0; i < m; ++i)
+         {  (++it).op_info(op, arg, i_var);
+            size_t ci = c * m + i;
+            Base*  ty = taylor_y_.data() + ci * q1;
+            if( op == FunrpOp )
+            {  index_[ci]  = 0;
+               select_[ci] = false;
+               ty[0]       = parameter[ arg[0] ];
+               for(size_t k = 1; k < p; ++k)
+                  ty[k] = Base(0.0);
+            }
+            else
+            {  CPPAD_ASSERT_UNKNOWN( op == FunrvOp );
+               index_[ci]  = i_var;
+               select_[ci] = true;
+               const Base* t = taylor + i_var * J;
+               for(size_t k = 0; k < p; ++k)
+                  ty[k] = t[k];
+            }
+         }
+         // second AFunOp for this call
+         ++it;
+      }
+      //
+      // taylor_y_
+      bool ok = afun->forward_batch(
+         call_id_, select_, p, q, taylor_x_, taylor_y_
+      );
+      if( ! ok )
+      {  ok = true;
+         one_select_.resize(m);
+         one_x_.resize(n * q1);
+         one_y_.resize(m * q1);
+         for(size_t c = 0; c < n_call && ok; ++c)
+         {  for(size_t i = 0; i < m; ++i)
+               one_select_[i] = select_[c * m + i];
+            for(size_t ell = 0; ell < n * q1; ++ell)
+               one_x_[ell] = taylor_x_[c * n * q1 + ell];
+            for(size_t ell = 0; ell < m * q1; ++ell)
+               one_y_[ell] = taylor_y_[c * m * q1 + ell];
+            ok = afun->forward(
+               call_id_[c], one_select_, p, q, one_x_, one_y_
+            );
+            for(size_t ell = 0; ell < m * q1; ++ell)
+               taylor_y_[c * m * q1 + ell] = one_y_[ell];
+         }
+      }
+      if( ! ok )
+         error(atom_index, "forward");
+      //
+      // taylor
+      for(size_t ci = 0; ci < n_call * m; ++ci) if( index_[ci] > 0 )
+      {  for(size_t k = p; k < q1; ++k)
+            taylor[ index_[ci] * J + k ] = taylor_y_[ci * q1 + k];
+      }
+      //
+      itr = last;
+      return true;
+   }
+   // --------------------------------------------------------------------
+   // reverse
+   template <class Iterator>
+   bool reverse(
+      Iterator&                   itr      ,
+      const player<Base>*         play     ,
+      const bool*                 cskip_op ,
+      size_t                      d        ,
+      size_t                      J        ,
+      const Base*                 taylor   ,
+      size_t                      K        ,
+      Base*                       partial  )
+   {  //
+      // op, arg, i_var
+      OpCode        op;
+      const addr_t* arg;
+      size_t        i_var;
+      itr.op_info(op, arg, i_var);
+      CPPAD_ASSERT_UNKNOWN( op == AFunOp );
+      //
+      // atom_index, n, m, afun
+      size_t atom_index = size_t( arg[0] );
+      size_t n          = size_t( arg[2] );
+      size_t m          = size_t( arg[3] );
+      atomic_four<Base>* afun = object(atom_index);
+      if( afun == nullptr )
+         return false;
+      //
+      // n_call, last
+      // max_argument: maximum variable argument for the calls in the batch.
+      // The calls are found in reverse order and the results of a call
+      // must be greater than max_argument for the calls after it.
+      size_t   max_argument = 0;
+      Iterator prev         = itr;
+      Iterator last         = itr;
+      size_t   n_call       = 0;
+      bool     more         = true;
+      while( more )
+      {  // prev corresponds to the second AFunOp for a call
+         prev.op_info(op, arg, i_var);
+         CPPAD_ASSERT_UNKNOWN( op == AFunOp );
+         more  = size_t( arg[0] ) == atom_index;
+         more &= size_t( arg[2] ) == n && size_t( arg[3] ) == m;
+         //
+         // results
+         Iterator it = prev;
+         for(size_t i = 0; i < m && more; ++i)
+         {  (--it).op_info(op, arg, i_var);
+            if( op == FunrvOp )
+               more = max_argument < i_var;
+         }
+         if( more )
+         {  // arguments
+            for(size_t j = 0; j < n; ++j)
+            {  (--it).op_info(op, arg, i_var);
+               if( op == FunavOp )
+                  max_argument = std::max(max_argument, size_t( arg[0] ));
+            }
+            // first AFunOp for this call
+            --it;
+            ++n_call;
+            last = it;
+            //
+            // prev
+            prev = it;
+            (--prev).op_info(op, arg, i_var);
+            more = op == AFunOp && ! cskip_op[ prev.op_index() ];
+         }
+      }
+      if( n_call < 2 )
+         return false;
+      //
+      // parameter, k1
+      const Base* parameter = play->GetPar();
+      size_t      k1        = d + 1;
+      //
+      // call_id_, select_, index_, taylor_x_, taylor_y_, partial_y_
+      // (the calls are in the order they appear in the operation sequence)
+      resize(n_call, n, m, k1, true);
+      Iterator it = last;
+      for(size_t c = 0; c < n_call; ++c)
+      {  // first AFunOp for this call
+         if( c > 0 )
+            ++it;
+         it.op_info(op, arg, i_var);
+         call_id_[c] = size_t( arg[1] );
+         //
+         // arguments
+         for(size_t j = 0; j < n; ++j)
+         {  (++it).op_info(op, arg, i_var);
+            size_t cj = c * n + j;
+            Base*  tx = taylor_x_.data() + cj * k1;
+            if( op == FunapOp )
+            {  index_[cj]  = 0;
+               select_[cj] = false;
+               tx[0]       = parameter[ arg[0] ];
+               for(size_t ell = 1; ell < k1; ++ell)
+                  tx[ell] = Base(0.0);
+            }
+            else
+            {  CPPAD_ASSERT_UNKNOWN( op == FunavOp );
+               index_[cj]    = size_t( arg[0] );
+               select_[cj]   = true;
+               const Base* t = taylor + size_t( arg[0] ) * J;
+               for(size_t ell = 0; ell < k1; ++ell)
+                  tx[ell] = t[ell];
+            }
+         }
+         //
+         // results
+         for(size_t i = 0; i < m; ++i)
+         {  (++it).op_info(op, arg, i_var);
+            size_t ci = c * m + i;
+            Base*  ty = taylor_y_.data()  + ci * k1;
+            Base*  py = partial_y_.data() + ci * k1;
+            if( op == FunrpOp )
+            {  for(size_t ell = 0; ell < k1; ++ell)
+               {  ty[ell] = Base(0.0);
+                  py[ell] = Base(0.0);
+               }
+               ty[0] = parameter[ arg[0] ];
+            }
+            else
+            {  CPPAD_ASSERT_UNKNOWN( op == FunrvOp );
+               const Base* t  = taylor  + i_var * J;
+               const Base* pt = partial + i_var * K;
+               for(size_t ell = 0; ell < k1; ++ell)
+               {  ty[ell] = t[ell];
+                  py[ell] = pt[ell];
+               }
+            }
+         }
+         // second AFunOp for this call
+         ++it;
+      }
+      //
+      // partial_x_
+      bool ok = afun->reverse_batch(
+         call_id_, select_, d, taylor_x_, taylor_y_, partial_x_, partial_y_
+      );
+      if( ! ok )
+      {  ok = true;
+         one_select_.resize(n);
+         one_x_.resize(n * k1);
+         one_y_.resize(m * k1);
+         one_px_.resize(n * k1);
+         one_py_.resize(m * k1);
+         for(size_t c = 0; c < n_call && ok; ++c)
+         {  for(size_t j = 0; j < n; ++j)
+               one_select_[j] = select_[c * n + j];
+            for(size_t ell = 0; ell < n * k1; ++ell)
+               one_x_[ell] = taylor_x_[c * n * k1 + ell];
+            for(size_t ell = 0; ell < m * k1; ++ell)
+            {  one_y_[ell]  = taylor_y_[c * m * k1 + ell];
+               one_py_[ell] = partial_y_[c * m * k1 + ell];
+            }
+            ok = afun->reverse(
+               call_id_[c], one_select_, d, one_x_, one_y_, one_px_, one_py_
+            );
+            for(size_t ell = 0; ell < n * k1; ++ell)
+               partial_x_[c * n * k1 + ell] = one_px_[ell];
+         }
+      }
+      if( ! ok )
+         error(atom_index, "reverse");
+      //
+      // partial
+      for(size_t cj = 0; cj < n_call * n; ++cj) if( index_[cj] > 0 )
+      {  for(size_t ell = 0; ell < k1; ++ell)
+            partial[ index_[cj] * K + ell ] += partial_x_[cj * k1 + ell];
+      }
+      //
+      itr = last;
+      return true;
+   }
+};
+
+} } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
+
+# endif
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_CALL_ATOMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/atomic_index.hpp>
@@ -388,6 +388,13 @@ type_x
 ******
 type for each component of x (not used by atomic_two interface).
 
+ident_zero_x
+************
+is work space with size equal to the number of arguments
+(only used by the atomic_four interface).
+It is an argument so that the sweeps can avoid allocating memory
+for each atomic function call.
+
 x_index
 *******
 is a mapping from the index of an atomic function argument
@@ -415,6 +422,7 @@ void call_atomic_for_jac_sparsity(
    bool                         dependency    ,
    const vector<Base>&          parameter_x   ,
    const vector<ad_type_enum>&  type_x        ,
+   vector<bool>&                ident_zero_x  ,
    const pod_vector<size_t>&    x_index       ,
    const pod_vector<size_t>&    y_index       ,
    InternalSparsity&            var_sparsity  )
@@ -427,7 +435,6 @@ void call_atomic_for_jac_sparsity(
    local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
    //
    // ident_zero_x
-   vector<bool> ident_zero_x;
    if( type == 4 )
    {  size_t n = x_index.size();
       ident_zero_x.resize(n);
@@ -550,6 +557,13 @@ type_x
 ******
 type for each component of x (not used by atomic_two interface).
 
+ident_zero_x
+************
+is work space with size equal to the number of arguments
+(only used by the atomic_four interface).
+It is an argument so that the sweeps can avoid allocating memory
+for each atomic function call.
+
 x_index
 *******
 is a mapping from the index of an atomic function argument
@@ -577,6 +591,7 @@ void call_atomic_rev_jac_sparsity(
    bool                         dependency    ,
    const vector<Base>&          parameter_x   ,
    const vector<ad_type_enum>&  type_x        ,
+   vector<bool>&                ident_zero_x  ,
    const pod_vector<size_t>&    x_index       ,
    const pod_vector<size_t>&    y_index       ,
    InternalSparsity&            var_sparsity  )
@@ -589,7 +604,6 @@ void call_atomic_rev_jac_sparsity(
    local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
    //
    // ident_zero_x
-   vector<bool> ident_zero_x;
    if( type == 4 )
    {  size_t n = x_index.size();
       ident_zero_x.resize(n);
@@ -712,6 +726,13 @@ type_x
 ******
 type for each component of x (not used by atomic_two interface).
 
+ident_zero_x
+************
+is work space with size equal to the number of arguments
+(only used by the atomic_four interface).
+It is an argument so that the sweeps can avoid allocating memory
+for each atomic function call.
+
 x_index
 *******
 is a mapping from the index of an atomic function argument
@@ -782,6 +803,7 @@ void call_atomic_for_hes_sparsity(
    size_t                       call_id           ,
    const vector<Base>&          parameter_x       ,
    const vector<ad_type_enum>&  type_x            ,
+   vector<bool>&                ident_zero_x      ,
    const pod_vector<size_t>&    x_index           ,
    const pod_vector<size_t>&    y_index           ,
    size_t                       np1               ,
@@ -800,7 +822,6 @@ void call_atomic_for_hes_sparsity(
    local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
    //
    // ident_zero_x
-   vector<bool> ident_zero_x;
    if( type == 4 )
    {  size_t n = x_index.size();
       ident_zero_x.resize(n);
@@ -955,6 +976,13 @@ type_x
 ******
 type for each component of x (not used by atomic_two interface).
 
+ident_zero_x
+************
+is work space with size equal to the number of arguments
+(only used by the atomic_four interface).
+It is an argument so that the sweeps can avoid allocating memory
+for each atomic function call.
+
 x_index
 *******
 is a mapping from the index of an atomic function argument
@@ -997,6 +1025,7 @@ void call_atomic_rev_hes_sparsity(
    size_t                       call_id           ,
    const vector<Base>&          parameter_x       ,
    const vector<ad_type_enum>&  type_x            ,
+   vector<bool>&                ident_zero_x      ,
    const pod_vector<size_t>&    x_index           ,
    const pod_vector<size_t>&    y_index           ,
    const InternalSparsity&      for_jac_sparsity  ,
@@ -1011,7 +1040,6 @@ void call_atomic_rev_hes_sparsity(
    local::atomic_index<RecBase>(set_null, atom_index, type, name_ptr, v_ptr);
    //
    // ident_zero_x
-   vector<bool> ident_zero_x;
    if( type == 4 )
    {  size_t n = x_index.size();
       ident_zero_x.resize(n);
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_DYNAMIC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -68,6 +68,9 @@ where
 The arguments for each dynamic parameter have index value
 lower than the index value for the parameter.
 
+\param profile
+if not null, the operator profile for this sweep is recorded here.
+
 \param not_used_rec_base
 Specifies RecBase for this call.
 */
@@ -91,6 +94,7 @@ void dynamic(
    const pod_vector<addr_t>&     dyn_ind2par_ind    ,
    const pod_vector<opcode_t>&   dyn_par_op         ,
    const pod_vector<addr_t>&     dyn_par_arg        ,
+   play::op_profile*             profile            ,
    const RecBase&                not_used_rec_base  )
 {
    // number of dynamic parameters
@@ -132,6 +136,11 @@ void dynamic(
    // Initialize index in dyn_par_arg
    size_t i_arg = 0;
    //
+   // profile, profile_start
+   std::uint64_t profile_start = 0;
+   if( profile != nullptr )
+      profile->start_sweep(play::dynamic_sweep, sizeof(Base));
+   //
    // Loop throubh the dynamic parameters
    size_t i_dyn = 0;
    while(i_dyn < num_dynamic_par)
@@ -164,6 +173,10 @@ void dynamic(
             par[j] = & all_par_vec[ dyn_par_arg[i_arg + j] ];
       }
       //
+      // profile_start
+      if( profile != nullptr )
+         profile_start = play::op_profile::cycle();
+      //
       switch(op)
       {
          // ---------------------------------------------------------------
@@ -518,6 +531,15 @@ void dynamic(
          CPPAD_ASSERT_UNKNOWN(false);
          break;
       }
+      //
+      // profile
+      if( profile != nullptr )
+      {  profile->record(size_t(op), profile_start);
+         if( op == atom_dyn )
+         {  size_t atom_index = size_t( dyn_par_arg[i_arg + 0] );
+            profile->record_atomic(atom_index, profile_start);
+         }
+      }
 # if CPPAD_DYNAMIC_TRACE
       if(
          (op != cond_exp_dyn) &
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FOR_HES_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -203,11 +203,13 @@ void for_hes(
       CPPAD_ASSERT_UNKNOWN( j == play->num_var_vecad_ind_rec() );
    }
    // ------------------------------------------------------------------------
-   // work space used by AFunOp.
-   vector<Base>         atom_x;  //// value of parameter arguments to function
-   vector<ad_type_enum> type_x;  // argument types
-   pod_vector<size_t>   atom_ix; // variable index (on tape) for each argument
-   pod_vector<size_t>   atom_iy; // variable index (on tape) for each result
+   // work space used by AFunOp
+   // (the vectors are in the player work space and do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(0) );
+   vector<Base>&         atom_x( atom_work.par_x ); // parameter arguments
+   vector<ad_type_enum>& type_x( atom_work.type_x ); // argument types
+   pod_vector<size_t>&   atom_ix( atom_work.x_index ); // argument variables
+   pod_vector<size_t>&   atom_iy( atom_work.y_index ); // result variables
    //
    // information set by atomic forward (initialization to avoid warnings)
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -237,6 +239,12 @@ void for_hes(
    CppAD::vectorBool zf_value(np1);
    CppAD::vectorBool zh_value(np1 * np1);
 # endif
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::for_hes_sweep, 0);
+   //
    bool   flag; // temporary for use in switch cases below
    bool   more_operators = true;
    size_t count_independent = 0;
@@ -245,6 +253,10 @@ void for_hes(
       // next op
       (++itr).op_info(op, arg, i_var);
 
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == start_atom, atom_index);
+      //
       // does the Hessian in question have a non-zero derivative
       // with respect to this variable
       bool include = NumRes(op) > 0;
@@ -481,8 +493,8 @@ void for_hes(
             atom_state = start_atom;
             //
             call_atomic_for_hes_sparsity<Base,RecBase>(
-               atom_index, atom_old, atom_x, type_x, atom_ix, atom_iy,
-               np1, numvar, rev_jac_sparse, for_hes_sparse
+               atom_index, atom_old, atom_x, type_x, atom_work.ident_zero_x,
+               atom_ix, atom_iy, np1, numvar, rev_jac_sparse, for_hes_sparse
             );
          }
          break;
@@ -672,6 +684,10 @@ void for_hes(
 # else
    }
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == start_atom, atom_index);
 
    return;
 }
@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FOR_JAC_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <set>
@@ -127,11 +127,13 @@ void for_jac(
    }
 
    // --------------------------------------------------------------
-   // work space used by AFunOp.
-   vector<Base>         atom_x;  //// value of parameter arguments to function
-   vector<ad_type_enum> type_x;  // argument types
-   pod_vector<size_t>   atom_ix; // variable index (on tape) for each argument
-   pod_vector<size_t>   atom_iy; // variable index (on tape) for each result
+   // work space used by AFunOp
+   // (the vectors are in the player work space and do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(0) );
+   vector<Base>&         atom_x( atom_work.par_x ); // parameter arguments
+   vector<ad_type_enum>& type_x( atom_work.type_x ); // argument types
+   pod_vector<size_t>&   atom_ix( atom_work.x_index ); // argument variables
+   pod_vector<size_t>&   atom_iy( atom_work.y_index ); // result variables
    //
    // information set by atomic forward (initialization to avoid warnings)
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -162,6 +164,12 @@ void for_jac(
    itr.op_info(op, arg, i_var);
    CPPAD_ASSERT_UNKNOWN( op == BeginOp );
    //
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::for_jac_sweep, 0);
+   //
    bool more_operators = true;
    while(more_operators)
    {  bool flag; // temporary for use in switch cases.
@@ -169,6 +177,10 @@ void for_jac(
       // this op
       (++itr).op_info(op, arg, i_var);
 
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == start_atom, atom_index);
+      //
       // rest of information depends on the case
       switch( op )
       {
@@ -635,6 +647,7 @@ void for_jac(
                dependency,
                atom_x,
                type_x,
+               atom_work.ident_zero_x,
                atom_ix,
                atom_iy,
                var_sparsity
@@ -818,6 +831,10 @@ void for_jac(
 # else
    }
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == start_atom, atom_index);
 
    return;
 }
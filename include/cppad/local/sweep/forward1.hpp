@@ -7,6 +7,7 @@
 
 # include <cppad/local/play/atom_op_info.hpp>
 # include <cppad/local/sweep/call_atomic.hpp>
+# include <cppad/local/sweep/atomic_batch.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -222,12 +223,15 @@ void forward1(
    const size_t order_up  = q;
 
    // vectors used by atomic function operators
-   vector<Base>         atom_par_x;  // argument parameter values
-   vector<ad_type_enum> atom_type_x; // argument type
-   vector<Base>         atom_tx;     // argument vector Taylor coefficients
-   vector<Base>         atom_ty;     // result vector Taylor coefficients
-   vector<size_t>       atom_iy;     // variable indices for result vector
-   vector<bool>         atom_sy;     // select_y for this atomic call
+   // (these are in the player work space and so do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(q+1) );
+   vector<Base>&         atom_par_x( atom_work.par_x );  // parameter values
+   vector<ad_type_enum>& atom_type_x( atom_work.type_x ); // argument type
+   vector<Base>&         atom_tx( atom_work.tx );  // argument Taylor coefs
+   vector<Base>&         atom_ty( atom_work.ty );  // result Taylor coefs
+   vector<size_t>&       atom_iy( atom_work.iy );  // result variable indices
+   vector<bool>&         atom_sy( atom_work.sy );  // select_y for this call
+   atomic_batch<Base, RecBase> atom_batch; // batches of atomic calls
    //
    // information defined by atomic function operators
    size_t atom_index=0, atom_id=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -272,6 +276,12 @@ void forward1(
 # endif
    //
    bool flag; // a temporary flag to use in switch cases
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::forward1_sweep, (q + 1) * sizeof(Base));
+   //
    bool more_operators = true;
    while(more_operators)
    {
@@ -311,6 +321,10 @@ void forward1(
          (++itr).op_info(op, arg, i_var);
       }
 
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == start_atom, atom_index);
+      //
       // action depends on the operator
       switch( op )
       {
@@ -891,7 +905,11 @@ void forward1(
             op, arg, atom_index, atom_id, atom_m, atom_n
          );
          if( flag )
-         {  atom_state = arg_atom;
+         {  // check for a batch of calls to this atomic function
+            if( atom_batch.forward(itr, play, cskip_op, p, q, J, taylor) )
+               break;
+            //
+            atom_state = arg_atom;
             atom_i     = 0;
             atom_j     = 0;
             //
@@ -1072,6 +1090,10 @@ void forward1(
 # else
    }
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == start_atom, atom_index);
    CPPAD_ASSERT_UNKNOWN( atom_state == start_atom );
 
    if( (p == 0) && (compare_change_count == 0) )
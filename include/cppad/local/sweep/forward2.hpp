@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_FORWARD2_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -137,12 +137,14 @@ void forward2(
    const size_t order_up  = q;
 
    // vectors used by atomic function operators
-   vector<Base> atom_par_x;          // argument parameter values
-   vector<ad_type_enum> atom_type_x; // argument type
-   vector<Base> atom_tx_one;         // argument vector Taylor coefficients
-   vector<Base> atom_tx_all;
-   vector<Base> atom_ty_one;         // result vector Taylor coefficients
-   vector<Base> atom_ty_all;
+   // (these are in the player work space and so do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(q * r + 1) );
+   vector<Base>& atom_par_x( atom_work.par_x );          // parameter values
+   vector<ad_type_enum>& atom_type_x( atom_work.type_x ); // argument type
+   vector<Base>& atom_tx_one( atom_work.tx ); // argument Taylor coefficients
+   vector<Base>& atom_tx_all( atom_work.tx_all );
+   vector<Base>& atom_ty_one( atom_work.ty ); // result Taylor coefficients
+   vector<Base>& atom_ty_all( atom_work.ty_all );
    //
    // information defined by atomic function operators
    size_t atom_index=0, atom_id=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -163,10 +165,10 @@ void forward2(
    const size_t atom_q1 = q+1;
 
    // variable indices for results vector
-   vector<size_t> atom_iy;
+   vector<size_t>& atom_iy( atom_work.iy );
 
    // select_y for an atomic function call
-   vector<bool> atom_sy;
+   vector<bool>& atom_sy( atom_work.sy );
 
    // skip the BeginOp at the beginning of the recording
    play::const_sequential_iterator itr = play->begin();
@@ -182,6 +184,12 @@ void forward2(
    CppAD::vector<Base> Z_vec(q+1);
 # endif
    bool flag; // a temporary flag to use in switch cases
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::forward2_sweep, (1 + q * r) * sizeof(Base));
+   //
    bool more_operators = true;
    while(more_operators)
    {
@@ -221,6 +229,10 @@ void forward2(
          (++itr).op_info(op, arg, i_var);
       }
 
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == start_atom, atom_index);
+      //
       // action depends on the operator
       switch( op )
       {
@@ -779,6 +791,10 @@ void forward2(
 # else
    }
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == start_atom, atom_index);
    CPPAD_ASSERT_UNKNOWN( atom_state == start_atom );
 
    return;
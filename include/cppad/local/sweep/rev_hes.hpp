@@ -2,7 +2,7 @@
 # define CPPAD_LOCAL_SWEEP_REV_HES_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/local/play/atom_op_info.hpp>
@@ -153,11 +153,13 @@ void rev_hes(
    }
 
    // ----------------------------------------------------------------------
-   // work space used by AFunOp.
-   vector<Base>         atom_x;  // value of parameter arguments to function
-   vector<ad_type_enum> type_x;  // argument types
-   pod_vector<size_t>   atom_ix; // variable indices for argument vector
-   pod_vector<size_t>   atom_iy; // variable indices for result vector
+   // work space used by AFunOp
+   // (the vectors are in the player work space and do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(0) );
+   vector<Base>&         atom_x( atom_work.par_x ); // parameter arguments
+   vector<ad_type_enum>& type_x( atom_work.type_x ); // argument types
+   pod_vector<size_t>&   atom_ix( atom_work.x_index ); // argument variables
+   pod_vector<size_t>&   atom_iy( atom_work.y_index ); // result variables
    //
    // information set by atomic forward (initialization to avoid warnings)
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -186,6 +188,12 @@ void rev_hes(
    CppAD::vectorBool zf_value(limit);
    CppAD::vectorBool zh_value(limit);
 # endif
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::rev_hes_sweep, 0);
+   //
    bool more_operators = true;
    while(more_operators)
    {  bool flag; // temporary for use in switch cases
@@ -193,6 +201,10 @@ void rev_hes(
       // next op
       (--itr).op_info(op, arg, i_var);
 
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == end_atom, atom_index);
+      //
       // rest of information depends on the case
       switch( op )
       {
@@ -637,8 +649,8 @@ void rev_hes(
             //
             // call atomic function for this operation
             call_atomic_rev_hes_sparsity<Base,RecBase>(
-               atom_index, atom_old, atom_x, type_x, atom_ix, atom_iy,
-               for_jac_sparse, RevJac, rev_hes_sparse
+               atom_index, atom_old, atom_x, type_x, atom_work.ident_zero_x,
+               atom_ix, atom_iy, for_jac_sparse, RevJac, rev_hes_sparse
             );
          }
          break;
@@ -782,6 +794,10 @@ void rev_hes(
 # else
    }
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == end_atom, atom_index);
    // values corresponding to BeginOp
    CPPAD_ASSERT_UNKNOWN( itr.op_index() == 0 );
    CPPAD_ASSERT_UNKNOWN( i_var == 0 );
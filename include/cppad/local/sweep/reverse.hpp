@@ -2,11 +2,12 @@
 # define CPPAD_LOCAL_SWEEP_REVERSE_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 
 # include <cppad/local/play/atom_op_info.hpp>
+# include <cppad/local/sweep/atomic_batch.hpp>
 
 // BEGIN_CPPAD_LOCAL_SWEEP_NAMESPACE
 namespace CppAD { namespace local { namespace sweep {
@@ -156,6 +157,11 @@ the entire atomic function call must be in the subgraph.
 \param not_used_rec_base
 Specifies RecBase for this call.
 
+\param atom_work_ptr
+If this is null, the atomic function work space in play is used.
+Otherwise, it is work space for this call and play is not modified;
+e.g., so that different threads can use the same player at the same time.
+
 \par Assumptions
 The first operator on the tape is a BeginOp,
 and the next n operators are InvOp operations for the
@@ -171,10 +177,11 @@ void reverse(
    const Base*                 Taylor,
    size_t                      K,
    Base*                       Partial,
-   bool*                       cskip_op,
+   const bool*                 cskip_op,
    const pod_vector<Addr>&     load_op2var,
    Iterator&                   play_itr,
-   const RecBase&              not_used_rec_base
+   const RecBase&              not_used_rec_base,
+   play::atom_work<Base>*      atom_work_ptr = nullptr
 )
 {
    // check numvar argument
@@ -191,14 +198,17 @@ void reverse(
    // work space used by AFunOp.
    const size_t         atom_k  = d;   // highest order we are differentiating
    const size_t         atom_k1 = d+1; // number orders for this calculation
-   vector<Base>         atom_par_x;    // argument parameter values
-   vector<ad_type_enum> atom_type_x;   // argument type
-   vector<bool>         atom_sx;       // slect_x for this function call
-   vector<size_t>       atom_ix;       // variable indices for argument vector
-   vector<Base>         atom_tx;       // argument vector Taylor coefficients
-   vector<Base>         atom_ty;       // result vector Taylor coefficients
-   vector<Base>         atom_px;       // partials w.r.t argument vector
-   vector<Base>         atom_py;       // partials w.r.t. result vector
+   // (the vectors are in the work space and do not allocate memory)
+   play::atom_work<Base>& atom_work( play->atom_work_obj(d+1, atom_work_ptr) );
+   vector<Base>&         atom_par_x( atom_work.par_x );  // parameter values
+   vector<ad_type_enum>& atom_type_x( atom_work.type_x ); // argument type
+   vector<bool>&         atom_sx( atom_work.sx ); // select_x for this call
+   vector<size_t>&       atom_ix( atom_work.ix ); // argument variable indices
+   vector<Base>&         atom_tx( atom_work.tx ); // argument Taylor coefs
+   vector<Base>&         atom_ty( atom_work.ty ); // result Taylor coefs
+   vector<Base>&         atom_px( atom_work.px ); // partials w.r.t. argument
+   vector<Base>&         atom_py( atom_work.py ); // partials w.r.t. result
+   atomic_batch<Base, RecBase> atom_batch; // batches of atomic calls
    //
    // information defined by atomic forward
    size_t atom_index=0, atom_old=0, atom_m=0, atom_n=0, atom_i=0, atom_j=0;
@@ -220,6 +230,12 @@ void reverse(
    size_t        i_var;
    play_itr.op_info(op, arg, i_var);
    CPPAD_ASSERT_UNKNOWN( op == EndOp );
+   //
+   // profile
+   play::op_profile* profile = play->op_profile_ptr();
+   if( profile != nullptr )
+      profile->start_sweep(play::reverse_sweep, 2 * (d + 1) * sizeof(Base));
+   //
    while(op != BeginOp )
    {  bool flag; // temporary for use in switch cases
       //
@@ -273,6 +289,10 @@ void reverse(
       );
       std::cout << std::endl;
 # endif
+      // profile
+      if( profile != nullptr )
+         profile->next_op(size_t(op), atom_state == end_atom, atom_index);
+      //
       switch( op )
       {
          case AbsOp:
@@ -657,7 +677,12 @@ void reverse(
             op, arg, atom_index, atom_old, atom_m, atom_n
          );
          if( flag )
-         {  atom_state = ret_atom;
+         {  // check for a batch of calls to this atomic function
+            if( atom_batch.reverse(
+               play_itr, play, cskip_op, d, J, Taylor, K, Partial
+            ) ) break;
+            //
+            atom_state = ret_atom;
             atom_i     = atom_m;
             atom_j     = atom_n;
             //
@@ -808,6 +833,10 @@ void reverse(
 # if CPPAD_REVERSE_TRACE
    std::cout << std::endl;
 # endif
+   //
+   // profile
+   if( profile != nullptr )
+      profile->end_sweep(atom_state == end_atom, atom_index);
 }
 
 } } } // END_CPPAD_LOCAL_SWEEP_NAMESPACE
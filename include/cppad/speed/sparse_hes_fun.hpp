@@ -2,7 +2,7 @@
 # define CPPAD_SPEED_SPARSE_HES_FUN_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin sparse_hes_fun}
@@ -199,30 +199,38 @@ namespace CppAD {
             fp[k] = Float(0);
       }
 
-      // determine which diagonal entries are present in row[k], col[k]
-      CppAD::vector<size_t> diagonal(n);
-      for(i = 0; i < n; i++)
-         diagonal[i] = K;   // no diagonal entry for this row
-      for(k = 0; k < K; k++)
-      {  if( row[k] == col[k] )
-         {  CPPAD_ASSERT_UNKNOWN( diagonal[row[k]] == K );
-            // index of the diagonal entry
-            diagonal[ row[k] ] = k;
+      // The diagonal indices and the factors are only needed when p == 2.
+      // Computing the factors requires order K^2 operations so they are
+      // not computed when p == 0 (which is used to record large functions).
+      CppAD::vector<size_t> diagonal;
+      CppAD::vector<Float>  factor;
+      if( p == 2 )
+      {  //
+         // determine which diagonal entries are present in row[k], col[k]
+         diagonal.resize(n);
+         for(i = 0; i < n; i++)
+            diagonal[i] = K;   // no diagonal entry for this row
+         for(k = 0; k < K; k++)
+         {  if( row[k] == col[k] )
+            {  CPPAD_ASSERT_UNKNOWN( diagonal[row[k]] == K );
+               // index of the diagonal entry
+               diagonal[ row[k] ] = k;
+            }
          }
-      }
-
-      // determine which entries must be multiplied by a factor of two
-      CppAD::vector<Float> factor(K);
-      for(k = 0; k < K; k++)
-      {  factor[k] = Float(1);
-         for(size_t k1 = 0; k1 < K; k1++)
-         {  bool reflected = true;
-            reflected &= k != k1;
-            reflected &= row[k] != col[k];
-            reflected &= row[k] == col[k1];
-            reflected &= col[k] == row[k1];
-            if( reflected )
-               factor[k] = Float(2);
+         //
+         // determine which entries must be multiplied by a factor of two
+         factor.resize(K);
+         for(k = 0; k < K; k++)
+         {  factor[k] = Float(1);
+            for(size_t k1 = 0; k1 < K; k1++)
+            {  bool reflected = true;
+               reflected &= k != k1;
+               reflected &= row[k] != col[k];
+               reflected &= row[k] == col[k1];
+               reflected &= col[k] == row[k1];
+               if( reflected )
+                  factor[k] = Float(2);
+            }
          }
       }
 
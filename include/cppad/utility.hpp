@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 // BEGIN_SORT_THIS_LINE_PLUS_1
 # include <cppad/utility/check_numeric_type.hpp>
@@ -21,6 +21,7 @@
 # include <cppad/utility/ode_err_control.hpp>
 # include <cppad/utility/ode_gear.hpp>
 # include <cppad/utility/ode_gear_control.hpp>
+# include <cppad/utility/ode_sparse_work.hpp>
 # include <cppad/utility/omp_alloc.hpp>
 # include <cppad/utility/poly.hpp>
 # include <cppad/utility/pow_int.hpp>
@@ -28,7 +29,9 @@
 # include <cppad/utility/romberg_one.hpp>
 # include <cppad/utility/rosen_34.hpp>
 # include <cppad/utility/runge_45.hpp>
+# include <cppad/utility/runge_45_batch.hpp>
 # include <cppad/utility/set_union.hpp>
+# include <cppad/utility/sparse_lu.hpp>
 # include <cppad/utility/sparse_rc.hpp>
 # include <cppad/utility/sparse_rcv.hpp>
 # include <cppad/utility/speed_test.hpp>
@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_CREATE_DLL_LIB_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin create_dll_lib}
@@ -89,6 +89,16 @@ In the Clang or GNU case, the default for this option is
 
    *cppad_c_compiler_cmd* ``-shared`` .
 
+n_job
+=====
+This is a positive integer (represented as a string) that specifies
+the maximum number of C source files that are compiled at the same time.
+The default value for this option is ``1`` .
+Compiling in parallel is useful when a large function has been split
+into many translation units; see :ref:`to_csrc@csrc_vec` .
+This option is ignored in the MSVC case
+(where the files are always compiled one at a time).
+
 
 err_msg
 *******
@@ -104,7 +114,9 @@ The file :ref:`dll_lib.cpp-name` contains an example and test of
 {xrst_end create_dll_lib}
 */
 # include <map>
+# include <cstdlib>
 # include <cppad/local/temp_file.hpp>
+# include <cppad/utility/to_string.hpp>
 # include <cppad/configure.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
@@ -125,6 +137,7 @@ std::string create_dll_lib(
    // compile, link
    string compile = "";
    string  link   = "";
+   size_t  n_job  = 1;
 # if CPPAD_C_COMPILER_MSVC_FLAGS
    compile = CPPAD_C_COMPILER_CMD " /EHs /EHc /c /TC";
    link    = "link /DLL";
@@ -139,6 +152,15 @@ std::string create_dll_lib(
          compile = pair.second;
       else if( key == "link" )
          link = pair.second;
+      else if( key == "n_job" )
+      {  int value = std::atoi( pair.second.c_str() );
+         if( value <= 0 )
+         {  err_msg = "options[n_job] = " + pair.second;
+            err_msg += " is not a positive integer";
+            return err_msg;
+         }
+         n_job = size_t(value);
+      }
       else
       {  err_msg = "options contains following invalid key: " + key;
          return err_msg;
@@ -171,11 +193,19 @@ std::string create_dll_lib(
    {  err_msg += "dll_file = " + dll_file + "\ndoes not end with " + dll_ext;
       return err_msg;
    }
+# ifdef _MSC_VER
+   n_job = 1;
+# endif
    //
    // o_file_list, o_file_vec;
    string       o_file_list;
    StringVector o_file_vec( csrc_files.size() );
    //
+   // job_cmd, n_running
+   // used to run up to n_job compiles in parallel using one shell command
+   string job_cmd   = "";
+   size_t n_running = 0;
+   //
    // i_csrc
    for(size_t i_csrc = 0; i_csrc < csrc_files.size(); ++i_csrc)
    {  //
@@ -195,11 +225,35 @@ std::string create_dll_lib(
       //
       // o_file
       // compile c_file and put result in o_file
-      flag = std::system( cmd.c_str() );
-      if(  flag != 0 )
-      {  err_msg = "create_dll_lib: following system command failed\n";
-         err_msg += cmd;
-         return err_msg;
+      if( n_job == 1 )
+      {  flag = std::system( cmd.c_str() );
+         if(  flag != 0 )
+         {  err_msg = "create_dll_lib: following system command failed\n";
+            err_msg += cmd;
+            return err_msg;
+         }
+      }
+      else
+      {  // run this command in the background and wait for the group of
+         // commands to finish when there are n_job of them or this is the
+         // last file
+         string pid = "pid_" + to_string(n_running);
+         job_cmd   += cmd + " & " + pid + "=$!; ";
+         ++n_running;
+         if( n_running == n_job || i_csrc + 1 == csrc_files.size() )
+         {  job_cmd = "status=0; " + job_cmd;
+            for(size_t i = 0; i < n_running; ++i)
+               job_cmd += "wait $pid_" + to_string(i) + " || status=1; ";
+            job_cmd += "exit $status";
+            flag = std::system( job_cmd.c_str() );
+            if(  flag != 0 )
+            {  err_msg = "create_dll_lib: following system command failed\n";
+               err_msg += job_cmd;
+               return err_msg;
+            }
+            job_cmd   = "";
+            n_running = 0;
+         }
       }
       //
       // o_file_list
@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_ODE_GEAR_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -21,9 +21,9 @@ An Arbitrary Order Gear Method
 Syntax
 ******
 
-   # ``include <cppad/utility/ode_gear.hpp>``
-
-``OdeGear`` ( *F* , *m* , *n* , *T* , *X* , *e* )
+| # ``include <cppad/utility/ode_gear.hpp>``
+| ``OdeGear`` ( *F* , *m* , *n* , *T* , *X* , *e* )
+| ``OdeGear`` ( *F* , *m* , *n* , *T* , *X* , *e* , *work* )
 
 Purpose
 *******
@@ -108,6 +108,9 @@ On output,
 
    f\_x [i * n + j] = \partial_{x(j)} f_i ( t , x )
 
+If the *work* argument is present, *f_x* is a sparse matrix; see
+:ref:`ode_sparse_work@Ode_dep` .
+
 Warning
 =======
 The arguments *f* , and *f_x*
@@ -197,6 +200,32 @@ the solution; i.e.,
 
 where :math:`h` is the maximum of :math:`t_{j+1} - t_j`.
 
+work
+****
+The argument *work* is optional and has prototype
+
+   ``ode_sparse_work`` < *SizeVector* , *Vector* >& *work*
+
+If it is present, the Jacobian *f_x* is a sparse matrix,
+the equations are solved using a sparse LU factorization,
+and the Jacobian and its factorization can be reused for several steps
+(modified Newton method); see :ref:`ode_sparse_work-name` .
+In this case, the Newton iterations are computed using
+
+.. math::
+
+   \left[ \alpha_m I - J \right] ( x_m^k - x_m^{k-1} )
+   =
+   f( t_m , x_m^{k-1} )
+   - \alpha_0 x_0 - \cdots - \alpha_{m-1} x_{m-1}
+   - \alpha_m x_m^{k-1}
+
+where :math:`J` is the most recent evaluation of the Jacobian
+(which is equivalent to Newton's method below when
+:math:`J = \partial_x f( t_m , x_m^0 )` ).
+If the factorization has a zero pivot,
+:math:`X[ m * n + i ]` and :math:`e[i]` are set to ``nan`` .
+
 Scalar
 ******
 The type *Scalar* must satisfy the conditions
@@ -403,6 +432,8 @@ vol. 18, no. 1, pp. 89-95, Jan. 1971.
 # include <cppad/utility/vector.hpp>
 # include <cppad/utility/lu_factor.hpp>
 # include <cppad/utility/lu_invert.hpp>
+# include <cppad/utility/nan.hpp>
+# include <cppad/utility/ode_sparse_work.hpp>
 
 namespace CppAD { // BEGIN CppAD namespace
 
@@ -560,6 +591,157 @@ void OdeGear(
    }
 }
 
+template <class Vector, class Fun, class SizeVector>
+void OdeGear(
+   Fun                                  &F    ,
+   size_t                                m    ,
+   size_t                                n    ,
+   const Vector                         &T    ,
+   Vector                               &X    ,
+   Vector                               &e    ,
+   ode_sparse_work<SizeVector, Vector>  &work )
+{
+   // temporary indices
+   size_t i, j, k;
+
+   typedef typename Vector::value_type Scalar;
+
+   // check numeric type specifications
+   CheckNumericType<Scalar>();
+
+   // check simple vector class specifications
+   CheckSimpleVector<Scalar, Vector>();
+
+   CPPAD_ASSERT_KNOWN(
+      m >= 1,
+      "OdeGear: m is less than one"
+   );
+   CPPAD_ASSERT_KNOWN(
+      n > 0,
+      "OdeGear: n is equal to zero"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t(T.size()) >= (m+1),
+      "OdeGear: size of T is not greater than or equal (m+1)"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t(X.size()) >= (m+1) * n,
+      "OdeGear: size of X is not greater than or equal (m+1) * n"
+   );
+   for(j = 0; j < m; j++) CPPAD_ASSERT_KNOWN(
+      T[j] < T[j+1],
+      "OdeGear: the array T is not monotone increasing"
+   );
+
+   // some constants
+   Scalar zero(0);
+   Scalar one(1);
+
+   // vectors required by method
+   Vector alpha(m + 1);
+   Vector beta(m + 1);
+   Vector f(n);
+   Vector x_m0(n);
+   Vector x_m(n);
+   Vector b(n);
+
+   // compute alpha[m]
+   alpha[m] = zero;
+   for(k = 0; k < m; k++)
+      alpha[m] += one / (T[m] - T[k]);
+
+   // compute beta[m-1]
+   beta[m-1] = one / (T[m-1] - T[m]);
+   for(k = 0; k < m-1; k++)
+      beta[m-1] += one / (T[m-1] - T[k]);
+
+
+   // compute other components of alpha
+   for(j = 0; j < m; j++)
+   {  // compute alpha[j]
+      alpha[j] = one / (T[j] - T[m]);
+      for(k = 0; k < m; k++)
+      {  if( k != j )
+         {  alpha[j] *= (T[m] - T[k]);
+            alpha[j] /= (T[j] - T[k]);
+         }
+      }
+   }
+
+   // compute other components of beta
+   for(j = 0; j <= m; j++)
+   {  if( j != m-1 )
+      {  // compute beta[j]
+         beta[j] = one / (T[j] - T[m-1]);
+         for(k = 0; k <= m; k++)
+         {  if( k != j && k != m-1 )
+            {  beta[j] *= (T[m-1] - T[k]);
+               beta[j] /= (T[j] - T[k]);
+            }
+         }
+      }
+   }
+
+   // evaluate f(T[m-1], x_{m-1} )
+   for(i = 0; i < n; i++)
+      x_m[i] = X[(m-1) * n + i];
+   F.Ode(T[m-1], x_m, f);
+
+   // solve for x_m^0
+   for(i = 0; i < n; i++)
+   {  x_m[i] =  f[i];
+      for(j = 0; j < m; j++)
+         x_m[i] -= beta[j] * X[j * n + i];
+      x_m[i] /= beta[m];
+   }
+   x_m0 = x_m;
+
+   // factorization of A = ( alpha[m] * I - f_x )
+   bool ok = true;
+   if( work.use_count == 0 || work.reuse <= work.use_count )
+   {  // evaluate partial w.r.t x of f(T[m], x_m^0)
+      F.Ode_dep(T[m], x_m, work.f_x);
+      ok = work.factor(alpha[m], - one);
+      work.use_count = 0;
+   }
+   else if( alpha[m] < work.alpha || work.alpha < alpha[m] )
+   {  // step size pattern changed, use previous f_x
+      ok = work.factor(alpha[m], - one);
+   }
+   ++work.use_count;
+   if( ! ok )
+   {  for(i = 0; i < n; i++)
+      {  X[m * n + i] = nan(zero);
+         e[i]         = nan(zero);
+      }
+      return;
+   }
+
+   // Iterations of (modified) Newton's method
+   for(k = 0; k < 3; k++)
+   {
+      F.Ode(T[m], x_m, f);
+
+      // b = f - alpha[0] x_0 - ... - alpha[m-1] x_{m-1} - alpha[m] x_m
+      for(i = 0; i < n; i++)
+      {  b[i] = f[i] - alpha[m] * x_m[i];
+         for(j = 0; j < m; j++)
+            b[i] -= alpha[j] * X[ j * n + i ];
+      }
+      work.lu.solve(b, b);
+      for(i = 0; i < n; i++)
+         x_m[i] += b[i];
+   }
+
+   // return estimate for x( t[k] ) and the estimated error bound
+   for(i = 0; i < n; i++)
+   {  X[m * n + i] = x_m[i];
+      e[i]         = x_m[i] - x_m0[i];
+      if( e[i] < zero )
+         e[i] = - e[i];
+   }
+}
+
 } // End CppAD namespace
 
 # endif
@@ -0,0 +1,201 @@
+# ifndef CPPAD_UTILITY_ODE_SPARSE_WORK_HPP
+# define CPPAD_UTILITY_ODE_SPARSE_WORK_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin ode_sparse_work}
+
+Sparse Jacobian Work Space for Rosen34 and OdeGear
+##################################################
+
+Syntax
+******
+
+| # ``include <cppad/utility/ode_sparse_work.hpp>``
+| ``ode_sparse_work`` < *SizeVector* , *Vector* > *work* ( *reuse* )
+| *work* . ``clear`` ()
+| *xf* = ``Rosen34`` ( *F* , *M* , *ti* , *tf* , *xi* , *e* , *work* )
+| ``OdeGear`` ( *F* , *m* , *n* , *T* , *X* , *e* , *work* )
+
+Purpose
+*******
+The :ref:`Rosen34-name` and :ref:`OdeGear-name` methods solve
+linear equations with matrices of the form
+:math:`\alpha I + \beta \partial_x F(t, x)` .
+If the *work* argument is present,
+the Jacobian :math:`\partial_x F(t, x)` is a :ref:`sparse_rcv-name` matrix
+and the equations are solved using :ref:`sparse_lu-name` .
+The *work* object stores the sparsity pattern and the
+:ref:`sparse_lu@analyze` results between steps and between calls,
+so they are only computed once.
+
+SizeVector
+**********
+The type *SizeVector* is a :ref:`sparse_rc@SizeVector` .
+
+Vector
+******
+The type *Vector* is the same as *Vector* for
+:ref:`Rosen34<Rosen34@Vector>` and :ref:`OdeGear<OdeGear@Vector>` .
+We use *Scalar* for the type of the elements of *Vector* .
+
+Ode_dep
+*******
+If the *work* argument is present, the call to
+*F* . ``Ode_dep`` has the following prototype:
+
+   *F* . ``Ode_dep`` ( *t* , *x* , *f_x* )
+
+with
+
+   ``sparse_rcv`` < *SizeVector* , *Vector* >& *f_x*
+
+The input value of *f_x* is its output value for the previous call using
+this *work* object (it is empty for the first call).
+Upon return, *f_x* is the Jacobian :math:`\partial_x F(t, x)` .
+The sparsity pattern of *f_x* must be the same for every call
+until *work* . ``clear`` () is called.
+For example, the first call can set the sparsity pattern for *f_x*
+and all the calls can use *f_x* for the *subset* argument to
+:ref:`sparse_jac_for<sparse_jac@subset>` .
+Using the same :ref:`sparse_jac@work` object for every call to
+``sparse_jac_for`` means that the coloring is only computed once.
+
+reuse
+*****
+This argument has type ``size_t`` , is optional, and its default value is one.
+It is the number of calls to ``OdeGear`` that use each evaluation
+of the Jacobian.
+If it is greater than one, ``OdeGear`` uses a modified Newton method;
+i.e., the Jacobian is only evaluated every *reuse* steps and
+the corresponding factorization is used for the Newton iterations
+in the steps in between.
+The factorization is recomputed, using the previous Jacobian,
+when the step size pattern changes (:math:`\alpha_m` in
+:ref:`OdeGear<OdeGear@Gear's Method>` changes).
+The Jacobian is always evaluated at every step by ``Rosen34``
+because Rosenbrock methods require an accurate Jacobian to
+obtain their order.
+The value *work* . ``reuse`` can be changed between calls.
+
+clear
+*****
+This informs *work* that the sparsity pattern for *f_x* may change.
+It also forces the next call to ``OdeGear`` to evaluate the Jacobian.
+
+Other Members
+*************
+The other members of *work* store information between calls and
+should not be changed.
+
+{xrst_toc_hidden
+   example/utility/ode_sparse.cpp
+}
+Example
+*******
+The file :ref:`ode_sparse.cpp-name`
+contains an example and test using ``ode_sparse_work`` .
+The program :ref:`speed_ode_sparse-name` compares the speed of
+the sparse and dense versions of ``Rosen34`` and ``OdeGear`` .
+
+{xrst_end ode_sparse_work}
+*/
+# include <cppad/utility/sparse_rcv.hpp>
+# include <cppad/utility/sparse_lu.hpp>
+# include <cppad/utility/vector.hpp>
+
+namespace CppAD { // BEGIN CPPAD_NAMESPACE
+
+/// work space used by Rosen34 and OdeGear with sparse Jacobians
+template <class SizeVector, class Vector>
+class ode_sparse_work {
+public:
+   /// type of the elements of Vector
+   typedef typename Vector::value_type Scalar;
+   /// Jacobian of F w.r.t. x; i.e., f_x in the call to F.Ode_dep
+   sparse_rcv<SizeVector, Vector> f_x;
+   /// number of OdeGear steps that use each Jacobian evaluation
+   size_t reuse;
+   /// matrix alpha * I + beta * f_x; the first f_x.nnz() entries
+   /// correspond to f_x and the rest are diagonal entries not in f_x
+   sparse_rcv<SizeVector, Vector> A;
+   /// diag[i] is the index in A of the i-th diagonal element
+   vector<size_t> diag;
+   /// factorization of A
+   sparse_lu<Scalar> lu;
+   /// number of OdeGear steps that used the current Jacobian
+   size_t use_count;
+   /// value of alpha corresponding to the current factorization
+   Scalar alpha;
+   //
+   /// constructor
+   ode_sparse_work(size_t reuse_in = 1)
+   : reuse(reuse_in), use_count(0), alpha(0)
+   { }
+   /// reset work to empty
+   void clear(void)
+   {  f_x       = sparse_rcv<SizeVector, Vector>();
+      A         = sparse_rcv<SizeVector, Vector>();
+      diag.clear();
+      lu        = sparse_lu<Scalar>();
+      use_count = 0;
+   }
+   /// A = alpha_in * I + beta * f_x and factor it; returns false if the
+   /// factorization has a zero pivot
+   bool factor(const Scalar& alpha_in, const Scalar& beta)
+   {  size_t n   = f_x.nr();
+      size_t nnz = f_x.nnz();
+      const SizeVector& row( f_x.row() );
+      const SizeVector& col( f_x.col() );
+      //
+      // A, diag, lu: sparsity pattern and symbolic analysis
+      if( A.nr() == 0 )
+      {  CPPAD_ASSERT_KNOWN( f_x.nc() == n,
+            "ode_sparse_work: f_x is not a square matrix"
+         );
+         size_t n_extra = n;
+         diag.resize(n);
+         for(size_t i = 0; i < n; ++i)
+            diag[i] = nnz;
+         for(size_t k = 0; k < nnz; ++k)
+         {  if( row[k] == col[k] )
+            {  diag[ row[k] ] = k;
+               --n_extra;
+            }
+         }
+         sparse_rc<SizeVector> pattern(n, n, nnz + n_extra);
+         for(size_t k = 0; k < nnz; ++k)
+            pattern.set(k, row[k], col[k]);
+         size_t k = nnz;
+         for(size_t i = 0; i < n; ++i)
+         {  if( diag[i] == nnz )
+            {  diag[i] = k;
+               pattern.set(k++, i, i);
+            }
+         }
+         A = sparse_rcv<SizeVector, Vector>(pattern);
+         lu.analyze(pattern, "minimum_degree");
+      }
+      CPPAD_ASSERT_KNOWN( A.nr() == n && nnz <= A.nnz(),
+         "ode_sparse_work: f_x pattern changed without calling clear"
+      );
+      //
+      // A
+      const Vector& val( f_x.val() );
+      for(size_t k = 0; k < nnz; ++k)
+         A.set(k, beta * val[k]);
+      for(size_t k = nnz; k < A.nnz(); ++k)
+         A.set(k, Scalar(0));
+      for(size_t i = 0; i < n; ++i)
+         A.set(diag[i], A.val()[ diag[i] ] + alpha_in);
+      //
+      alpha = alpha_in;
+      return lu.factor(A);
+   }
+};
+
+} // END_CPPAD_NAMESPACE
+
+# endif
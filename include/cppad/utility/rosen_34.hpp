@@ -2,7 +2,7 @@
 # define CPPAD_UTILITY_ROSEN_34_HPP
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 /*
@@ -25,6 +25,7 @@ Syntax
 | # ``include <cppad/utility/rosen_34.hpp>``
 | *xf* = ``Rosen34`` ( *F* , *M* , *ti* , *tf* , *xi* )
 | *xf* = ``Rosen34`` ( *F* , *M* , *ti* , *tf* , *xi* , *e* )
+| *xf* = ``Rosen34`` ( *F* , *M* , *ti* , *tf* , *xi* , *e* , *work* )
 
 Description
 ***********
@@ -145,6 +146,8 @@ and the input values of the elements of *f_x* do not matter.
 On output, the [ *i* * *n* + *j* ] element of
 *f_x* is set equal to :math:`\partial_{x(j)} F_i (t, x)`
 (see *F* ( *t* , *x* ) in :ref:`Rosen34@Description` ).
+If the *work* argument is present, *f_x* is a sparse matrix; see
+:ref:`ode_sparse_work@Ode_dep` .
 
 Nan
 ===
@@ -237,6 +240,16 @@ estimated bound for the absolute value of the error in *xf*
 
 where :math:`h = (tf - ti) / M` is the step size.
 
+work
+****
+The argument *work* is optional and has prototype
+
+   ``ode_sparse_work`` < *SizeVector* , *Vector* >& *work*
+
+If it is present, the Jacobian *f_x* is a sparse matrix and the
+equations are solved using a sparse LU factorization; see
+:ref:`ode_sparse_work-name` .
+
 Scalar
 ******
 The type *Scalar* must satisfy the conditions
@@ -295,6 +308,7 @@ The source code for this routine is in the file
 # include <cppad/utility/vector.hpp>
 # include <cppad/utility/lu_factor.hpp>
 # include <cppad/utility/lu_invert.hpp>
+# include <cppad/utility/ode_sparse_work.hpp>
 
 // needed before one can use CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL
 # include <cppad/utility/thread_alloc.hpp>
@@ -502,6 +516,180 @@ Vector Rosen34(
    return xf;
 }
 
+template <class Scalar, class Vector, class Fun, class SizeVector>
+Vector Rosen34(
+   Fun                                   &F    ,
+   size_t                                 M    ,
+   const Scalar                          &ti   ,
+   const Scalar                          &tf   ,
+   const Vector                          &xi   ,
+   Vector                                &e    ,
+   ode_sparse_work<SizeVector, Vector>   &work )
+{
+   CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
+
+   // check numeric type specifications
+   CheckNumericType<Scalar>();
+
+   // check simple vector class specifications
+   CheckSimpleVector<Scalar, Vector>();
+
+   // Parameters for Shampine's Rosenbrock method (same as dense case)
+   static Scalar a[3] = {
+      Scalar(0),
+      Scalar(1),
+      Scalar(3)   / Scalar(5)
+   };
+   static Scalar b[2 * 2] = {
+      Scalar(1),
+      Scalar(0),
+      Scalar(24)  / Scalar(25),
+      Scalar(3)   / Scalar(25)
+   };
+   static Scalar ct[4] = {
+      Scalar(1)   / Scalar(2),
+      - Scalar(3) / Scalar(2),
+      Scalar(121) / Scalar(50),
+      Scalar(29)  / Scalar(250)
+   };
+   static Scalar cg[3 * 3] = {
+      - Scalar(4),
+      Scalar(0),
+      Scalar(0),
+      Scalar(186) / Scalar(25),
+      Scalar(6)   / Scalar(5),
+      Scalar(0),
+      - Scalar(56) / Scalar(125),
+      - Scalar(27) / Scalar(125),
+      - Scalar(1)  / Scalar(5)
+   };
+   static Scalar d3[3] = {
+      Scalar(97) / Scalar(108),
+      Scalar(11) / Scalar(72),
+      Scalar(25) / Scalar(216)
+   };
+   static Scalar d4[4] = {
+      Scalar(19)  / Scalar(18),
+      Scalar(1)   / Scalar(4),
+      Scalar(25)  / Scalar(216),
+      Scalar(125) / Scalar(216)
+   };
+   CPPAD_ASSERT_KNOWN(
+      M >= 1,
+      "Error in Rosen34: the number of steps is less than one"
+   );
+   CPPAD_ASSERT_KNOWN(
+      e.size() == xi.size(),
+      "Error in Rosen34: size of e not equal to size of xi"
+   );
+   size_t i, k, l, m;                // indices
+
+   size_t  n    = xi.size();         // number of components in X(t)
+   Scalar  ns   = Scalar(double(M)); // number of steps as Scalar object
+   Scalar  h    = (tf - ti) / ns;    // step size
+   Scalar  zero = Scalar(0);         // some constants
+   Scalar  one  = Scalar(1);
+   Scalar  two  = Scalar(2);
+
+   // vectors used to store values returned by F
+   Vector Eg(n), f_t(n);
+   Vector g(n * 3), x3(n), x4(n), xf(n), ftmp(n), xtmp(n), nan_vec(n);
+
+   // initialize e = 0, nan_vec = nan
+   for(i = 0; i < n; i++)
+   {  e[i]       = zero;
+      nan_vec[i] = nan(zero);
+   }
+
+   xf = xi;           // initialize solution
+   for(m = 0; m < M; m++)
+   {  // time at beginning of this interval
+      Scalar t = ti * (Scalar(int(M - m)) / ns)
+                 + tf * (Scalar(int(m)) / ns);
+
+      // value of x at beginning of this interval
+      x3 = x4 = xf;
+
+      // evaluate partial derivatives at beginning of this interval
+      F.Ode_ind(t, xf, f_t);
+      F.Ode_dep(t, xf, work.f_x);
+      if( hasnan(f_t) || hasnan( work.f_x.val() ) )
+      {  e = nan_vec;
+         return nan_vec;
+      }
+
+      // sparse LU factor E = I - f_x * h / 2
+      if( ! work.factor(one, - h / two) )
+      {  e = nan_vec;
+         return nan_vec;
+      }
+
+      // loop over integration steps
+      for(k = 0; k < 3; k++)
+      {  // set location for next function evaluation
+         xtmp = xf;
+         for(l = 0; l < k; l++)
+         {  // loop over previous function evaluations
+            Scalar bkl = b[(k-1)*2 + l];
+            for(i = 0; i < n; i++)
+            {  // loop over elements of x
+               xtmp[i] += bkl * g[i*3 + l] * h;
+            }
+         }
+         // ftmp = F(t + a[k] * h, xtmp)
+         F.Ode(t + a[k] * h, xtmp, ftmp);
+         if( hasnan(ftmp) )
+         {  e = nan_vec;
+            return nan_vec;
+         }
+
+         // Form Eg for this integration step
+         for(i = 0; i < n; i++)
+            Eg[i] = ftmp[i] + ct[k] * f_t[i] * h;
+         for(l = 0; l < k; l++)
+         {  for(i = 0; i < n; i++)
+               Eg[i] += cg[(k-1)*3 + l] * g[i*3 + l];
+         }
+
+         // Solve the equation E * g = Eg
+         work.lu.solve(Eg, Eg);
+
+         // save solution and advance x3, x4
+         for(i = 0; i < n; i++)
+         {  g[i*3 + k]  = Eg[i];
+            x3[i]      += h * d3[k] * Eg[i];
+            x4[i]      += h * d4[k] * Eg[i];
+         }
+      }
+      // Form Eg for last update to x4 only
+      for(i = 0; i < n; i++)
+         Eg[i] = ftmp[i] + ct[3] * f_t[i] * h;
+      for(l = 0; l < 3; l++)
+      {  for(i = 0; i < n; i++)
+            Eg[i] += cg[2*3 + l] * g[i*3 + l];
+      }
+
+      // Solve the equation E * g = Eg
+      work.lu.solve(Eg, Eg);
+
+      // advance x4 and accumulate error bound
+      for(i = 0; i < n; i++)
+      {  x4[i] += h * d4[3] * Eg[i];
+
+         // cant use abs because cppad.hpp may not be included
+         Scalar diff = x4[i] - x3[i];
+         if( diff < zero )
+            e[i] -= diff;
+         else
+            e[i] += diff;
+      }
+
+      // advance xf for this step using x4
+      xf = x4;
+   }
+   return xf;
+}
+
 } // End CppAD namespace
 
 # endif
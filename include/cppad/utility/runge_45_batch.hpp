@@ -0,0 +1,573 @@
+# ifndef CPPAD_UTILITY_RUNGE_45_BATCH_HPP
+# define CPPAD_UTILITY_RUNGE_45_BATCH_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin Runge45Batch}
+{xrst_spell
+   eabs
+   ef
+   erel
+   maxabs
+   nstep
+   scur
+   smax
+   smin
+   tf
+   xf
+}
+
+Runge45 Applied to Many Trajectories at the Same Time
+#####################################################
+
+Syntax
+******
+
+| # ``include <cppad/utility/runge_45_batch.hpp>``
+| *xf* = ``Runge45Batch`` ( *F* , *n_traj* , *ti* , *tf* , *xi* ,
+| |tab| *smin* , *smax* , *scur* , *eabs* , *erel* , *ef* , *nstep* ,
+| |tab| *n_block* , *n_thread*
+| )
+
+Purpose
+*******
+This routine solves the same ODE
+
+.. math::
+   :nowrap:
+
+   \begin{eqnarray}
+      X_k (ti)  & = & xi_k       \\
+      X_k '(t)  & = & F[t , X_k (t)]
+   \end{eqnarray}
+
+for many initial values :math:`xi_k` ,
+:math:`k = 0 , \ldots , K-1` where :math:`K` is *n_traj* .
+For each trajectory, the result is the same as
+
+| |tab| *xf_k* = ``OdeErrControl`` ( *method* , *ti* , *tf* , *xi_k* ,
+| |tab| |tab| *smin* , *smax* , *scur_k* , *eabs* , *erel* , *ef_k* ,
+| |tab| |tab| *maxabs_k* , *nstep_k*
+| |tab| )
+
+where *method* . ``step`` ( *ta* , *tb* , *xa* , *xb* , *eb* ) is
+
+   *xb* = ``Runge45`` ( *F* , 1 , *ta* , *tb* , *xa* , *eb* )
+
+and *method* . ``order`` () is 4; see :ref:`OdeErrControl-name`
+and :ref:`Runge45-name` .
+Each trajectory has its own step size control
+(its own accepted and rejected steps).
+The trajectories are processed in blocks of size *n_block* and
+*F* is called once per stage for all the trajectories in a block,
+so the cost of calling *F* is amortized over the block and
+the loops over the trajectories can be vectorized by the compiler.
+The temporary vectors are allocated once per block
+(not once per step).
+
+Layout
+******
+We use :math:`n` for the number of components in :math:`X_k (t)` .
+All the vectors that contain values for each trajectory are stored in
+structure of arrays order; i.e., component *i* of trajectory *k*
+in a vector *v* is
+
+   *v* [ *i* * *n_traj* + *k* ]
+
+Fun
+***
+The object *F* has prototype
+
+   *Fun* & *F*
+
+and must support the syntax
+
+   *F* . ``Ode`` ( *t* , *x* , *f* )
+
+t
+=
+The argument *t* has prototype ``const`` *Vector* & *t* .
+Its size, :math:`K_b` , is the number of trajectories in the current block.
+The value *t* [ *k* ] is the time for the *k*-th trajectory in the block
+(the trajectories are at different times).
+
+x
+=
+The argument *x* has prototype ``const`` *Vector* & *x*
+and size :math:`n K_b` .
+Component *i* of the *k*-th trajectory in the block is
+*x* [ *i* * :math:`K_b` + *k* ] .
+
+f
+=
+The argument *f* has prototype *Vector* & *f* and size :math:`n K_b` .
+The input value of its elements does not matter.
+Upon return, *f* [ *i* * :math:`K_b` + *k* ] is component *i* of
+:math:`F( t_k , x_k )` where :math:`t_k` and :math:`x_k` are the
+time and state for the *k*-th trajectory in the block.
+If any component for the *k*-th trajectory is ``nan`` ,
+the corresponding step for that trajectory fails; see
+:ref:`OdeErrControl<OdeErrControl@Method@step>` .
+
+valvector
+=========
+The *Ode* function can pack the block into
+:ref:`valvector-name` objects, one for each component of :math:`t` and
+:math:`x` , and evaluate an ``ADFun<valvector>`` that was taped once
+for the right hand side of the ODE.
+This is done by the :ref:`runge_45_batch.cpp-name` example.
+
+n_traj
+******
+This argument has prototype ``size_t`` *n_traj* and is the number of
+trajectories :math:`K` . It must be greater than zero.
+
+ti
+**
+This argument has prototype ``const`` *Scalar* & *ti* and is the
+initial time for all the trajectories.
+
+tf
+**
+This argument has prototype ``const`` *Scalar* & *tf* and is the
+final time for all the trajectories.
+
+xi
+**
+This argument has prototype ``const`` *Vector* & *xi* and size
+:math:`n K` . It contains the initial values :math:`xi_k` .
+
+smin
+****
+This argument has prototype ``const`` *Scalar* & *smin* and is the
+minimum step size for all the trajectories.
+
+smax
+****
+This argument has prototype ``const`` *Scalar* & *smax* and is the
+maximum step size for all the trajectories.
+
+scur
+****
+This argument has prototype *Vector* & *scur* and size :math:`K` .
+On input, *scur* [ *k* ] is the step size to try first for
+the *k*-th trajectory.
+Upon return, it is the step size suggested for the next call
+(see :ref:`OdeErrControl<OdeErrControl@scur>` ).
+
+eabs
+****
+This argument has prototype ``const`` *Vector* & *eabs* and size
+:math:`n` . It is the absolute error bound for each component of
+the state (the same for all trajectories).
+
+erel
+****
+This argument has prototype ``const`` *Scalar* & *erel* and is the
+relative error bound for all the trajectories.
+
+ef
+**
+This argument has prototype *Vector* & *ef* and size :math:`n K` .
+The input value of its elements does not matter.
+Upon return, it contains the estimated error bound for each component
+of each trajectory.
+
+nstep
+*****
+This argument has prototype *SizeVector* & *nstep* and size :math:`K` .
+The input value of its elements does not matter.
+Upon return, *nstep* [ *k* ] is the number of steps
+(accepted or rejected) used by the *k*-th trajectory.
+
+n_block
+*******
+This argument has prototype ``size_t`` *n_block* and must be greater
+than zero.
+It is the number of trajectories in each call to *F* . ``Ode``
+(the last block may be smaller).
+All the trajectories in a block are evaluated until the last one
+reaches *tf* ; i.e., trajectories that are done use zero step size
+until then.
+
+n_thread
+********
+This argument has prototype ``size_t`` *n_thread* .
+If it is greater than one, and this file is compiled with OpenMP,
+the blocks are divided between *n_thread* OpenMP threads.
+In this case *F* . ``Ode`` must be thread safe,
+and :ref:`thread_alloc::parallel_setup<ta_parallel_setup-name>`
+must be called before ``Runge45Batch`` if
+:ref:`CppAD::vector<CppAD_vector-name>` is used for *Vector* .
+(The block index determines which trajectories a thread works on,
+so the results do not depend on *n_thread* .)
+
+xf
+**
+The return value has prototype *Vector* *xf* and size :math:`n K` .
+It contains the approximate solution :math:`X_k (tf)` for each trajectory.
+If a step fails at the minimum step size for a trajectory,
+the corresponding components of *xf* and *ef* are ``nan`` .
+
+Scalar
+******
+The type *Scalar* must satisfy the conditions for *Scalar* in
+:ref:`OdeErrControl<OdeErrControl@Scalar>` and
+:ref:`Runge45<Runge45@Scalar>` .
+
+Vector
+******
+The type *Vector* must be a :ref:`SimpleVector-name` class with
+:ref:`elements of type Scalar<SimpleVector@Elements of Specified Type>` .
+
+SizeVector
+**********
+The type *SizeVector* must be a :ref:`SimpleVector-name` class with
+elements of type ``size_t`` .
+
+{xrst_toc_hidden
+   example/utility/runge_45_batch.cpp
+}
+Example
+*******
+The file :ref:`runge_45_batch.cpp-name`
+contains an example and test of ``Runge45Batch`` .
+The program :ref:`speed_runge_45_batch-name` compares its speed
+with a loop of calls to ``OdeErrControl`` using ``Runge45`` .
+
+{xrst_end Runge45Batch}
+--------------------------------------------------------------------------
+*/
+
+// link exp, log, and fabs for float and double
+# include <cppad/base_require.hpp>
+
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/utility/check_simple_vector.hpp>
+# include <cppad/utility/nan.hpp>
+# include <cppad/utility/vector.hpp>
+
+namespace CppAD { // BEGIN CppAD namespace
+
+namespace local { namespace runge_45_batch {
+// ---------------------------------------------------------------------------
+// solve for trajectories k_start, ... , k_start + n_b - 1
+template <class Scalar, class Vector, class SizeVector, class Fun>
+void block(
+   Fun&              F       ,
+   size_t            n_traj  ,
+   size_t            k_start ,
+   size_t            n_b     ,
+   const Scalar&     ti      ,
+   const Scalar&     tf      ,
+   const Vector&     xi      ,
+   const Scalar&     smin    ,
+   const Scalar&     smax    ,
+   Vector&           scur    ,
+   const Vector&     eabs    ,
+   const Scalar&     erel    ,
+   Vector&           ef      ,
+   SizeVector&       nstep   ,
+   Vector&           xf      )
+{  size_t n = size_t( eabs.size() );
+   //
+   // Cash-Karp parameters (not static so that this routine is thread safe)
+   const Scalar a[6] = {
+      Scalar(0),
+      Scalar(1) / Scalar(5),
+      Scalar(3) / Scalar(10),
+      Scalar(3) / Scalar(5),
+      Scalar(1),
+      Scalar(7) / Scalar(8)
+   };
+   const Scalar b[5 * 5] = {
+      Scalar(1) / Scalar(5),
+      Scalar(0),
+      Scalar(0),
+      Scalar(0),
+      Scalar(0),
+
+      Scalar(3) / Scalar(40),
+      Scalar(9) / Scalar(40),
+      Scalar(0),
+      Scalar(0),
+      Scalar(0),
+
+      Scalar(3) / Scalar(10),
+      -Scalar(9) / Scalar(10),
+      Scalar(6) / Scalar(5),
+      Scalar(0),
+      Scalar(0),
+
+      -Scalar(11) / Scalar(54),
+      Scalar(5) / Scalar(2),
+      -Scalar(70) / Scalar(27),
+      Scalar(35) / Scalar(27),
+      Scalar(0),
+
+      Scalar(1631) / Scalar(55296),
+      Scalar(175) / Scalar(512),
+      Scalar(575) / Scalar(13824),
+      Scalar(44275) / Scalar(110592),
+      Scalar(253) / Scalar(4096)
+   };
+   const Scalar c4[6] = {
+      Scalar(2825) / Scalar(27648),
+      Scalar(0),
+      Scalar(18575) / Scalar(48384),
+      Scalar(13525) / Scalar(55296),
+      Scalar(277) / Scalar(14336),
+      Scalar(1) / Scalar(4),
+   };
+   const Scalar c5[6] = {
+      Scalar(37) / Scalar(378),
+      Scalar(0),
+      Scalar(250) / Scalar(621),
+      Scalar(125) / Scalar(594),
+      Scalar(0),
+      Scalar(512) / Scalar(1771)
+   };
+   //
+   // constants
+   Scalar zero(0.0);
+   Scalar one(1.0);
+   Scalar two(2.0);
+   Scalar three(3.0);
+   Scalar m1(3.0);  // Runge45 order minus one
+   //
+   // work space for this block: component i of trajectory k is [i * n_b + k]
+   Vector xa(n * n_b), xtmp(n * n_b), ftmp(n * n_b), x4(n * n_b);
+   Vector x5(n * n_b), eb(n * n_b), efb(n * n_b), fh(6 * n * n_b);
+   Vector ta(n_b), tb(n_b), h(n_b), t(n_b), step(n_b), zero_or_nan(n_b);
+   vector<bool> minimum_step(n_b), done(n_b);
+   //
+   // xa, efb, done, nstep
+   for(size_t k = 0; k < n_b; ++k)
+   {  ta[k]   = ti;
+      done[k] = ti == tf;
+      nstep[k_start + k] = 0;
+   }
+   for(size_t i = 0; i < n; ++i)
+   {  for(size_t k = 0; k < n_b; ++k)
+      {  xa[i * n_b + k]  = xi[i * n_traj + k_start + k];
+         efb[i * n_b + k] = zero;
+      }
+   }
+   size_t n_done = 0;
+   for(size_t k = 0; k < n_b; ++k)
+      if( done[k] )
+         ++n_done;
+   //
+   while( n_done < n_b )
+   {  //
+      // step, minimum_step, tb, h
+      for(size_t k = 0; k < n_b; ++k)
+      {  if( done[k] )
+         {  tb[k] = ta[k];
+            h[k]  = zero;
+         }
+         else
+         {  step[k] = scur[k_start + k];
+            if( smax <= step[k] )
+               step[k] = smax;
+            minimum_step[k] = step[k] <= smin;
+            if( minimum_step[k] )
+               step[k] = smin;
+            if( tf <= ta[k] + step[k] * three / two )
+               tb[k] = tf;
+            else
+               tb[k] = ta[k] + step[k];
+            ++nstep[k_start + k];
+            h[k] = tb[k] - ta[k];
+         }
+         zero_or_nan[k] = zero;
+      }
+      //
+      // x4, x5: one Runge45 step from ta to tb for each trajectory
+      for(size_t ell = 0; ell < n * n_b; ++ell)
+         x4[ell] = x5[ell] = xa[ell];
+      for(size_t j = 0; j < 6; ++j)
+      {  for(size_t ell = 0; ell < n * n_b; ++ell)
+            xtmp[ell] = xa[ell];
+         for(size_t p = 0; p < j; ++p)
+         {  Scalar bjp = b[ (j-1) * 5 + p ];
+            for(size_t ell = 0; ell < n * n_b; ++ell)
+               xtmp[ell] += bjp * fh[p * n * n_b + ell];
+         }
+         for(size_t k = 0; k < n_b; ++k)
+            t[k] = ta[k] + a[j] * h[k];
+         //
+         // ftmp = F(t, xtmp)
+         F.Ode(t, xtmp, ftmp);
+         //
+         // zero_or_nan
+         for(size_t i = 0; i < n; ++i)
+            for(size_t k = 0; k < n_b; ++k)
+               zero_or_nan[k] *= ftmp[i * n_b + k];
+         //
+         for(size_t i = 0; i < n; ++i)
+         {  for(size_t k = 0; k < n_b; ++k)
+            {  size_t ell = i * n_b + k;
+               Scalar fhi = ftmp[ell] * h[k];
+               fh[j * n * n_b + ell] = fhi;
+               x4[ell] += c4[j] * fhi;
+               x5[ell] += c5[j] * fhi;
+               x5[ell] += zero_or_nan[k];
+            }
+         }
+      }
+      //
+      // eb
+      for(size_t i = 0; i < n; ++i)
+      {  for(size_t k = 0; k < n_b; ++k)
+         {  size_t ell = i * n_b + k;
+            eb[ell]  = zero;
+            eb[ell] += fabs( x5[ell] - x4[ell] );
+            eb[ell] += zero_or_nan[k];
+         }
+      }
+      //
+      // step control for each trajectory (see OdeErrControl)
+      for(size_t k = 0; k < n_b; ++k)
+      {  if( done[k] )
+            continue;
+         //
+         // ok
+         bool ok = true;
+         for(size_t i = 0; i < n; ++i)
+         {  size_t ell = i * n_b + k;
+            ok &= ! ( CppAD::isnan( x5[ell] ) || CppAD::isnan( eb[ell] ) );
+         }
+         if( (! ok) && minimum_step[k] )
+         {  for(size_t i = 0; i < n; ++i)
+            {  xa[i * n_b + k]  = nan(zero);
+               efb[i * n_b + k] = nan(zero);
+            }
+            done[k] = true;
+            ++n_done;
+            continue;
+         }
+         //
+         // lambda
+         Scalar scur_k = scur[k_start + k];
+         Scalar lambda = Scalar(10) * scur_k / h[k];
+         for(size_t i = 0; i < n; ++i)
+         {  size_t ell = i * n_b + k;
+            Scalar axbi;
+            if( zero <= x5[ell] )
+               axbi = x5[ell];
+            else
+               axbi = - x5[ell];
+            Scalar a_i = eabs[i] + erel * axbi;
+            if( ! (eb[ell] == zero) )
+            {  Scalar r    = ( a_i / eb[ell] ) * h[k] / (tf - ti);
+               Scalar root = exp( log(r) / m1 );
+               if( root <= lambda )
+                  lambda = root;
+            }
+         }
+         if( ok && ( one <= lambda || h[k] <= smin * three / two) )
+         {  // accept this step
+            ta[k] = tb[k];
+            for(size_t i = 0; i < n; ++i)
+            {  size_t ell = i * n_b + k;
+               xa[ell]  = x5[ell];
+               efb[ell] = efb[ell] + eb[ell];
+            }
+         }
+         if( ! ok )
+            scur[k_start + k] = h[k] / two;
+         else if( ! (ta[k] == tf) )
+            scur[k_start + k] = lambda * h[k] / two;
+         //
+         if( ta[k] == tf )
+         {  done[k] = true;
+            ++n_done;
+         }
+      }
+   }
+   //
+   // xf, ef
+   for(size_t i = 0; i < n; ++i)
+   {  for(size_t k = 0; k < n_b; ++k)
+      {  xf[i * n_traj + k_start + k] = xa[i * n_b + k];
+         ef[i * n_traj + k_start + k] = efb[i * n_b + k];
+      }
+   }
+   return;
+}
+} } // END local::runge_45_batch namespace
+// ---------------------------------------------------------------------------
+template <class Scalar, class Vector, class SizeVector, class Fun>
+Vector Runge45Batch(
+   Fun&           F        ,
+   size_t         n_traj   ,
+   const Scalar&  ti       ,
+   const Scalar&  tf       ,
+   const Vector&  xi       ,
+   const Scalar&  smin     ,
+   const Scalar&  smax     ,
+   Vector&        scur     ,
+   const Vector&  eabs     ,
+   const Scalar&  erel     ,
+   Vector&        ef       ,
+   SizeVector&    nstep    ,
+   size_t         n_block  ,
+   size_t         n_thread )
+{  //
+   // check simple vector class specifications
+   CheckSimpleVector<Scalar, Vector>();
+   CheckSimpleVector<size_t, SizeVector>();
+   //
+   size_t n = size_t( eabs.size() );
+   CPPAD_ASSERT_KNOWN( n_traj > 0 && n_block > 0,
+      "Runge45Batch: n_traj or n_block is zero"
+   );
+   CPPAD_ASSERT_KNOWN( smin <= smax,
+      "Runge45Batch: smin > smax"
+   );
+   CPPAD_ASSERT_KNOWN( size_t( xi.size() ) == n * n_traj,
+      "Runge45Batch: size of xi is not equal to eabs.size() * n_traj"
+   );
+   CPPAD_ASSERT_KNOWN( size_t( ef.size() ) == n * n_traj,
+      "Runge45Batch: size of ef is not equal to eabs.size() * n_traj"
+   );
+   CPPAD_ASSERT_KNOWN(
+      size_t( scur.size() ) == n_traj && size_t( nstep.size() ) == n_traj,
+      "Runge45Batch: size of scur or nstep is not equal to n_traj"
+   );
+   //
+   // xf
+   Vector xf(n * n_traj);
+   //
+   // n_b_max
+   size_t n_b_max = n_block;
+   if( n_traj < n_b_max )
+      n_b_max = n_traj;
+   size_t n_b_total = (n_traj + n_b_max - 1) / n_b_max;
+   //
+   // process the blocks
+   // (use an int loop index because some OpenMP versions require it)
+   int n_b_int = int( n_b_total );
+# ifdef _OPENMP
+# pragma omp parallel for schedule(dynamic) \
+   num_threads( int(n_thread) ) if( n_thread > 1 )
+# endif
+   for(int i_b = 0; i_b < n_b_int; ++i_b)
+   {  size_t k_start = size_t(i_b) * n_b_max;
+      size_t n_b     = n_b_max;
+      if( n_traj < k_start + n_b )
+         n_b = n_traj - k_start;
+      local::runge_45_batch::block(
+         F, n_traj, k_start, n_b, ti, tf, xi,
+         smin, smax, scur, eabs, erel, ef, nstep, xf
+      );
+   }
+   return xf;
+}
+
+} // END CppAD namespace
+
+# endif
@@ -0,0 +1,480 @@
+# ifndef CPPAD_UTILITY_SPARSE_LU_HPP
+# define CPPAD_UTILITY_SPARSE_LU_HPP
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin sparse_lu}
+{xrst_spell
+   nnz
+}
+
+Sparse LU Factorization With Symbolic Reuse
+###########################################
+
+Syntax
+******
+
+| # ``include <cppad/utility/sparse_lu.hpp>``
+| ``sparse_lu`` < *Base* > *lu*
+| *lu* . ``analyze`` ( *pattern* , *ordering* )
+| *ok* = *lu* . ``factor`` ( *matrix* )
+| *lu* . ``solve`` ( *b* , *x* )
+| *n* = *lu* . ``n`` ()
+| *nnz* = *lu* . ``nnz`` ()
+
+Purpose
+*******
+Solves the linear equation :math:`A x = b` where
+:math:`A \in \B{R}^{n \times n}` is a sparse matrix.
+The work is split into a symbolic step, that only depends on the
+sparsity pattern for :math:`A` ,
+and a numeric step, that depends on the values in :math:`A` .
+The symbolic step is done once and then the numeric step can be
+repeated for many matrices with the same sparsity pattern; e.g.,
+the Jacobians that appear when solving a stiff ODE.
+The dense routines :ref:`LuFactor-name` and :ref:`LuSolve-name`
+take order :math:`n^3` operations to factor :math:`A` .
+
+Pivoting
+********
+The factorization is
+
+.. math::
+
+   P A P^\R{T} = L U
+
+where :math:`P` is a permutation matrix chosen by the symbolic step,
+:math:`L` is lower triangular with ones on the diagonal,
+and :math:`U` is upper triangular.
+The pivots are the diagonal elements of :math:`P A P^\R{T}` ;
+i.e., there is no numerical pivoting.
+This works well for matrices that are diagonally dominant,
+or close to the identity; e.g.,
+:math:`I - h \gamma J` in the :ref:`Rosen34-name` method.
+It also means that the sequence of floating point operations
+in the numeric step does not depend on the values in :math:`A` .
+
+Base
+****
+The type *Base* must satisfy the conditions for a
+:ref:`NumericType-name` .
+If *Base* is ``AD<double>`` , the numeric step can be recorded
+in an :ref:`ADFun-name` object.
+
+analyze
+*******
+This function does the symbolic analysis.
+It computes the permutation :math:`P` ,
+the sparsity pattern for :math:`L + U` (including fill in),
+and the sequence of operations used by the numeric step.
+It must be called before the first call to ``factor`` .
+
+pattern
+=======
+This argument has prototype
+
+   ``const sparse_rc`` < *SizeVector* >& *pattern*
+
+where *SizeVector* is a :ref:`sparse_rc@SizeVector` .
+It is the sparsity pattern for :math:`A` .
+The number of rows and columns in *pattern* must be equal,
+we use :math:`n` to denote this value.
+The diagonal elements of :math:`A` are included in the factorization
+(even if they are not in *pattern* ).
+
+ordering
+========
+This argument has prototype
+
+   ``const std::string&`` *ordering*
+
+If it is ``"natural"`` , :math:`P` is the identity matrix.
+This is a good choice for banded matrices.
+If it is ``"minimum_degree"`` , :math:`P` is chosen by the
+minimum degree heuristic applied to the sparsity pattern for
+:math:`A + A^\R{T}` .
+This tends to reduce the amount of fill in.
+
+factor
+******
+This function does the numeric factorization of :math:`A` .
+It can be called any number of times after ``analyze`` .
+
+matrix
+======
+This argument has prototype
+
+   ``const sparse_rcv`` < *SizeVector* , *ValueVector* >& *matrix*
+
+Its sparsity pattern, *matrix* . ``pat`` () , must be the same as
+*pattern* in the previous call to ``analyze`` .
+The *ValueVector* must be a :ref:`SimpleVector-name` with elements
+of type *Base* .
+
+ok
+==
+The return value has prototype
+
+   ``bool`` *ok*
+
+It is true if all the pivots are non-zero
+(in which case :math:`A` is invertible).
+If it is false, one of the pivots is zero and ``solve``
+cannot be used until a ``factor`` that returns true.
+If *Base* is ``AD<double>`` , the comparison of the pivots with zero
+depends on the values used while recording.
+
+solve
+*****
+This function uses the most recent factorization to solve
+:math:`A x = b` .
+
+b
+=
+This argument has prototype
+
+   ``const`` *ValueVector* & *b*
+
+and size :math:`n` . It is the right hand side of the equation.
+
+x
+=
+This argument has prototype
+
+   *ValueVector* & *x*
+
+and size :math:`n` .
+The input value of its elements does not matter.
+Upon return it is the solution of :math:`A x = b` .
+The vectors *b* and *x* may be the same vector.
+
+n
+*
+The return value *n* has type ``size_t`` and is the number of
+rows (and columns) in :math:`A` .
+
+nnz
+***
+The return value *nnz* has type ``size_t`` and is the number of
+possibly non-zero elements in :math:`L + U` ;
+i.e., the number in :math:`A` plus the fill in.
+
+{xrst_toc_hidden
+   example/utility/sparse_lu.cpp
+}
+Example
+*******
+The file :ref:`sparse_lu.cpp-name`
+contains an example and test of ``sparse_lu`` .
+The program :ref:`speed_sparse_lu-name` compares its speed
+with :ref:`LuFactor-name` .
+
+{xrst_end sparse_lu}
+*/
+# include <algorithm>
+# include <set>
+# include <string>
+# include <utility>
+# include <cppad/core/cppad_assert.hpp>
+# include <cppad/utility/check_numeric_type.hpp>
+# include <cppad/utility/check_simple_vector.hpp>
+# include <cppad/utility/sparse_rcv.hpp>
+# include <cppad/utility/vector.hpp>
+
+namespace CppAD { // BEGIN CPPAD_NAMESPACE
+
+/// sparse LU factorization with a symbolic step that can be reused
+template <class Base>
+class sparse_lu {
+private:
+   /// number of rows and columns in A
+   size_t n_;
+   /// number of possibly non-zero elements in A
+   size_t nnz_a_;
+   /// perm_[p] is the original index corresponding to pivot p
+   vector<size_t> perm_;
+   /// L + U in row major order with permuted indices;
+   /// row i is col_[ start_[i] ], ... , col_[ start_[i+1] - 1 ]
+   vector<size_t> start_;
+   vector<size_t> col_;
+   /// diag_[i] is the index in col_ of the diagonal element in row i
+   vector<size_t> diag_;
+   /// a_index_[k] is the index in val_ for the k-th element of A
+   vector<size_t> a_index_;
+   /// val_[ div_target_[d] ] /= pivot p
+   /// for d = div_start_[p], ... , div_start_[p+1] - 1
+   vector<size_t> div_start_;
+   vector<size_t> div_target_;
+   /// val_[ upd_target_[u] ] -= val_[ upd_left_[u] ] * val_[ upd_right_[u] ]
+   /// for u = upd_start_[p], ... , upd_start_[p+1] - 1
+   vector<size_t> upd_start_;
+   vector<size_t> upd_target_;
+   vector<size_t> upd_left_;
+   vector<size_t> upd_right_;
+   /// values for L + U
+   vector<Base> val_;
+   /// the most recent factor returned true
+   bool factor_ok_;
+   // -----------------------------------------------------------------------
+   /// index in col_ corresponding to row i and column j (which must exist)
+   size_t position(size_t i, size_t j) const
+   {  size_t lower = start_[i];
+      size_t upper = start_[i+1];
+      while( lower + 1 < upper )
+      {  size_t middle = (lower + upper) / 2;
+         if( j < col_[middle] )
+            upper = middle;
+         else
+            lower = middle;
+      }
+      CPPAD_ASSERT_UNKNOWN( col_[lower] == j );
+      return lower;
+   }
+public:
+   /// constructor
+   sparse_lu(void)
+   : n_(0), nnz_a_(0), factor_ok_(false)
+   {  CheckNumericType<Base>(); }
+   /// number of rows and columns in A
+   size_t n(void) const
+   {  return n_; }
+   /// number of possibly non-zero elements in L + U
+   size_t nnz(void) const
+   {  return col_.size(); }
+   // -----------------------------------------------------------------------
+   /// symbolic analysis
+   template <class SizeVector>
+   void analyze(
+      const sparse_rc<SizeVector>& pattern  ,
+      const std::string&           ordering )
+   {  CPPAD_ASSERT_KNOWN(
+         pattern.nr() == pattern.nc(),
+         "sparse_lu::analyze: pattern is not square"
+      );
+      CPPAD_ASSERT_KNOWN(
+         ordering == "natural" || ordering == "minimum_degree",
+         "sparse_lu::analyze: ordering is not natural or minimum_degree"
+      );
+      bool min_degree = ordering == "minimum_degree";
+      //
+      // n_, nnz_a_
+      n_     = pattern.nr();
+      nnz_a_ = pattern.nnz();
+      const SizeVector& row( pattern.row() );
+      const SizeVector& col( pattern.col() );
+      //
+      // adjacent
+      // graph corresponding to the pattern for A + A^T (without diagonal)
+      vector< std::set<size_t> > adjacent(n_);
+      for(size_t k = 0; k < nnz_a_; ++k)
+      {  size_t i = row[k];
+         size_t j = col[k];
+         CPPAD_ASSERT_KNOWN( i < n_ && j < n_,
+            "sparse_lu::analyze: pattern row or column index is too large"
+         );
+         if( i != j )
+         {  adjacent[i].insert(j);
+            adjacent[j].insert(i);
+         }
+      }
+      //
+      // degree_set
+      // (degree, index) for indices that have not been eliminated
+      std::set< std::pair<size_t, size_t> > degree_set;
+      if( min_degree )
+      {  for(size_t i = 0; i < n_; ++i)
+            degree_set.insert( std::make_pair(adjacent[i].size(), i) );
+      }
+      //
+      // perm_, inverse, eliminated
+      // eliminated[p] = original indices adjacent to pivot p when eliminated
+      perm_.resize(n_);
+      vector<size_t> inverse(n_);
+      vector< vector<size_t> > eliminated(n_);
+      for(size_t p = 0; p < n_; ++p)
+      {  size_t k = p;
+         if( min_degree )
+         {  k = degree_set.begin()->second;
+            degree_set.erase( degree_set.begin() );
+         }
+         perm_[p]   = k;
+         inverse[k] = p;
+         //
+         // eliminated[p]
+         const std::set<size_t>& clique( adjacent[k] );
+         eliminated[p].resize( clique.size() );
+         size_t ell = 0;
+         std::set<size_t>::const_iterator itr;
+         for(itr = clique.begin(); itr != clique.end(); ++itr)
+            eliminated[p][ell++] = *itr;
+         //
+         // eliminate k: its neighbors become a clique
+         for(ell = 0; ell < eliminated[p].size(); ++ell)
+         {  size_t i = eliminated[p][ell];
+            if( min_degree )
+               degree_set.erase( std::make_pair(adjacent[i].size(), i) );
+            adjacent[i].erase(k);
+            for(size_t m = 0; m < eliminated[p].size(); ++m)
+            {  size_t j = eliminated[p][m];
+               if( i != j )
+                  adjacent[i].insert(j);
+            }
+            if( min_degree )
+               degree_set.insert( std::make_pair(adjacent[i].size(), i) );
+         }
+         adjacent[k].clear();
+      }
+      //
+      // upper, lower
+      // column indices (permuted) above and below the diagonal in each row
+      vector< vector<size_t> > upper(n_), lower(n_);
+      for(size_t p = 0; p < n_; ++p)
+      {  size_t size = eliminated[p].size();
+         upper[p].resize(size);
+         for(size_t ell = 0; ell < size; ++ell)
+            upper[p][ell] = inverse[ eliminated[p][ell] ];
+         std::sort( upper[p].data(), upper[p].data() + size );
+         for(size_t ell = 0; ell < size; ++ell)
+            lower[ upper[p][ell] ].push_back(p);
+      }
+      //
+      // start_, col_, diag_
+      start_.resize(n_ + 1);
+      diag_.resize(n_);
+      start_[0] = 0;
+      for(size_t i = 0; i < n_; ++i)
+         start_[i+1] = start_[i] + lower[i].size() + 1 + upper[i].size();
+      col_.resize( start_[n_] );
+      for(size_t i = 0; i < n_; ++i)
+      {  size_t ell = start_[i];
+         for(size_t m = 0; m < lower[i].size(); ++m)
+            col_[ell++] = lower[i][m];
+         diag_[i]    = ell;
+         col_[ell++] = i;
+         for(size_t m = 0; m < upper[i].size(); ++m)
+            col_[ell++] = upper[i][m];
+         CPPAD_ASSERT_UNKNOWN( ell == start_[i+1] );
+      }
+      //
+      // a_index_
+      a_index_.resize(nnz_a_);
+      for(size_t k = 0; k < nnz_a_; ++k)
+         a_index_[k] = position( inverse[ row[k] ], inverse[ col[k] ] );
+      //
+      // div_start_, div_target_, upd_start_, upd_target_, upd_left_, upd_right_
+      // L + U has symmetric sparsity so the pattern for column p of L
+      // is the same as the pattern for row p of U
+      size_t n_div = 0;
+      size_t n_upd = 0;
+      for(size_t p = 0; p < n_; ++p)
+      {  n_div += upper[p].size();
+         n_upd += upper[p].size() * upper[p].size();
+      }
+      div_start_.resize(n_ + 1);
+      div_target_.resize(n_div);
+      upd_start_.resize(n_ + 1);
+      upd_target_.resize(n_upd);
+      upd_left_.resize(n_upd);
+      upd_right_.resize(n_upd);
+      size_t d = 0;
+      size_t u = 0;
+      for(size_t p = 0; p < n_; ++p)
+      {  div_start_[p] = d;
+         upd_start_[p] = u;
+         const vector<size_t>& index( upper[p] );
+         for(size_t ell = 0; ell < index.size(); ++ell)
+         {  size_t i    = index[ell];
+            size_t left = position(i, p);
+            div_target_[d++] = left;
+            for(size_t m = 0; m < index.size(); ++m)
+            {  size_t j = index[m];
+               upd_target_[u] = position(i, j);
+               upd_left_[u]   = left;
+               upd_right_[u]  = diag_[p] + 1 + m;
+               ++u;
+            }
+         }
+      }
+      div_start_[n_] = d;
+      upd_start_[n_] = u;
+      //
+      // val_
+      val_.resize( col_.size() );
+      factor_ok_ = false;
+   }
+   // -----------------------------------------------------------------------
+   /// numeric factorization
+   template <class SizeVector, class ValueVector>
+   bool factor(const sparse_rcv<SizeVector, ValueVector>& matrix)
+   {  CheckSimpleVector<Base, ValueVector>();
+      CPPAD_ASSERT_KNOWN(
+         matrix.nr() == n_ && matrix.nnz() == nnz_a_,
+         "sparse_lu::factor: matrix pattern is different from analyze pattern"
+      );
+      const ValueVector& a_val( matrix.val() );
+      //
+      // val_ = P A P^T
+      for(size_t ell = 0; ell < val_.size(); ++ell)
+         val_[ell] = Base(0.0);
+      for(size_t k = 0; k < nnz_a_; ++k)
+         val_[ a_index_[k] ] += a_val[k];
+      //
+      // val_ = L + U - I
+      factor_ok_ = false;
+      for(size_t p = 0; p < n_; ++p)
+      {  Base pivot = val_[ diag_[p] ];
+         if( pivot == Base(0.0) )
+            return false;
+         for(size_t d = div_start_[p]; d < div_start_[p+1]; ++d)
+            val_[ div_target_[d] ] /= pivot;
+         for(size_t u = upd_start_[p]; u < upd_start_[p+1]; ++u)
+            val_[ upd_target_[u] ] -=
+               val_[ upd_left_[u] ] * val_[ upd_right_[u] ];
+      }
+      factor_ok_ = true;
+      return true;
+   }
+   // -----------------------------------------------------------------------
+   /// solve A x = b using the most recent factorization
+   template <class ValueVector>
+   void solve(const ValueVector& b, ValueVector& x) const
+   {  CheckSimpleVector<Base, ValueVector>();
+      CPPAD_ASSERT_KNOWN(
+         factor_ok_,
+         "sparse_lu::solve: the most recent factor did not return true"
+      );
+      CPPAD_ASSERT_KNOWN(
+         size_t( b.size() ) == n_ && size_t( x.size() ) == n_,
+         "sparse_lu::solve: size of b or x is not equal to n"
+      );
+      //
+      // y = P b
+      vector<Base> y(n_);
+      for(size_t p = 0; p < n_; ++p)
+         y[p] = b[ perm_[p] ];
+      //
+      // y = L^{-1} y
+      for(size_t i = 0; i < n_; ++i)
+      {  for(size_t ell = start_[i]; ell < diag_[i]; ++ell)
+            y[i] -= val_[ell] * y[ col_[ell] ];
+      }
+      //
+      // y = U^{-1} y
+      for(size_t i = n_; i > 0; --i)
+      {  size_t d = diag_[i-1];
+         for(size_t ell = d + 1; ell < start_[i]; ++ell)
+            y[i-1] -= val_[ell] * y[ col_[ell] ];
+         y[i-1] /= val_[d];
+      }
+      //
+      // x = P^T y
+      for(size_t p = 0; p < n_; ++p)
+         x[ perm_[p] ] = y[p];
+   }
+};
+
+} // END_CPPAD_NAMESPACE
+
+# endif
@@ -131,6 +131,8 @@ private:
    struct thread_alloc_info {
       /// count of available bytes for this thread
       size_t  count_inuse_;
+      /// maximum of count_inuse_ since the last reset_inuse_max
+      size_t  count_inuse_max_;
       /// count of inuse bytes for this thread
       size_t  count_available_;
       /// root of available list for this thread and each capacity
@@ -236,6 +238,7 @@ private:
             info->root_available_[c].next_   = nullptr;
          }
          info->count_inuse_     = 0;
+         info->count_inuse_max_ = 0;
          info->count_available_ = 0;
       }
       return info;
@@ -267,6 +270,8 @@ private:
       CPPAD_ASSERT_UNKNOWN( result >= info->count_inuse_ );
 
       info->count_inuse_ = result;
+      if( info->count_inuse_max_ < result )
+         info->count_inuse_max_ = result;
    }
    // -----------------------------------------------------------------------
    /*!
@@ -1196,6 +1201,95 @@ Example
       return info->count_inuse_;
    }
 /* -----------------------------------------------------------------------
+{xrst_begin ta_inuse_max}
+
+Maximum Amount of Memory a Thread has Used
+##########################################
+
+Syntax
+******
+| *num_bytes* = ``thread_alloc::inuse_max`` ( *thread* )
+| ``thread_alloc::reset_inuse_max`` ( *thread* )
+
+Purpose
+*******
+The function ``inuse_max`` informs the program of the
+maximum value of :ref:`inuse<ta_inuse-name>` for the specified thread
+(the high-water mark) since the previous call to ``reset_inuse_max``
+for the thread.
+If there was no such call, it is the maximum since the thread
+first used ``thread_alloc`` .
+
+thread
+******
+This argument has prototype
+
+   ``size_t`` *thread*
+
+Either :ref:`thread_num<ta_thread_num-name>` must be the same as *thread* ,
+or the current execution mode must be sequential
+(not :ref:`parallel<ta_in_parallel-name>` ).
+
+num_bytes
+*********
+The return value has prototype
+
+   ``size_t`` *num_bytes*
+
+It is the maximum number of bytes that were in use at the same time
+by the specified thread.
+
+reset_inuse_max
+***************
+This sets the maximum to the number of bytes
+currently in use by the specified thread.
+
+Example
+*******
+:ref:`thread_alloc.cpp-name`
+
+{xrst_end ta_inuse_max}
+*/
+   /*!
+   Determine the maximum amount of memory that was inuse.
+
+   \param thread [in]
+   Thread for which we are determining the amount of memory
+   (must be < CPPAD_MAX_NUM_THREADS).
+   Durring parallel execution, this must be the thread
+   that is currently executing.
+
+   \return
+   The maximum amount of memory in bytes since the last reset_inuse_max.
+   */
+   static size_t inuse_max(size_t thread)
+   {
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN(
+         thread == thread_num() || (! in_parallel())
+      );
+      thread_alloc_info* info = thread_info(thread);
+      return info->count_inuse_max_;
+   }
+   /*!
+   Set the maximum amount of memory inuse to the current amount inuse.
+
+   \param thread [in]
+   Thread for which we are resetting the maximum
+   (must be < CPPAD_MAX_NUM_THREADS).
+   Durring parallel execution, this must be the thread
+   that is currently executing.
+   */
+   static void reset_inuse_max(size_t thread)
+   {
+      CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+      CPPAD_ASSERT_UNKNOWN(
+         thread == thread_num() || (! in_parallel())
+      );
+      thread_alloc_info* info = thread_info(thread);
+      info->count_inuse_max_  = info->count_inuse_;
+   }
+/* -----------------------------------------------------------------------
 {xrst_begin ta_available}
 
 Amount of Memory Available for Quick Use by a Thread
@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_abs_normal}
+
+Speed Test qp_interior_sparse Using a Piecewise Linear Problem
+##############################################################
+
+Syntax
+******
+``speed/abs_normal/speed_abs_normal`` [ *N* ]
+
+Purpose
+*******
+This program compares the speed of
+:ref:`qp_interior-name` and :ref:`qp_interior_sparse-name`
+for the piecewise linear problem in :ref:`qp_interior_sparse.cpp-name`
+(which has :math:`N` original variables).
+
+N
+*
+is the number of original variables in the piecewise linear problem.
+The default value is 10000.
+The ``qp_interior`` method is only run with
+:math:`\min(N, 100)` original variables because its
+computation time is proportional to the cube of the number of variables.
+
+Output
+******
+For each method and size this program prints
+
+.. csv-table::
+   :widths: auto
+
+   method,the dense or sparse method
+   N,number of original variables
+   n,number of variables in the quadratic program (3 * N)
+   seconds,time to solve the quadratic program
+   objective,value of the original objective at the solution
+
+Correctness
+***********
+The program returns zero (one) if both methods converge and
+obtain the same objective value (otherwise).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_abs_normal}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/sparse_rcv.hpp>
+# include <cppad/utility/elapsed_seconds.hpp>
+# include "../../example/abs_normal/qp_interior.hpp"
+# include "../../example/abs_normal/qp_interior_sparse.hpp"
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// d_vector, s_vector, sparse_matrix
+typedef CppAD::vector<double>                 d_vector;
+typedef CppAD::vector<size_t>                 s_vector;
+typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+//
+// problem
+// quadratic program for minimizing, with respect to x,
+//    sum_i | x_i - t_i | + sum_i | x_{i+1} - x_i |
+// see example/abs_normal/qp_interior_sparse.cpp
+struct problem {
+   size_t        N;
+   d_vector      t, c, g, xin;
+   sparse_matrix C, G;
+};
+problem create_problem(size_t N)
+{  problem p;
+   p.N = N;
+   size_t n = 3 * N;
+   size_t m = 4 * N - 1;
+   //
+   // t
+   p.t.resize(N);
+   for(size_t i = 0; i < N; ++i)
+      p.t[i] = double( (i * 7919) % 101 ) / 10.0;
+   //
+   // C, c
+   size_t nnz = 4 * N + 6 * (N - 1) + 1;
+   CppAD::sparse_rc<s_vector> C_pattern(m, n, nnz);
+   d_vector C_val(nnz);
+   p.c.resize(m);
+   size_t k = 0, r = 0;
+   for(size_t i = 0; i < N; ++i)
+   {  size_t x_i = 3 * i, v_i = 3 * i + 1, u_i = 3 * i + 2;
+      C_pattern.set(k, r, x_i); C_val[k++] =  1.0;
+      C_pattern.set(k, r, v_i); C_val[k++] = -1.0;
+      p.c[r++] = - p.t[i];
+      C_pattern.set(k, r, x_i); C_val[k++] = -1.0;
+      C_pattern.set(k, r, v_i); C_val[k++] = -1.0;
+      p.c[r++] = p.t[i];
+      if( i + 1 < N )
+      {  size_t x_ip = 3 * (i + 1);
+         C_pattern.set(k, r, x_ip); C_val[k++] =  1.0;
+         C_pattern.set(k, r, x_i);  C_val[k++] = -1.0;
+         C_pattern.set(k, r, u_i);  C_val[k++] = -1.0;
+         p.c[r++] = 0.0;
+         C_pattern.set(k, r, x_ip); C_val[k++] = -1.0;
+         C_pattern.set(k, r, x_i);  C_val[k++] =  1.0;
+         C_pattern.set(k, r, u_i);  C_val[k++] = -1.0;
+         p.c[r++] = 0.0;
+      }
+      else
+      {  C_pattern.set(k, r, u_i); C_val[k++] = -1.0;
+         p.c[r++] = 0.0;
+      }
+   }
+   p.C = sparse_matrix(C_pattern);
+   for(k = 0; k < nnz; ++k)
+      p.C.set(k, C_val[k]);
+   //
+   // G = 0, g
+   CppAD::sparse_rc<s_vector> G_pattern(n, n, 0);
+   p.G = sparse_matrix(G_pattern);
+   p.g.resize(n);
+   for(size_t i = 0; i < N; ++i)
+   {  p.g[3 * i]     = 0.0;
+      p.g[3 * i + 1] = 1.0;
+      p.g[3 * i + 2] = 1.0;
+   }
+   //
+   // xin
+   p.xin.resize(n);
+   for(size_t i = 0; i < N; ++i)
+   {  p.xin[3 * i]     = p.t[i];
+      p.xin[3 * i + 1] = 1.0;
+      p.xin[3 * i + 2] = 1.0;
+      if( i + 1 < N )
+         p.xin[3 * i + 2] += std::fabs( p.t[i+1] - p.t[i] );
+   }
+   return p;
+}
+//
+// objective
+double objective(const problem& p, const d_vector& x)
+{  double obj = 0.0;
+   for(size_t i = 0; i < p.N; ++i)
+   {  obj += std::fabs( x[3 * i] - p.t[i] );
+      if( i + 1 < p.N )
+         obj += std::fabs( x[3 * (i+1)] - x[3 * i] );
+   }
+   return obj;
+}
+//
+// solve
+// returns the objective value at the solution and sets seconds and ok
+double solve(const problem& p, bool sparse, double& seconds, bool& ok)
+{  size_t n = p.g.size();
+   size_t m = p.c.size();
+   double epsilon = 1e-6;
+   size_t maxitr  = 100;
+   size_t level   = 0;
+   d_vector xout(n), yout(m), sout(m);
+   double start = CppAD::elapsed_seconds();
+   if( sparse ) ok = CppAD::qp_interior_sparse(
+      level, p.c, p.C, p.g, p.G, epsilon, maxitr, p.xin, xout, yout, sout
+   );
+   else
+   {  d_vector C(m * n), G(n * n);
+      for(size_t ell = 0; ell < m * n; ++ell)
+         C[ell] = 0.0;
+      for(size_t ell = 0; ell < n * n; ++ell)
+         G[ell] = 0.0;
+      for(size_t k = 0; k < p.C.nnz(); ++k)
+         C[ p.C.row()[k] * n + p.C.col()[k] ] = p.C.val()[k];
+      ok = CppAD::qp_interior(
+         level, p.c, C, p.g, G, epsilon, maxitr, p.xin, xout, yout, sout
+      );
+   }
+   seconds = CppAD::elapsed_seconds() - start;
+   return objective(p, xout);
+}
+//
+// print_line
+void print_line(
+   const char* method, size_t N, double seconds, double obj, bool ok
+)
+{  std::printf(
+      "method = %-6s, N = %6d, n = %6d, seconds = %8.3f, "
+      "objective = %12.6f%s\n",
+      method, int(N), int(3 * N), seconds, obj,
+      ok ? "" : ", did not converge"
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // N
+   size_t N = 10000;
+   if( argc > 1 )
+      N = size_t( std::atol( argv[1] ) );
+   if( N < 2 )
+   {  std::fprintf(stderr, "speed_abs_normal: N is less than two\n");
+      return 1;
+   }
+   size_t N_dense = std::min(N, size_t(100) );
+   //
+   // compare dense and sparse on the small problem
+   problem p_dense = create_problem(N_dense);
+   double  seconds;
+   bool    ok_solve;
+   double  obj_dense = solve(p_dense, false, seconds, ok_solve);
+   ok &= ok_solve;
+   print_line("dense", N_dense, seconds, obj_dense, ok_solve);
+   double  obj_sparse = solve(p_dense, true, seconds, ok_solve);
+   ok &= ok_solve;
+   print_line("sparse", N_dense, seconds, obj_sparse, ok_solve);
+   ok &= CppAD::NearEqual(obj_dense, obj_sparse, 1e-6, 1e-6);
+   //
+   // sparse on the large problem
+   if( N_dense < N )
+   {  problem p = create_problem(N);
+      obj_sparse = solve(p, true, seconds, ok_solve);
+      ok &= ok_solve;
+      print_line("sparse", N, seconds, obj_sparse, ok_solve);
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_cond_exp}
+
+Speed Test CondExpSwitch Versus Nested CondExpLt
+################################################
+
+Syntax
+******
+``speed/cond_exp/speed_cond_exp`` [ *n_eval* [ *n_piece* ] ]
+
+Purpose
+*******
+This program compares different ways of recording the piecewise function
+
+.. math::
+
+   f(x) = \sin( x + k ) \exp( x / (k + 1) ) \; \R{for} \; k \leq x < k + 1
+
+for :math:`k = 0 , \ldots , K-1` where :math:`K` is *n_piece*
+(the first piece also includes :math:`x < 0`
+and the last piece also includes :math:`K \leq x` ).
+The methods are:
+
+nested
+======
+A sequence of nested :ref:`CondExpLt<CondExp-name>` operations;
+i.e., the first comparison selects piece zero
+or the result of the rest of the sequence.
+
+switch
+======
+The :ref:`CondExpSwitch-name` function.
+
+For each method, the function is evaluated with and without
+:ref:`optimizing<optimize-name>` the recording.
+Each evaluation is a zero order :ref:`forward_zero-name` ,
+followed by a first order :ref:`reverse_one-name` ,
+at a point that is chosen so that all the pieces are used.
+
+n_eval
+******
+is the number of evaluations for each method.
+The default value is 10000.
+
+n_piece
+*******
+is the number of pieces in the function.
+The default value is 100.
+
+Output
+******
+For each method this program prints
+
+.. csv-table::
+   :widths: auto
+
+   method,nested or switch
+   optimize,false (true) if the recording was not (was) optimized
+   size_var,number of variables in the recording
+   skip,average value of :ref:`number_skip-name` for the evaluations
+   seconds,time for all the evaluations
+
+Correctness
+***********
+The program returns zero (one) if the values and derivatives
+computed by the different methods agree (do not agree)
+with the known results.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_cond_exp}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// a_double, d_vector, a_vector
+typedef CppAD::AD<double>       a_double;
+typedef CppAD::vector<double>   d_vector;
+typedef CppAD::vector<a_double> a_vector;
+//
+// piece
+// value of the piecewise function for piece k
+template <class Scalar>
+Scalar piece(size_t k, const Scalar& x)
+{  return sin( x + double(k) ) * exp( x / double(k + 1) );
+}
+//
+// piece_derivative
+// derivative of piece(k, x) with respect to x
+double piece_derivative(size_t k, double x)
+{  double e = exp( x / double(k + 1) );
+   return cos( x + double(k) ) * e + sin( x + double(k) ) * e / double(k + 1);
+}
+//
+// record
+void record(const char* method, size_t n_piece, CppAD::ADFun<double>& f)
+{  std::string name(method);
+   //
+   // ax
+   a_vector ax(1), ay(1);
+   ax[0] = 0.5;
+   CppAD::Independent(ax);
+   //
+   // breakpoint, value
+   a_vector breakpoint(n_piece - 1), value(n_piece);
+   for(size_t k = 0; k < n_piece; ++k)
+   {  value[k] = piece(k, ax[0]);
+      if( k + 1 < n_piece )
+         breakpoint[k] = double(k + 1);
+   }
+   //
+   // ay
+   if( name == "switch" )
+      ay[0] = CppAD::CondExpSwitch(ax[0], breakpoint, value);
+   else
+   {  ay[0] = value[n_piece - 1];
+      for(size_t k = n_piece - 1; k > 0; --k)
+         ay[0] = CppAD::CondExpLt(ax[0], breakpoint[k-1], value[k-1], ay[0]);
+   }
+   f.Dependent(ax, ay);
+}
+//
+// print_line
+void print_line(
+   const char* method   ,
+   bool        optimize ,
+   size_t      size_var ,
+   double      skip     ,
+   double      seconds  ,
+   bool        ok       )
+{  std::printf(
+      "method = %-6s, optimize = %-5s, size_var = %6d, "
+      "skip = %8.1f, seconds = %8.3f%s\n",
+      method, optimize ? "true" : "false", int(size_var), skip, seconds,
+      ok ? "" : ", check failed"
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_eval, n_piece
+   size_t n_eval  = 10000;
+   size_t n_piece = 100;
+   if( argc > 1 )
+      n_eval = size_t( std::atol( argv[1] ) );
+   if( argc > 2 )
+      n_piece = size_t( std::atol( argv[2] ) );
+   if( n_eval == 0 || n_piece == 0 )
+   {  std::fprintf(stderr, "speed_cond_exp: n_eval or n_piece is zero\n");
+      return 1;
+   }
+   //
+   const char* method_list[] = { "nested", "switch" };
+   for(size_t i_method = 0; i_method < 2; ++i_method)
+   for(size_t i_optimize = 0; i_optimize < 2; ++i_optimize)
+   {  const char* method   = method_list[i_method];
+      bool        optimize = i_optimize == 1;
+      //
+      // f
+      CppAD::ADFun<double> f;
+      record(method, n_piece, f);
+      if( optimize )
+         f.optimize();
+      //
+      // x, w
+      d_vector x(1), w(1);
+      w[0] = 1.0;
+      //
+      double skip    = 0.0;
+      bool   ok_eval = true;
+      double start   = CppAD::elapsed_seconds();
+      for(size_t i_eval = 0; i_eval < n_eval; ++i_eval)
+      {  // x[0] cycles through all the pieces
+         size_t k  = i_eval % n_piece;
+         x[0]      = double(k) + double(i_eval % 7 + 1) / 8.0;
+         d_vector y  = f.Forward(0, x);
+         d_vector dw = f.Reverse(1, w);
+         skip     += double( f.number_skip() );
+         //
+         ok_eval &= CppAD::NearEqual(y[0], piece(k, x[0]), 1e-10, 1e-10);
+         ok_eval &= CppAD::NearEqual(
+            dw[0], piece_derivative(k, x[0]), 1e-10, 1e-10
+         );
+      }
+      double seconds = CppAD::elapsed_seconds() - start;
+      skip          /= double(n_eval);
+      ok            &= ok_eval;
+      //
+      print_line(method, optimize, f.size_var(), skip, seconds, ok_eval);
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
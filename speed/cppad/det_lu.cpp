@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_det_lu.cpp}
@@ -19,6 +19,7 @@ Implementation
 # include <cppad/speed/det_by_lu.hpp>
 # include <cppad/speed/uniform_01.hpp>
 # include <cppad/cppad.hpp>
+# include <cppad/core/atomic/linalg/linalg.hpp>
 
 // Note that CppAD uses global_option["memory"] at the main program level
 # include <map>
@@ -35,7 +36,7 @@ bool link_det_lu(
 
    // --------------------------------------------------------------------
    // check global options
-   const char* valid[] = { "memory", "optimize", "val_graph"};
+   const char* valid[] = { "memory", "optimize", "atomic", "val_graph"};
    size_t n_valid = sizeof(valid) / sizeof(valid[0]);
    typedef std::map<std::string, bool>::iterator iterator;
    //
@@ -67,6 +68,11 @@ bool link_det_lu(
    ADVector   detA(m);     // AD range space vector
    CppAD::ADFun<double> f; // AD function object
 
+   // atomic function information
+   CppAD::vector<ADScalar> alog_det(2);
+   CppAD::atomic_linalg<double> linalg("linalg");
+   size_t call_id = linalg.set_log_det(size);
+
    // vectors of reverse mode weights
    CppAD::vector<double> w(1);
    w[0] = 1.;
@@ -86,7 +92,13 @@ bool link_det_lu(
       Independent(A, abort_op_index, record_compare);
 
       // AD computation of the determinant
-      detA[0] = Det(A);
+      if( ! global_option["atomic"] )
+         detA[0] = Det(A);
+      else
+      {  // det(A) = sign * exp( log | det(A) | )
+         linalg(call_id, A, alog_det);
+         detA[0] = alog_det[1] * exp( alog_det[0] );
+      }
 
       // create function object f : A -> detA
       f.Dependent(A, detA);
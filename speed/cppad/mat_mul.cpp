@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_mat_mul.cpp}
@@ -20,7 +20,7 @@ Implementation
 # include <cppad/cppad.hpp>
 # include <cppad/speed/mat_sum_sq.hpp>
 # include <cppad/speed/uniform_01.hpp>
-# include <cppad/example/atomic_four/mat_mul/mat_mul.hpp>
+# include <cppad/core/atomic/linalg/linalg.hpp>
 
 // Note that CppAD uses global_option["memory"] at the main program level
 # include <map>
@@ -79,7 +79,8 @@ bool link_mat_mul(
 
    // atomic function information
    CppAD::vector<ADScalar> ax(2 * n), ay(n);
-   CppAD::atomic_mat_mul<double> atom_mul("atom_mul");
+   CppAD::atomic_linalg<double> linalg("linalg");
+   size_t call_id = linalg.set_mat_mul(size, size, size);
    //
    // do not even record comparison operators
    size_t abort_op_index = 0;
@@ -104,8 +105,7 @@ bool link_mat_mul(
             ax[n + j] = X[j];
          }
          // Y = X * X
-         size_t call_id = atom_mul.set(size, size, size);
-         atom_mul(call_id, ax, ay);
+         linalg(call_id, ax, ay);
          Z[0] = 0.;
          for(j = 0; j < n; j++)
             Z[0] += ay[j];
@@ -141,7 +141,7 @@ bool link_mat_mul(
             ax[j+n] = X[j];
          }
          // Y = X * X
-         atom_mul(ax, ay);
+         linalg(call_id, ax, ay);
          Z[0] = 0.;
          for(j = 0; j < n; j++)
             Z[0] += ay[j];
@@ -168,7 +168,7 @@ bool link_mat_mul(
    size_t thread                   = CppAD::thread_alloc::thread_num();
    global_cppad_thread_alloc_inuse = CppAD::thread_alloc::inuse(thread);
    // --------------------------------------------------------------------
-   // Free temporary work space (any future atomic_mat_mul constructors
+   // Free temporary work space (any future atomic_linalg constructors
    // would create new temporary work space.)
    CppAD::user_atomic<double>::clear();
    // --------------------------------------------------------------------
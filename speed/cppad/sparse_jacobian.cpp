@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 /*
 {xrst_begin cppad_sparse_jacobian.cpp}
@@ -151,10 +151,9 @@ namespace {
       size_t group_max = 25;
       //
       if( global_option["subgraph"] )
-      {  // This would cache some information in f,  but would it enough ?
-         // The time it takes to compute derivatives that are not used
-         // slows down the test when onetape is false.
-         // f.subgraph_jac_rev(x, ac_subset);
+      {  // Cache the subgraph for each row of the Jacobian in f
+         // (they are computed during the first subgraph_jac_rev call).
+         f.subgraph_cache(true);
       }
       else
       {  // need full sparsity pattern
@@ -1,10 +1,7 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
-# include <cstring>
-# include <cppad/utility/vector.hpp>
-
 /*
 {xrst_begin cppad_jit_sparse_jacobian.cpp}
 
@@ -15,9 +12,177 @@ Specifications
 **************
 :ref:`link_sparse_jacobian-name`
 
+Implementation
+**************
+The C source code for the sparse Jacobian is created using
+:ref:`to_csrc@derivative` equal to ``sparse_jac_for`` .
+
 {xrst_spell_off}
 {xrst_code cpp} */
-// A cppad_jit version of this test is not yet available
+# include <map>
+# include <cppad/cppad.hpp>
+# include <cppad/speed/uniform_01.hpp>
+# include <cppad/speed/sparse_jac_fun.hpp>
+extern std::map<std::string, bool> global_option;
+
+# ifdef _WIN32
+# define DLL_EXT ".dll"
+# else
+# define DLL_EXT ".so"
+# endif
+
+# if ! (CPPAD_C_COMPILER_GNU_FLAGS || CPPAD_C_COMPILER_MSVC_FLAGS )
+bool link_sparse_jacobian(
+   const std::string&               job      ,
+   size_t                           size     ,
+   size_t                           repeat   ,
+   size_t                           m        ,
+   const CppAD::vector<size_t>&     row      ,
+   const CppAD::vector<size_t>&     col      ,
+   CppAD::vector<double>&           x        ,
+   CppAD::vector<double>&           jacobian ,
+   size_t&                          n_color  )
+{  return false; }
+# else
+namespace {
+   //
+   // using
+   using std::string;
+   using CppAD::vector;
+   //
+   // typedefs
+   typedef CppAD::AD<double>              a_double;
+   typedef vector<size_t>                 s_vector;
+   typedef vector<double>                 d_vector;
+   typedef vector<a_double>               a_vector;
+   typedef CppAD::sparse_rc<s_vector>     sparsity;
+   //
+   // get_function_ptr
+   CppAD::jit_double get_function_ptr(
+      CppAD::link_dll_lib* dll_linker )
+   {  std::string function_name = "cppad_jit_sparse_jacobian_sparse_jac_for";
+      string err_msg;
+      void* void_ptr = (*dll_linker)(function_name, err_msg);
+      if( err_msg != "" )
+      {  std::cerr << "link_sparse_jacobian: err_msg = " << err_msg << "\n";
+         return nullptr;
+      }
+      CppAD::jit_double function_ptr =
+            reinterpret_cast<CppAD::jit_double>(void_ptr);
+      return function_ptr;
+   }
+   //
+   // setup
+   CppAD::link_dll_lib* setup(
+      // inputs
+      size_t                  size      ,
+      size_t                  m         ,
+      const s_vector&         row       ,
+      const s_vector&         col       ,
+      // outputs
+      size_t&                 nnz_all   ,
+      s_vector&               subset2all )
+   {  // optimization options
+      string optimize_options =
+         "no_conditional_skip no_compare_op no_print_for_op";
+      //
+      // nc, nr
+      size_t nc = size;
+      size_t nr = m;
+      //
+      // x, a_x
+      a_vector a_x(nc);
+      d_vector x(nc);
+      CppAD::uniform_01(nc, x);
+      for(size_t j = 0; j < nc; j++)
+         a_x[j] = x[j];
+      //
+      // Independent
+      size_t abort_op_index = 0;
+      bool record_compare   = false;
+      CppAD::Independent(a_x, abort_op_index, record_compare);
+      //
+      // a_y
+      a_vector a_y(nr);
+      size_t order = 0;
+      CppAD::sparse_jac_fun<a_double>(nr, nc, a_x, row, col, order, a_y);
+      //
+      // f
+      CppAD::ADFun<double> f;
+      f.Dependent(a_x, a_y);
+      if( global_option["optimize"] )
+         f.optimize(optimize_options);
+      f.function_name_set("sparse_jacobian");
+      //
+      // pattern
+      // sparsity pattern for the entire Jacobian
+      // (could use row, col, but pretend we do not know that)
+      sparsity identity(nc, nc, nc), pattern;
+      for(size_t k = 0; k < nc; ++k)
+         identity.set(k, k, k);
+      bool transpose     = false;
+      bool dependency    = false;
+      bool internal_bool = global_option["boolsparsity"];
+      f.for_jac_sparsity(
+         identity, transpose, dependency, internal_bool, pattern
+      );
+      //
+      // nnz_all, subset2all
+      // map from the subset (row, col) to the entire pattern
+      nnz_all = pattern.nnz();
+      std::map<size_t, size_t> index_map;
+      for(size_t ell = 0; ell < nnz_all; ++ell)
+         index_map[ pattern.row()[ell] * nc + pattern.col()[ell] ] = ell;
+      subset2all.resize( row.size() );
+      for(size_t k = 0; k < row.size(); ++k)
+         subset2all[k] = index_map[ row[k] * nc + col[k] ];
+      //
+      // coloring
+      string coloring = "cppad";
+# if CPPAD_HAS_COLPACK
+      if( global_option["colpack"] )
+         coloring = "colpack";
+# endif
+      //
+      // csrc_file
+      // Use forward mode because m > n (same as cppad sparse_jacobian)
+      string type      = "double";
+      string csrc_file = "sparse_jacobian.c";
+      std::ofstream ofs;
+      ofs.open(csrc_file, std::ofstream::out);
+      f.to_csrc(ofs, type, "sparse_jac_for", pattern, coloring);
+      ofs.close();
+      //
+      // dll_file
+      string dll_file = "sparse_jacobian" DLL_EXT;
+      CppAD::vector< string > csrc_files(1);
+      csrc_files[0] = csrc_file;
+      std::map< string, string > dll_options;
+# if CPPAD_C_COMPILER_MSVC_FLAGS
+      dll_options["compile"] = CPPAD_C_COMPILER_CMD " /EHs /EHc /c /TC /O2";
+# endif
+# if CPPAD_C_COMPILER_GNU_FLAGS
+      dll_options["compile"] = "gcc -c -fPIC -O2";
+# endif
+      string err_msg =
+         CppAD::create_dll_lib(dll_file, csrc_files, dll_options);
+      if( err_msg != "" )
+      {  std::cerr << "link_sparse_jacobian: err_msg = " << err_msg << "\n";
+         return nullptr;
+      }
+      //
+      // dll_linker_ptr
+      CppAD::link_dll_lib* dll_linker_ptr =
+         new CppAD::link_dll_lib(dll_file, err_msg);
+      if( err_msg != "" )
+      {  std::cerr << "link_sparse_jacobian: err_msg = " << err_msg << "\n";
+         delete dll_linker_ptr;
+         return nullptr;
+      }
+      return dll_linker_ptr;
+   }
+}
+
 bool link_sparse_jacobian(
    const std::string&               job      ,
    size_t                           size     ,
@@ -28,9 +193,119 @@ bool link_sparse_jacobian(
    CppAD::vector<double>&           x        ,
    CppAD::vector<double>&           jacobian ,
    size_t&                          n_color  )
-{
-   return false;
+{  // --------------------------------------------------------------------
+   // check global options
+   const char* valid[] = { "onetape", "optimize", "boolsparsity"
+# if CPPAD_HAS_COLPACK
+      , "colpack"
+# endif
+   };
+   size_t n_valid = sizeof(valid) / sizeof(valid[0]);
+   typedef std::map<string, bool>::iterator iterator;
+   //
+   for(iterator itr=global_option.begin(); itr!=global_option.end(); ++itr)
+   {  if( itr->second )
+      {  bool ok = false;
+         for(size_t i = 0; i < n_valid; i++)
+            ok |= itr->first == valid[i];
+         if( ! ok )
+            return false;
+      }
+   }
+   // --------------------------------------------------------------------
+   // pointer to dll linker
+   static CppAD::link_dll_lib* static_dll_linker = nullptr;
+   //
+   // pointer to sparse jacobian function
+   static CppAD::jit_double static_sparse_jacobian = nullptr;
+   //
+   // size corresponding static_sparse_jacobian
+   static size_t static_size = 0;
+   //
+   // number of elements in entire sparsity pattern
+   static size_t static_nnz_all = 0;
+   //
+   // map from (row, col) subset to the entire sparsity pattern
+   static s_vector static_subset2all;
+   //
+   // value of the Jacobian for the entire sparsity pattern
+   static d_vector static_jac_all;
+   //
+   // n_color is not computed by this package
+   n_color = 0;
+   //
+   // onetape
+   bool onetape = global_option["onetape"];
+   // ----------------------------------------------------------------------
+   if( job == "setup" )
+   {  if( onetape )
+      {  if( static_dll_linker != nullptr )
+            delete static_dll_linker;
+         static_dll_linker = setup(
+            size, m, row, col, static_nnz_all, static_subset2all
+         );
+         if( static_dll_linker == nullptr )
+            return false;
+         //
+         static_sparse_jacobian = get_function_ptr(static_dll_linker);
+         static_size            = size;
+         if( static_sparse_jacobian == nullptr )
+            return false;
+      }
+      else
+      {  static_sparse_jacobian = nullptr;
+         static_size            = 0;
+      }
+      return true;
+   }
+   if( job ==  "teardown" )
+   {  if( static_dll_linker != nullptr )
+      {  delete static_dll_linker;
+         static_dll_linker = nullptr;
+      }
+      static_subset2all.clear();
+      static_jac_all.clear();
+      return true;
+   }
+   // -----------------------------------------------------------------------
+   CPPAD_ASSERT_UNKNOWN( job == "run" );
+   size_t nnz = row.size();
+   while(repeat--)
+   {  if( onetape )
+      {  // use if before assert to avoid warning that static_size is not used
+         if( size != static_size )
+         {  CPPAD_ASSERT_UNKNOWN( size == static_size );
+         }
+      }
+      else
+      {  if( static_dll_linker != nullptr )
+            delete static_dll_linker;
+         static_dll_linker = setup(
+            size, m, row, col, static_nnz_all, static_subset2all
+         );
+         if( static_dll_linker == nullptr )
+            return false;
+         //
+         static_sparse_jacobian = get_function_ptr(static_dll_linker);
+         static_size            = size;
+         if( static_sparse_jacobian == nullptr )
+            return false;
+      }
+      // choose a value for x
+      CppAD::uniform_01(size, x);
+      //
+      // evaluate the sparse Jacobian
+      static_jac_all.resize(static_nnz_all);
+      size_t compare_change = 0;
+      static_sparse_jacobian(
+         size, x.data(), static_nnz_all, static_jac_all.data(), &compare_change
+      );
+      for(size_t k = 0; k < nnz; ++k)
+         jacobian[k] = static_jac_all[ static_subset2all[k] ];
+   }
+   return true;
 }
+# endif // CPPAD_C_COMPILER_GNU_FLAGS || CPPAD_C_COMPILER_MSVC_FLAGS
 /* {xrst_code}
 {xrst_spell_on}
 
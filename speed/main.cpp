@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cstring>
@@ -10,6 +10,8 @@
 # include <iostream>
 # include <iomanip>
 # include <map>
+# include <string>
+# include <vector>
 # include <cppad/utility/vector.hpp>
 # include <cppad/speed/det_grad_33.hpp>
 # include <cppad/speed/det_33.hpp>
@@ -17,6 +19,7 @@
 # include <cppad/utility/poly.hpp>
 # include <cppad/utility/track_new_del.hpp>
 # include <cppad/utility/thread_alloc.hpp>
+# include "src/speed_result.hpp"
 
 # ifdef CPPAD_ADOLC_SPEED
 # define AD_PACKAGE "adolc"
@@ -49,14 +52,23 @@
 /*
 {xrst_begin speed_main}
 {xrst_spell
+   arrowhead
    boolsparsity
+   csv
+   jit
+   json
+   kkt
+   mad
    onetape
    optionlist
+   pde
+   regressions
    retaped
    revsparsity
    subgraphs
    subsparsity
    underbar
+   warmup
 }
 
 Running the Speed Test Program
@@ -64,12 +76,16 @@ Running the Speed Test Program
 
 Syntax
 ******
-``speed/`` *package* / ``speed_`` *package* *test* *seed* *option_list*
+| ``speed/`` *package* / ``speed_`` *package* *test* *seed* *option_list*
+| ``speed/`` *package* / ``speed_`` *package* ``compare``
+| |tab| *old_file* *new_file* [ *threshold* ]
 
 Purpose
 *******
 A version of this program runs the correctness tests
 or the speed tests for one AD package identified by *package* .
+The second syntax compares two result files; see
+:ref:`speed_main@compare` below.
 
 package
 *******
@@ -214,10 +230,10 @@ the optimization of the operation sequence.
 atomic
 ======
 If this option is present,
-CppAD will use a user defined
-:ref:`atomic<atomic_two-name>` operation is used for the test.
+CppAD will use an :ref:`atomic_linalg-name` operation for the test.
 So far, CppAD has only implemented
-the :ref:`mat_mul<link_mat_mul-name>` test as an atomic operation.
+the :ref:`mat_mul<link_mat_mul-name>` and
+:ref:`det_lu<link_det_lu-name>` tests using atomic operations.
 
 hes2jac
 =======
@@ -286,6 +302,101 @@ The CppAD
 :ref:`sparse_hessian<link_sparse_hessian-name>` test
 is implemented for this option.
 
+Settings
+********
+The *option_list* can also contain settings that have the form
+*name* ``=`` *value* (with no spaces).
+They control how the speed tests are run and are not included in
+*optionlist* (see below).
+
+warmup
+======
+The setting ``warmup=`` *n* specifies the number of un-timed calls
+for each test size that are made before the timed calls.
+The default value for *n* is zero.
+
+repeat
+======
+The setting ``repeat=`` *n* specifies the number of timed calls
+for each test size.
+The default value for *n* is one.
+The rate reported for each size is the median of the rates for the timed
+calls.
+If *n* is greater than one, the median absolute deviation of the rates is
+also reported.
+
+time_min
+========
+The setting ``time_min=`` *seconds* specifies the minimum time for
+each timed call (the test is repeated within the call until this time
+is reached). The default value for *seconds* is one.
+
+json
+====
+The setting ``json=`` *file_name* specifies a JSON file where the
+results for each speed test and size are written; see :ref:`speed_result-name` .
+The results for a test, options, and size replace the corresponding
+results in the file (if they exist) and the other results in the file
+are kept.
+Hence one file can accumulate the results for all the tests and
+all the option combinations by running this program once for each
+option combination.
+
+csv
+===
+The setting ``csv=`` *file_name* is the same as ``json`` except that the
+results are written in CSV format.
+
+pattern
+=======
+The setting ``pattern=`` *name* selects the sparsity pattern used by the
+:ref:`sparse_jacobian<link_sparse_jacobian-name>` and
+:ref:`sparse_hessian<link_sparse_hessian-name>` tests.
+The default value ``random`` corresponds to small randomly generated patterns.
+The other values, ``pde2`` , ``pde3`` , ``kkt`` and ``arrow`` ,
+have the structure of large scale problems
+(2D and 3D finite difference PDE residuals, optimal control KKT systems,
+and arrowhead problems); see :ref:`speed_sparse_pattern-name` .
+If *name* is not ``random`` , ``_`` *name* is appended to *test*
+in the speed results and in the result files; e.g.,
+``sparse_jacobian_pde2`` .
+
+size_max
+========
+The setting ``size_max=`` *n* changes the sizes for the
+sparse_jacobian and sparse_hessian tests to
+*n* / 10^4 , ..., *n* / 10 , *n*
+(only the sizes greater than or equal 100 are included).
+The value *n* must be greater than or equal 100.
+For example, the following command uses up to :math:`10^7` variables:
+
+| |tab| ``speed/cppad_jit/speed_cppad_jit sparse_jacobian 123``
+| |tab| |tab| ``pattern=pde3 size_max=10000000``
+
+The jit package compiles the C source code for the Jacobian
+so its setup time grows quickly with the size.
+
+memory
+======
+Each result includes the maximum amount of memory that was in use
+during the calls for the corresponding test and size.
+This is the :ref:`thread_alloc::inuse_max<ta_inuse_max-name>` value
+minus the amount in use at the start of the calls.
+It only includes memory allocated using ``thread_alloc`` ; e.g.,
+the memory used by CppAD and by :ref:`CppAD::vector<CppAD_vector-name>` .
+
+compare
+*******
+If *test* is ``compare`` , the results in the files
+*old_file* and *new_file* are compared.
+Each of these files was created using the ``json`` or ``csv`` setting.
+A line is printed for each test, option list and size that is in both files.
+A result is marked as a regression if its rate decreased by more than
+the relative amount *threshold* or its memory increased by more than
+the relative amount *threshold* .
+The default value for *threshold* is 0.1 .
+The program returns one (zero) if there are (are not) any regressions.
+
 Correctness Results
 *******************
 One, but not both, of the following two output lines
@@ -330,8 +441,20 @@ colors used for each sparse Jacobian (Hessian) calculation; see
 *n_color* for
 :ref:`sparse_jac<sparse_jac@n_color>` and *n_sweep* for
 :ref:`sparse_hessian<sparse_hessian@n_sweep>` .
+
+mad
+===
+If the :ref:`speed_main@Settings@repeat` setting is greater than one,
+each speed test has an extra output line with the following form
+
+   *package* _ *test* _ ``mad`` = [ *mad_1* , ..., *mad_n*  ]
+
+where *mad_1* , ..., *mad_n* are the median absolute deviations
+of the rates for the corresponding sizes.
 {xrst_toc_hidden
    speed/src/link.xrst
+   speed/src/sparse_pattern.hpp
+   speed/src/speed_result.hpp
 }
 Link Routines
 *************
@@ -389,6 +512,10 @@ size_t global_cppad_thread_alloc_inuse = 0;
 // so same sparsity pattern is obtained during source generation and usage.
 size_t global_seed= 0;
 //
+// This is the value of the pattern setting. It is used by the sparse_jacobian
+// and sparse_hessian tests to choose the sparsity pattern.
+std::string global_sparse_pattern = "random";
+//
 // --------------------------------------------------------------------------
 namespace {
    using std::cout;
@@ -409,6 +536,74 @@ namespace {
       "val_graph"
    };
    size_t num_option = sizeof(option_list) / sizeof( option_list[0] );
+   //
+   // settings (see Settings in the documentation above)
+   size_t      setting_warmup   = 0;
+   size_t      setting_repeat   = 1;
+   double      setting_time_min = 1.0;
+   size_t      setting_size_max = 0;
+   std::string setting_json     = "";
+   std::string setting_csv      = "";
+   //
+   // results for all the speed tests that were run
+   std::vector<speed_record> speed_record_list;
+   // ----------------------------------------------------------------
+   // options that are present separated by the underbar character
+   std::string option_string(void)
+   {  std::string result = "";
+      for(size_t i = 0; i < num_option; i++)
+      {  std::string option = option_list[i];
+         if( global_option[option] )
+         {  if( result != "" )
+               result += "_";
+            result += option;
+         }
+      }
+      return result;
+   }
+   // ----------------------------------------------------------------
+   // set a setting; returns false if name or value is not valid
+   bool set_setting(const std::string& name, const std::string& value)
+   {  if( name == "pattern" )
+      {  const char* valid[] = { "random", "pde2", "pde3", "kkt", "arrow" };
+         bool found = false;
+         for(size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); ++i)
+            found |= value == valid[i];
+         if( found )
+            global_sparse_pattern = value;
+         return found;
+      }
+      if( name == "json" || name == "csv" )
+      {  if( value == "" )
+            return false;
+         if( name == "json" )
+            setting_json = value;
+         else
+            setting_csv = value;
+         return true;
+      }
+      const char* str = value.c_str();
+      char*       end = nullptr;
+      if( name == "time_min" )
+      {  setting_time_min = std::strtod(str, &end);
+         return value != "" && *end == '\0' && 0.0 < setting_time_min;
+      }
+      if( value == "" || value.find_first_not_of("0123456789") != value.npos )
+         return false;
+      if( name == "warmup" )
+      {  setting_warmup = size_t( std::atol(str) );
+         return true;
+      }
+      if( name == "repeat" )
+      {  setting_repeat = size_t( std::atol(str) );
+         return 0 < setting_repeat;
+      }
+      if( name == "size_max" )
+      {  setting_size_max = size_t( std::atol(str) );
+         return 100 <= setting_size_max;
+      }
+      return false;
+   }
    // ----------------------------------------------------------------
    // not available test message
    void not_available_message(const char* test_name)
@@ -461,11 +656,9 @@ namespace {
          ok = correct_case(is_package_double);
       }
       cout << AD_PACKAGE << "_" << case_name;
-      for(size_t i = 0; i < num_option; i++)
-      {  std::string option = option_list[i];
-         if( global_option[option]  )
-            cout << "_" << option;
-      }
+      std::string options = option_string();
+      if( options != "" )
+         cout << "_" << options;
       if( ! available )
       {  cout << "_available = false" << endl;
          return ok;
@@ -487,12 +680,18 @@ namespace {
       double time_case(double time_min,  size_t size)  ,
       const CppAD::vector<size_t>&        size_vec     ,
       const std::string&                  case_name    )
-   {  double time_min = 1.;
+   {  double time_min = setting_time_min;
       cout << case_name << "_size = ";
       output(size_vec);
       cout << endl;
       cout << AD_PACKAGE << "_" << case_name << "_rate = ";
       cout << std::fixed;
+      //
+      // thread
+      // the speed tests are run in sequential mode
+      size_t thread = CppAD::thread_alloc::thread_num();
+      //
+      std::vector<double> mad_vec( size_vec.size() );
       for(size_t i = 0; i < size_vec.size(); i++)
       {  if( i == 0 )
             cout << "[ ";
@@ -500,8 +699,36 @@ namespace {
             cout << ", ";
          cout << std::flush;
          size_t size = size_vec[i];
-         double time = time_case(time_min, size);
-         double rate = 1. / time;
+         //
+         // start measuring memory
+         size_t inuse_start = CppAD::thread_alloc::inuse(thread);
+         CppAD::thread_alloc::reset_inuse_max(thread);
+         //
+         // warmup calls
+         for(size_t j = 0; j < setting_warmup; ++j)
+            time_case(time_min, size);
+         //
+         // rate, mad
+         std::vector<double> rate_vec(setting_repeat);
+         for(size_t j = 0; j < setting_repeat; ++j)
+            rate_vec[j] = 1. / time_case(time_min, size);
+         double rate, mad;
+         speed_median_mad(rate_vec, rate, mad);
+         mad_vec[i] = mad;
+         //
+         // speed_record_list
+         speed_record record;
+         record.package     = AD_PACKAGE;
+         record.test        = case_name;
+         record.option      = option_string();
+         record.size        = size;
+         record.repeat      = setting_repeat;
+         record.rate_median = rate;
+         record.rate_mad    = mad;
+         record.memory      =
+            CppAD::thread_alloc::inuse_max(thread) - inuse_start;
+         speed_record_list.push_back(record);
+         //
          if( rate >= 1000 )
             cout << std::setprecision(0) << rate;
          else if( rate >= 10 )
@@ -511,6 +738,18 @@ namespace {
       }
       cout << " ]" << endl;
       //
+      // median absolute deviations
+      if( setting_repeat > 1 )
+      {  cout << AD_PACKAGE << "_" << case_name << "_mad = [ ";
+         cout << std::scientific << std::setprecision(2);
+         for(size_t i = 0; i < mad_vec.size(); i++)
+         {  if( i > 0 )
+               cout << ", ";
+            cout << mad_vec[i];
+         }
+         cout << " ]" << endl;
+      }
+      //
       return;
    }
 }
@@ -547,6 +786,24 @@ int main(int argc, char *argv[])
    };
    const size_t n_test  = sizeof(test_list) / sizeof(test_list[0]);
    //
+   // compare
+   if( argc > 1 && strcmp(argv[1], "compare") == 0 )
+   {  if( argc < 4 || 5 < argc )
+      {  cout << "usage: ./speed_" << AD_PACKAGE
+                << " compare old_file new_file [threshold]" << endl;
+         return 1;
+      }
+      double threshold = 0.1;
+      if( argc == 5 )
+         threshold = std::atof( argv[4] );
+      size_t n_regress;
+      if( ! speed_compare(argv[2], argv[3], threshold, n_regress) )
+         return 1;
+      cout << "speed compare: number of regressions = ";
+      cout << n_regress << endl;
+      return static_cast<int>( n_regress > 0 );
+   }
+   //
    test_enum match = test_error;
    int    iseed = 0;
    bool   error = argc < 3;
@@ -565,6 +822,10 @@ int main(int argc, char *argv[])
          global_option[ option_list[i] ] = false;
       for(size_t i = 3; i < size_t(argc); i++)
       {  bool found = false;
+         std::string arg = argv[i];
+         size_t      eq  = arg.find('=');
+         if( eq != std::string::npos )
+            found = set_setting( arg.substr(0, eq), arg.substr(eq + 1) );
          for(size_t j = 0; j < num_option; j++)
          {  if( strcmp(argv[i], option_list[j]) == 0 )
             {  global_option[ option_list[j] ] = true;
@@ -594,6 +855,12 @@ int main(int argc, char *argv[])
             std::cout << ", ";
          cout << option_list[i];
       }
+      cout << "\n\nsettings: zero or more of the following:";
+      cout << "\n\twarmup=n, repeat=n, time_min=seconds, "
+           << "json=file_name, csv=file_name,"
+           << "\n\tpattern=random|pde2|pde3|kkt|arrow, size_max=n";
+      cout << "\n\nusage: ./speed_"
+           << AD_PACKAGE << " compare old_file new_file [threshold]";
       cout << endl << endl;
       return 1;
    }
@@ -623,6 +890,31 @@ int main(int argc, char *argv[])
       size_sparse_hessian[i]  = 250 * (i + 1) * (i + 1);
       size_sparse_jacobian[i] = 250 * (i + 1) * (i + 1);
    }
+   if( setting_size_max != 0 )
+   {  // sizes for the sparse tests are size_max / 10^k, k = 0, 1, ...
+      CppAD::vector<size_t> size_sparse;
+      size_t size = setting_size_max;
+      while( 100 <= size && size_sparse.size() < n_size )
+      {  size_sparse.push_back(size);
+         size /= 10;
+      }
+      size_t n_sparse = size_sparse.size();
+      size_sparse_hessian.resize(n_sparse);
+      size_sparse_jacobian.resize(n_sparse);
+      for(size_t i = 0; i < n_sparse; ++i)
+      {  size_sparse_hessian[i]  = size_sparse[n_sparse - i - 1];
+         size_sparse_jacobian[i] = size_sparse[n_sparse - i - 1];
+      }
+   }
+   //
+   // name_sparse_hessian, name_sparse_jacobian
+   // names for the sparse tests include the pattern when it is not random
+   std::string name_sparse_hessian  = "sparse_hessian";
+   std::string name_sparse_jacobian = "sparse_jacobian";
+   if( global_sparse_pattern != "random" )
+   {  name_sparse_hessian  += "_" + global_sparse_pattern;
+      name_sparse_jacobian += "_" + global_sparse_pattern;
+   }
    switch(match)
    {
       // run all the correctness tests
@@ -643,12 +935,12 @@ int main(int argc, char *argv[])
       ok &= run_correct(
          available_sparse_hessian,
          correct_sparse_hessian,
-         "sparse_hessian"
+         name_sparse_hessian.c_str()
       );
       ok &= run_correct(
          available_sparse_jacobian,
          correct_sparse_jacobian,
-         "sparse_jacobian"
+         name_sparse_jacobian.c_str()
       );
       // summarize results
       assert( ok || (Run_error_count > 0) );
@@ -680,10 +972,10 @@ int main(int argc, char *argv[])
          time_poly,            size_poly,            "poly"
       );
       if( available_sparse_hessian() ) run_speed(
-         time_sparse_hessian,  size_sparse_hessian,  "sparse_hessian"
+         time_sparse_hessian,  size_sparse_hessian,  name_sparse_hessian
       );
       if( available_sparse_jacobian() ) run_speed(
-      time_sparse_jacobian, size_sparse_jacobian, "sparse_jacobian"
+      time_sparse_jacobian, size_sparse_jacobian, name_sparse_jacobian
       );
       ok = true;
       break;
@@ -757,12 +1049,12 @@ int main(int argc, char *argv[])
       ok &= run_correct(
          available_sparse_hessian,
          correct_sparse_hessian,
-         "sparse_hessian"
+         name_sparse_hessian.c_str()
       );
       run_speed(
-         time_sparse_hessian, size_sparse_hessian,  "sparse_hessian"
+         time_sparse_hessian, size_sparse_hessian,  name_sparse_hessian
       );
-      cout << AD_PACKAGE << "_sparse_hessian_n_color = ";
+      cout << AD_PACKAGE << "_" << name_sparse_hessian << "_n_color = ";
       for(size_t i = 0; i < size_sparse_hessian.size(); i++)
       {  if( i == 0 )
             cout << "[ ";
@@ -784,16 +1076,16 @@ int main(int argc, char *argv[])
       ok &= run_correct(
          available_sparse_jacobian,
          correct_sparse_jacobian,
-         "sparse_jacobian"
+         name_sparse_jacobian.c_str()
       );
       run_speed(
-         time_sparse_jacobian, size_sparse_jacobian, "sparse_jacobian"
+         time_sparse_jacobian, size_sparse_jacobian, name_sparse_jacobian
       );
       {  // output values of n_color
          CppAD::vector<size_t> size_vec, n_color_vec;
          info_sparse_jacobian(size_vec, n_color_vec);
          assert( size_sparse_jacobian.size() == size_vec.size() );
-         cout << AD_PACKAGE << "_sparse_jacobian_n_color = ";
+         cout << AD_PACKAGE << "_" << name_sparse_jacobian << "_n_color = ";
          for(size_t i = 0; i < size_vec.size(); i++)
          {  assert( size_vec[i] == size_sparse_jacobian[i] );
             if( i == 0 )
@@ -810,6 +1102,16 @@ int main(int argc, char *argv[])
       default:
       assert(0);
    }
+   //
+   // write the results
+   if( setting_json != "" && ! speed_write(setting_json, speed_record_list) )
+   {  cout << "speed main: cannot write " << setting_json << endl;
+      ok = false;
+   }
+   if( setting_csv != "" && ! speed_write(setting_csv, speed_record_list) )
+   {  cout << "speed main: cannot write " << setting_csv << endl;
+      ok = false;
+   }
 # ifndef NDEBUG
    // return memory for vectors that are still in scope
    size_det_lu.clear();
@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_ode_sparse}
+
+Speed Test Rosen34 and OdeGear With Sparse Jacobians
+####################################################
+
+Syntax
+******
+``speed/ode_sparse/speed_ode_sparse`` [ *n_max* ]
+
+Purpose
+*******
+This program compares the speed of :ref:`Rosen34-name` and
+:ref:`OdeGear-name` using dense Jacobians with their speed using
+sparse Jacobians and an :ref:`ode_sparse_work-name` object.
+
+ODE
+***
+The ODE is the reaction diffusion equation
+
+.. math::
+
+   x_i^\prime (t) =
+   d ( x_{i-1} - 2 x_i + x_{i+1} ) + x_i ( 1 - x_i )
+
+for :math:`i = 0 , \ldots , n-1` where :math:`x_{-1} = x_n = 0` ,
+:math:`d = 100` , and :math:`t \in [0, 1]` .
+(The grid spacing is one and the length of the domain grows with :math:`n` .)
+The Jacobians are computed using an :ref:`ADFun-name` object.
+The sparse Jacobians use :ref:`sparse_jac_for<sparse_jac-name>`
+and compute the coloring once.
+The dense Jacobians use :ref:`Jacobian-name` .
+All the methods use 20 steps and ``OdeGear`` uses
+:math:`m = 2` (except for the first step).
+
+n_max
+*****
+The number of states is :math:`n = 100, 300, 1000, 3000, 10000, \ldots`
+where :math:`n \leq` *n_max* .
+The default value of *n_max* is 10000.
+The dense methods are only run for :math:`n \leq 300` because
+their computation time is proportional to :math:`n^3` .
+
+Output
+******
+For each method and size this program prints
+
+.. csv-table::
+   :widths: auto
+
+   method,method name and dense or sparse
+   n,number of states
+   n_jac,number of Jacobian evaluations
+   seconds,time to solve the ODE
+   diff,maximum difference from the sparse method with reuse equal one
+
+The ``gear_sparse_5`` method reuses each Jacobian for five steps.
+
+Correctness
+***********
+The program returns zero (one) if the dense and sparse methods
+obtain the same solution and reusing the Jacobian changes the solution
+by less than :math:`10^{-3}` (otherwise).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_ode_sparse}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// d_vector, s_vector, sparse_matrix
+typedef CppAD::vector<double>                 d_vector;
+typedef CppAD::vector<size_t>                 s_vector;
+typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+//
+// Fun
+class Fun {
+private:
+   CppAD::ADFun<double>        fun_;
+   CppAD::sparse_rc<s_vector>  pattern_;
+   CppAD::sparse_jac_work      work_;
+public:
+   // number of Jacobian evaluations
+   size_t n_jac;
+   //
+   // constructor
+   Fun(size_t n) : n_jac(0)
+   {  using CppAD::AD;
+      double d = 100.0;
+      CppAD::vector< AD<double> > ax(n), af(n);
+      for(size_t i = 0; i < n; ++i)
+         ax[i] = 0.0;
+      CppAD::Independent(ax);
+      for(size_t i = 0; i < n; ++i)
+      {  af[i] = ax[i] * (1.0 - ax[i]) - 2.0 * d * ax[i];
+         if( 0 < i )
+            af[i] += d * ax[i-1];
+         if( i + 1 < n )
+            af[i] += d * ax[i+1];
+      }
+      fun_.Dependent(ax, af);
+      //
+      // pattern_
+      CppAD::sparse_rc<s_vector> pattern_in(n, n, n);
+      for(size_t i = 0; i < n; ++i)
+         pattern_in.set(i, i, i);
+      fun_.for_jac_sparsity(pattern_in, false, false, false, pattern_);
+   }
+   // f(t, x)
+   void Ode(const double& t, const d_vector& x, d_vector& f)
+   {  f = fun_.Forward(0, x); }
+   //
+   // f_t (t, x)
+   void Ode_ind(const double& t, const d_vector& x, d_vector& f_t)
+   {  for(size_t i = 0; i < size_t( x.size() ); ++i)
+         f_t[i] = 0.0;
+   }
+   // dense f_x (t, x)
+   void Ode_dep(const double& t, const d_vector& x, d_vector& f_x)
+   {  ++n_jac;
+      f_x = fun_.Jacobian(x);
+   }
+   // sparse f_x (t, x)
+   void Ode_dep(const double& t, const d_vector& x, sparse_matrix& f_x)
+   {  ++n_jac;
+      if( f_x.nr() == 0 )
+         f_x = sparse_matrix(pattern_);
+      size_t group_max = 1;
+      fun_.sparse_jac_for(group_max, x, f_x, pattern_, "cppad", work_);
+   }
+};
+//
+// ti, tf, M, m_max
+const double ti    = 0.0;
+const double tf    = 1.0;
+const size_t M     = 20;
+const size_t m_max = 2;
+//
+// initial
+d_vector initial(size_t n)
+{  d_vector xi(n);
+   for(size_t i = 0; i < n; ++i)
+      xi[i] = double(i + 1) / double(n + 1);
+   return xi;
+}
+//
+// rosen
+// returns the solution of the ODE and sets seconds and n_jac
+d_vector rosen(size_t n, bool sparse, double& seconds, size_t& n_jac)
+{  Fun F(n);
+   d_vector xi = initial(n);
+   d_vector e(n), xf;
+   double start = CppAD::elapsed_seconds();
+   if( sparse )
+   {  CppAD::ode_sparse_work<s_vector, d_vector> work;
+      xf = CppAD::Rosen34(F, M, ti, tf, xi, e, work);
+   }
+   else
+      xf = CppAD::Rosen34(F, M, ti, tf, xi, e);
+   seconds = CppAD::elapsed_seconds() - start;
+   n_jac   = F.n_jac;
+   return xf;
+}
+//
+// gear
+// returns the solution of the ODE and sets seconds and n_jac
+// (reuse equal zero means use dense Jacobians)
+d_vector gear(size_t n, size_t reuse, double& seconds, size_t& n_jac)
+{  Fun F(n);
+   CppAD::ode_sparse_work<s_vector, d_vector> work(reuse);
+   double h = (tf - ti) / double(M);
+   d_vector T(m_max + 1), X( (m_max + 1) * n ), e(n);
+   d_vector x_previous( m_max * n );
+   d_vector xi = initial(n);
+   for(size_t i = 0; i < n; ++i)
+      x_previous[i] = xi[i];
+   double start = CppAD::elapsed_seconds();
+   for(size_t step = 1; step <= M; ++step)
+   {  size_t m = std::min(step, m_max);
+      for(size_t j = 0; j <= m; ++j)
+         T[j] = ti + double(step + j - m) * h;
+      for(size_t ell = 0; ell < m * n; ++ell)
+         X[ell] = x_previous[ell];
+      if( reuse == 0 )
+         CppAD::OdeGear(F, m, n, T, X, e);
+      else
+         CppAD::OdeGear(F, m, n, T, X, e, work);
+      size_t m_next = std::min(step + 1, m_max);
+      for(size_t ell = 0; ell < m_next * n; ++ell)
+         x_previous[ell] = X[ (m + 1 - m_next) * n + ell ];
+   }
+   seconds = CppAD::elapsed_seconds() - start;
+   n_jac   = F.n_jac;
+   d_vector xf(n);
+   for(size_t i = 0; i < n; ++i)
+      xf[i] = X[m_max * n + i];
+   return xf;
+}
+//
+// max_diff
+// returns nan if x or y has a nan
+double max_diff(const d_vector& x, const d_vector& y)
+{  double diff = 0.0;
+   for(size_t i = 0; i < x.size(); ++i)
+   {  double diff_i = std::fabs( x[i] - y[i] );
+      if( CppAD::isnan(diff_i) )
+         return diff_i;
+      diff = std::max(diff, diff_i);
+   }
+   return diff;
+}
+//
+// print_line
+void print_line(
+   const char* method, size_t n, size_t n_jac, double seconds, double diff
+)
+{  std::printf(
+      "method = %-13s, n = %6d, n_jac = %3d, seconds = %9.2e, diff = %8.1e\n",
+      method, int(n), int(n_jac), seconds, diff
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_max
+   size_t n_max = 10000;
+   if( argc > 1 )
+      n_max = size_t( std::atol( argv[1] ) );
+   if( n_max < 100 )
+   {  std::fprintf(stderr, "speed_ode_sparse: n_max is less than 100\n");
+      return 1;
+   }
+   //
+   for(size_t n = 100; n <= n_max; n = (n % 3 == 0) ? 10 * n / 3 : 3 * n)
+   {  bool   dense = n <= 300;
+      double seconds;
+      size_t n_jac;
+      //
+      // Rosen34
+      d_vector x_rosen = rosen(n, true, seconds, n_jac);
+      print_line("rosen_sparse", n, n_jac, seconds, 0.0);
+      if( dense )
+      {  d_vector x = rosen(n, false, seconds, n_jac);
+         double diff = max_diff(x, x_rosen);
+         print_line("rosen_dense", n, n_jac, seconds, diff);
+         ok &= diff < 1e-10;
+      }
+      //
+      // OdeGear
+      d_vector x_gear = gear(n, 1, seconds, n_jac);
+      print_line("gear_sparse", n, n_jac, seconds, 0.0);
+      d_vector x = gear(n, 5, seconds, n_jac);
+      double diff = max_diff(x, x_gear);
+      print_line("gear_sparse_5", n, n_jac, seconds, diff);
+      ok &= diff < 1e-3;
+      if( dense )
+      {  x    = gear(n, 0, seconds, n_jac);
+         diff = max_diff(x, x_gear);
+         print_line("gear_dense", n, n_jac, seconds, diff);
+         ok &= diff < 1e-10;
+      }
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_record}
+
+Speed Test Recording With and Without record_reserve
+####################################################
+
+Syntax
+******
+``speed/record/speed_record`` [ *n_repeat* [ *size* ] ]
+
+Purpose
+*******
+This program measures the number of operators recorded per second
+for the following functions:
+
+det_minor
+=========
+The determinant of a *size* by *size* matrix computed using
+:ref:`det_by_minor-name` (the function used by :ref:`link_det_minor-name` ).
+
+ode
+===
+The solution of the ODE in :ref:`ode_evaluate-name`
+(the function used by :ref:`link_ode-name` )
+where the initial value has *size* components.
+
+Each function is recorded *n_repeat* times without using
+:ref:`record_reserve-name` and *n_repeat* times using it.
+When it is used,
+the size of the recording is obtained from a previous recording
+of the same function.
+
+n_repeat
+********
+is the number of times each function is recorded for each method.
+The default value is 100.
+
+size
+****
+is the size of the problem as explained above.
+The default value is 9.
+
+Output
+******
+For each function and method this program prints
+
+.. csv-table::
+   :widths: auto
+
+   function,det_minor or ode
+   reserve,false (true) if record_reserve is not (is) used
+   size_op,number of operators in each recording
+   seconds,time for all the recordings
+   op_per_sec,number of operators recorded per second
+
+Correctness
+***********
+The program returns zero (one) if the recordings with and without
+``record_reserve`` are (are not) the same size and do (do not)
+evaluate to the same values.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_record}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/cppad.hpp>
+# include <cppad/speed/det_by_minor.hpp>
+# include <cppad/speed/ode_evaluate.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// a_double, d_vector, a_vector
+typedef CppAD::AD<double>       a_double;
+typedef CppAD::vector<double>   d_vector;
+typedef CppAD::vector<a_double> a_vector;
+//
+// record
+// record the function and return its operation sequence in f
+void record(
+   const char*            function ,
+   size_t                 size     ,
+   size_t                 n_op     ,
+   size_t                 n_arg    ,
+   CppAD::ADFun<double>&  f        )
+{  std::string name(function);
+   size_t n = size;
+   if( name == "det_minor" )
+      n = size * size;
+   //
+   // ax
+   a_vector ax(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = double(j + 1) / double(n);
+   CppAD::Independent(ax);
+   if( n_op > 0 )
+      a_double::record_reserve(n_op, n_arg);
+   //
+   // ay
+   a_vector ay;
+   if( name == "det_minor" )
+   {  CppAD::det_by_minor<a_double> det(size);
+      ay.resize(1);
+      ay[0] = det(ax);
+   }
+   else
+   {  size_t p = 0;
+      ay.resize(n);
+      CppAD::ode_evaluate(ax, p, ay);
+   }
+   f.Dependent(ax, ay);
+}
+//
+// print_line
+void print_line(
+   const char* function ,
+   bool        reserve  ,
+   size_t      size_op  ,
+   size_t      n_repeat ,
+   double      seconds  )
+{  std::printf(
+      "function = %-9s, reserve = %-5s, size_op = %8d, "
+      "seconds = %8.3f, op_per_sec = %10.3e\n",
+      function, reserve ? "true" : "false", int(size_op), seconds,
+      double(n_repeat * size_op) / seconds
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_repeat, size
+   size_t n_repeat = 100;
+   size_t size     = 9;
+   if( argc > 1 )
+      n_repeat = size_t( std::atol( argv[1] ) );
+   if( argc > 2 )
+      size = size_t( std::atol( argv[2] ) );
+   if( n_repeat == 0 || size == 0 )
+   {  std::fprintf(stderr, "speed_record: n_repeat or size is zero\n");
+      return 1;
+   }
+   //
+   const char* function_list[] = { "det_minor", "ode" };
+   for(size_t i_fun = 0; i_fun < 2; ++i_fun)
+   {  const char* function = function_list[i_fun];
+      //
+      // n_op, n_arg
+      // this recording also initializes the thread_alloc memory pool
+      CppAD::ADFun<double> f;
+      record(function, size, 0, 0, f);
+      size_t n_op  = f.size_op();
+      size_t n_arg = f.size_op_arg();
+      //
+      // x, y
+      d_vector x( f.Domain() );
+      for(size_t j = 0; j < x.size(); ++j)
+         x[j] = double(j + 2) / double( x.size() );
+      d_vector y = f.Forward(0, x);
+      //
+      for(size_t i_reserve = 0; i_reserve < 2; ++i_reserve)
+      {  bool   reserve = i_reserve == 1;
+         size_t r_op    = reserve ? n_op  : 0;
+         size_t r_arg   = reserve ? n_arg : 0;
+         //
+         CppAD::ADFun<double> g;
+         double start = CppAD::elapsed_seconds();
+         for(size_t i_repeat = 0; i_repeat < n_repeat; ++i_repeat)
+            record(function, size, r_op, r_arg, g);
+         double seconds = CppAD::elapsed_seconds() - start;
+         //
+         ok &= g.size_op()     == n_op;
+         ok &= g.size_op_arg() == n_arg;
+         ok &= g.size_par()    == f.size_par();
+         d_vector y_g = g.Forward(0, x);
+         for(size_t i = 0; i < y.size(); ++i)
+            ok &= y_g[i] == y[i];
+         //
+         print_line(function, reserve, n_op, n_repeat, seconds);
+      }
+   }
+   if( ! ok )
+      std::printf("speed_record: check failed\n");
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
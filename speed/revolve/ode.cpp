@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_revolve}
+{xrst_spell
+   revolve
+}
+
+Speed Test revolve Using the link_ode Problem
+#############################################
+
+Syntax
+******
+``speed/revolve/speed_revolve`` [ *n_step* [ *n_state* ] ]
+
+Purpose
+*******
+This program compares two ways to compute the derivative of
+:math:`w^\R{T} y(x, 1)` with respect to :math:`x` where
+:math:`y(x, t)` is the solution of the ODE in :ref:`ode_evaluate-name`
+(the problem used by :ref:`link_ode-name` ) and
+:math:`w_i = 1` for all :math:`i` .
+The ODE is solved using *n_step* fourth order Runge-Kutta steps
+(:ref:`Runge45-name` with one step per call).
+
+tape
+====
+All of the steps are recorded in one ``ADFun<double>`` object
+and its reverse mode is used.
+
+revolve
+=======
+One step is recorded and :ref:`revolve-name` is used
+with different numbers of snapshots.
+
+n_step
+******
+is the number of time steps. The default value is 100000.
+
+n_state
+*******
+is the number of components in :math:`x` .
+The default value is 10.
+
+Output
+******
+For each method this program prints
+
+.. csv-table::
+   :widths: auto
+
+   method,the tape or revolve method
+   n_snap,number of snapshots (zero for the tape method)
+   seconds,time for the derivative calculation
+   n_forward,number of zero order forward step evaluations
+   bytes,approximate memory used for the calculation
+
+The tape seconds include the time to record the tape, and the revolve
+seconds include the time to record one step.
+The bytes are the memory for the operation sequence, the zero order
+Taylor coefficients, and the snapshots.
+
+Correctness
+***********
+The program returns zero (one) if the derivatives computed using
+the different methods agree (do not agree) with the known solution.
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_revolve}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/cppad.hpp>
+# include <cppad/speed/ode_evaluate.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// a_double, d_vector, a_vector
+typedef CppAD::AD<double>     a_double;
+typedef CppAD::vector<double> d_vector;
+typedef CppAD::vector<a_double> a_vector;
+//
+// rk_step
+// one Runge45 step from t_init to t_init + h
+a_vector rk_step(double t_init, double h, const a_vector& ay)
+{  CppAD::ode_evaluate_fun<a_double> F;
+   size_t   M  = 1;
+   a_double ti = t_init;
+   a_double tf = t_init + h;
+   return CppAD::Runge45(F, M, ti, tf, ay);
+}
+//
+// fun_bytes
+// memory for the operation sequence and zero order Taylor coefficients
+size_t fun_bytes(const CppAD::ADFun<double>& f)
+{  return f.size_op_seq() + f.size_par() * sizeof(double)
+      + f.size_var() * sizeof(double);
+}
+//
+// check_dw
+bool check_dw(const d_vector& x, const d_vector& dw)
+{  size_t n = x.size();
+   d_vector fp(n * n);
+   CppAD::ode_evaluate(x, 1, fp);
+   bool ok = true;
+   for(size_t j = 0; j < n; ++j)
+   {  double sum = 0.0;
+      for(size_t i = 0; i < n; ++i)
+         sum += fp[i * n + j];
+      ok &= CppAD::NearEqual(dw[j], sum, 1e-10, 1e-10);
+   }
+   return ok;
+}
+//
+// print_line
+void print_line(
+   const char* method, size_t n_snap, double seconds,
+   size_t n_forward, size_t bytes, bool ok
+)
+{  std::printf(
+      "method = %-7s, n_snap = %4d, seconds = %8.3f, "
+      "n_forward = %9d, bytes = %10d%s\n",
+      method, int(n_snap), seconds, int(n_forward), int(bytes),
+      ok ? "" : ", check failed"
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_step, n_state
+   size_t n_step  = 100000;
+   size_t n_state = 10;
+   if( argc > 1 )
+      n_step = size_t( std::atol( argv[1] ) );
+   if( argc > 2 )
+      n_state = size_t( std::atol( argv[2] ) );
+   if( n_step == 0 || n_state == 0 )
+   {  std::fprintf(stderr, "speed_revolve: n_step or n_state is zero\n");
+      return 1;
+   }
+   double h = 1.0 / double(n_step);
+   //
+   // x, w
+   d_vector x(n_state), w(n_state);
+   for(size_t j = 0; j < n_state; ++j)
+   {  x[j] = double(j + 1) / double(n_state);
+      w[j] = 1.0;
+   }
+   // ------------------------------------------------------------------------
+   // tape
+   {  double start = CppAD::elapsed_seconds();
+      a_vector ax(n_state);
+      for(size_t j = 0; j < n_state; ++j)
+         ax[j] = x[j];
+      CppAD::Independent(ax);
+      a_vector ay = ax;
+      for(size_t k = 0; k < n_step; ++k)
+         ay = rk_step(double(k) * h, h, ay);
+      CppAD::ADFun<double> f(ax, ay);
+      f.Forward(0, x);
+      d_vector dw = f.Reverse(1, w);
+      double seconds = CppAD::elapsed_seconds() - start;
+      //
+      bool ok_tape = check_dw(x, dw);
+      ok          &= ok_tape;
+      print_line("tape", 0, seconds, 1, fun_bytes(f), ok_tape);
+   }
+   // ------------------------------------------------------------------------
+   // revolve
+   size_t n_snap_list[] = { 10, 20, 50, 100 };
+   for(size_t i = 0; i < sizeof(n_snap_list) / sizeof(size_t); ++i)
+   {  size_t n_snap = std::min(n_snap_list[i], n_step);
+      double start  = CppAD::elapsed_seconds();
+      //
+      // step
+      // the ODE does not depend on time so the step is the same for all k
+      a_vector ax(n_state);
+      for(size_t j = 0; j < n_state; ++j)
+         ax[j] = x[j];
+      CppAD::Independent(ax);
+      a_vector ay = rk_step(0.0, h, ax);
+      CppAD::ADFun<double> step(ax, ay);
+      //
+      d_vector x_final, dw;
+      size_t n_forward = CppAD::revolve(
+         step, n_step, n_snap, x, w, x_final, dw
+      );
+      double seconds = CppAD::elapsed_seconds() - start;
+      //
+      bool ok_revolve = check_dw(x, dw);
+      ok             &= ok_revolve;
+      size_t bytes    = fun_bytes(step) + n_snap * n_state * sizeof(double);
+      print_line("revolve", n_snap, seconds, n_forward, bytes, ok_revolve);
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_runge_45_batch}
+
+Speed Test Runge45Batch Versus a Loop of Runge45 Calls
+######################################################
+
+Syntax
+******
+``speed/runge_45_batch/speed_runge_45_batch`` [ *n_traj_max* ]
+
+Purpose
+*******
+This program compares the speed of :ref:`Runge45Batch-name`
+with a loop over the trajectories that calls :ref:`OdeErrControl-name`
+using :ref:`Runge45-name` for each trajectory.
+
+ODE
+***
+The ODE is the damped pendulum
+
+.. math::
+
+   \frac{d}{dt} \left( \begin{array}{c}
+      x_0 \\ x_1 \\ x_2
+   \end{array} \right)
+   =
+   \left( \begin{array}{c}
+      x_1 \\ - x_2 \sin( x_0 ) - x_1 / 10 \\ 0
+   \end{array} \right)
+
+for :math:`t \in [0, 10]` .
+The component :math:`x_2 (t) = p_k` is a parameter that is different
+for each trajectory; :math:`p_k` is between one and ten.
+
+n_traj_max
+**********
+The number of trajectories is :math:`K = 1000, 10000, 100000, \ldots`
+where :math:`K \leq` *n_traj_max* .
+The default value of *n_traj_max* is 100000.
+
+Output
+******
+For each method and number of trajectories this program prints
+the following:
+
+.. csv-table::
+   :widths: auto
+
+   method,see below
+   n_traj,number of trajectories
+   nstep,total number of steps for all the trajectories
+   seconds,time to solve the ODE for all the trajectories
+
+The methods are:
+
+.. csv-table::
+   :widths: auto
+
+   loop,a loop of calls to OdeErrControl using Runge45
+   batch,Runge45Batch with 64 trajectories per block
+   batch_valvector,same as batch using an ADFun<valvector> for the ODE
+   batch_thread,same as batch using 4 OpenMP threads
+
+The ``batch_thread`` method is only run if this program is compiled with
+OpenMP.
+
+Correctness
+***********
+The program returns zero (one) if all the methods
+obtain the same solution (otherwise).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_runge_45_batch}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+// valvector must be included before cppad.hpp
+# include <cppad/example/valvector/class.hpp>
+# include <cppad/cppad.hpp>
+# include <cppad/utility/runge_45_batch.hpp>
+# ifdef _OPENMP
+# include <omp.h>
+# endif
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// d_vector, s_vector
+typedef CppAD::vector<double> d_vector;
+typedef CppAD::vector<size_t> s_vector;
+//
+// n, ti, tf, smin, smax, erel, eabs_all, scur_start, n_block
+const size_t n          = 3;
+const double ti         = 0.0;
+const double tf         = 10.0;
+const double smin       = 1e-6;
+const double smax       = 1.0;
+const double erel       = 0.0;
+const double eabs_all   = 1e-6;
+const double scur_start = 0.1;
+const size_t n_block    = 64;
+//
+// double_fun
+class double_fun {
+public:
+   void Ode(const double& t, const d_vector& x, d_vector& f)
+   {  f[0] = x[1];
+      f[1] = - x[2] * std::sin( x[0] ) - x[1] / 10.0;
+      f[2] = 0.0;
+   }
+};
+//
+// method
+class method {
+public:
+   double_fun F;
+   void step(
+      double ta, double tb, d_vector& xa, d_vector& xb, d_vector& eb)
+   {  xb = CppAD::Runge45(F, 1, ta, tb, xa, eb);
+   }
+   size_t order(void)
+   {  return 4; }
+};
+//
+// batch_fun
+class batch_fun {
+public:
+   void Ode(const d_vector& t, const d_vector& x, d_vector& f)
+   {  size_t n_b = t.size();
+      for(size_t k = 0; k < n_b; ++k)
+      {  f[k]           = x[n_b + k];
+         f[n_b + k]     =
+            - x[2 * n_b + k] * std::sin( x[k] ) - x[n_b + k] / 10.0;
+         f[2 * n_b + k] = 0.0;
+      }
+   }
+};
+//
+// valvector_fun
+class valvector_fun {
+private:
+   CppAD::ADFun<valvector> g_;
+public:
+   valvector_fun(void)
+   {  typedef CppAD::AD<valvector> ad_valvector;
+      CPPAD_TESTVECTOR( ad_valvector ) atx(n + 1), af(n);
+      for(size_t j = 0; j <= n; ++j)
+         atx[j] = valvector(0.0);
+      CppAD::Independent(atx);
+      af[0] = atx[2];
+      af[1] = - atx[3] * sin( atx[1] ) - atx[2] / valvector(10.0);
+      af[2] = valvector(0.0);
+      g_.Dependent(atx, af);
+   }
+   void Ode(const d_vector& t, const d_vector& x, d_vector& f)
+   {  size_t n_b = t.size();
+      CPPAD_TESTVECTOR( valvector ) tx(n + 1), vf(n);
+      tx[0].resize(n_b);
+      for(size_t k = 0; k < n_b; ++k)
+         tx[0][k] = t[k];
+      for(size_t i = 0; i < n; ++i)
+      {  tx[i + 1].resize(n_b);
+         for(size_t k = 0; k < n_b; ++k)
+            tx[i + 1][k] = x[i * n_b + k];
+      }
+      vf = g_.Forward(0, tx);
+      for(size_t i = 0; i < n; ++i)
+      {  // a constant dependent variable has size one
+         size_t size_i = vf[i].size();
+         for(size_t k = 0; k < n_b; ++k)
+            f[i * n_b + k] = vf[i][ k % size_i ];
+      }
+   }
+};
+//
+// initial
+d_vector initial(size_t n_traj)
+{  d_vector xi(n * n_traj);
+   for(size_t k = 0; k < n_traj; ++k)
+   {  xi[0 * n_traj + k] = 1.0;
+      xi[1 * n_traj + k] = 0.0;
+      xi[2 * n_traj + k] = 1.0 + 9.0 * double(k) / double(n_traj);
+   }
+   return xi;
+}
+//
+// loop
+// returns the solution for all the trajectories and sets seconds, nstep
+d_vector loop(size_t n_traj, double& seconds, size_t& nstep)
+{  d_vector xi = initial(n_traj);
+   d_vector xf(n * n_traj), xi_k(n), xf_k(n), ef_k(n), maxabs_k(n), eabs(n);
+   for(size_t i = 0; i < n; ++i)
+      eabs[i] = eabs_all;
+   method M;
+   nstep = 0;
+   double start = CppAD::elapsed_seconds();
+   for(size_t k = 0; k < n_traj; ++k)
+   {  for(size_t i = 0; i < n; ++i)
+         xi_k[i] = xi[i * n_traj + k];
+      double scur_k = scur_start;
+      size_t nstep_k;
+      xf_k = CppAD::OdeErrControl(M, ti, tf, xi_k,
+         smin, smax, scur_k, eabs, erel, ef_k, maxabs_k, nstep_k
+      );
+      for(size_t i = 0; i < n; ++i)
+         xf[i * n_traj + k] = xf_k[i];
+      nstep += nstep_k;
+   }
+   seconds = CppAD::elapsed_seconds() - start;
+   return xf;
+}
+//
+// batch
+// returns the solution for all the trajectories and sets seconds, nstep
+template <class Fun>
+d_vector batch(
+   Fun& F, size_t n_traj, size_t n_thread, double& seconds, size_t& nstep)
+{  d_vector xi = initial(n_traj);
+   d_vector scur(n_traj), eabs(n), ef(n * n_traj), xf;
+   s_vector nstep_k(n_traj);
+   for(size_t k = 0; k < n_traj; ++k)
+      scur[k] = scur_start;
+   for(size_t i = 0; i < n; ++i)
+      eabs[i] = eabs_all;
+   double start = CppAD::elapsed_seconds();
+   xf = CppAD::Runge45Batch(F, n_traj, ti, tf, xi,
+      smin, smax, scur, eabs, erel, ef, nstep_k, n_block, n_thread
+   );
+   seconds = CppAD::elapsed_seconds() - start;
+   nstep   = 0;
+   for(size_t k = 0; k < n_traj; ++k)
+      nstep += nstep_k[k];
+   return xf;
+}
+# ifdef _OPENMP
+//
+// in_parallel, thread_number
+bool in_parallel(void)
+{  return omp_in_parallel() != 0; }
+size_t thread_number(void)
+{  return static_cast<size_t>( omp_get_thread_num() ); }
+# endif
+//
+// same_solution
+bool same_solution(const d_vector& x, const d_vector& y)
+{  bool ok = true;
+   for(size_t i = 0; i < x.size(); ++i)
+      ok &= CppAD::NearEqual(x[i], y[i], 1e-10, 1e-10);
+   return ok;
+}
+//
+// print_line
+void print_line(const char* method, size_t n_traj, size_t nstep, double sec)
+{  std::printf(
+      "method = %-15s, n_traj = %7d, nstep = %9d, seconds = %9.2e\n",
+      method, int(n_traj), int(nstep), sec
+   );
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_traj_max
+   size_t n_traj_max = 100000;
+   if( argc > 1 )
+      n_traj_max = size_t( std::atol( argv[1] ) );
+   if( n_traj_max < 1000 )
+   {  std::fprintf(stderr,
+         "speed_runge_45_batch: n_traj_max is less than 1000\n"
+      );
+      return 1;
+   }
+   //
+   batch_fun     F_double;
+   valvector_fun F_valvector;
+   for(size_t n_traj = 1000; n_traj <= n_traj_max; n_traj *= 10)
+   {  double seconds;
+      size_t nstep;
+      //
+      // loop
+      d_vector x_loop = loop(n_traj, seconds, nstep);
+      print_line("loop", n_traj, nstep, seconds);
+      //
+      // batch
+      d_vector x = batch(F_double, n_traj, 1, seconds, nstep);
+      print_line("batch", n_traj, nstep, seconds);
+      ok &= same_solution(x, x_loop);
+      //
+      // batch_valvector
+      x = batch(F_valvector, n_traj, 1, seconds, nstep);
+      print_line("batch_valvector", n_traj, nstep, seconds);
+      ok &= same_solution(x, x_loop);
+# ifdef _OPENMP
+      //
+      // batch_thread
+      size_t n_thread = 4;
+      CppAD::thread_alloc::parallel_setup(
+         n_thread, in_parallel, thread_number
+      );
+      x = batch(F_double, n_traj, n_thread, seconds, nstep);
+      CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+      print_line("batch_thread", n_traj, nstep, seconds);
+      ok &= same_solution(x, x_loop);
+# endif
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
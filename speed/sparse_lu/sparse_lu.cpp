@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_sparse_lu}
+{xrst_spell
+   nnz
+}
+
+Speed Test sparse_lu Versus LuFactor
+####################################
+
+Syntax
+******
+``speed/sparse_lu/speed_sparse_lu`` [ *n_max* ]
+
+Purpose
+*******
+This program compares the speed of :ref:`sparse_lu-name`
+with the dense routines :ref:`LuFactor-name` and :ref:`LuInvert-name` .
+
+Matrix
+******
+The matrix :math:`A` is :math:`I - h J` where :math:`J` is the
+five point finite difference approximation for a convection diffusion
+operator on an :math:`m \times m` grid; i.e., :math:`n = m^2` .
+This is the form of the matrix that is factored when solving a stiff ODE
+corresponding to a partial differential equation.
+
+n_max
+*****
+The sizes of the grid are :math:`m = 10, 20, 40, \ldots`
+where :math:`m^2 \leq` *n_max* .
+The default value of *n_max* is 6400.
+The dense method is only run for :math:`n \leq 1600` because its
+computation time is proportional to :math:`n^3` .
+
+Output
+******
+For each method and size this program prints
+
+.. csv-table::
+   :widths: auto
+
+   method,dense; sparse with natural ordering; sparse with minimum degree
+   n,number of rows and columns in the matrix
+   nnz,number of possibly non-zero elements in the factorization
+   analyze,seconds for one sparse_lu analyze
+   factor,seconds for one factor plus solve
+
+The factor time for the sparse methods does not include the analyze time
+because the analysis is reused for every matrix with the same pattern.
+
+Correctness
+***********
+The program returns zero (one) if all the methods that are run
+obtain the same solution (otherwise).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_sparse_lu}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <limits>
+# include <string>
+# include <cppad/utility/vector.hpp>
+# include <cppad/utility/elapsed_seconds.hpp>
+# include <cppad/utility/near_equal.hpp>
+# include <cppad/utility/lu_factor.hpp>
+# include <cppad/utility/lu_invert.hpp>
+# include <cppad/utility/sparse_lu.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// d_vector, s_vector, sparse_matrix
+typedef CppAD::vector<double>                 d_vector;
+typedef CppAD::vector<size_t>                 s_vector;
+typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+//
+// min_seconds
+// minimum time used to determine the seconds for one factor plus solve
+const double min_seconds = 0.2;
+//
+// create_matrix
+// I - h J on an m by m grid
+sparse_matrix create_matrix(size_t m)
+{  size_t n   = m * m;
+   size_t nnz = 5 * n - 4 * m;
+   CppAD::sparse_rc<s_vector> pattern(n, n, nnz);
+   d_vector value(nnz);
+   double h = 1e-2 * double( (m + 1) * (m + 1) );
+   size_t k = 0;
+   for(size_t i1 = 0; i1 < m; ++i1)
+   {  for(size_t i2 = 0; i2 < m; ++i2)
+      {  size_t i = i1 * m + i2;
+         pattern.set(k, i, i);   value[k++] = 1.0 + 4.0 * h;
+         if( 0 < i1 )
+         {  pattern.set(k, i, i - m); value[k++] = - 1.2 * h; }
+         if( i1 + 1 < m )
+         {  pattern.set(k, i, i + m); value[k++] = - 0.8 * h; }
+         if( 0 < i2 )
+         {  pattern.set(k, i, i - 1); value[k++] = - 1.1 * h; }
+         if( i2 + 1 < m )
+         {  pattern.set(k, i, i + 1); value[k++] = - 0.9 * h; }
+      }
+   }
+   CPPAD_ASSERT_UNKNOWN( k == nnz );
+   sparse_matrix matrix(pattern);
+   for(k = 0; k < nnz; ++k)
+      matrix.set(k, value[k]);
+   return matrix;
+}
+//
+// dense_solve
+// returns the seconds for one factor plus solve and sets x
+double dense_solve(const sparse_matrix& matrix, const d_vector& b, d_vector& x)
+{  size_t n = matrix.nr();
+   s_vector ip(n), jp(n);
+   d_vector LU(n * n);
+   size_t repeat = 0;
+   double start  = CppAD::elapsed_seconds();
+   double seconds = 0.0;
+   while( seconds < min_seconds )
+   {  for(size_t ell = 0; ell < n * n; ++ell)
+         LU[ell] = 0.0;
+      for(size_t k = 0; k < matrix.nnz(); ++k)
+         LU[ matrix.row()[k] * n + matrix.col()[k] ] = matrix.val()[k];
+      CppAD::LuFactor(ip, jp, LU);
+      x = b;
+      CppAD::LuInvert(ip, jp, LU, x);
+      ++repeat;
+      seconds = CppAD::elapsed_seconds() - start;
+   }
+   return seconds / double(repeat);
+}
+//
+// sparse_solve
+// returns the seconds for one factor plus solve and sets analyze_sec, nnz, x
+double sparse_solve(
+   const std::string&   ordering    ,
+   const sparse_matrix& matrix      ,
+   const d_vector&      b           ,
+   double&              analyze_sec ,
+   size_t&              nnz         ,
+   d_vector&            x           )
+{  CppAD::sparse_lu<double> lu;
+   double start = CppAD::elapsed_seconds();
+   lu.analyze(matrix.pat(), ordering);
+   analyze_sec = CppAD::elapsed_seconds() - start;
+   nnz         = lu.nnz();
+   //
+   size_t repeat  = 0;
+   bool   ok      = true;
+   double seconds = 0.0;
+   start          = CppAD::elapsed_seconds();
+   while( seconds < min_seconds )
+   {  ok &= lu.factor(matrix);
+      lu.solve(b, x);
+      ++repeat;
+      seconds = CppAD::elapsed_seconds() - start;
+   }
+   if( ! ok )
+      x[0] = std::numeric_limits<double>::quiet_NaN();
+   return seconds / double(repeat);
+}
+//
+// print_line
+void print_line(
+   const char* method, size_t n, size_t nnz, double analyze, double factor
+)
+{  std::printf(
+      "method = %-14s, n = %6d, nnz = %9d, analyze = %9.2e, factor = %9.2e\n",
+      method, int(n), int(nnz), analyze, factor
+   );
+}
+//
+// same_solution
+bool same_solution(const d_vector& x, const d_vector& y)
+{  bool ok = true;
+   for(size_t i = 0; i < x.size(); ++i)
+      ok &= CppAD::NearEqual(x[i], y[i], 1e-10, 1e-10);
+   return ok;
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_max
+   size_t n_max = 6400;
+   if( argc > 1 )
+      n_max = size_t( std::atol( argv[1] ) );
+   if( n_max < 100 )
+   {  std::fprintf(stderr, "speed_sparse_lu: n_max is less than 100\n");
+      return 1;
+   }
+   //
+   for(size_t m = 10; m * m <= n_max; m *= 2)
+   {  size_t n = m * m;
+      sparse_matrix matrix = create_matrix(m);
+      d_vector b(n), x_check(n), x_sparse(n);
+      for(size_t i = 0; i < n; ++i)
+         b[i] = double(i % 7) - 3.0;
+      //
+      // dense
+      bool dense = n <= 1600;
+      if( dense )
+      {  double factor = dense_solve(matrix, b, x_check);
+         print_line("dense", n, n * n, 0.0, factor);
+      }
+      //
+      // natural, minimum_degree
+      const char* ordering[] = { "natural", "minimum_degree" };
+      for(size_t j = 0; j < 2; ++j)
+      {  double analyze;
+         size_t nnz;
+         double factor = sparse_solve(
+            ordering[j], matrix, b, analyze, nnz, x_sparse
+         );
+         print_line(ordering[j], n, nnz, analyze, factor);
+         if( dense || j > 0 )
+            ok &= same_solution(x_check, x_sparse);
+         else
+            x_check = x_sparse;
+      }
+   }
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/utility/near_equal.hpp>
 # include <cppad/speed/sparse_hes_fun.hpp>
@@ -9,6 +9,10 @@
 # include <cppad/utility/time_test.hpp>
 
 # include "link_sparse_hessian.hpp"
+# include "sparse_pattern.hpp"
+
+// pattern setting in speed/main.cpp
+extern std::string global_sparse_pattern;
 
 namespace { // BEGIN_EMPTY_NAMESPACE
 
@@ -110,6 +114,20 @@ void choose_row_col(
       }
    }
 }
+//
+// set_row_col
+// row and column indices for the current pattern setting
+void set_row_col(
+   size_t                 n   ,
+   CppAD::vector<size_t>& row ,
+   CppAD::vector<size_t>& col )
+{  if( global_sparse_pattern == "random" )
+      choose_row_col(n, row, col);
+   else
+   {  bool lower = true;
+      speed_sparse_pattern(global_sparse_pattern, n, lower, row, col);
+   }
+}
 } // END_EMPTY_NAMESPACE
 /*
 ------------------------------------------------------------------------------
@@ -144,7 +162,7 @@ void info_sparse_hessian(size_t size, size_t& n_color)
 {  size_t n      = size;
    size_t repeat = 1;
    vector<size_t> row, col;
-   choose_row_col(n, row, col);
+   set_row_col(n, row, col);
 
    // note that cppad/speed/sparse_hessian.cpp assumes that x.size()
    // is the size corresponding to this test
@@ -174,7 +192,7 @@ namespace {
       size_t n = size;
       vector<double> x(n);
       if( size != previous_size )
-      {  choose_row_col(n, row, col);
+      {  set_row_col(n, row, col);
          previous_size = size;
       }
       size_t K = row.size();
@@ -197,7 +215,7 @@ bool available_sparse_hessian(void)
    size_t repeat = 1;
    vector<double> x(n);
    vector<size_t> row, col;
-   choose_row_col(n, row, col);
+   set_row_col(n, row, col);
    size_t K = row.size();
    vector<double> hessian(K);
 
@@ -212,7 +230,7 @@ bool correct_sparse_hessian(bool is_package_double)
    size_t repeat = 1;
    vector<double> x(n);
    vector<size_t> row, col;
-   choose_row_col(n, row, col);
+   set_row_col(n, row, col);
    size_t K = row.size();
    vector<double> hessian(K);
 # ifndef NDEBUG
@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/utility/vector.hpp>
 // BEGIN PROTOTYPE
@@ -73,6 +73,9 @@ the sparsity pattern for the Hessian that is computed.
 The calculation of this sparsity pattern,
 if necessary to compute the Hessian,
 is intended to be part of the timing for this test.
+By default the pattern is randomly generated.
+The :ref:`speed_main@Settings@pattern` setting selects a pattern
+with the structure of a large scale problem instead.
 
 size
 ****
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/utility/near_equal.hpp>
 # include <cppad/speed/sparse_jac_fun.hpp>
@@ -9,6 +9,10 @@
 # include <cppad/utility/time_test.hpp>
 
 # include "link_sparse_jacobian.hpp"
+# include "sparse_pattern.hpp"
+
+// pattern setting in speed/main.cpp
+extern std::string global_sparse_pattern;
 
 namespace { // BEGIN_EMPTY_NAMESPACE
    static CppAD::vector<size_t> info_size_vec_;
@@ -123,6 +127,30 @@ void choose_row_col(
    }
 # endif
 }
+//
+// range_dimension
+// m as a function of n for the current pattern setting
+size_t range_dimension(size_t n)
+{  if( global_sparse_pattern == "random" )
+      return 2 * n;
+   return n;
+}
+//
+// set_row_col
+// row and column indices for the current pattern setting
+void set_row_col(
+   size_t                 n    ,
+   size_t                 m    ,
+   CppAD::vector<size_t>& row  ,
+   CppAD::vector<size_t>& col  )
+{  if( global_sparse_pattern == "random" )
+      choose_row_col(n, m, row, col);
+   else
+   {  CPPAD_ASSERT_UNKNOWN( m == n );
+      bool lower = false;
+      speed_sparse_pattern(global_sparse_pattern, n, lower, row, col);
+   }
+}
 } // END_EMPTY_NAMESPACE
 /*
 ------------------------------------------------------------------------------
@@ -186,7 +214,7 @@ namespace {
       CPPAD_ASSERT_UNKNOWN( callback_size_ == size );
       //
       size_t          n = size;
-      size_t          m = 2 * n;
+      size_t          m = range_dimension(n);
       vector<double>  x(n);
       size_t          nnz = callback_row_.size();
       vector<double>  jacobian(nnz);
@@ -211,9 +239,9 @@ bool available_sparse_jacobian(void)
 {  using CppAD::vector;
    //
    size_t n      = 3;
-   size_t m      = 2 * n;
+   size_t m      = range_dimension(n);
    vector<size_t> row, col;
-   choose_row_col(n, m, row, col);
+   set_row_col(n, m, row, col);
    //
    size_t          repeat = 1;
    vector<double>  x(n);
@@ -240,9 +268,9 @@ bool correct_sparse_jacobian(bool is_package_double)
    double eps    = 10. * CppAD::numeric_limits<double>::epsilon();
    //
    size_t n      = 10;
-   size_t m      = 2 * n;
+   size_t m      = range_dimension(n);
    vector<size_t> row, col;
-   choose_row_col(n, m, row, col);
+   set_row_col(n, m, row, col);
    //
    // The double package assumes jacobian.size() >= m
    size_t nnz = row.size();
@@ -297,8 +325,8 @@ double time_sparse_jacobian(double time_min, size_t size)
    // set callback_row_, callback_col_, callback_size_
    callback_size_   = size;
    size_t n         = size;
-   size_t m         = 2 * n;
-   choose_row_col(n, m, callback_row_, callback_col_);
+   size_t m         = range_dimension(n);
+   set_row_col(n, m, callback_row_, callback_col_);
    //
    size_t          repeat = 1;
    vector<double>  x(n);
@@ -3,7 +3,7 @@
 
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/utility/vector.hpp>
 // BEGIN PROTOTYPE
@@ -73,6 +73,9 @@ See the standard link specifications for :ref:`link_routines@repeat` .
 m
 *
 Is the dimension of the range space for the function :math:`f(x)`.
+It is equal to :math:`2 n` for the default random pattern and
+:math:`n` for the structured patterns selected by the
+:ref:`speed_main@Settings@pattern` setting.
 
 row
 ***
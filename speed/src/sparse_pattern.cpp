@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <algorithm>
+# include <cppad/core/cppad_assert.hpp>
+# include "sparse_pattern.hpp"
+
+namespace {
+   //
+   // grid_width
+   // smallest w such that w^dim >= n
+   size_t grid_width(size_t n, size_t dim)
+   {  size_t w = 1;
+      while( true )
+      {  size_t power = 1;
+         for(size_t d = 0; d < dim; ++d)
+            power *= w;
+         if( power >= n )
+            return w;
+         ++w;
+      }
+   }
+   //
+   // push_back
+   // add (i, j) if j < n and, when lower is true, j <= i
+   void push_back(
+      size_t                 n     ,
+      bool                   lower ,
+      size_t                 i     ,
+      size_t                 j     ,
+      CppAD::vector<size_t>& row   ,
+      CppAD::vector<size_t>& col   )
+   {  if( j < n && ( j <= i || ! lower ) )
+      {  row.push_back(i);
+         col.push_back(j);
+      }
+   }
+}
+// ---------------------------------------------------------------------------
+bool speed_sparse_pattern(
+   const std::string&     pattern ,
+   size_t                 n       ,
+   bool                   lower   ,
+   CppAD::vector<size_t>& row     ,
+   CppAD::vector<size_t>& col     )
+{  CPPAD_ASSERT_UNKNOWN( n > 0 );
+   row.resize(0);
+   col.resize(0);
+   //
+   if( pattern == "pde2" )
+   {  size_t w = grid_width(n, 2);
+      for(size_t i = 0; i < n; ++i)
+      {  if( i >= w )
+            push_back(n, lower, i, i - w, row, col);
+         if( i % w != 0 )
+            push_back(n, lower, i, i - 1, row, col);
+         push_back(n, lower, i, i, row, col);
+         if( i % w != w - 1 )
+            push_back(n, lower, i, i + 1, row, col);
+         push_back(n, lower, i, i + w, row, col);
+      }
+      return true;
+   }
+   if( pattern == "pde3" )
+   {  size_t w  = grid_width(n, 3);
+      size_t w2 = w * w;
+      for(size_t i = 0; i < n; ++i)
+      {  size_t i1 = (i / w) % w;
+         if( i >= w2 )
+            push_back(n, lower, i, i - w2, row, col);
+         if( i1 != 0 )
+            push_back(n, lower, i, i - w, row, col);
+         if( i % w != 0 )
+            push_back(n, lower, i, i - 1, row, col);
+         push_back(n, lower, i, i, row, col);
+         if( i % w != w - 1 )
+            push_back(n, lower, i, i + 1, row, col);
+         if( i1 != w - 1 )
+            push_back(n, lower, i, i + w, row, col);
+         push_back(n, lower, i, i + w2, row, col);
+      }
+      return true;
+   }
+   if( pattern == "kkt" )
+   {  size_t block = 6;
+      for(size_t i = 0; i < n; ++i)
+      {  size_t I     = i / block;
+         size_t start = block * ( I == 0 ? 0 : I - 1 );
+         size_t end   = std::min(n, block * (I + 2) );
+         for(size_t j = start; j < end; ++j)
+            push_back(n, lower, i, j, row, col);
+      }
+      return true;
+   }
+   if( pattern == "arrow" )
+   {  for(size_t i = 0; i + 1 < n; ++i)
+      {  push_back(n, lower, i, i, row, col);
+         push_back(n, lower, i, n - 1, row, col);
+      }
+      if( lower )
+      {  for(size_t j = 0; j < n; ++j)
+            push_back(n, lower, n - 1, j, row, col);
+      }
+      else
+         push_back(n, lower, n - 1, n - 1, row, col);
+      return true;
+   }
+   return false;
+}
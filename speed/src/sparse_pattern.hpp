@@ -0,0 +1,122 @@
+# ifndef CPPAD_SPEED_SRC_SPARSE_PATTERN_HPP
+# define CPPAD_SPEED_SRC_SPARSE_PATTERN_HPP
+
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <string>
+# include <cppad/utility/vector.hpp>
+// BEGIN PROTOTYPE
+extern bool speed_sparse_pattern(
+   const std::string&                 pattern    ,
+   size_t                             n          ,
+   bool                               lower      ,
+   CppAD::vector<size_t>&             row        ,
+   CppAD::vector<size_t>&             col
+);
+// END PROTOTYPE
+/*
+------------------------------------------------------------------------------
+{xrst_begin speed_sparse_pattern}
+{xrst_spell
+   arrowhead
+   karush
+   kkt
+   kuhn
+   pde
+   tridiagonal
+}
+
+Structured Sparsity Patterns for the Sparse Speed Tests
+#######################################################
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN PROTOTYPE
+   // END PROTOTYPE
+}
+
+Purpose
+*******
+The :ref:`sparse_jacobian<link_sparse_jacobian-name>` and
+:ref:`sparse_hessian<link_sparse_hessian-name>` tests use small
+randomly generated patterns by default.
+This routine generates patterns that have the structure of large scale
+problems; see the :ref:`speed_main@Settings@pattern` setting.
+
+pattern
+*******
+is one of the following:
+
+.. csv-table::
+   :widths: auto
+
+   pde2,five point finite difference stencil on a 2D grid
+   pde3,seven point finite difference stencil on a 3D grid
+   kkt,block tridiagonal with dense blocks of size six
+   arrow,diagonal plus a dense last column (and row)
+
+pde2
+====
+The grid has width :math:`w` where :math:`w` is the smallest integer
+such that :math:`w^2 \geq n` .
+Row :math:`i` has possibly non-zero entries in the columns
+:math:`i`, :math:`i \pm 1` (same grid row) and :math:`i \pm w`
+that are less than :math:`n` .
+
+pde3
+====
+The grid has width :math:`w` where :math:`w` is the smallest integer
+such that :math:`w^3 \geq n` .
+Row :math:`i` has possibly non-zero entries in the columns
+:math:`i`, :math:`i \pm 1`, :math:`i \pm w` (same grid plane),
+and :math:`i \pm w^2` that are less than :math:`n` .
+
+kkt
+===
+This is the pattern for the Karush-Kuhn-Tucker system of an
+optimal control problem with six variables
+(states, controls and multipliers) per time step.
+Row :math:`i` is in block :math:`I = \lfloor i / 6 \rfloor` and has
+possibly non-zero entries in all the columns in blocks
+:math:`I - 1`, :math:`I` and :math:`I + 1` .
+
+arrow
+=====
+Row :math:`i < n - 1` has possibly non-zero entries in columns
+:math:`i` and :math:`n - 1` .
+If *lower* is false (the Jacobian case),
+row :math:`n - 1` only has a possibly non-zero diagonal entry.
+This keeps the number of colors small for forward mode
+(which the link routines use when :math:`m \geq n` ).
+If *lower* is true (the Hessian case), the pattern is symmetric
+and row :math:`n - 1` is dense; i.e., the pattern is an arrowhead.
+
+n
+*
+is the number of rows and columns in the pattern.
+
+lower
+*****
+If *lower* is true, only the entries in the lower triangle
+(column index less than or equal row index) are returned.
+This is the form used by the sparse Hessian test.
+
+row, col
+********
+The input size and elements of these vectors do not matter.
+Upon return they contain the row and column indices for the pattern
+in row major order.
+The diagonal is always included.
+
+Return
+******
+The return value is false (true) if *pattern* is not (is) one of the
+values above.
+
+{xrst_end speed_sparse_pattern}
+*/
+
+# endif
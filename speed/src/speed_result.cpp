@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <algorithm>
+# include <cmath>
+# include <cstdio>
+# include <cstdlib>
+# include <fstream>
+# include <iostream>
+# include <limits>
+# include <sstream>
+# include <cppad/core/cppad_assert.hpp>
+# include "speed_result.hpp"
+
+namespace {
+   // field names in the order they are written
+   const char* field_name[] = {
+      "package",
+      "test",
+      "option",
+      "size",
+      "repeat",
+      "rate_median",
+      "rate_mad",
+      "memory"
+   };
+   const size_t n_field = sizeof(field_name) / sizeof(field_name[0]);
+   //
+   // is_json
+   bool is_json(const std::string& file_name)
+   {  size_t n = file_name.size();
+      return n >= 5 && file_name.substr(n - 5) == ".json";
+   }
+   //
+   // same_key
+   bool same_key(const speed_record& left, const speed_record& right)
+   {  return left.package == right.package
+         && left.test    == right.test
+         && left.option  == right.option
+         && left.size    == right.size;
+   }
+   //
+   // field_value
+   // value of field j for a record as a string
+   std::string field_value(const speed_record& record, size_t j)
+   {  char buffer[100];
+      switch(j)
+      {  case 0: return record.package;
+         case 1: return record.test;
+         case 2: return record.option;
+         case 3: return std::to_string(record.size);
+         case 4: return std::to_string(record.repeat);
+         case 5:
+         std::snprintf(buffer, sizeof(buffer), "%.6e", record.rate_median);
+         return buffer;
+         case 6:
+         std::snprintf(buffer, sizeof(buffer), "%.6e", record.rate_mad);
+         return buffer;
+         case 7: return std::to_string(record.memory);
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+      }
+      return "";
+   }
+   //
+   // set_field
+   // set field j for a record from a string
+   bool set_field(speed_record& record, size_t j, const std::string& value)
+   {  const char* str = value.c_str();
+      char*       end = nullptr;
+      switch(j)
+      {  case 0: record.package = value; return true;
+         case 1: record.test    = value; return true;
+         case 2: record.option  = value; return true;
+         case 3: record.size        = std::strtoul(str, &end, 10); break;
+         case 4: record.repeat      = std::strtoul(str, &end, 10); break;
+         case 5: record.rate_median = std::strtod(str, &end);      break;
+         case 6: record.rate_mad    = std::strtod(str, &end);      break;
+         case 7: record.memory      = std::strtoul(str, &end, 10); break;
+         default:
+         CPPAD_ASSERT_UNKNOWN(false);
+         return false;
+      }
+      return value.size() > 0 && *end == '\0';
+   }
+   //
+   // json_field
+   // value of "name" in a line of a json file written by speed_write
+   bool json_field(
+      const std::string& line, const std::string& name, std::string& value)
+   {  std::string pattern = "\"" + name + "\":";
+      size_t start = line.find(pattern);
+      if( start == std::string::npos )
+         return false;
+      start += pattern.size();
+      while( start < line.size() && line[start] == ' ' )
+         ++start;
+      size_t end;
+      if( start < line.size() && line[start] == '"' )
+      {  ++start;
+         end = line.find('"', start);
+      }
+      else
+         end = line.find_first_of(", }", start);
+      if( end == std::string::npos )
+         return false;
+      value = line.substr(start, end - start);
+      return true;
+   }
+}
+// ---------------------------------------------------------------------------
+// speed_median_mad
+void speed_median_mad(
+   const std::vector<double>& rate, double& median, double& mad)
+{  CPPAD_ASSERT_UNKNOWN( rate.size() > 0 );
+   size_t n = rate.size();
+   std::vector<double> sorted(rate);
+   std::sort(sorted.begin(), sorted.end());
+   if( n % 2 == 1 )
+      median = sorted[n / 2];
+   else
+      median = ( sorted[n / 2 - 1] + sorted[n / 2] ) / 2.0;
+   //
+   for(size_t i = 0; i < n; ++i)
+      sorted[i] = std::fabs( rate[i] - median );
+   std::sort(sorted.begin(), sorted.end());
+   if( n % 2 == 1 )
+      mad = sorted[n / 2];
+   else
+      mad = ( sorted[n / 2 - 1] + sorted[n / 2] ) / 2.0;
+}
+// ---------------------------------------------------------------------------
+// speed_read
+bool speed_read(const std::string& file_name, std::vector<speed_record>& record)
+{  record.clear();
+   std::ifstream file( file_name.c_str() );
+   if( ! file.is_open() )
+      return false;
+   bool json = is_json(file_name);
+   std::string line;
+   //
+   // csv header
+   if( ! json )
+   {  if( ! std::getline(file, line) )
+         return true; // empty file
+      std::string header = field_name[0];
+      for(size_t j = 1; j < n_field; ++j)
+         header += std::string(",") + field_name[j];
+      if( line != header )
+         return false;
+   }
+   while( std::getline(file, line) )
+   {  speed_record one;
+      bool ok = true;
+      if( json )
+      {  if( line.find('{') == std::string::npos )
+            continue;
+         for(size_t j = 0; j < n_field; ++j)
+         {  std::string value;
+            ok &= json_field(line, field_name[j], value);
+            if( ok )
+               ok &= set_field(one, j, value);
+         }
+      }
+      else
+      {  if( line.size() == 0 )
+            continue;
+         std::stringstream stream(line);
+         for(size_t j = 0; j < n_field; ++j)
+         {  std::string value;
+            ok &= bool( std::getline(stream, value, ',') );
+            if( ok )
+               ok &= set_field(one, j, value);
+         }
+      }
+      if( ! ok )
+         return false;
+      record.push_back(one);
+   }
+   return true;
+}
+// ---------------------------------------------------------------------------
+// speed_write
+bool speed_write(
+   const std::string& file_name, const std::vector<speed_record>& record)
+{  //
+   // all_record: records in existing file that are not replaced
+   std::vector<speed_record> all_record;
+   std::ifstream existing( file_name.c_str() );
+   if( existing.is_open() )
+   {  existing.close();
+      std::vector<speed_record> old_record;
+      if( ! speed_read(file_name, old_record) )
+         return false;
+      for(size_t i = 0; i < old_record.size(); ++i)
+      {  bool replace = false;
+         for(size_t k = 0; k < record.size(); ++k)
+            replace |= same_key(old_record[i], record[k]);
+         if( ! replace )
+            all_record.push_back( old_record[i] );
+      }
+   }
+   for(size_t k = 0; k < record.size(); ++k)
+      all_record.push_back( record[k] );
+   //
+   std::ofstream file( file_name.c_str() );
+   if( ! file.is_open() )
+      return false;
+   if( is_json(file_name) )
+   {  file << "[\n";
+      for(size_t i = 0; i < all_record.size(); ++i)
+      {  file << "{ ";
+         for(size_t j = 0; j < n_field; ++j)
+         {  file << "\"" << field_name[j] << "\": ";
+            if( j < 3 )
+               file << "\"" << field_value(all_record[i], j) << "\"";
+            else
+               file << field_value(all_record[i], j);
+            if( j + 1 < n_field )
+               file << ", ";
+         }
+         file << " }";
+         if( i + 1 < all_record.size() )
+            file << ",";
+         file << "\n";
+      }
+      file << "]\n";
+   }
+   else
+   {  for(size_t j = 0; j < n_field; ++j)
+      {  if( j > 0 )
+            file << ",";
+         file << field_name[j];
+      }
+      file << "\n";
+      for(size_t i = 0; i < all_record.size(); ++i)
+      {  for(size_t j = 0; j < n_field; ++j)
+         {  if( j > 0 )
+               file << ",";
+            file << field_value(all_record[i], j);
+         }
+         file << "\n";
+      }
+   }
+   return file.good();
+}
+// ---------------------------------------------------------------------------
+// speed_compare
+bool speed_compare(
+   const std::string& old_file  ,
+   const std::string& new_file  ,
+   double             threshold ,
+   size_t&            n_regress )
+{  n_regress = 0;
+   std::vector<speed_record> old_record, new_record;
+   if( ! speed_read(old_file, old_record) )
+   {  std::cerr << "speed_compare: cannot read " << old_file << "\n";
+      return false;
+   }
+   if( ! speed_read(new_file, new_record) )
+   {  std::cerr << "speed_compare: cannot read " << new_file << "\n";
+      return false;
+   }
+   std::printf("%-10s %-16s %-24s %8s %12s %12s %8s %8s\n",
+      "package", "test", "option", "size",
+      "old_rate", "new_rate", "ratio", "memory"
+   );
+   for(size_t i = 0; i < old_record.size(); ++i)
+   for(size_t k = 0; k < new_record.size(); ++k)
+   {  if( same_key(old_record[i], new_record[k]) )
+      {  const speed_record& r_old( old_record[i] );
+         const speed_record& r_new( new_record[k] );
+         double ratio = r_new.rate_median / r_old.rate_median;
+         double memory_ratio = 1.0;
+         if( r_old.memory > 0 )
+            memory_ratio = double(r_new.memory) / double(r_old.memory);
+         else if( r_new.memory > 0 )
+            memory_ratio = std::numeric_limits<double>::infinity();
+         bool slower = ratio < 1.0 - threshold;
+         bool bigger = memory_ratio > 1.0 + threshold;
+         std::printf("%-10s %-16s %-24s %8d %12.4e %12.4e %8.3f %8.3f",
+            r_old.package.c_str(), r_old.test.c_str(),
+            r_old.option.c_str(), int(r_old.size),
+            r_old.rate_median, r_new.rate_median, ratio, memory_ratio
+         );
+         if( slower )
+            std::printf(" rate_regression");
+         if( bigger )
+            std::printf(" memory_regression");
+         std::printf("\n");
+         if( slower || bigger )
+            ++n_regress;
+      }
+   }
+   return true;
+}
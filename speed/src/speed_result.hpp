@@ -0,0 +1,115 @@
+# ifndef CPPAD_SPEED_SRC_SPEED_RESULT_HPP
+# define CPPAD_SPEED_SRC_SPEED_RESULT_HPP
+
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+# include <string>
+# include <vector>
+// BEGIN PROTOTYPE
+struct speed_record {
+   std::string package;     // AD package
+   std::string test;        // test name; e.g., det_lu
+   std::string option;      // options separated by _ (empty for none)
+   size_t      size;        // size argument for the test
+   size_t      repeat;      // number of timed calls used for the statistics
+   double      rate_median; // median of the rates for the timed calls
+   double      rate_mad;    // median absolute deviation of the rates
+   size_t      memory;      // maximum thread_alloc::inuse during the calls
+};
+extern void speed_median_mad(
+   const std::vector<double>&         rate       ,
+   double&                            median     ,
+   double&                            mad
+);
+extern bool speed_read(
+   const std::string&                 file_name  ,
+   std::vector<speed_record>&         record
+);
+extern bool speed_write(
+   const std::string&                 file_name  ,
+   const std::vector<speed_record>&   record
+);
+extern bool speed_compare(
+   const std::string&                 old_file   ,
+   const std::string&                 new_file   ,
+   double                             threshold  ,
+   size_t&                            n_regress
+);
+// END PROTOTYPE
+/*
+------------------------------------------------------------------------------
+{xrst_begin speed_result}
+{xrst_spell
+   csv
+   json
+   mad
+   regressions
+}
+
+Speed Test Result Files
+#######################
+
+Prototype
+*********
+{xrst_literal
+   // BEGIN PROTOTYPE
+   // END PROTOTYPE
+}
+
+Purpose
+*******
+These routines are used by :ref:`speed_main-name` to compute the
+statistics for repeated timings, to write and read the result files,
+and to compare two result files.
+
+speed_record
+************
+Each record corresponds to one *package* , *test* , *option* , and *size* ;
+i.e., these fields are the key for the record.
+
+speed_median_mad
+****************
+Sets *median* to the median of the elements of *rate*
+and *mad* to the median of the absolute deviations from *median* .
+The size of *rate* must be greater than zero.
+
+speed_read
+**********
+Reads the records in a file written by ``speed_write`` .
+The return value is false if the file cannot be opened or
+is not in one of the formats below.
+
+speed_write
+***********
+Writes the records to a file.
+If the file already exists, the records in the file are read first
+and the records with the same key as a new record are replaced.
+Hence the same file can be used to accumulate the results for
+many tests and option combinations.
+The return value is false if the existing file cannot be read
+or the file cannot be written.
+
+Format
+======
+If *file_name* ends with ``.json`` , the file is a JSON array
+with one object (record) per line.
+Otherwise it is a CSV file with a header line.
+In both cases the field names are the same as in ``speed_record`` .
+
+speed_compare
+*************
+Reads the records in *old_file* and *new_file* and prints a line
+for each key that is in both files.
+A record is a regression if its median rate decreased by more than
+the relative amount *threshold* ,
+or if its memory increased by more than the relative amount *threshold* .
+The regressions are marked in the output and *n_regress*
+is set to the number of regressions.
+The return value is false if one of the files cannot be read.
+
+{xrst_end speed_result}
+*/
+
+# endif
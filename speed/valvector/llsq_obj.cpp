@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+/*
+{xrst_begin speed_valvector}
+{xrst_spell
+   llsq
+   obj
+}
+
+Speed Test valvector Using a Linear Least Squares Objective
+###########################################################
+
+Syntax
+******
+``speed/valvector/speed_valvector`` [ *n_data* ... ]
+
+Purpose
+*******
+This program compares the time to evaluate the linear least squares
+objective in :ref:`valvector_llsq_obj.cpp-name` , and its gradient,
+using two different recordings:
+
+valvector
+=========
+The function is recorded using ``AD<valvector>`` .
+The time and data values are valvectors with size *n_data*
+and the objective only uses a few valvector operations.
+
+double
+======
+The function is recorded using ``AD<double>`` .
+The time and data values are scalars and the recording contains
+operations for each of the *n_data* residuals.
+
+n_data
+******
+Each *n_data* on the command line is the number of data values for one test.
+If there are no *n_data* arguments, the sizes
+1000, 10000, 100000, and 1000000 are used.
+
+Output
+******
+For each *n_data* , this program prints the rate (evaluations per second)
+for the valvector and double recordings.
+Each evaluation is zero order forward mode followed by
+first order reverse mode.
+
+Correctness
+***********
+The program returns zero (one) if the objective and gradient computed
+using the two recordings agree (do not agree).
+
+Source
+******
+{xrst_literal
+   // BEGIN C++
+   // END C++
+}
+
+{xrst_end speed_valvector}
+*/
+// BEGIN C++
+# include <cstdlib>
+# include <cstdio>
+# include <cppad/example/valvector/sum.hpp>
+# include <cppad/example/valvector/class.hpp>
+# include <cppad/cppad.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+// scalar_type
+typedef valvector::scalar_type scalar_type;
+//
+// nx
+// number of coefficients in the model
+const size_t nx = 3;
+//
+// set_data
+void set_data(size_t n_data, valvector& time, valvector& data)
+{  time.resize(n_data);
+   data.resize(n_data);
+   for(size_t i = 0; i < n_data; ++i)
+   {  time[i] = -1.0 + scalar_type(2 * i) / scalar_type(n_data - 1);
+      data[i] = time[i] < 0.0 ? -1.0 : 1.0;
+   }
+}
+//
+// record_valvector
+void record_valvector(
+   size_t n_data, valvector_ad_sum& asum, CppAD::ADFun<valvector>& f
+)
+{  typedef CppAD::AD<valvector> ad_valvector;
+   valvector time, data;
+   set_data(n_data, time, data);
+   //
+   CPPAD_TESTVECTOR( ad_valvector ) ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = valvector(0.0);
+   CppAD::Independent(ax);
+   //
+   // amodel
+   valvector    time_j(1.0);
+   ad_valvector amodel(0.0);
+   for(size_t  j = 0; j < nx; ++j)
+   {  amodel += time_j * ax[j];
+      time_j *= time;
+   }
+   //
+   // aobj
+   ad_valvector ares = data - amodel;
+   ad_valvector asq  = ares * ares;
+   CPPAD_TESTVECTOR( ad_valvector ) ay(1);
+   asum(asq, ay[0]);
+   f.Dependent(ax, ay);
+}
+//
+// record_double
+void record_double(size_t n_data, CppAD::ADFun<double>& f)
+{  typedef CppAD::AD<double> ad_double;
+   valvector time, data;
+   set_data(n_data, time, data);
+   //
+   CPPAD_TESTVECTOR( ad_double ) ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = 0.0;
+   CppAD::Independent(ax);
+   //
+   CPPAD_TESTVECTOR( ad_double ) ay(1);
+   ay[0] = 0.0;
+   for(size_t i = 0; i < n_data; ++i)
+   {  scalar_type time_j = 1.0;
+      ad_double   amodel = 0.0;
+      for(size_t j = 0; j < nx; ++j)
+      {  amodel += time_j * ax[j];
+         time_j *= time[i];
+      }
+      ad_double ares = data[i] - amodel;
+      ay[0] += ares * ares;
+   }
+   f.Dependent(ax, ay);
+}
+//
+// f_valvector, f_double
+CppAD::ADFun<valvector> f_valvector;
+CppAD::ADFun<double>    f_double;
+//
+// test_valvector
+void test_valvector(size_t size, size_t repeat)
+{  CPPAD_TESTVECTOR( valvector ) x(nx), w(1), dw(nx);
+   for(size_t j = 0; j < nx; ++j)
+      x[j][0] = 1.0;
+   w[0][0] = 1.0;
+   while(repeat--)
+   {  f_valvector.Forward(0, x);
+      dw = f_valvector.Reverse(1, w);
+   }
+}
+//
+// test_double
+void test_double(size_t size, size_t repeat)
+{  CPPAD_TESTVECTOR( double ) x(nx), w(1), dw(nx);
+   for(size_t j = 0; j < nx; ++j)
+      x[j] = 1.0;
+   w[0] = 1.0;
+   while(repeat--)
+   {  f_double.Forward(0, x);
+      dw = f_double.Reverse(1, w);
+   }
+}
+//
+// check
+bool check(void)
+{  bool ok = true;
+   scalar_type eps = 1e3 * std::numeric_limits<scalar_type>::epsilon();
+   //
+   CPPAD_TESTVECTOR( valvector ) vx(nx), vy(1), vw(1), vdw(nx);
+   CPPAD_TESTVECTOR( double )    dx(nx), dy(1), dw(1), ddw(nx);
+   for(size_t j = 0; j < nx; ++j)
+   {  vx[j][0] = 1.0 + scalar_type(j);
+      dx[j]    = 1.0 + scalar_type(j);
+   }
+   vw[0][0] = 1.0;
+   dw[0]    = 1.0;
+   //
+   vy  = f_valvector.Forward(0, vx);
+   vdw = f_valvector.Reverse(1, vw);
+   dy  = f_double.Forward(0, dx);
+   ddw = f_double.Reverse(1, dw);
+   //
+   ok &= CppAD::NearEqual(vy[0][0], dy[0], eps, eps);
+   for(size_t j = 0; j < nx; ++j)
+      ok &= CppAD::NearEqual(vdw[j].sum(), ddw[j], eps, eps);
+   return ok;
+}
+} // END_EMPTY_NAMESPACE
+//
+// main
+int main(int argc, char* argv[])
+{  bool ok = true;
+   //
+   // n_data_vec
+   CppAD::vector<size_t> n_data_vec;
+   for(int i = 1; i < argc; ++i)
+      n_data_vec.push_back( size_t( std::atol( argv[i] ) ) );
+   if( n_data_vec.size() == 0 )
+   {  n_data_vec.push_back(1000);
+      n_data_vec.push_back(10000);
+      n_data_vec.push_back(100000);
+      n_data_vec.push_back(1000000);
+   }
+   //
+   // asum
+   valvector_ad_sum asum;
+   //
+   double time_min = 0.5;
+   for(size_t k = 0; k < n_data_vec.size(); ++k)
+   {  size_t n_data = n_data_vec[k];
+      if( n_data < 2 )
+      {  std::fprintf(stderr, "speed_valvector: n_data < 2\n");
+         return 1;
+      }
+      record_valvector(n_data, asum, f_valvector);
+      record_double(n_data, f_double);
+      bool ok_k = check();
+      ok       &= ok_k;
+      //
+      double sec_valvector = CppAD::time_test(test_valvector, time_min, 0);
+      double sec_double    = CppAD::time_test(test_double,    time_min, 0);
+      std::printf(
+         "n_data = %8d, valvector_rate = %10.2f, double_rate = %10.2f%s\n",
+         int(n_data), 1.0 / sec_valvector, 1.0 / sec_double,
+         ok_k ? "" : ", check failed"
+      );
+   }
+   //
+   // free memory used by the recordings
+   f_valvector = CppAD::ADFun<valvector>();
+   f_double    = CppAD::ADFun<double>();
+   //
+   return static_cast<int>( ! ok );
+}
+// END C++
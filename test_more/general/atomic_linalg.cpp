@@ -0,0 +1,293 @@
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
+// SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
+// ----------------------------------------------------------------------------
+// Compare each atomic_linalg operation with the same calculation
+// recorded one scalar operation at a time.
+# include <cppad/core/atomic/linalg/linalg.hpp>
+
+namespace { // BEGIN_EMPTY_NAMESPACE
+//
+typedef CppAD::atomic_linalg<double> linalg_t;
+typedef linalg_t::op_enum_t           op_enum_t;
+//
+// check_solve
+// x = S^{-1} * b using Gaussian elimination without pivoting
+template <class Scalar>
+void check_solve(
+   op_enum_t                    op      ,
+   size_t                       n       ,
+   size_t                       n_right ,
+   const CppAD::vector<Scalar>& a       ,
+   CppAD::vector<Scalar>        b       ,
+   CppAD::vector<Scalar>&       x       )
+{  CppAD::vector<Scalar> s(n * n);
+   for(size_t r = 0; r < n; ++r)
+   {  for(size_t c = 0; c < n; ++c)
+      {  Scalar s_rc = a[r * n + c];
+         if( op == linalg_t::lower_solve_enum && r < c )
+            s_rc = Scalar(0);
+         if( op == linalg_t::upper_solve_enum && c < r )
+            s_rc = Scalar(0);
+         if( op == linalg_t::chol_solve_enum && r < c )
+            s_rc = a[c * n + r];
+         s[r * n + c] = s_rc;
+      }
+   }
+   for(size_t k = 0; k < n; ++k)
+   {  for(size_t i = k + 1; i < n; ++i)
+      {  Scalar l_ik = s[i * n + k] / s[k * n + k];
+         for(size_t j = k; j < n; ++j)
+            s[i * n + j] -= l_ik * s[k * n + j];
+         for(size_t j = 0; j < n_right; ++j)
+            b[i * n_right + j] -= l_ik * b[k * n_right + j];
+      }
+   }
+   x.resize(n * n_right);
+   for(size_t ell = 0; ell < n; ++ell)
+   {  size_t i = n - 1 - ell;
+      for(size_t j = 0; j < n_right; ++j)
+      {  Scalar sum = b[i * n_right + j];
+         for(size_t k = i + 1; k < n; ++k)
+            sum -= s[i * n + k] * x[k * n_right + j];
+         x[i * n_right + j] = sum / s[i * n + i];
+      }
+   }
+}
+//
+// check_log_det
+// log( det(a) ) using Gaussian elimination without pivoting
+template <class Scalar>
+Scalar check_log_det(size_t n, CppAD::vector<Scalar> s)
+{  for(size_t k = 0; k < n; ++k)
+   {  for(size_t i = k + 1; i < n; ++i)
+      {  Scalar l_ik = s[i * n + k] / s[k * n + k];
+         for(size_t j = k; j < n; ++j)
+            s[i * n + j] -= l_ik * s[k * n + j];
+      }
+   }
+   Scalar log_det = Scalar(0);
+   for(size_t i = 0; i < n; ++i)
+      log_det += log( s[i * n + i] );
+   return log_det;
+}
+//
+// record
+// f(x) = y(x) * y(x) where y is the result of the operation
+// (the element-wise square makes second derivatives nonzero)
+void record(
+   linalg_t&                    linalg   ,
+   bool                         use_atom ,
+   op_enum_t                    op       ,
+   size_t                       n        ,
+   size_t                       n_right  ,
+   const CppAD::vector<double>& x        ,
+   CppAD::ADFun<double>&        f        )
+{  using CppAD::AD;
+   size_t nx = x.size();
+   CppAD::vector< AD<double> > ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   //
+   // aa, ab
+   CppAD::vector< AD<double> > aa(n * n), ab(nx - n * n), ay;
+   for(size_t j = 0; j < n * n; ++j)
+      aa[j] = ax[j];
+   for(size_t j = 0; j < ab.size(); ++j)
+      ab[j] = ax[n * n + j];
+   //
+   // ay
+   if( op == linalg_t::mat_mul_enum )
+   {  ay.resize(n * n_right);
+      if( use_atom )
+         linalg(linalg.set_mat_mul(n, n, n_right), ax, ay);
+      else for(size_t i = 0; i < n; ++i)
+      {  for(size_t j = 0; j < n_right; ++j)
+         {  ay[i * n_right + j] = 0.0;
+            for(size_t k = 0; k < n; ++k)
+               ay[i * n_right + j] += aa[i * n + k] * ab[k * n_right + j];
+         }
+      }
+   }
+   else if( op == linalg_t::log_det_enum )
+   {  ay.resize(2);
+      if( use_atom )
+         linalg(linalg.set_log_det(n), ax, ay);
+      else
+         ay[0] = check_log_det(n, aa);
+      ay.resize(1);
+   }
+   else
+   {  ay.resize(n * n_right);
+      if( use_atom )
+         linalg(linalg.set_solve(op, n, n_right), ax, ay);
+      else
+         check_solve(op, n, n_right, aa, ab, ay);
+   }
+   //
+   // f
+   CppAD::vector< AD<double> > az( ay.size() );
+   for(size_t i = 0; i < ay.size(); ++i)
+      az[i] = ay[i] * ay[i];
+   f.Dependent(ax, az);
+}
+//
+// test_op
+bool test_op(linalg_t& linalg, op_enum_t op)
+{  bool ok = true;
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   using CppAD::NearEqual;
+   //
+   // n, n_right, nx
+   size_t n       = 4;
+   size_t n_right = 3;
+   size_t nx      = n * n + n * n_right;
+   if( op == linalg_t::log_det_enum )
+      nx = n * n;
+   //
+   // x
+   // a diagonally dominant matrix so that pivoting is not used
+   CppAD::vector<double> x(nx);
+   for(size_t j = 0; j < nx; ++j)
+      x[j] = 0.1 * double( (j * 7) % 11 ) - 0.3;
+   for(size_t i = 0; i < n; ++i)
+      x[i * n + i] += 3.0;
+   //
+   // f, g
+   CppAD::ADFun<double> f, g;
+   record(linalg, true,  op, n, n_right, x, f);
+   record(linalg, false, op, n, n_right, x, g);
+   size_t ny = f.Range();
+   //
+   // forward mode orders zero through three
+   size_t q = 4;
+   CppAD::vector<double> xq(nx * q);
+   for(size_t j = 0; j < nx; ++j)
+   {  xq[j * q + 0] = x[j];
+      for(size_t k = 1; k < q; ++k)
+         xq[j * q + k] = 0.05 * double( (j + k) % 5 ) - 0.1;
+   }
+   CppAD::vector<double> yf = f.Forward(q - 1, xq);
+   CppAD::vector<double> yg = g.Forward(q - 1, xq);
+   for(size_t i = 0; i < yf.size(); ++i)
+      ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+   //
+   // reverse mode
+   // (log_det reverse mode is only implemented for order_up <= 1)
+   if( op != linalg_t::log_det_enum )
+   {  CppAD::vector<double> w(ny * q);
+      for(size_t i = 0; i < w.size(); ++i)
+         w[i] = 1.0 + 0.1 * double(i);
+      CppAD::vector<double> df = f.Reverse(q, w);
+      CppAD::vector<double> dg = g.Reverse(q, w);
+      for(size_t j = 0; j < df.size(); ++j)
+         ok &= NearEqual(df[j], dg[j], eps99, eps99);
+   }
+   //
+   // Hessian
+   CppAD::vector<double> w(ny);
+   for(size_t i = 0; i < ny; ++i)
+      w[i] = 1.0 + double(i);
+   CppAD::vector<double> hf = f.Hessian(x, w);
+   CppAD::vector<double> hg = g.Hessian(x, w);
+   for(size_t k = 0; k < hf.size(); ++k)
+      ok &= NearEqual(hf[k], hg[k], eps99, eps99);
+   //
+   // Jacobian sparsity must include the non-zero Jacobian entries
+   CppAD::vector<double> jf = f.Jacobian(x);
+   CppAD::sparse_rc< CppAD::vector<size_t> > pattern_in(nx, nx, nx);
+   for(size_t k = 0; k < nx; ++k)
+      pattern_in.set(k, k, k);
+   CppAD::sparse_rc< CppAD::vector<size_t> > pattern_out;
+   f.for_jac_sparsity(pattern_in, false, false, true, pattern_out);
+   CppAD::vector<bool> jac_pattern(ny * nx);
+   for(size_t k = 0; k < jac_pattern.size(); ++k)
+      jac_pattern[k] = false;
+   for(size_t k = 0; k < pattern_out.nnz(); ++k)
+      jac_pattern[ pattern_out.row()[k] * nx + pattern_out.col()[k] ] = true;
+   for(size_t k = 0; k < jf.size(); ++k)
+      ok &= jf[k] == 0.0 || jac_pattern[k];
+   //
+   // Hessian sparsity must include the non-zero Hessian entries
+   CppAD::vector<bool> select_x(nx), select_y(ny);
+   for(size_t j = 0; j < nx; ++j)
+      select_x[j] = true;
+   for(size_t i = 0; i < ny; ++i)
+      select_y[i] = true;
+   f.for_hes_sparsity(select_x, select_y, false, pattern_out);
+   CppAD::vector<bool> hes_pattern(nx * nx);
+   for(size_t k = 0; k < hes_pattern.size(); ++k)
+      hes_pattern[k] = false;
+   for(size_t k = 0; k < pattern_out.nnz(); ++k)
+      hes_pattern[ pattern_out.row()[k] * nx + pattern_out.col()[k] ] = true;
+   for(size_t k = 0; k < hf.size(); ++k)
+      ok &= hf[k] == 0.0 || hes_pattern[k];
+   //
+   // Jacobian of a function recorded using base2ad
+   CppAD::ADFun< CppAD::AD<double>, double > af = f.base2ad();
+   CppAD::vector< CppAD::AD<double> > ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = x[j];
+   CppAD::Independent(ax);
+   CppAD::vector< CppAD::AD<double> > ajac = af.Jacobian(ax);
+   CppAD::ADFun<double> h(ax, ajac);
+   CppAD::vector<double> jh = h.Forward(0, x);
+   for(size_t k = 0; k < jh.size(); ++k)
+      ok &= NearEqual(jh[k], jf[k], eps99, eps99);
+   //
+   // optimize
+   f.optimize();
+   yf = f.Forward(0, x);
+   yg = g.Forward(0, x);
+   for(size_t i = 0; i < yf.size(); ++i)
+      ok &= NearEqual(yf[i], yg[i], eps99, eps99);
+   //
+   return ok;
+}
+//
+// singular
+bool singular(linalg_t& linalg)
+{  bool ok = true;
+   size_t n = 2;
+   //
+   // a is singular, b = a
+   CppAD::vector< CppAD::AD<double> > a(n * n), x(n * n), y(2);
+   a[0] = 1.0; a[1] = 2.0;
+   a[2] = 2.0; a[3] = 4.0;
+   CppAD::vector< CppAD::AD<double> > ax(2 * n * n);
+   for(size_t k = 0; k < n * n; ++k)
+   {  ax[k]         = a[k];
+      ax[n * n + k] = a[k];
+   }
+   // lu solve
+   linalg(linalg.set_solve(linalg_t::lu_solve_enum, n, n), ax, x);
+   for(size_t k = 0; k < n * n; ++k)
+      ok &= CppAD::isnan( x[k] );
+   //
+   // chol solve
+   linalg(linalg.set_solve(linalg_t::chol_solve_enum, n, n), ax, x);
+   for(size_t k = 0; k < n * n; ++k)
+      ok &= CppAD::isnan( x[k] );
+   //
+   // log_det
+   linalg(linalg.set_log_det(n), a, y);
+   ok &= y[0] == - std::numeric_limits<double>::infinity();
+   ok &= y[1] == 0.0;
+   //
+   return ok;
+}
+} // END_EMPTY_NAMESPACE
+
+bool atomic_linalg(void)
+{  bool ok = true;
+   linalg_t linalg("atomic_linalg");
+   ok &= test_op(linalg, linalg_t::mat_mul_enum);
+   ok &= test_op(linalg, linalg_t::lower_solve_enum);
+   ok &= test_op(linalg, linalg_t::upper_solve_enum);
+   ok &= test_op(linalg, linalg_t::lu_solve_enum);
+   ok &= test_op(linalg, linalg_t::chol_solve_enum);
+   ok &= test_op(linalg, linalg_t::log_det_enum);
+   ok &= singular(linalg);
+   return ok;
+}
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 
 # include <cppad/cppad.hpp>
@@ -369,7 +369,110 @@ namespace {
       }
       return ok;
    }
-
+   // -------------------------------------------------------------------
+   // Test use_in_parallel true, where the tape is shared by all threads,
+   // against use_in_parallel false.
+   bool test_seven(void)
+   {  bool ok = true;
+      using CppAD::AD;
+      using CppAD::NearEqual;
+      using CppAD::vector;
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      //
+      // g_fun
+      // uses a dynamic parameter, a conditional expression, and a VecAD
+      size_t n = 2, m = 2;
+      vector< AD<double> > ax(n), ay(m), ap(1);
+      ax[0] = 0.5;
+      ax[1] = 1.5;
+      ap[0] = 2.0;
+      CppAD::Independent(ax, ap);
+      CppAD::VecAD<double> av(2);
+      av[ AD<double>(0) ] = ax[1];
+      av[ AD<double>(1) ] = ax[0];
+      AD<double> aindex = CondExpLt(ax[0], ax[1], AD<double>(0), AD<double>(1));
+      ay[0] = ap[0] * ax[0] * ax[1] + sin( av[aindex] );
+      ay[1] = CondExpLt(ax[0], ax[1], ax[0] * ax[0], exp( ax[1] ) );
+      CppAD::ADFun<double> g_fun(ax, ay);
+      //
+      // chk_shared, chk_separate
+      bool internal_bool    = false;
+      bool use_hes_sparsity = false;
+      bool use_base2ad      = true;
+      chkpoint_two<double> chk_shared(g_fun, "chk_shared",
+         internal_bool, use_hes_sparsity, use_base2ad, true
+      );
+      chkpoint_two<double> chk_separate(g_fun, "chk_separate",
+         internal_bool, use_hes_sparsity, use_base2ad, false
+      );
+      //
+      // f_shared, f_separate
+      CppAD::Independent(ax);
+      chk_shared(ax, ay);
+      for(size_t i = 0; i < m; ++i)
+         ay[i] *= ax[i];
+      CppAD::ADFun<double> f_shared(ax, ay);
+      //
+      CppAD::Independent(ax);
+      chk_separate(ax, ay);
+      for(size_t i = 0; i < m; ++i)
+         ay[i] *= ax[i];
+      CppAD::ADFun<double> f_separate(ax, ay);
+      //
+      for(size_t i_case = 0; i_case < 3; ++i_case)
+      {  if( i_case == 2 )
+         {  // change dynamic parameter in both checkpoint functions
+            vector<double> p(1);
+            p[0] = 3.0;
+            chk_shared.new_dynamic(p);
+            chk_separate.new_dynamic(p);
+         }
+         //
+         // x
+         // second case uses the other branch of the conditionals
+         vector<double> x(n), x_p(n);
+         x[0] = 0.25 + double(i_case % 2);
+         x[1] = 0.75;
+         x_p[0] = 1.0;
+         x_p[1] = 2.0;
+         //
+         // forward orders zero, one, and two
+         vector<double> y(m), z(m);
+         for(size_t k = 0; k < 3; ++k)
+         {  y = f_shared.Forward(k, k == 0 ? x : x_p);
+            z = f_separate.Forward(k, k == 0 ? x : x_p);
+            for(size_t i = 0; i < m; ++i)
+               ok &= NearEqual(y[i], z[i], eps99, eps99);
+         }
+         //
+         // reverse order three
+         vector<double> w(m * 3), dw(n * 3), dz(n * 3);
+         for(size_t i = 0; i < m * 3; ++i)
+            w[i] = double(i + 1);
+         dw = f_shared.Reverse(3, w);
+         dz = f_separate.Reverse(3, w);
+         for(size_t j = 0; j < n * 3; ++j)
+            ok &= NearEqual(dw[j], dz[j], eps99, eps99);
+         //
+         // Jacobian using base2ad
+         CppAD::ADFun< AD<double>, double > af_shared   = f_shared.base2ad();
+         CppAD::ADFun< AD<double>, double > af_separate = f_separate.base2ad();
+         vector< AD<double> > ajac_shared, ajac_separate;
+         for(size_t j = 0; j < n; ++j)
+            ax[j] = x[j];
+         CppAD::Independent(ax);
+         ajac_shared   = af_shared.Jacobian(ax);
+         ajac_separate = af_separate.Jacobian(ax);
+         vector< AD<double> > adiff(n * m);
+         for(size_t k = 0; k < n * m; ++k)
+            adiff[k] = ajac_shared[k] - ajac_separate[k];
+         CppAD::ADFun<double> h(ax, adiff);
+         vector<double> diff = h.Forward(0, x);
+         for(size_t k = 0; k < n * m; ++k)
+            ok &= NearEqual(diff[k], 0.0, eps99, eps99);
+      }
+      return ok;
+   }
 }
 bool chkpoint_two(void)
 {  bool ok = true;
@@ -381,6 +484,7 @@ bool chkpoint_two(void)
    ok  &= test_five(true);
    ok  &= test_five(false);
    ok  &= test_six();
+   ok  &= test_seven();
    //
    return ok;
 }
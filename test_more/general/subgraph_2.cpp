@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-22 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/cppad.hpp>
 
@@ -49,10 +49,176 @@ bool test_subgraph_subset(void)
    return ok;
 }
 
+// subgraph_jac_rev using separate work space for two sets of rows
+// (the function includes an atomic function call)
+bool test_subgraph_work(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::vector;
+   typedef vector<double> d_vector;
+   typedef vector<size_t> s_vector;
+   typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+   //
+   // g(u) = [ u_0 * u_1 , sin(u_1) ]
+   size_t n = 5;
+   vector< AD<double> > au(2), av(2);
+   au[0] = 1.0;
+   au[1] = 2.0;
+   CppAD::Independent(au);
+   av[0] = au[0] * au[1];
+   av[1] = sin( au[1] );
+   CppAD::ADFun<double> g(au, av);
+   CppAD::chkpoint_two<double> g_atom(g, "g", false, false, false, false);
+   //
+   // f(x)
+   d_vector x(n);
+   vector< AD<double> > ax(n), ay(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = x[j] = double(j + 1);
+   CppAD::Independent(ax);
+   for(size_t i = 0; i + 1 < n; ++i)
+      ay[i] = ax[i] * ax[i+1];
+   au[0] = ax[0];
+   au[1] = ax[n-1];
+   g_atom(au, av);
+   ay[n-1] = av[0] + av[1];
+   CppAD::ADFun<double> f(ax, ay);
+   //
+   // check
+   // Jacobian using the version of subgraph_jac_rev that modifies f
+   vector<bool> select_domain(n), select_range(n);
+   for(size_t j = 0; j < n; ++j)
+   {  select_domain[j] = true;
+      select_range[j]  = true;
+   }
+   sparse_matrix check;
+   f.subgraph_jac_rev(select_domain, select_range, x, check);
+   //
+   // even, odd
+   // Jacobian rows using separate work space
+   f.Forward(0, x);
+   f.subgraph_reverse(select_domain);
+   const CppAD::ADFun<double>& f_const(f);
+   CppAD::subgraph_work<double> work_even, work_odd;
+   vector<bool> select_even(n), select_odd(n);
+   for(size_t i = 0; i < n; ++i)
+   {  select_even[i] = i % 2 == 0;
+      select_odd[i]  = i % 2 == 1;
+   }
+   sparse_matrix even, odd;
+   f_const.subgraph_jac_rev(select_even, even, work_even);
+   f_const.subgraph_jac_rev(select_odd,  odd,  work_odd);
+   //
+   // check that even and odd partition check
+   ok &= even.nnz() + odd.nnz() == check.nnz();
+   size_t k_even = 0, k_odd = 0;
+   for(size_t k = 0; k < check.nnz(); ++k)
+   {  size_t i = check.row()[k];
+      const sparse_matrix& part( i % 2 == 0 ? even : odd );
+      size_t& k_part = i % 2 == 0 ? k_even : k_odd;
+      if( k_part < part.nnz() )
+      {  ok &= part.row()[k_part] == i;
+         ok &= part.col()[k_part] == check.col()[k];
+         ok &= part.val()[k_part] == check.val()[k];
+      }
+      ++k_part;
+   }
+   //
+   // check the atomic function row
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   size_t k = even.nnz() - 2;
+   ok &= even.row()[k] == n-1 && even.col()[k] == 0;
+   ok &= CppAD::NearEqual(even.val()[k], x[n-1], eps99, eps99);
+   ++k;
+   ok &= even.row()[k] == n-1 && even.col()[k] == n-1;
+   double check_val = x[0] + std::cos( x[n-1] );
+   ok &= CppAD::NearEqual(even.val()[k], check_val, eps99, eps99);
+   //
+   // the same work space can be used again
+   f_const.subgraph_jac_rev(select_odd, even, work_even);
+   ok &= even.nnz() == odd.nnz();
+   for(size_t k = 0; k < odd.nnz(); ++k)
+      ok &= even.val()[k] == odd.val()[k];
+   //
+   return ok;
+}
+
+// ---------------------------------------------------------------------------
+// check that cached subgraphs give the same results as computing them
+bool test_subgraph_cache(void)
+{  bool ok = true;
+   using CppAD::AD;
+   using CppAD::vector;
+   typedef vector<double> d_vector;
+   typedef vector<size_t> s_vector;
+   typedef CppAD::sparse_rcv<s_vector, d_vector> sparse_matrix;
+   //
+   // f(x), g(x)
+   size_t n = 6;
+   d_vector x(n);
+   vector< AD<double> > ax(n), ay(n);
+   for(size_t j = 0; j < n; ++j)
+      ax[j] = x[j] = double(j + 1);
+   CppAD::Independent(ax);
+   for(size_t i = 0; i + 1 < n; ++i)
+      ay[i] = ax[i] * sin( ax[i+1] );
+   ay[n-1] = CppAD::CondExpLt(ax[0], ax[n-1], ax[0] * ax[n-1], ax[1]);
+   CppAD::ADFun<double> f(ax, ay), g;
+   g = f;
+   //
+   // f uses the cache and g does not
+   f.subgraph_cache(true);
+   //
+   // select_domain, select_range
+   vector<bool> select_domain(n), select_range(n);
+   for(size_t i = 0; i < n; ++i)
+      select_range[i] = true;
+   //
+   for(size_t i_domain = 0; i_domain < 2; ++i_domain)
+   {  // second time exclude some of the domain
+      for(size_t j = 0; j < n; ++j)
+         select_domain[j] = i_domain == 0 || j % 2 == 0;
+      //
+      for(size_t i_x = 0; i_x < 3; ++i_x)
+      {  // x
+         // (for i_x == 2 the condtional expression changes value)
+         for(size_t j = 0; j < n; ++j)
+            x[j] = double(i_x + 1) / double(j + 1);
+         //
+         sparse_matrix f_jac, g_jac;
+         f.subgraph_jac_rev(select_domain, select_range, x, f_jac);
+         g.subgraph_jac_rev(select_domain, select_range, x, g_jac);
+         //
+         ok &= f_jac.nnz() == g_jac.nnz();
+         for(size_t k = 0; k < f_jac.nnz() && ok; ++k)
+         {  ok &= f_jac.row()[k] == g_jac.row()[k];
+            ok &= f_jac.col()[k] == g_jac.col()[k];
+            ok &= f_jac.val()[k] == g_jac.val()[k];
+         }
+         //
+         // work space version uses the cache in f
+         CppAD::subgraph_work<double> work;
+         const CppAD::ADFun<double>& f_const(f);
+         f.subgraph_reverse(select_domain);
+         f_const.subgraph_jac_rev(select_range, f_jac, work);
+         ok &= f_jac.nnz() == g_jac.nnz();
+         for(size_t k = 0; k < f_jac.nnz() && ok; ++k)
+         {  ok &= f_jac.row()[k] == g_jac.row()[k];
+            ok &= f_jac.col()[k] == g_jac.col()[k];
+            ok &= f_jac.val()[k] == g_jac.val()[k];
+         }
+      }
+   }
+   //
+   return ok;
+}
+
 } // END_EMPTY_NAMESPACE
 
 bool subgraph_2(void)
 {  bool ok = true;
    ok &= test_subgraph_subset();
+   ok &= test_subgraph_work();
+   ok &= test_subgraph_cache();
    return ok;
 }
@@ -1,6 +1,6 @@
 // SPDX-License-Identifier: EPL-2.0 OR GPL-2.0-or-later
 // SPDX-FileCopyrightText: Bradley M. Bell <bradbell@seanet.com>
-// SPDX-FileContributor: 2003-23 Bradley M. Bell
+// SPDX-FileContributor: 2003-24 Bradley M. Bell
 // ----------------------------------------------------------------------------
 # include <cppad/cppad.hpp>
 # include <cppad/utility/link_dll_lib.hpp>
@@ -700,6 +700,247 @@ bool csum_case(void)
    return ok;
 }
 // ---------------------------------------------------------------------------
+bool batch_case(void)
+{  // ok
+   bool ok = true;
+   //
+   // AD
+   using CppAD::AD;
+   //
+   // reciprocal
+   atomic_fun reciprocal("reciprocal");
+   //
+   // nx, ax
+   size_t nx = 3;
+   CPPAD_TESTVECTOR( AD<double> ) ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = double(j + 1);
+   CppAD::Independent(ax);
+   //
+   // ny, ay
+   // ay[0] = sum_j 1 / ax[j],  ay[1] = - sum_j ax[j]
+   size_t ny = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ay(ny), au(1), aw(1);
+   ay[0] = 0.0;
+   ay[1] = 0.0;
+   for(size_t j = 0; j < nx; ++j)
+   {  au[0] = ax[j];
+      reciprocal(au, aw);
+      ay[0] += aw[0];
+      ay[1] -= ax[j];
+   }
+   //
+   // function_name
+   std::string function_name = "batch";
+   //
+   // f
+   CppAD::ADFun<double> f(ax, ay);
+   f.function_name_set(function_name);
+   //
+   // dll_file
+   std::string dll_file = dll_file_name();
+   //
+   // csrc_files
+   CppAD::vector<std::string> csrc_files(2);
+   csrc_files[0] = create_csrc_file(0, reciprocal.forward_zero() );
+   std::string type = "double";
+   std::map< std::string, std::string > csrc_options;
+   csrc_options["batch_size"] = "3";
+   std::stringstream ss;
+   f.to_csrc(ss, type, csrc_options);
+   csrc_files[1] = create_csrc_file(1, ss.str() );
+   //
+   // create_dll_lib
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cout << err_msg << "\n";
+      ok = false;
+      return ok;
+   }
+   //
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   //
+   // jit_batch_double
+   using CppAD::jit_batch_double;
+   //
+   // jit_function
+   jit_batch_double jit_function = nullptr;
+   if( err_msg != "" )
+   {  std::cout << "dll_linker ctor error: " << err_msg << "\n";
+      ok = false;
+   }
+   else
+   {  // jit_function
+      std::string complete_name = "cppad_jit_batch_" + function_name;
+      jit_function = reinterpret_cast<jit_batch_double>(
+            dll_linker(complete_name, err_msg)
+      );
+      if( err_msg != "" )
+      {  std::cout << "dll_linker fun_ptr error: " << err_msg << "\n";
+         ok = false;
+      }
+   }
+   if( ok )
+   {  //
+      // x
+      // x[j * n_point + k] is component j of point k
+      size_t n_point = 7;
+      CppAD::vector<double> x(nx * n_point), y(ny * n_point);
+      for(size_t j = 0; j < nx; ++j)
+      {  for(size_t k = 0; k < n_point; ++k)
+            x[j * n_point + k] = double(j + 1) * double(k + 1);
+      }
+      for(size_t i = 0; i < ny * n_point; ++i)
+         y[i] = std::numeric_limits<double>::quiet_NaN();
+      //
+      // y
+      size_t compare_change = 0;
+      int flag = jit_function(
+         n_point, nx, x.data(), ny, y.data(), &compare_change
+      );
+      ok &= flag == 0;
+      ok &= compare_change == 0;
+      //
+      // ok
+      double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+      for(size_t k = 0; k < n_point; ++k)
+      {  double check_0 = 0.0, check_1 = 0.0;
+         for(size_t j = 0; j < nx; ++j)
+         {  check_0 += 1.0 / x[j * n_point + k];
+            check_1 -= x[j * n_point + k];
+         }
+         ok &= CppAD::NearEqual(y[0 * n_point + k], check_0, eps99, eps99);
+         ok &= CppAD::NearEqual(y[1 * n_point + k], check_1, eps99, eps99);
+      }
+   }
+   return ok;
+}
+// ---------------------------------------------------------------------------
+bool split_case(void)
+{  // ok
+   bool ok = true;
+   //
+   // AD
+   using CppAD::AD;
+   //
+   // reciprocal
+   atomic_fun reciprocal("reciprocal");
+   //
+   // nx, ax
+   size_t nx = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ax(nx);
+   for(size_t j = 0; j < nx; ++j)
+      ax[j] = double(j + 1);
+   CppAD::Independent(ax);
+   //
+   // ny, ay
+   // a chain of temporaries so that slots in v are reused and the
+   // result nodes are split into several parts
+   size_t ny = 2;
+   CPPAD_TESTVECTOR( AD<double> ) ay(ny), au(1), aw(1);
+   AD<double> at = ax[0];
+   for(size_t i = 0; i < 5; ++i)
+   {  au[0] = at * ax[1] + 1.0;
+      reciprocal(au, aw);
+      at = sin( aw[0] ) + at * at;
+   }
+   ay[0] = at;
+   ay[1] = at * ax[0];
+   //
+   // function_name
+   std::string function_name = "split";
+   //
+   // f
+   CppAD::ADFun<double> f(ax, ay);
+   f.function_name_set(function_name);
+   //
+   // dll_file
+   std::string dll_file = dll_file_name();
+   //
+   // csrc_files
+   CppAD::vector<std::string> csrc_files(2);
+   csrc_files[0] = create_csrc_file(0, reciprocal.forward_zero() );
+   std::string type = "double";
+   std::map< std::string, std::string > csrc_options;
+   csrc_options["batch_size"]    = "2";
+   csrc_options["max_statement"] = "3";
+   std::stringstream ss;
+   f.to_csrc(ss, type, csrc_options);
+   csrc_files[1] = create_csrc_file(1, ss.str() );
+   //
+   // ok
+   // check that the function was split into parts
+   ok &= ss.str().find("cppad_jit_split_part_1") != std::string::npos;
+   ok &= ss.str().find("cppad_jit_batch_split_part_1") != std::string::npos;
+   //
+   // create_dll_lib
+   std::map< std::string, std::string > options;
+   std::string err_msg = CppAD::create_dll_lib(dll_file, csrc_files, options);
+   if( err_msg != "" )
+   {  std::cout << err_msg << "\n";
+      ok = false;
+      return ok;
+   }
+   //
+   // dll_linker
+   CppAD::link_dll_lib dll_linker(dll_file, err_msg);
+   if( err_msg != "" )
+   {  std::cout << "dll_linker ctor error: " << err_msg << "\n";
+      return false;
+   }
+   //
+   // jit_function, jit_batch
+   using CppAD::jit_double;
+   using CppAD::jit_batch_double;
+   jit_double jit_function = reinterpret_cast<jit_double>(
+      dll_linker("cppad_jit_" + function_name, err_msg)
+   );
+   if( err_msg != "" )
+   {  std::cout << "dll_linker fun_ptr error: " << err_msg << "\n";
+      return false;
+   }
+   jit_batch_double jit_batch = reinterpret_cast<jit_batch_double>(
+      dll_linker("cppad_jit_batch_" + function_name, err_msg)
+   );
+   if( err_msg != "" )
+   {  std::cout << "dll_linker fun_ptr error: " << err_msg << "\n";
+      return false;
+   }
+   //
+   // x, y
+   // x[j * n_point + k] is component j of point k
+   size_t n_point = 5;
+   CppAD::vector<double> x(nx * n_point), y(ny * n_point);
+   for(size_t j = 0; j < nx; ++j)
+   {  for(size_t k = 0; k < n_point; ++k)
+         x[j * n_point + k] = double(j + 1) / double(k + 2);
+   }
+   size_t compare_change = 0;
+   int flag = jit_batch(
+      n_point, nx, x.data(), ny, y.data(), &compare_change
+   );
+   ok &= flag == 0;
+   //
+   // ok
+   double eps99 = 99.0 * std::numeric_limits<double>::epsilon();
+   CppAD::vector<double> x_k(nx), y_k(ny), check(ny);
+   for(size_t k = 0; k < n_point; ++k)
+   {  for(size_t j = 0; j < nx; ++j)
+         x_k[j] = x[j * n_point + k];
+      check = f.Forward(0, x_k);
+      flag  = jit_function(nx, x_k.data(), ny, y_k.data(), &compare_change);
+      ok   &= flag == 0;
+      for(size_t i = 0; i < ny; ++i)
+      {  ok &= CppAD::NearEqual(y_k[i], check[i], eps99, eps99);
+         ok &= CppAD::NearEqual(y[i * n_point + k], check[i], eps99, eps99);
+      }
+   }
+   ok &= compare_change == 0;
+   return ok;
+}
+// ---------------------------------------------------------------------------
 } // END_EMPTY_NAMESPACE
 // ---------------------------------------------------------------------------
 bool to_csrc(void)
@@ -709,5 +950,7 @@ bool to_csrc(void)
    ok     &= atomic_case();
    ok     &= discrete_case();
    ok     &= csum_case();
+   ok     &= batch_case();
+   ok     &= split_case();
    return ok;
 }